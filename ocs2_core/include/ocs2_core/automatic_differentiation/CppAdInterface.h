@@ -33,7 +33,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <Eigen/Core>
 
 // STL
+#include <memory>
 #include <string>
+#include <utility>
 
 // CppAD
 #include <cppad/cg.hpp>
@@ -85,7 +87,7 @@ class CppAdInterface {
   ~CppAdInterface() = default;
 
   /**
-   * Copy constructor. Models are reloaded if available.
+   * Copy constructor. The models of rhs are reloaded, if the library on disk still has the configuration of the library of rhs.
    */
   CppAdInterface(const CppAdInterface& rhs);
 
@@ -100,7 +102,7 @@ class CppAdInterface {
   void loadModels(bool verbose = true);
 
   /**
-   * Creates models, compiles them, and saves them to disk
+   * Creates models, compiles them, and saves them to disk together with a manifest that identifies the configuration of the library.
    *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
@@ -108,13 +110,28 @@ class CppAdInterface {
   void createModels(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
 
   /**
-   * Load models if they are available on disk. Creates a new library otherwise.
+   * Load models if they are available on disk and up to date. Creates a new library otherwise.
+   * A library is up to date if its manifest matches the hash of the model name, the dimensions, the approximation order, the compile
+   * flags and the compiler identification and version. The function is only taped if the library needs to be created. Hence, a change
+   * of the function that keeps its dimensions is not detected, call createModels() after changing the function.
    *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
    */
   void loadModelsIfAvailable(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
 
+  /**
+   * Loads the models of several interfaces if they are available and up to date, see loadModelsIfAvailable(). The missing libraries
+   * are compiled in parallel. Their functions are taped sequentially, since CppAD taping is not thread safe.
+   * Running this once when deploying prebuilds all libraries, such that later calls only load them.
+   *
+   * @param interfaces : Interfaces with the order of derivatives to generate for each of them
+   * @param nThreads : Number of threads used for compilation, including the calling thread
+   * @param verbose : Print out extra information
+   */
+  static void loadModelsIfAvailable(const std::vector<std::pair<CppAdInterface*, ApproximationOrder>>& interfaces, size_t nThreads,
+                                    bool verbose = true);
+
   /**
    * @param x : input vector of size variableDim
    * @param p : parameter vector of size parameterDim
@@ -165,6 +182,52 @@ class CppAdInterface {
    */
   matrix_t getHessian(const vector_t& w, const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Function values at a batch of points. Point i is given by column i of xBatch and pBatch.
+   * The outputs of all batch functions are only resized when their size does not match, such that repeated calls over a horizon of the
+   * same length reuse the memory of the caller.
+   *
+   * @param xBatch : variables, variableDim x numPoints
+   * @param pBatch : parameters, parameterDim x numPoints. May be empty if parameterDim = 0.
+   * @param [out] values : rangeDim x numPoints, column i holds f(x_i, p_i)
+   */
+  void getFunctionValueBatch(const matrix_t& xBatch, const matrix_t& pBatch, matrix_t& values) const;
+
+  /**
+   * Sparse Jacobians at a batch of points. All points share the sparsity pattern of getJacobianSparsityPattern().
+   *
+   * @param xBatch : variables, variableDim x numPoints
+   * @param pBatch : parameters, parameterDim x numPoints. May be empty if parameterDim = 0.
+   * @param [out] sparseJacobians : nnzJacobian x numPoints, column i holds the nonzeros of d/dx( f(x_i, p_i) )
+   */
+  void getSparseJacobianBatch(const matrix_t& xBatch, const matrix_t& pBatch, matrix_t& sparseJacobians) const;
+
+  /**
+   * Dense Jacobians at a batch of points.
+   *
+   * @param xBatch : variables, variableDim x numPoints
+   * @param pBatch : parameters, parameterDim x numPoints. May be empty if parameterDim = 0.
+   * @param [out] jacobians : numPoints matrices of size rangeDim x variableDim
+   */
+  void getJacobianBatch(const matrix_t& xBatch, const matrix_t& pBatch, matrix_array_t& jacobians) const;
+
+  /**
+   * Gauss-Newton approximations at a batch of points, see getGaussNewtonApproximation().
+   *
+   * @param xBatch : variables, variableDim x numPoints
+   * @param pBatch : parameters, parameterDim x numPoints. May be empty if parameterDim = 0.
+   * @param [out] gnApproximations : numPoints approximations with the values stored in f, dfdx, dfdxx.
+   */
+  void getGaussNewtonApproximationBatch(const matrix_t& xBatch, const matrix_t& pBatch,
+                                        std::vector<ScalarFunctionQuadraticApproximation>& gnApproximations) const;
+
+  /**
+   * Sparsity pattern of the Jacobian w.r.t. the variables, shared by all points of getSparseJacobianBatch().
+   * Nonzero k is located at (rows[k], cols[k]), ordered by row first, then by column.
+   */
+  const std::vector<size_t>& getJacobianSparsityRows() const { return jacobianRows_; }
+  const std::vector<size_t>& getJacobianSparsityCols() const { return jacobianCols_; }
+
  private:
   /**
    * Defines library folder names
@@ -182,6 +245,60 @@ class CppAdInterface {
    */
   bool isLibraryAvailable() const;
 
+  /**
+   * Checks if the library on disk was created with the given configuration.
+   * @param configurationHash : hash of the configuration, see computeConfigurationHash
+   * @return isLibraryUpToDate
+   */
+  bool isLibraryUpToDate(const std::string& configurationHash) const;
+
+  /**
+   * Reads the configuration hash from the manifest of the library on disk
+   * @return configuration hash, empty if the library has no manifest
+   */
+  std::string readManifestConfigurationHash() const;
+
+  /**
+   * Writes the manifest of the library
+   * @param configurationHash : hash of the configuration, see computeConfigurationHash
+   * @param approximationOrder : Order of derivatives in the library
+   */
+  void writeManifest(const std::string& configurationHash, ApproximationOrder approximationOrder) const;
+
+  /**
+   * Tapes and optimizes the function. Sets the range dimension.
+   * @return taped ad function
+   */
+  std::unique_ptr<ad_fun_t> tapeFunction();
+
+  /**
+   * Computes a hash identifying the configuration of the library: the model name, the dimensions, the approximation order, the compile
+   * flags and the compiler identification and version. Does not require taping the function.
+   * @param approximationOrder : Order of derivatives to generate
+   * @return hash in hexadecimal format
+   */
+  std::string computeConfigurationHash(ApproximationOrder approximationOrder) const;
+
+  /** Generated sources of the model library, see generateSources */
+  struct ModelSources;
+
+  /**
+   * Generates the sources of the model library. Uses CppAD and is therefore not thread safe.
+   * @param fun : taped ad function
+   * @param approximationOrder : Order of derivatives to generate
+   * @param configurationHash : hash of the configuration, see computeConfigurationHash
+   * @return sources
+   */
+  std::unique_ptr<ModelSources> generateSources(std::unique_ptr<ad_fun_t> fun, ApproximationOrder approximationOrder,
+                                                std::string configurationHash) const;
+
+  /**
+   * Compiles the generated sources and saves the library to disk. Can run in parallel for different models.
+   * @param sources : generated sources
+   * @param verbose : Print out extra information
+   */
+  void compileLibrary(ModelSources& sources, bool verbose) const;
+
   /**
    * Creates a random temporary folder name
    * @return folder name
@@ -221,8 +338,31 @@ class CppAdInterface {
    */
   cppad_sparsity::SparsityPattern createHessianSparsity(ad_fun_t& fun) const;
 
+  /**
+   * Writes the concatenation of column i of xBatch and pBatch to xp
+   */
+  void getBatchInput(const matrix_t& xBatch, const matrix_t& pBatch, size_t i, vector_t& xp) const;
+
+  /**
+   * Checks the sizes of a batch of points
+   * @return number of points
+   */
+  size_t checkBatchSize(const matrix_t& xBatch, const matrix_t& pBatch) const;
+
+  /**
+   * Evaluates the sparse Jacobian at xp into sparseJacobian, which must have space for nnzJacobian_ elements
+   */
+  void evaluateSparseJacobian(const vector_t& xp, scalar_t* sparseJacobian) const;
+
+  /**
+   * Builds the Gauss-Newton approximation from the function value and the sparse Jacobian
+   */
+  void fillGaussNewtonApproximation(const vector_t& value, const scalar_t* sparseJacobian,
+                                    ScalarFunctionQuadraticApproximation& gnApprox) const;
+
   std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> dynamicLib_;
   std::unique_ptr<CppAD::cg::GenericModel<scalar_t>> model_;
+  std::string configurationHash_;  // of the loaded library, empty if it has no manifest
   ad_parameterized_function_t adFunction_;
   std::vector<std::string> compileFlags_;
 
@@ -232,6 +372,8 @@ class CppAdInterface {
   size_t rangeDim_ = 0;
   size_t nnzJacobian_ = 0;
   size_t nnzHessian_ = 0;
+  std::vector<size_t> jacobianRows_;
+  std::vector<size_t> jacobianCols_;
 
   // Names
   std::string modelName_;
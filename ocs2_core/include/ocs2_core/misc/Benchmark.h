@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <algorithm>
 #include <chrono>
 
 #include "ocs2_core/Types.h"
@@ -99,6 +100,13 @@ class RepeatedTimer {
    */
   scalar_t getAverageInMilliseconds() const { return getTotalInMilliseconds() / numTimedIntervals_; }
 
+  /**
+   * @return Expected duration of the next interval, i.e., the maximum of the average and the last interval. Zero if no interval was timed.
+   */
+  scalar_t getExpectedIntervalInMilliseconds() const {
+    return (numTimedIntervals_ > 0) ? std::max(getAverageInMilliseconds(), getLastIntervalInMilliseconds()) : 0.0;
+  }
+
  private:
   int numTimedIntervals_;
   std::chrono::nanoseconds totalTime_;
@@ -67,6 +67,9 @@ struct MetricsCollection {
   // Cost
   scalar_t cost;
 
+  // Dynamics violation (defect) of the interval starting at this node
+  vector_t dynamicsViolation;
+
   // Equality constraints
   vector_t stateEqConstraint;
   vector_t stateInputEqConstraint;
@@ -85,6 +88,8 @@ struct MetricsCollection {
   void swap(MetricsCollection& other) {
     // Cost
     std::swap(cost, other.cost);
+    // Dynamics violation
+    dynamicsViolation.swap(other.dynamicsViolation);
     // Equality constraints
     stateEqConstraint.swap(other.stateEqConstraint);
     stateInputEqConstraint.swap(other.stateInputEqConstraint);
@@ -102,6 +107,8 @@ struct MetricsCollection {
   void clear() {
     // Cost
     cost = 0.0;
+    // Dynamics violation
+    dynamicsViolation = vector_t();
     // Equality constraints
     stateEqConstraint = vector_t();
     stateInputEqConstraint = vector_t();
@@ -0,0 +1,77 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <pthread.h>
+#include <sched.h>
+#include <iostream>
+#include <thread>
+
+namespace ocs2 {
+
+/**
+ * Pins the input thread to a single CPU core.
+ *
+ * @param cpu: The index of the CPU core. A negative value leaves the affinity unchanged.
+ * @param thread: A reference to the tread.
+ */
+inline void setThreadAffinity(int cpu, pthread_t thread) {
+  if (cpu >= 0) {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    if (pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuSet) != 0) {
+      std::cerr << "WARNING: Failed to set the affinity of the thread to CPU " << cpu << " (one possible reason could be "
+                << "that the CPU does not exist or is not available to this process.)" << std::endl;
+    }
+  }
+}
+
+/**
+ * Pins the input thread to a single CPU core.
+ *
+ * @param cpu: The index of the CPU core. A negative value leaves the affinity unchanged.
+ * @param thread: A reference to the tread.
+ */
+inline void setThreadAffinity(int cpu, std::thread& thread) {
+  setThreadAffinity(cpu, thread.native_handle());
+}
+
+/**
+ * Pins the thread this function is called from to a single CPU core.
+ *
+ * @param cpu: The index of the CPU core. A negative value leaves the affinity unchanged.
+ */
+inline void setThisThreadAffinity(int cpu) {
+  setThreadAffinity(cpu, pthread_self());
+}
+
+}  // namespace ocs2
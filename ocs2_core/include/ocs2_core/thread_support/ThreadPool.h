@@ -29,7 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
+#include <exception>
+#include <functional>
 #include <future>
 #include <mutex>
 #include <queue>
@@ -40,6 +43,11 @@ namespace ocs2 {
 
 /**
  * Thread pool class to execute tasks on multiple threads.
+ *
+ * The workers are persistent. While idle, a worker spins for a short period on the dispatch state before it parks on a condition
+ * variable, such that back-to-back calls to runParallel are picked up without a wake-up delay. Likewise, the caller of runParallel
+ * spins for a short period before it parks while waiting for the helpers to finish. runParallel hands the task over by
+ * reference, i.e., without allocating per helper. Each worker thread always runs with the same worker index.
  */
 class ThreadPool {
  public:
@@ -48,8 +56,10 @@ class ThreadPool {
    *
    * @param [in] nThreads: Number of threads to launch in the pool
    * @param [in] priority: The worker thread priority
+   * @param [in] cpuAffinity: The CPU core to pin each worker thread to, i.e. worker i is pinned to cpuAffinity[i]. Workers without an
+   *                          entry or with a negative entry are not pinned.
    */
-  explicit ThreadPool(size_t nThreads = 1, int priority = 0);
+  explicit ThreadPool(size_t nThreads = 1, int priority = 0, std::vector<int> cpuAffinity = std::vector<int>());
 
   /**
    * Destructor
@@ -72,7 +82,10 @@ class ThreadPool {
    * - 1 task will run in the calling thread with ID = nThreads.
    * - N-1 tasks will run on the threadpool with ID in [0, nThreads-1].
    *
-   * @note This is a blocking operation, returns when all tasks are completed.
+   * @note This is a blocking operation, returns when all tasks are completed. An exception thrown by any of the tasks is rethrown
+   *       after all tasks are completed.
+   * @note Calls to runParallel from different threads are serialized. Calling runParallel with helpers from within a task of a
+   *       runParallel call of the same pool would deadlock and throws a std::runtime_error instead.
    * @warning Calling runParallel(task, nThreads) does not guarantee that each task will be executed with a different workerIndex.
    *
    * @param [in] taskFunction: task function to run in the pool.
@@ -96,6 +109,23 @@ class ThreadPool {
    */
   void worker(int workerIndex);
 
+  /**
+   * Blocks the worker until there is a new parallel job, a queued task or the pool is stopped. Spins for a short period before parking.
+   *
+   * @param [in] lastParallelJobId: The id of the last parallel job the worker has seen.
+   */
+  void waitForWork(size_t lastParallelJobId);
+
+  /** Wakes up the parked workers */
+  void notifyWorkers();
+
+  /**
+   * Claims and executes instances of the current parallel job until all instances are claimed.
+   *
+   * @param [in] workerIndex: The index passed to the task.
+   */
+  void executeParallelJob(int workerIndex);
+
   /**
    * Run a task asynchronously in another thread
    *
@@ -103,12 +133,31 @@ class ThreadPool {
    */
   void runTask(std::unique_ptr<TaskBase> taskPtr);
 
-  bool stop_{false};  //!< flag telling all threads to stop, protected by taskQueueLock_
+  std::atomic_bool stop_{false};  //!< flag telling all threads to stop
 
   std::queue<std::unique_ptr<TaskBase>> taskQueue_;  // protected by taskQueueLock_
-  std::condition_variable taskQueueCondition_;
+  std::atomic_int numQueuedTasks_{0};
   std::mutex taskQueueLock_;
 
+  // Parking of the idle workers
+  std::condition_variable wakeUpCondition_;
+  std::mutex wakeUpLock_;
+  std::atomic_int numParkedWorkers_{0};
+
+  // The parallel job. A new job is published by incrementing parallelJobId_.
+  std::mutex parallelJobLock_;                              // serializes calls to runParallel
+  const std::function<void(int)>* parallelTaskPtr_{nullptr};  // valid while numUnfinishedTasks_ > 0
+  std::atomic<size_t> parallelJobId_{0};
+  std::atomic_int numUnclaimedTasks_{0};
+  std::atomic_int numUnfinishedTasks_{0};
+  std::exception_ptr parallelTaskException_;  // protected by parallelTaskExceptionLock_
+  std::mutex parallelTaskExceptionLock_;
+
+  // Parking of the caller of runParallel while the helpers finish
+  std::condition_variable parallelJobDoneCondition_;
+  std::mutex parallelJobDoneLock_;
+  std::atomic_bool isCallerParked_{false};
+
   std::vector<std::thread> workerThreads_;
 };
 
@@ -0,0 +1,120 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace ocs2 {
+
+/**
+ * Wait-free triple buffer for passing values from one producer thread to one consumer thread.
+ *
+ * The three slots are allocated once at construction. The producer fills its write slot in place and publishes it with
+ * publishWriteBuffer(). The consumer takes the most recently published slot with updateReadBuffer(). Both sides only exchange
+ * slot indices through a single atomic variable, so neither of them ever blocks or misses the latest published value. Values
+ * which are published while the consumer does not read are overwritten by the newer ones.
+ *
+ * Every published value is tagged with a generation number, starting at 1, which allows the consumer to detect skipped values.
+ *
+ * @warning Only one thread may call getWriteBuffer() and publishWriteBuffer(), and only one (possibly different) thread may call
+ * updateReadBuffer(), getReadBuffer() and getReadGeneration().
+ *
+ * @tparam T : wrapped type
+ */
+template <typename T>
+class TripleBuffer {
+ public:
+  /**
+   * Constructor initializes all slots with a given value.
+   * @param value
+   */
+  explicit TripleBuffer(const T& value = T()) : slots_{{value, value, value}}, generations_{{0, 0, 0}} {}
+
+  /** Gets the slot which the producer can fill in place. The slot keeps the content it had when it was last read. */
+  T& getWriteBuffer() { return slots_[writeIndex_]; }
+
+  /**
+   * Makes the write slot available to the consumer and hands a free slot back to the producer.
+   * @return The generation of the published value.
+   */
+  size_t publishWriteBuffer() {
+    generations_[writeIndex_] = ++writeGeneration_;
+    writeIndex_ = middle_.exchange(writeIndex_ | newValueFlag_, std::memory_order_acq_rel) & indexMask_;
+    return writeGeneration_;
+  }
+
+  /**
+   * Replaces the read slot with the most recently published one.
+   * @return True: the read slot was updated, False: nothing has been published since the last update.
+   */
+  bool updateReadBuffer() {
+    if ((middle_.load(std::memory_order_relaxed) & newValueFlag_) == 0) {
+      return false;
+    }
+    readIndex_ = middle_.exchange(readIndex_, std::memory_order_acq_rel) & indexMask_;
+    return true;
+  }
+
+  /** Read the slot which was taken by the last updateReadBuffer() call. */
+  const T& getReadBuffer() const { return slots_[readIndex_]; }
+
+  /** Read/write the slot which was taken by the last updateReadBuffer() call. */
+  T& getReadBuffer() { return slots_[readIndex_]; }
+
+  /** Gets the generation of the read slot. It is 0 if nothing has been read yet. */
+  size_t getReadGeneration() const { return generations_[readIndex_]; }
+
+ private:
+  static constexpr uint8_t indexMask_ = 0x3;
+  static constexpr uint8_t newValueFlag_ = 0x4;
+
+  std::array<T, 3> slots_;
+  std::array<size_t, 3> generations_;
+
+  // owned by the producer
+  uint8_t writeIndex_ = 0;
+  size_t writeGeneration_ = 0;
+
+  // owned by the consumer
+  uint8_t readIndex_ = 1;
+
+  // index of the slot in between, together with the flag whether it holds a value which has not been read yet
+  std::atomic<uint8_t> middle_{2};
+};
+
+template <typename T>
+constexpr uint8_t TripleBuffer<T>::indexMask_;
+template <typename T>
+constexpr uint8_t TripleBuffer<T>::newValueFlag_;
+
+}  // namespace ocs2
@@ -29,10 +29,81 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
 #include <boost/filesystem.hpp>
 
+#include <ocs2_core/thread_support/ThreadPool.h>
+
 namespace ocs2 {
 
+namespace {
+
+/** Library processor that gives access to the generated sources, such that they can be generated before compilation */
+class SourceAccessLibraryProcessor : public CppAD::cg::DynamicModelLibraryProcessor<scalar_t> {
+ public:
+  using CppAD::cg::DynamicModelLibraryProcessor<scalar_t>::DynamicModelLibraryProcessor;
+
+  const std::map<std::string, std::string>& getModelSources(CppAD::cg::ModelCSourceGen<scalar_t>& model) { return this->getSources(model); }
+  using CppAD::cg::DynamicModelLibraryProcessor<scalar_t>::getLibrarySources;
+};
+
+/** Path, identification and version of the compiler of the model libraries, e.g. "/usr/bin/gcc gcc (Ubuntu 9.4.0) 9.4.0" */
+const std::string& getCompilerVersion() {
+  static const std::string compilerVersion = []() {
+    const CppAD::cg::GccCompiler<scalar_t> gccCompiler;
+    std::string output;
+    try {
+      CppAD::cg::system::callExecutable(gccCompiler.getCompilerPath(), {"--version"}, &output);
+    } catch (const CppAD::cg::CGException&) {
+      output.clear();  // a missing compiler fails later, when compiling
+    }
+    return gccCompiler.getCompilerPath() + " " + output.substr(0, output.find('\n'));
+  }();
+  return compilerVersion;
+}
+
+/** 64 bit FNV-1a hash, stable across platforms and runs */
+class Fnv1aHash {
+ public:
+  void add(const std::string& data) {
+    for (const char c : data) {
+      hash_ = (hash_ ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+    }
+    // separator, such that ("ab", "c") and ("a", "bc") differ
+    hash_ = (hash_ ^ 0xffULL) * 1099511628211ULL;
+  }
+
+  std::string toString() const {
+    std::ostringstream stream;
+    stream << std::hex << std::setw(16) << std::setfill('0') << hash_;
+    return stream.str();
+  }
+
+ private:
+  uint64_t hash_ = 14695981039346656037ULL;
+};
+
+}  // namespace
+
+/** Sources of a model library. Members depend on each other by reference and are therefore kept together. */
+struct CppAdInterface::ModelSources {
+  ModelSources(std::unique_ptr<ad_fun_t> taped, const std::string& modelName, const std::string& libraryName)
+      : fun(std::move(taped)), sourceGen(*fun, modelName), libraryCSourceGen(sourceGen), processor(libraryCSourceGen, libraryName) {}
+
+  std::unique_ptr<ad_fun_t> fun;
+  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen;
+  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen;
+  SourceAccessLibraryProcessor processor;
+  std::string configurationHash;
+  ApproximationOrder approximationOrder;
+};
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -60,8 +131,12 @@ CppAdInterface::CppAdInterface(ad_function_t adFunction, size_t variableDim, std
 /******************************************************************************************************/
 CppAdInterface::CppAdInterface(const CppAdInterface& rhs)
     : CppAdInterface(rhs.adFunction_, rhs.variableDim_, rhs.parameterDim_, rhs.modelName_, rhs.folderName_, rhs.compileFlags_) {
-  if (isLibraryAvailable()) {
-    loadModels(false);
+  // Only load the library of rhs. It might have been replaced on disk in the meantime.
+  if (rhs.model_ != nullptr) {
+    const bool isSameLibrary = rhs.configurationHash_.empty() ? isLibraryAvailable() : isLibraryUpToDate(rhs.configurationHash_);
+    if (isSameLibrary) {
+      loadModels(false);
+    }
   }
 }
 
@@ -71,52 +146,9 @@ CppAdInterface::CppAdInterface(const CppAdInterface& rhs)
 void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool verbose) {
   createFolderStructure();
 
-  // set and declare independent variables and start tape recording
-  ad_vector_t xp(variableDim_ + parameterDim_);
-  xp.setOnes();  // Ones are better than zero, to prevent devision by zero in taping
-  CppAD::Independent(xp);
-
-  // Split in variables and parameters
-  ad_vector_t x = xp.segment(0, variableDim_);
-  ad_vector_t p = xp.segment(variableDim_, parameterDim_);
-  // dependent variable vector
-  ad_vector_t y;
-  // the model equation
-  adFunction_(x, p, y);
-  rangeDim_ = y.rows();
-  // create f: xp -> y and stop tape recording
-  ad_fun_t fun(xp, y);
-  // Optimize the operation sequence
-  fun.optimize();
-
-  // generates source code
-  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen(fun, modelName_);
-  setApproximationOrder(approximationOrder, sourceGen, fun);
-
-  // Compiler objects, compile to temporary shared library file to avoid interference between processes
-  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen(sourceGen);
-  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
-  CppAD::cg::DynamicModelLibraryProcessor<scalar_t> libraryProcessor(libraryCSourceGen, libraryName_ + tmpName_);
-  setCompilerOptions(gccCompiler);
-
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Compiling Shared Library: "
-              << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
-  }
-
-  // Compile and store the library
-  dynamicLib_ = libraryProcessor.createDynamicLibrary(gccCompiler);
-  model_ = dynamicLib_->model(modelName_);
-
-  setSparsityNonzeros();
-
-  // Rename generated library after loading
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Renaming " << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << " to "
-              << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
-  }
-  boost::filesystem::rename(libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION,
-                            libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
+  auto sources = generateSources(tapeFunction(), approximationOrder, computeConfigurationHash(approximationOrder));
+  compileLibrary(*sources, verbose);
+  loadModels(false);
 }
 
 /******************************************************************************************************/
@@ -130,6 +162,7 @@ void CppAdInterface::loadModels(bool verbose) {
   dynamicLib_.reset(new CppAD::cg::LinuxDynamicLib<scalar_t>(libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION));
   model_ = dynamicLib_->model(modelName_);
   rangeDim_ = model_->Range();
+  configurationHash_ = readManifestConfigurationHash();
 
   setSparsityNonzeros();
 }
@@ -138,10 +171,55 @@ void CppAdInterface::loadModels(bool verbose) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void CppAdInterface::loadModelsIfAvailable(ApproximationOrder approximationOrder, bool verbose) {
-  if (isLibraryAvailable()) {
+  auto configurationHash = computeConfigurationHash(approximationOrder);
+  if (isLibraryUpToDate(configurationHash)) {
     loadModels(verbose);
   } else {
-    createModels(approximationOrder, verbose);
+    createFolderStructure();
+    auto sources = generateSources(tapeFunction(), approximationOrder, std::move(configurationHash));
+    compileLibrary(*sources, verbose);
+    loadModels(false);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::loadModelsIfAvailable(const std::vector<std::pair<CppAdInterface*, ApproximationOrder>>& interfaces, size_t nThreads,
+                                           bool verbose) {
+  // Load the up to date libraries. Tape the functions and generate the sources of the missing or outdated ones.
+  std::vector<std::unique_ptr<ModelSources>> sources(interfaces.size());
+  for (size_t i = 0; i < interfaces.size(); i++) {
+    auto& adInterface = *interfaces[i].first;
+    const auto approximationOrder = interfaces[i].second;
+    auto configurationHash = adInterface.computeConfigurationHash(approximationOrder);
+    if (adInterface.isLibraryUpToDate(configurationHash)) {
+      adInterface.loadModels(verbose);
+    } else {
+      adInterface.createFolderStructure();
+      sources[i] = adInterface.generateSources(adInterface.tapeFunction(), approximationOrder, std::move(configurationHash));
+    }
+  }
+
+  // Compile in parallel
+  nThreads = std::max(nThreads, size_t(1));
+  std::atomic_size_t nextIndex{0};
+  auto compileTask = [&](int) {
+    size_t i;
+    while ((i = nextIndex++) < interfaces.size()) {
+      if (sources[i] != nullptr) {
+        interfaces[i].first->compileLibrary(*sources[i], verbose);
+      }
+    }
+  };
+  ThreadPool threadPool(nThreads - 1);
+  threadPool.runParallel(std::move(compileTask), nThreads);
+
+  // Load the new libraries
+  for (size_t i = 0; i < interfaces.size(); i++) {
+    if (sources[i] != nullptr) {
+      interfaces[i].first->loadModels(false);
+    }
   }
 }
 
@@ -166,20 +244,15 @@ matrix_t CppAdInterface::getJacobian(const vector_t& x, const vector_t& p) const
   // Concatenate input
   vector_t xp(variableDim_ + parameterDim_);
   xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
 
   std::vector<scalar_t> sparseJacobian(nnzJacobian_);
-  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
-  size_t const* rows;
-  size_t const* cols;
-  // Call this particular SparseJacobian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
-  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+  evaluateSparseJacobian(xp, sparseJacobian.data());
 
   // Write sparse elements into Eigen type. Only jacobian w.r.t. variables was requested, so cols should not contain elements corresponding
   // to parameters.
   matrix_t jacobian = matrix_t::Zero(model_->Range(), variableDim_);
   for (size_t i = 0; i < nnzJacobian_; i++) {
-    jacobian(rows[i], cols[i]) = sparseJacobian[i];
+    jacobian(jacobianRows_[i], jacobianCols_[i]) = sparseJacobian[i];
   }
 
   assert(jacobian.allFinite());
@@ -193,26 +266,34 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
   // Concatenate input
   vector_t xp(variableDim_ + parameterDim_);
   xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
-
-  ScalarFunctionQuadraticApproximation gnApprox;
 
   // Zero order
   vector_t valueVector(model_->Range());
   model_->ForwardZero(xp, valueVector);
-  gnApprox.f = 0.5 * valueVector.squaredNorm();
 
   // Jacobian
   std::vector<scalar_t> sparseJacobian(nnzJacobian_);
-  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
-  size_t const* rows;
-  size_t const* cols;
-  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+  evaluateSparseJacobian(xp, sparseJacobian.data());
+
+  ScalarFunctionQuadraticApproximation gnApprox;
+  fillGaussNewtonApproximation(valueVector, sparseJacobian.data(), gnApprox);
+  return gnApprox;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::fillGaussNewtonApproximation(const vector_t& value, const scalar_t* sparseJacobian,
+                                                  ScalarFunctionQuadraticApproximation& gnApprox) const {
+  const auto& rows = jacobianRows_;
+  const auto& cols = jacobianCols_;
+
+  gnApprox.f = 0.5 * value.squaredNorm();
 
   // Sparse evaluation of J' * f
   gnApprox.dfdx.setZero(variableDim_);
   for (size_t i = 0; i < nnzJacobian_; i++) {
-    gnApprox.dfdx(cols[i]) += sparseJacobian[i] * valueVector(rows[i]);
+    gnApprox.dfdx(cols[i]) += sparseJacobian[i] * value(rows[i]);
   }
 
   /*
@@ -230,7 +311,7 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
     gnApprox.dfdxx(col_i, col_i) += v_i * v_i;
     // Process off-diagonals
     size_t j = i + 1;
-    while (rows[j] == row_i) {
+    while (j < nnzJacobian_ && rows[j] == row_i) {
       const size_t col_j = cols[j];
       gnApprox.dfdxx(col_j, col_i) += v_i * sparseJacobian[j];
       gnApprox.dfdxx(col_i, col_j) = gnApprox.dfdxx(col_j, col_i);  // Maintain symmetry as we go.
@@ -240,7 +321,6 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
 
   assert(gnApprox.dfdx.allFinite());
   assert(gnApprox.dfdxx.allFinite());
-  return gnApprox;
 }
 
 /******************************************************************************************************/
@@ -285,6 +365,239 @@ matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const
   return hessian;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getFunctionValueBatch(const matrix_t& xBatch, const matrix_t& pBatch, matrix_t& values) const {
+  const size_t numPoints = checkBatchSize(xBatch, pBatch);
+  values.resize(rangeDim_, numPoints);
+
+  vector_t xp(variableDim_ + parameterDim_);
+  for (size_t i = 0; i < numPoints; i++) {
+    getBatchInput(xBatch, pBatch, i, xp);
+    CppAD::cg::ArrayView<scalar_t> valueArrayView(values.data() + i * rangeDim_, rangeDim_);
+    model_->ForwardZero(CppAD::cg::ArrayView<const scalar_t>(xp.data(), xp.size()), valueArrayView);
+  }
+  assert(values.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getSparseJacobianBatch(const matrix_t& xBatch, const matrix_t& pBatch, matrix_t& sparseJacobians) const {
+  const size_t numPoints = checkBatchSize(xBatch, pBatch);
+  sparseJacobians.resize(nnzJacobian_, numPoints);
+
+  // Column major storage: the nonzeros of each point are contiguous
+  vector_t xp(variableDim_ + parameterDim_);
+  for (size_t i = 0; i < numPoints; i++) {
+    getBatchInput(xBatch, pBatch, i, xp);
+    evaluateSparseJacobian(xp, sparseJacobians.data() + i * nnzJacobian_);
+  }
+  assert(sparseJacobians.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getJacobianBatch(const matrix_t& xBatch, const matrix_t& pBatch, matrix_array_t& jacobians) const {
+  const size_t numPoints = checkBatchSize(xBatch, pBatch);
+  jacobians.resize(numPoints);
+
+  vector_t xp(variableDim_ + parameterDim_);
+  vector_t sparseJacobian(nnzJacobian_);
+  for (size_t i = 0; i < numPoints; i++) {
+    getBatchInput(xBatch, pBatch, i, xp);
+    evaluateSparseJacobian(xp, sparseJacobian.data());
+
+    auto& jacobian = jacobians[i];
+    jacobian.setZero(rangeDim_, variableDim_);
+    for (size_t k = 0; k < nnzJacobian_; k++) {
+      jacobian(jacobianRows_[k], jacobianCols_[k]) = sparseJacobian[k];
+    }
+    assert(jacobian.allFinite());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getGaussNewtonApproximationBatch(const matrix_t& xBatch, const matrix_t& pBatch,
+                                                      std::vector<ScalarFunctionQuadraticApproximation>& gnApproximations) const {
+  const size_t numPoints = checkBatchSize(xBatch, pBatch);
+  gnApproximations.resize(numPoints);
+
+  vector_t xp(variableDim_ + parameterDim_);
+  vector_t value(rangeDim_);
+  vector_t sparseJacobian(nnzJacobian_);
+  for (size_t i = 0; i < numPoints; i++) {
+    getBatchInput(xBatch, pBatch, i, xp);
+    model_->ForwardZero(xp, value);
+    evaluateSparseJacobian(xp, sparseJacobian.data());
+    fillGaussNewtonApproximation(value, sparseJacobian.data(), gnApproximations[i]);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getBatchInput(const matrix_t& xBatch, const matrix_t& pBatch, size_t i, vector_t& xp) const {
+  xp.head(variableDim_) = xBatch.col(i);
+  if (parameterDim_ > 0) {
+    xp.tail(parameterDim_) = pBatch.col(i);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t CppAdInterface::checkBatchSize(const matrix_t& xBatch, const matrix_t& pBatch) const {
+  if (static_cast<size_t>(xBatch.rows()) != variableDim_) {
+    throw std::runtime_error("[CppAdInterface] Batch of variables has " + std::to_string(xBatch.rows()) + " rows, expected " +
+                             std::to_string(variableDim_));
+  }
+  const bool hasParameters = parameterDim_ > 0 || pBatch.size() > 0;
+  if (hasParameters && (static_cast<size_t>(pBatch.rows()) != parameterDim_ || pBatch.cols() != xBatch.cols())) {
+    throw std::runtime_error("[CppAdInterface] Batch of parameters has size " + std::to_string(pBatch.rows()) + " x " +
+                             std::to_string(pBatch.cols()) + ", expected " + std::to_string(parameterDim_) + " x " +
+                             std::to_string(xBatch.cols()));
+  }
+  return xBatch.cols();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::evaluateSparseJacobian(const vector_t& xp, scalar_t* sparseJacobian) const {
+  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xp.data(), xp.size());
+  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian, nnzJacobian_);
+  size_t const* rows;
+  size_t const* cols;
+  // Call this particular SparseJacobian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
+  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<CppAdInterface::ad_fun_t> CppAdInterface::tapeFunction() {
+  // set and declare independent variables and start tape recording
+  ad_vector_t xp(variableDim_ + parameterDim_);
+  xp.setOnes();  // Ones are better than zero, to prevent devision by zero in taping
+  CppAD::Independent(xp);
+
+  // Split in variables and parameters
+  ad_vector_t x = xp.segment(0, variableDim_);
+  ad_vector_t p = xp.segment(variableDim_, parameterDim_);
+  // dependent variable vector
+  ad_vector_t y;
+  // the model equation
+  adFunction_(x, p, y);
+  rangeDim_ = y.rows();
+  // create f: xp -> y and stop tape recording
+  std::unique_ptr<ad_fun_t> fun(new ad_fun_t(xp, y));
+  // Optimize the operation sequence
+  fun->optimize();
+  return fun;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::computeConfigurationHash(ApproximationOrder approximationOrder) const {
+  Fnv1aHash hash;
+  hash.add(modelName_);
+  hash.add(std::to_string(variableDim_) + " " + std::to_string(parameterDim_));
+  hash.add(std::to_string(static_cast<int>(approximationOrder)));
+  for (const auto& flag : compileFlags_) {
+    hash.add(flag);
+  }
+  hash.add(getCompilerVersion());
+  return hash.toString();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<CppAdInterface::ModelSources> CppAdInterface::generateSources(std::unique_ptr<ad_fun_t> fun,
+                                                                              ApproximationOrder approximationOrder,
+                                                                              std::string configurationHash) const {
+  std::unique_ptr<ModelSources> sources(new ModelSources(std::move(fun), modelName_, libraryName_ + tmpName_));
+  sources->configurationHash = std::move(configurationHash);
+  sources->approximationOrder = approximationOrder;
+  setApproximationOrder(approximationOrder, sources->sourceGen, *sources->fun);
+  sources->processor.getModelSources(sources->sourceGen);
+  sources->processor.getLibrarySources();
+  return sources;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::compileLibrary(ModelSources& sources, bool verbose) const {
+  // Compile to temporary shared library file to avoid interference between processes
+  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
+  setCompilerOptions(gccCompiler);
+
+  if (verbose) {
+    std::cerr << "[CppAdInterface] Compiling Shared Library: "
+              << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
+  }
+
+  // Compile and store the library
+  sources.processor.createDynamicLibrary(gccCompiler, false);
+
+  // Rename generated library after compilation
+  if (verbose) {
+    std::cerr << "[CppAdInterface] Renaming " << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << " to "
+              << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
+  }
+  boost::filesystem::rename(libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION,
+                            libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
+  writeManifest(sources.configurationHash, sources.approximationOrder);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool CppAdInterface::isLibraryUpToDate(const std::string& configurationHash) const {
+  return isLibraryAvailable() && readManifestConfigurationHash() == configurationHash;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::readManifestConfigurationHash() const {
+  std::ifstream manifest(libraryName_ + ".manifest");
+  std::string key;
+  std::string value;
+  while (manifest >> key >> value) {
+    if (key == "configuration:") {
+      return value;
+    }
+  }
+  return std::string();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::writeManifest(const std::string& configurationHash, ApproximationOrder approximationOrder) const {
+  // Write to a temporary file first, such that a concurrent reader never sees a partial manifest
+  const std::string manifestName = libraryName_ + ".manifest";
+  {
+    std::ofstream manifest(manifestName + tmpName_);
+    manifest << "configuration: " << configurationHash << "\n";
+    manifest << "model: " << modelName_ << "\n";
+    manifest << "variableDim: " << variableDim_ << "\n";
+    manifest << "parameterDim: " << parameterDim_ << "\n";
+    manifest << "rangeDim: " << rangeDim_ << "\n";
+    manifest << "approximationOrder: " << static_cast<int>(approximationOrder) << "\n";
+    manifest << "compiler: " << getCompilerVersion() << "\n";
+  }
+  boost::filesystem::rename(manifestName + tmpName_, manifestName);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -319,8 +632,11 @@ void CppAdInterface::createFolderStructure() const {
 /******************************************************************************************************/
 std::string CppAdInterface::getUniqueTemporaryName() const {
   // Random string should be unique for each process and time of calling.
+  // The counter distinguishes instances within a process, which may compile at the same time.
+  static std::atomic_size_t instanceCounter{0};
   int randomFromClock = std::chrono::high_resolution_clock::now().time_since_epoch().count() % 1000;
-  return std::string("cppadcg_tmp") + std::to_string(randomFromClock) + std::to_string(getpid());
+  return std::string("cppadcg_tmp") + std::to_string(randomFromClock) + std::to_string(getpid()) + "_" +
+         std::to_string(instanceCounter++);
 }
 
 /******************************************************************************************************/
@@ -369,6 +685,7 @@ void CppAdInterface::setApproximationOrder(ApproximationOrder approximationOrder
 void CppAdInterface::setSparsityNonzeros() {
   if (model_->isJacobianSparsityAvailable()) {
     nnzJacobian_ = cppad_sparsity::getNumberOfNonZeros(model_->JacobianSparsitySet());
+    model_->JacobianSparsity(jacobianRows_, jacobianCols_);
   }
   if (model_->isHessianSparsityAvailable()) {
     nnzHessian_ = cppad_sparsity::getNumberOfNonZeros(model_->HessianSparsitySet());
@@ -113,6 +113,11 @@ MetricsCollection interpolate(const index_alpha_t& indexAlpha, const std::vector
   out.cost = interpolate(indexAlpha, dataArray,
                          [](const std::vector<MetricsCollection>& array, size_t t) -> const scalar_t& { return array[t].cost; });
 
+  // dynamics violation
+  out.dynamicsViolation = interpolate(indexAlpha, dataArray, [](const std::vector<MetricsCollection>& array, size_t t) -> const vector_t& {
+    return array[t].dynamicsViolation;
+  });
+
   // constraints
   out.stateEqConstraint = interpolate(indexAlpha, dataArray, [](const std::vector<MetricsCollection>& array, size_t t) -> const vector_t& {
     return array[t].stateEqConstraint;
@@ -65,7 +65,7 @@ void TargetTrajectories::clear() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /***************************************************************************************************** */
-bool TargetTrajectories::operator==(const TargetTrajectories& other) {
+bool TargetTrajectories::operator==(const TargetTrajectories& other) const {
   return this->timeTrajectory == other.timeTrajectory && this->stateTrajectory == other.stateTrajectory &&
          this->inputTrajectory == other.inputTrajectory;
 }
@@ -27,19 +27,82 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <stdexcept>
+
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
 #include <ocs2_core/thread_support/SetThreadPriority.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 namespace ocs2 {
 
+namespace {
+/**
+ * Busy-waits until the condition holds or the spin budget is exhausted.
+ * Spins tightly first and yields the CPU for the remainder of the budget.
+ *
+ * @return true if the condition holds.
+ */
+template <typename Condition>
+bool spinWait(Condition condition) {
+  constexpr int numTightIterations = 1024;
+  constexpr int numYieldIterations = 64;
+  for (int i = 0; i < numTightIterations; i++) {
+    if (condition()) {
+      return true;
+    }
+  }
+  for (int i = 0; i < numYieldIterations; i++) {
+    if (condition()) {
+      return true;
+    }
+    std::this_thread::yield();
+  }
+  return condition();
+}
+
+/**
+ * Marks the execution of a parallel job instance on the current thread, used to detect nested calls to runParallel. The scopes of
+ * a thread form a stack on the call stack, such that no allocation is needed.
+ */
+class ParallelJobScope {
+ public:
+  explicit ParallelJobScope(const ThreadPool* poolPtr) : poolPtr_(poolPtr), outerScopePtr_(innermostScopePtr_) {
+    innermostScopePtr_ = this;
+  }
+  ~ParallelJobScope() { innermostScopePtr_ = outerScopePtr_; }
+  ParallelJobScope(const ParallelJobScope&) = delete;
+  ParallelJobScope& operator=(const ParallelJobScope&) = delete;
+
+  /** Whether the current thread is executing a parallel job instance of the given pool */
+  static bool isActive(const ThreadPool* poolPtr) {
+    for (const auto* scopePtr = innermostScopePtr_; scopePtr != nullptr; scopePtr = scopePtr->outerScopePtr_) {
+      if (scopePtr->poolPtr_ == poolPtr) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  const ThreadPool* poolPtr_;
+  const ParallelJobScope* outerScopePtr_;
+  static thread_local const ParallelJobScope* innermostScopePtr_;
+};
+
+thread_local const ParallelJobScope* ParallelJobScope::innermostScopePtr_ = nullptr;
+}  // unnamed namespace
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
-ThreadPool::ThreadPool(size_t nThreads, int priority) {
+ThreadPool::ThreadPool(size_t nThreads, int priority, std::vector<int> cpuAffinity) {
   workerThreads_.reserve(nThreads);
   for (size_t i = 0; i < nThreads; i++) {
     workerThreads_.emplace_back(&ThreadPool::worker, this, i);
     setThreadPriority(priority, workerThreads_.back());
+    if (i < cpuAffinity.size()) {
+      setThreadAffinity(cpuAffinity[i], workerThreads_.back());
+    }
   }
 }
 
@@ -48,10 +111,10 @@ ThreadPool::ThreadPool(size_t nThreads, int priority) {
 /**************************************************************************************************/
 ThreadPool::~ThreadPool() {
   {  // set exit flag, wake up threads and join
-    std::lock_guard<std::mutex> lock(taskQueueLock_);
+    std::lock_guard<std::mutex> lock(wakeUpLock_);
     stop_ = true;
   }
-  taskQueueCondition_.notify_all();
+  wakeUpCondition_.notify_all();
   for (auto& thread : workerThreads_) {
     if (thread.joinable()) {
       thread.join();
@@ -63,21 +126,30 @@ ThreadPool::~ThreadPool() {
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::worker(int workerIndex) {
+  size_t lastParallelJobId = parallelJobId_;
   while (true) {
-    std::unique_ptr<ThreadPool::TaskBase> taskPtr;
-    {
-      std::unique_lock<std::mutex> lock(taskQueueLock_);
-      taskQueueCondition_.wait(lock, [this] { return !taskQueue_.empty() || stop_; });
+    waitForWork(lastParallelJobId);
 
-      // exit condition
-      if (stop_) {
-        break;
-      }
+    // exit condition
+    if (stop_) {
+      break;
+    }
+
+    // help with the parallel job
+    const size_t parallelJobId = parallelJobId_;
+    if (parallelJobId != lastParallelJobId) {
+      lastParallelJobId = parallelJobId;
+      executeParallelJob(workerIndex);
+    }
 
-      // pop the first task
+    // pop the first queued task
+    std::unique_ptr<ThreadPool::TaskBase> taskPtr;
+    if (numQueuedTasks_ > 0) {
+      std::lock_guard<std::mutex> lock(taskQueueLock_);
       if (!taskQueue_.empty()) {
         taskPtr = std::move(taskQueue_.front());
         taskQueue_.pop();
+        --numQueuedTasks_;
       }
     }
 
@@ -87,6 +159,58 @@ void ThreadPool::worker(int workerIndex) {
   }
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::waitForWork(size_t lastParallelJobId) {
+  auto hasWork = [&]() { return stop_ || parallelJobId_ != lastParallelJobId || numQueuedTasks_ > 0; };
+
+  if (spinWait(hasWork)) {
+    return;
+  }
+
+  // Park. The condition is checked after registering as parked, see notifyWorkers.
+  std::unique_lock<std::mutex> lock(wakeUpLock_);
+  ++numParkedWorkers_;
+  wakeUpCondition_.wait(lock, hasWork);
+  --numParkedWorkers_;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::notifyWorkers() {
+  // The work is published before reading numParkedWorkers_. A worker that registers as parked afterwards will see the work.
+  if (numParkedWorkers_ > 0) {
+    { std::lock_guard<std::mutex> lock(wakeUpLock_); }
+    wakeUpCondition_.notify_all();
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::executeParallelJob(int workerIndex) {
+  // A successful claim guarantees that parallelTaskPtr_ refers to the job the instance belongs to.
+  while (numUnclaimedTasks_.fetch_sub(1) > 0) {
+    try {
+      ParallelJobScope scope(this);
+      (*parallelTaskPtr_)(workerIndex);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(parallelTaskExceptionLock_);
+      if (!parallelTaskException_) {
+        parallelTaskException_ = std::current_exception();
+      }
+    }
+
+    // The last instance to finish wakes up the caller if it is parked. See runParallel for the ordering.
+    if (numUnfinishedTasks_.fetch_sub(1) == 1 && isCallerParked_) {
+      { std::lock_guard<std::mutex> lock(parallelJobDoneLock_); }
+      parallelJobDoneCondition_.notify_one();
+    }
+  }
+}
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
@@ -94,31 +218,71 @@ void ThreadPool::runTask(std::unique_ptr<TaskBase> taskPtr) {
   {
     std::lock_guard<std::mutex> lock(taskQueueLock_);
     taskQueue_.push(std::move(taskPtr));
+    ++numQueuedTasks_;
   }
-  taskQueueCondition_.notify_one();
+  notifyWorkers();
 }
 
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::runParallel(std::function<void(int)> taskFunction, int N) {
-  // Launch tasks in helper threads
-  std::vector<std::future<void>> futures;
-  if (N > 1) {
-    const int numHelpers = N - 1;
-    futures.reserve(numHelpers);
-    for (int i = 0; i < numHelpers; ++i) {
-      futures.emplace_back(run(taskFunction));
+  // Without workers, all instances run on this thread.
+  if (workerThreads_.empty()) {
+    for (int i = 1; i < N; ++i) {
+      taskFunction(0);
     }
+    taskFunction(0);
+    return;
   }
 
-  // Execute one instance in this thread.
   const auto workerId = static_cast<int>(numThreads());  // threadpool workers use ID 0 -> nThreads - 1
-  taskFunction(workerId);
+  const int numHelpers = N - 1;
+  if (numHelpers <= 0) {
+    taskFunction(workerId);
+    return;
+  }
+
+  // The helpers of the outer job cannot finish while this thread waits for parallelJobLock_.
+  if (ParallelJobScope::isActive(this)) {
+    throw std::runtime_error("[ThreadPool::runParallel] Nested call from within a task of runParallel on the same pool.");
+  }
+
+  std::lock_guard<std::mutex> parallelJobLock(parallelJobLock_);
 
-  // Wait for helpers to finish.
-  for (auto&& fut : futures) {
-    fut.get();
+  // Publish the job to the helpers. The task is passed by reference, it outlives the job.
+  parallelTaskPtr_ = &taskFunction;
+  parallelTaskException_ = nullptr;
+  numUnfinishedTasks_ = numHelpers;
+  numUnclaimedTasks_ = numHelpers;
+  ++parallelJobId_;
+  notifyWorkers();
+
+  // Execute one instance in this thread.
+  std::exception_ptr callerException;
+  try {
+    ParallelJobScope scope(this);
+    taskFunction(workerId);
+  } catch (...) {
+    callerException = std::current_exception();
+  }
+
+  // Take over the instances that no helper has claimed yet, then wait for helpers to finish.
+  executeParallelJob(workerId);
+  auto isJobDone = [this]() { return numUnfinishedTasks_ == 0; };
+  if (!spinWait(isJobDone)) {
+    // Park. The condition is checked after registering as parked, the last helper reads isCallerParked_ after finishing.
+    std::unique_lock<std::mutex> lock(parallelJobDoneLock_);
+    isCallerParked_ = true;
+    parallelJobDoneCondition_.wait(lock, isJobDone);
+    isCallerParked_ = false;
+  }
+
+  if (callerException) {
+    std::rethrow_exception(callerException);
+  }
+  if (parallelTaskException_) {
+    std::rethrow_exception(parallelTaskException_);
   }
 }
 
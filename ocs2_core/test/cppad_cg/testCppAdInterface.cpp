@@ -60,3 +60,114 @@ TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailable) {
   ASSERT_TRUE(gnApproximation.dfdx.isApprox(testJacobian(x, p).transpose() * testFun(x, p)));
   ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
 }
+
+TEST_F(CppAdInterfaceParameterizedFixture, batchEvaluation) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelBatchEvaluation");
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+
+  const int numPoints = 10;
+  const matrix_t xBatch = matrix_t::Random(variableDim_, numPoints);
+  const matrix_t pBatch = matrix_t::Random(parameterDim_, numPoints);
+
+  matrix_t values;
+  matrix_t sparseJacobians;
+  matrix_array_t jacobians;
+  std::vector<ScalarFunctionQuadraticApproximation> gnApproximations;
+  adInterface.getFunctionValueBatch(xBatch, pBatch, values);
+  adInterface.getSparseJacobianBatch(xBatch, pBatch, sparseJacobians);
+  adInterface.getJacobianBatch(xBatch, pBatch, jacobians);
+  adInterface.getGaussNewtonApproximationBatch(xBatch, pBatch, gnApproximations);
+
+  const auto& rows = adInterface.getJacobianSparsityRows();
+  const auto& cols = adInterface.getJacobianSparsityCols();
+  ASSERT_EQ(sparseJacobians.rows(), rows.size());
+  ASSERT_EQ(jacobians.size(), numPoints);
+  ASSERT_EQ(gnApproximations.size(), numPoints);
+
+  for (int i = 0; i < numPoints; i++) {
+    const vector_t x = xBatch.col(i);
+    const vector_t p = pBatch.col(i);
+    ASSERT_TRUE(values.col(i).isApprox(testFun(x, p)));
+    ASSERT_TRUE(jacobians[i].isApprox(testJacobian(x, p)));
+
+    matrix_t jacobianFromSparse = matrix_t::Zero(values.rows(), variableDim_);
+    for (size_t k = 0; k < rows.size(); k++) {
+      jacobianFromSparse(rows[k], cols[k]) = sparseJacobians(k, i);
+    }
+    ASSERT_TRUE(jacobianFromSparse.isApprox(testJacobian(x, p)));
+
+    ASSERT_DOUBLE_EQ(gnApproximations[i].f, 0.5 * testFun(x, p).squaredNorm());
+    ASSERT_TRUE(gnApproximations[i].dfdx.isApprox(testJacobian(x, p).transpose() * testFun(x, p)));
+    ASSERT_TRUE(gnApproximations[i].dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
+  }
+
+  // Wrong parameter dimension
+  ASSERT_ANY_THROW(adInterface.getFunctionValueBatch(xBatch, matrix_t::Random(parameterDim_ + 1, numPoints), values));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, recompileIfOutdated) {
+  const std::string modelName = "testModelRecompileIfOutdated";
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+
+  {
+    ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, modelName);
+    adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  }
+
+  // Same name, different approximation order: the library on disk is outdated
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, modelName);
+  adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  ASSERT_TRUE(adInterface.getJacobian(x, p).isApprox(testJacobian(x, p)));
+  ASSERT_TRUE(adInterface.getHessian(0, x, p).isApprox(testHessian(0, x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, loadWithoutTaping) {
+  const std::string modelName = "testModelLoadWithoutTaping";
+  {
+    ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, modelName);
+    adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  }
+
+  // An up to date library is loaded without taping the function
+  size_t numTapings = 0;
+  const auto countingFunImpl = [&numTapings](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+    numTapings++;
+    funImpl(x, p, y);
+  };
+  ocs2::CppAdInterface adInterface(countingFunImpl, variableDim_, parameterDim_, modelName);
+  adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  ASSERT_EQ(numTapings, 0);
+
+  // A copy loads the same library
+  ocs2::CppAdInterface adInterfaceCopy(adInterface);
+  ASSERT_EQ(numTapings, 0);
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  ASSERT_TRUE(adInterfaceCopy.getFunctionValue(x, p).isApprox(testFun(x, p)));
+  ASSERT_TRUE(adInterfaceCopy.getJacobian(x, p).isApprox(testJacobian(x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailableInParallel) {
+  const size_t numModels = 4;
+  std::vector<std::unique_ptr<ocs2::CppAdInterface>> adInterfaces;
+  std::vector<std::pair<ocs2::CppAdInterface*, ocs2::CppAdInterface::ApproximationOrder>> modelsToLoad;
+  for (size_t i = 0; i < numModels; i++) {
+    const auto order = (i % 2 == 0) ? ocs2::CppAdInterface::ApproximationOrder::First : ocs2::CppAdInterface::ApproximationOrder::Second;
+    adInterfaces.emplace_back(new ocs2::CppAdInterface(funImpl, variableDim_, parameterDim_, "testModelParallel" + std::to_string(i)));
+    modelsToLoad.emplace_back(adInterfaces.back().get(), order);
+  }
+
+  // Compiles all in parallel the first time, loads the second time
+  for (int repetition = 0; repetition < 2; repetition++) {
+    ocs2::CppAdInterface::loadModelsIfAvailable(modelsToLoad, 2, false);
+
+    vector_t x = vector_t::Random(variableDim_);
+    vector_t p = vector_t::Random(parameterDim_);
+    for (size_t i = 0; i < numModels; i++) {
+      ASSERT_TRUE(adInterfaces[i]->getFunctionValue(x, p).isApprox(testFun(x, p)));
+      ASSERT_TRUE(adInterfaces[i]->getJacobian(x, p).isApprox(testJacobian(x, p)));
+    }
+    ASSERT_TRUE(adInterfaces[1]->getHessian(0, x, p).isApprox(testHessian(0, x, p)));
+  }
+}
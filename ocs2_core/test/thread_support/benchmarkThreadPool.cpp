@@ -0,0 +1,106 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+/*
+ * Benchmark of the dispatch latency of ThreadPool::runParallel. Built as a plain executable, it is not run as part of the tests.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+using namespace ocs2;
+
+namespace {
+
+/**
+ * Measures the latency of dispatching an empty task with runParallel, i.e. the time between the call and the return of runParallel
+ * when the task itself does not do any work.
+ */
+benchmark::RepeatedTimer measureDispatchLatency(ThreadPool& pool, int N, int numRepetitions) {
+  std::atomic_int counter{0};
+  auto task = [&](int) { counter++; };
+
+  // warm up
+  for (int i = 0; i < 100; i++) {
+    pool.runParallel(task, N);
+  }
+
+  benchmark::RepeatedTimer timer;
+  for (int i = 0; i < numRepetitions; i++) {
+    timer.startTimer();
+    pool.runParallel(task, N);
+    timer.endTimer();
+  }
+
+  return timer;
+}
+
+void benchmarkDispatchLatency() {
+  constexpr int numRepetitions = 10000;
+  const size_t maxNumThreads = std::max(std::thread::hardware_concurrency(), 2U) - 1;
+
+  for (size_t numThreads = 1; numThreads <= maxNumThreads; numThreads *= 2) {
+    ThreadPool pool(numThreads);
+    const auto timer = measureDispatchLatency(pool, numThreads + 1, numRepetitions);
+    std::cout << "[benchmarkThreadPool] runParallel with " << numThreads << " worker(s):\t average "
+              << 1e3 * timer.getAverageInMilliseconds() << " [us], max " << 1e3 * timer.getMaxIntervalInMilliseconds() << " [us]\n";
+  }
+}
+
+void benchmarkDispatchLatencyAfterIdle() {
+  constexpr int numRepetitions = 100;
+  ThreadPool pool(1);
+
+  // Workers are parked after being idle for a while
+  std::atomic_int counter{0};
+  benchmark::RepeatedTimer timer;
+  for (int i = 0; i < numRepetitions; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    timer.startTimer();
+    pool.runParallel([&](int) { counter++; }, 2);
+    timer.endTimer();
+  }
+
+  std::cout << "[benchmarkThreadPool] runParallel after 1 [ms] idle:\t average " << 1e3 * timer.getAverageInMilliseconds()
+            << " [us], max " << 1e3 * timer.getMaxIntervalInMilliseconds() << " [us]\n";
+}
+
+}  // unnamed namespace
+
+int main() {
+  benchmarkDispatchLatency();
+  benchmarkDispatchLatencyAfterIdle();
+  return 0;
+}
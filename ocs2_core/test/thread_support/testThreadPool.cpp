@@ -1,3 +1,6 @@
+#include <chrono>
+#include <stdexcept>
+
 #include <gtest/gtest.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
@@ -121,3 +124,114 @@ TEST(testThreadPool, testMoveOnlyTask) {
 
   EXPECT_EQ(result.get(), 3.14);
 }
+
+TEST(testThreadPool, testRunParallelFixedWorkerIds) {
+  constexpr size_t numThreads = 3;
+  ThreadPool pool(numThreads);
+
+  // Each worker thread always runs with the same worker index
+  std::mutex idsMutex;
+  std::vector<std::pair<std::thread::id, int>> threadIds;
+  for (int call = 0; call < 100; call++) {
+    pool.runParallel(
+        [&](int workerId) {
+          std::lock_guard<std::mutex> lock(idsMutex);
+          threadIds.emplace_back(std::this_thread::get_id(), workerId);
+        },
+        numThreads + 1);
+  }
+
+  ASSERT_EQ(threadIds.size(), 100 * (numThreads + 1));
+  for (const auto& lhs : threadIds) {
+    EXPECT_GE(lhs.second, 0);
+    EXPECT_LE(lhs.second, numThreads);
+    for (const auto& rhs : threadIds) {
+      if (lhs.first == rhs.first) {
+        EXPECT_EQ(lhs.second, rhs.second);
+      }
+    }
+  }
+}
+
+TEST(testThreadPool, testRunParallelPropagateException) {
+  ThreadPool pool(2);
+  std::atomic_int counter;
+  counter = 0;
+
+  auto task = [&](int) {
+    if (counter++ == 1) {
+      throw std::runtime_error("exception");
+    }
+  };
+  EXPECT_THROW(pool.runParallel(task, 3), std::runtime_error);
+  EXPECT_EQ(counter, 3);
+
+  // The pool is usable afterwards
+  counter = 0;
+  pool.runParallel([&](int) { counter++; }, 3);
+  EXPECT_EQ(counter, 3);
+}
+
+TEST(testThreadPool, testRunParallelFromMultipleThreads) {
+  ThreadPool pool(2);
+  std::atomic_int counter;
+  counter = 0;
+
+  auto caller = [&]() {
+    for (int i = 0; i < 100; i++) {
+      pool.runParallel([&](int) { counter++; }, 5);
+    }
+  };
+  std::thread thread1(caller);
+  std::thread thread2(caller);
+  thread1.join();
+  thread2.join();
+
+  EXPECT_EQ(counter, 2 * 100 * 5);
+}
+
+TEST(testThreadPool, testCpuAffinity) {
+  ThreadPool pool(2, 0, {0, -1});
+  std::atomic_int counter;
+  counter = 0;
+
+  pool.runParallel([&](int) { counter++; }, 3);
+
+  EXPECT_EQ(counter, 3);
+}
+
+TEST(testThreadPool, testRunParallelWaitsForLongTasks) {
+  ThreadPool pool(2);
+  std::atomic_int counter;
+  counter = 0;
+
+  // The caller parks while the helpers are busy
+  pool.runParallel(
+      [&](int) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        counter++;
+      },
+      3);
+
+  EXPECT_EQ(counter, 3);
+}
+
+TEST(testThreadPool, testNestedRunParallelThrows) {
+  ThreadPool pool(2);
+  std::atomic_int counter;
+  counter = 0;
+
+  auto task = [&](int) { pool.runParallel([&](int) { counter++; }, 3); };
+  EXPECT_THROW(pool.runParallel(task, 3), std::runtime_error);
+  EXPECT_EQ(counter, 0);
+
+  // Without helpers, the nested call runs on the calling thread
+  pool.runParallel([&](int) { pool.runParallel([&](int) { counter++; }, 1); }, 3);
+  EXPECT_EQ(counter, 3);
+
+  // A nested call on another pool is fine
+  ThreadPool otherPool(1);
+  counter = 0;
+  pool.runParallel([&](int) { otherPool.runParallel([&](int) { counter++; }, 2); }, 3);
+  EXPECT_EQ(counter, 6);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include <ocs2_core/thread_support/TripleBuffer.h>
+
+TEST(testTripleBuffer, basicPublishRead) {
+  // initialize
+  ocs2::TripleBuffer<std::string> tripleBuffer("init");
+  ASSERT_EQ(tripleBuffer.getReadBuffer(), "init");
+  ASSERT_EQ(tripleBuffer.getReadGeneration(), 0);
+
+  // nothing published
+  ASSERT_FALSE(tripleBuffer.updateReadBuffer());
+
+  // fill in place and publish
+  tripleBuffer.getWriteBuffer() = "update";
+  ASSERT_EQ(tripleBuffer.getReadBuffer(), "init");
+  ASSERT_EQ(tripleBuffer.publishWriteBuffer(), 1);
+
+  // update
+  ASSERT_TRUE(tripleBuffer.updateReadBuffer());
+  ASSERT_EQ(tripleBuffer.getReadBuffer(), "update");
+  ASSERT_EQ(tripleBuffer.getReadGeneration(), 1);
+
+  // update twice is false
+  ASSERT_FALSE(tripleBuffer.updateReadBuffer());
+  ASSERT_EQ(tripleBuffer.getReadBuffer(), "update");
+}
+
+TEST(testTripleBuffer, latestValueWins) {
+  ocs2::TripleBuffer<int> tripleBuffer(0);
+
+  for (int i = 1; i <= 5; i++) {
+    tripleBuffer.getWriteBuffer() = i;
+    tripleBuffer.publishWriteBuffer();
+  }
+
+  // only the last published value is read, the generation shows the skipped ones
+  ASSERT_TRUE(tripleBuffer.updateReadBuffer());
+  ASSERT_EQ(tripleBuffer.getReadBuffer(), 5);
+  ASSERT_EQ(tripleBuffer.getReadGeneration(), 5);
+  ASSERT_FALSE(tripleBuffer.updateReadBuffer());
+}
+
+TEST(testTripleBuffer, slotsAreReused) {
+  ocs2::TripleBuffer<std::vector<double>> tripleBuffer(std::vector<double>(100, 0.0));
+
+  std::vector<const double*> slotData;
+  for (int i = 0; i < 10; i++) {
+    auto& writeBuffer = tripleBuffer.getWriteBuffer();
+    writeBuffer.assign(100, static_cast<double>(i));
+    slotData.push_back(writeBuffer.data());
+    tripleBuffer.publishWriteBuffer();
+    ASSERT_TRUE(tripleBuffer.updateReadBuffer());
+    ASSERT_EQ(tripleBuffer.getReadBuffer().front(), static_cast<double>(i));
+  }
+
+  // filling in place never reallocates the slots
+  for (const auto* data : slotData) {
+    ASSERT_TRUE(data == slotData[0] || data == slotData[1] || data == slotData[2]);
+  }
+}
+
+TEST(testTripleBuffer, concurrentPublishRead) {
+  constexpr size_t numValues = 100000;
+  constexpr size_t valueSize = 16;
+  ocs2::TripleBuffer<std::vector<size_t>> tripleBuffer(std::vector<size_t>(valueSize, 0));
+
+  std::thread producer([&]() {
+    for (size_t i = 1; i <= numValues; i++) {
+      auto& writeBuffer = tripleBuffer.getWriteBuffer();
+      std::fill(writeBuffer.begin(), writeBuffer.end(), i);
+      tripleBuffer.publishWriteBuffer();
+    }
+  });
+
+  // the reader must eventually see the last published value
+  size_t lastGeneration = 0;
+  while (lastGeneration < numValues) {
+    if (tripleBuffer.updateReadBuffer()) {
+      const auto& readBuffer = tripleBuffer.getReadBuffer();
+      const size_t generation = tripleBuffer.getReadGeneration();
+      // the value is never torn and generations only increase
+      ASSERT_GT(generation, lastGeneration);
+      for (const auto v : readBuffer) {
+        ASSERT_EQ(v, generation);
+      }
+      lastGeneration = generation;
+    }
+  }
+
+  producer.join();
+  ASSERT_EQ(lastGeneration, numValues);
+}
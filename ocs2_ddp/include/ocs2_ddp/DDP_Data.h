@@ -75,6 +75,15 @@ struct PrimalDataContainer {
     modelDataEventTimes.clear();
     modelDataTrajectory.clear();
   }
+
+  /**
+   * Clears the primal solution and its metrics while keeping the model data as preallocated memory. The model data is no longer
+   * consistent with the primal solution and has to be overwritten before being used.
+   */
+  void clearRetainingModelData() {
+    primalSolution.clear();
+    problemMetrics.clear();
+  }
 };
 
 /**
@@ -109,4 +118,19 @@ struct DualDataContainer {
   }
 };
 
+/**
+ * Resizes a trajectory in place. In contrast to clear() followed by resize(), the retained elements keep their memory and are expected
+ * to be overwritten by the caller.
+ *
+ * @param [in] n: The new size.
+ * @param [in, out] trajectory: The trajectory to be resized.
+ * @return 1 if the trajectory storage had to grow, otherwise 0.
+ */
+template <typename T, typename Alloc>
+size_t resizeTrajectory(size_t n, std::vector<T, Alloc>& trajectory) {
+  const size_t numAllocations = (n > trajectory.capacity()) ? 1 : 0;
+  trajectory.resize(n);
+  return numAllocations;
+}
+
 }  // namespace ocs2
@@ -174,6 +174,36 @@ void retrieveActiveNormalizedTime(const std::pair<int, int>& partitionInterval,
  */
 std::vector<std::pair<int, int>> computePartitionIntervals(const scalar_array_t& timeTrajectory, int numWorkers);
 
+/**
+ * Checks whether the multipliers of two MultiplierCollections are equal within the given tolerance in the infinity norm.
+ *
+ * @param [in] lhs: The first MultiplierCollection.
+ * @param [in] rhs: The second MultiplierCollection.
+ * @param [in] tol: The tolerance.
+ * @return True if they have the same structure and all the penalties and Lagrange multipliers are within tolerance.
+ */
+bool isMultiplierCollectionNear(const MultiplierCollection& lhs, const MultiplierCollection& rhs, scalar_t tol);
+
+/**
+ * Updates the LQ approximation of an intermediate node to the first order for a small change of its state and input. The Jacobians,
+ * the Hessians and the dynamics are kept, while the cost value and gradients as well as the constraint values are updated based on
+ * them. The cost value is updated to the second order.
+ *
+ * @param [in] deltaState: The change of the state.
+ * @param [in] deltaInput: The change of the input.
+ * @param [in,out] modelData: The LQ approximation of the node.
+ */
+void updateIntermediateLQ(const vector_t& deltaState, const vector_t& deltaInput, ModelData& modelData);
+
+/**
+ * Copies a primal solution with a linear controller into another one in place. In contrast to the copy assignment of PrimalSolution,
+ * the controller is not cloned and the memory of the destination trajectories is reused.
+ *
+ * @param [in] src: The source primal solution.
+ * @param [out] dst: The destination primal solution.
+ */
+void copyPrimalSolution(const PrimalSolution& src, PrimalSolution& dst);
+
 /**
  * Gets a reference to the linear controller from the given primal solution.
  */
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/Integrator.h>
@@ -68,6 +69,8 @@ struct Settings {
   size_t nThreads_ = 1;
   /** Priority of threads used in the multi-threading scheme. */
   int threadPriority_ = 99;
+  /** The CPU core to pin each worker thread to (see ThreadPool). Empty leaves the affinity unchanged. */
+  std::vector<int> cpuAffinity_;
 
   /** Maximum number of iterations of DDP. */
   size_t maxNumIterations_ = 15;
@@ -95,15 +98,44 @@ struct Settings {
   scalar_t timeStep_ = 1e-2;
   /** The backward pass integrator type: SLQ uses it for solving Riccati equation and ILQR uses it for discretizing LQ approximation. */
   IntegratorType backwardPassIntegratorType_ = IntegratorType::ODE45;
+  /** If true, SLQ solves the Riccati equation with a dedicated allocation-free RK4 integrator using the maximum step timeStep_ instead of
+   * backwardPassIntegratorType_. It does not support the risk-sensitive variant. */
+  bool useFixedStepRiccatiIntegrator_ = false;
 
   /** The initial coefficient of the quadratic penalty function in the merit function. It should be greater than one. */
   scalar_t constraintPenaltyInitialValue_ = 2.0;
   /** The rate that the coefficient of the quadratic penalty function in the merit function grows. It should be greater than one. */
   scalar_t constraintPenaltyIncreaseRate_ = 2.0;
 
+  /** If true, the LQ approximation of an intermediate node is not recomputed when its state, input and multipliers have changed less
+   * than incrementalLQApproximationTolerance_ since the previous iteration. Instead, the previous approximation is updated to first
+   * order. Only the nodes with the same time as in the previous iteration are reused, e.g. for a fixed-step rollout. */
+  bool incrementalLQApproximation_ = false;
+  /** The tolerance on the infinity norm of the state, input and multiplier changes for the incremental LQ approximation. */
+  scalar_t incrementalLQApproximationTolerance_ = 1e-6;
+
+  /** If true, the dual update after an accepted step and the intermediate LQ approximation of the next iteration are pipelined in one
+   * parallel pass over the nodes. The pass starts on the line-search workers as soon as the accepted step is settled, while the other
+   * trials are aborted, and only if the next iteration is certain. The result is identical to the sequential iteration. It falls back
+   * to the sequential iteration for the last iteration, a rejected step, the Levenberg-Marquardt strategy, or the incremental LQ
+   * approximation. */
+  bool pipelinedIteration_ = false;
+
+  /** The number of segments of the multiple-shooting forward pass. For more than one segment, the horizon is split into equally long
+   * segments which are rolled out independently from their own shooting states. The segments of all line-search trials are shared
+   * between the threads. The defects between the segments are closed by the
+   * backward pass and penalized in the merit function. It is only supported by ILQR with the line-search strategy and a time-triggered
+   * rollout. One segment is the classical single-shooting forward pass. */
+  size_t numShootingSegments_ = 1;
+
   /** If true, terms of the Riccati equation will be pre-computed before interpolation in the flow-map */
   bool preComputeRiccatiTerms_ = true;
 
+  /** If true, the discretization (ILQR), the constraint projection, and the Riccati equations (SLQ and ILQR) use compile-time sized
+   * kernels for the state and input dimensions which have an instantiation (see fixed_size_riccati::isSupported). Other dimensions use
+   * the dynamic-size kernels. */
+  bool useFixedSizeRiccatiKernels_ = false;
+
   /** Use either the optimized control policy (true) or the optimized state-input trajectory (false). */
   bool useFeedbackPolicy_ = false;
 
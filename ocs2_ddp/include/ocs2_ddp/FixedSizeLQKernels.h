@@ -0,0 +1,79 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/dynamics/SystemDynamicsBase.h>
+#include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/model_data/ModelData.h>
+
+namespace ocs2 {
+namespace fixed_size_lq {
+
+/**
+ * Checks whether a compile-time sized instantiation of the LQ kernels exists for the given dimensions. The instantiations are the ones
+ * of fixed_size_riccati, i.e., a fixed state dimension and a bounded input dimension.
+ *
+ * @param [in] stateDim: The state dimension.
+ * @param [in] inputDim: The input dimension.
+ */
+bool isSupported(size_t stateDim, size_t inputDim);
+
+/**
+ * Projects the LQ approximation onto the null space of the state-input equality constraints with compile-time sized kernels. It
+ * returns the same result as ocs2::projectLQ, including the change of input variables of the dynamics and the cost.
+ *
+ * @param [in] modelData: The model data.
+ * @param [in] constraintRangeProjector: The projection matrix to the range space of the state-input equality constraints.
+ * @param [in] constraintNullProjector: The projection matrix to the null space of the state-input equality constraints.
+ * @param [out] projectedModelData: The projected model data.
+ * @return false if there is no instantiation for the dimensions of modelData. In this case, the output is not modified.
+ */
+bool projectLQ(const ModelData& modelData, const matrix_t& constraintRangeProjector, const matrix_t& constraintNullProjector,
+               ModelData& projectedModelData);
+
+/**
+ * Discretizes the linearized dynamics with the given sensitivity integrator. The linear approximations of the system are evaluated as
+ * in selectDynamicsSensitivityDiscretization, while their composition to the sensitivities uses compile-time sized kernels.
+ *
+ * @param [in] integratorType: The sensitivity integrator type.
+ * @param [in] system: The system dynamics.
+ * @param [in] t: The time.
+ * @param [in] x: The state.
+ * @param [in] u: The input.
+ * @param [in] dt: The time step.
+ * @param [out] discreteDynamics: The linear approximation of the discrete dynamics x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}.
+ * @return false if there is no instantiation for the dimensions of the system. In this case, the output is not modified.
+ */
+bool sensitivityDiscretization(SensitivityIntegratorType integratorType, SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                               const vector_t& u, scalar_t dt, VectorFunctionLinearApproximation& discreteDynamics);
+
+}  // namespace fixed_size_lq
+}  // namespace ocs2
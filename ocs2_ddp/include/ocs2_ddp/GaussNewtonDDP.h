@@ -50,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_ddp/DDP_Data.h"
 #include "ocs2_ddp/DDP_Settings.h"
 #include "ocs2_ddp/riccati_equations/RiccatiModification.h"
+#include "ocs2_ddp/riccati_equations/RiccatiSensitivity.h"
 #include "ocs2_ddp/search_strategy/SearchStrategyBase.h"
 
 namespace ocs2 {
@@ -109,6 +110,22 @@ class GaussNewtonDDP : public SolverBase {
 
   std::string getBenchmarkingInfo() const override;
 
+  /**
+   * Gets the number of the intermediate LQ approximations since the last reset. When the incremental LQ approximation is not active,
+   * both numbers are the same.
+   *
+   * @return A pair of (the number of recomputed nodes, the total number of nodes).
+   */
+  std::pair<size_t, size_t> getNumIntermediateLQApproximations() const {
+    return {numRecomputedIntermediateLQNodes_, numIntermediateLQNodes_};
+  }
+
+  /**
+   * Gets the number of times that the storage of the DDP data trajectories had to grow since the last reset. Once the horizon
+   * length is settled, it should stay constant over the iterations.
+   */
+  size_t getNumTrajectoryAllocations() const { return numTrajectoryAllocations_; }
+
   /**
    * Const access to ddp settings
    */
@@ -156,6 +173,30 @@ class GaussNewtonDDP : public SolverBase {
    */
   virtual void approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) = 0;
 
+  /**
+   * Calculates the LQ approximation of the optimal control problem for an intermediate node.
+   *
+   * @param [in] workerIndex: Working agent index.
+   * @param [in] timeIndex: The time index of the node.
+   * @param [in] primalSolution: The primal solution.
+   * @param [in] multipliers: The multipliers of the node.
+   * @param [out] modelData: The LQ approximation of the node.
+   */
+  virtual void approximateIntermediateLQWorker(size_t workerIndex, size_t timeIndex, const PrimalSolution& primalSolution,
+                                               const MultiplierCollection& multipliers, ModelData& modelData) = 0;
+
+  /**
+   * Prepares the intermediate model data trajectory of primalData for the LQ approximation. If the incremental LQ approximation is active,
+   * the LQ approximations of the previous iteration are reused for the nodes whose time, state, input and multipliers have changed
+   * less than the tolerance. The reused approximations are updated to first order. It should be called at the beginning of
+   * approximateIntermediateLQ.
+   *
+   * @param [in] dualSolution: The dual solution
+   * @param [in,out] primalData: The primal Data
+   * @return Whether the LQ approximation of each node should be computed.
+   */
+  std::vector<bool> reuseIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData);
+
   /**
    * Calculate controller for the timeIndex by using primal and dual and write the result back to dstController
    *
@@ -193,6 +234,22 @@ class GaussNewtonDDP : public SolverBase {
   virtual void riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
                                       const ScalarFunctionQuadraticApproximation& finalValueFunction) = 0;
 
+  /**
+   * Solves the Riccati equations for the partition in the given index like riccatiEquationsWorker, and additionally computes the
+   * sensitivity of the partition to its final value function. The value function trajectory of the partition is not necessarily
+   * written. It is used to find the exact final value function of the partitions when solving them in parallel.
+   *
+   * @param [in] workerIndex: Current worker index
+   * @param [in] partitionInterval: Current active interval
+   * @param [in] finalValueFunction The final Sm(dfdxx), Sv(dfdx), s(f), for Riccati equation.
+   * @param [out] initialValueFunction The value function at the start of the partition.
+   * @param [out] sensitivity The terminal sensitivity of the partition.
+   */
+  virtual void riccatiSensitivityWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
+                                        const ScalarFunctionQuadraticApproximation& finalValueFunction,
+                                        ScalarFunctionQuadraticApproximation& initialValueFunction,
+                                        riccati_sensitivity::Data& sensitivity) = 0;
+
  private:
   /**
    * Get the State Input Equality Constraint Lagrangian Impl object
@@ -278,6 +335,23 @@ class GaussNewtonDDP : public SolverBase {
    */
   scalar_t calculateRolloutMerit(const PerformanceIndex& performanceIndex) const;
 
+  /** Predicts the duration of the next iteration in milliseconds based on the timing history of the previous iterations. */
+  scalar_t getExpectedIterationDurationInMilliseconds() const;
+
+  /**
+   * Keeps a copy of the optimized solution if it satisfies the constraint tolerance and has a lower cost than the best feasible
+   * iterate of the current run so far.
+   */
+  void updateBestFeasibleIterate();
+
+  /**
+   * Replaces the optimized solution by the best feasible iterate of the current run, if the optimized solution is either infeasible
+   * or has a higher cost.
+   *
+   * @return Whether the optimized solution is replaced.
+   */
+  bool restoreBestFeasibleIterate();
+
   /**
    * Approximates the nonlinear problem as a linear-quadratic problem around the
    * nominal state and control trajectories. This method updates the following
@@ -321,8 +395,34 @@ class GaussNewtonDDP : public SolverBase {
    */
   void initializeDualSolutionAndMetrics();
 
-  /** Based on the current LQ solution updates the optimized primal and dual solutions. */
-  void takePrimalDualStep(scalar_t lqModelExpectedCost);
+  /**
+   * Based on the current LQ solution updates the optimized primal and dual solutions.
+   *
+   * @param [in] lqModelExpectedCost: The expected cost of unoptimizedController_ based on the LQ model.
+   * @return whether the step is accepted. Otherwise, the optimized solution is the nominal one.
+   */
+  bool takePrimalDualStep(scalar_t lqModelExpectedCost);
+
+  /** Prepares updateDualSolutionAndIntermediateLQWorker() for the optimized primal solution. */
+  void initializeDualSolutionAndIntermediateLQUpdate();
+
+  /**
+   * Updates the optimized dual solution and computes the intermediate LQ approximation of the optimized primal solution. The workers
+   * share the nodes, and the LQ approximation of a node starts as soon as its multipliers are updated. The result is stored in
+   * pipelinedModelDataTrajectory_ and used by the next iteration.
+   *
+   * @param [in] taskId: The index of the worker. The first worker also updates the final and pre-jump multipliers.
+   */
+  void updateDualSolutionAndIntermediateLQWorker(size_t taskId);
+
+  /** Sets the initial times of the multiple-shooting segments of the current run. The segment boundaries close to an event are dropped. */
+  void initializeShootingNodes();
+
+  /**
+   * Updates the nominal shooting states and their increments based on the LQ solution. The increments are computed by a linear forward
+   * pass of the unoptimized controller over the nominal trajectory, which includes the defects between the segments.
+   */
+  void updateShootingNodes();
 
   /**
    * Checks convergence of the main loop of DDP.
@@ -349,6 +449,9 @@ class GaussNewtonDDP : public SolverBase {
   // controller that is calculated directly from dual solution. It is unoptimized because it haven't gone through searching.
   LinearController unoptimizedController_;
 
+  // number of times that the storage of the DDP data trajectories had to grow
+  size_t numTrajectoryAllocations_ = 0;
+
   // multi-threading helper variables
   std::atomic_size_t nextTaskId_{0};
   std::atomic_size_t nextTimeIndex_{0};
@@ -378,10 +481,30 @@ class GaussNewtonDDP : public SolverBase {
   PrimalSolution optimizedPrimalSolution_;
   ProblemMetrics optimizedProblemMetrics_;
 
+  // the best feasible iterate of the current run which is returned on an exhausted time budget
+  DualSolution bestFeasibleDualSolution_;
+  PrimalSolution bestFeasiblePrimalSolution_;
+  ProblemMetrics bestFeasibleProblemMetrics_;
+  PerformanceIndex bestFeasiblePerformanceIndex_;
+  bool hasBestFeasibleIterate_ = false;
+
   // cached data used for caching the nominal trajectories for which the LQ problem is
   // constructed and solved before terminating run()
   DualDataContainer cachedDualData_;
   PrimalDataContainer cachedPrimalData_;
+  // whether the intermediate LQ approximation in cachedPrimalData_ is of the previous iteration of the current run
+  bool isCachedIntermediateLQValid_ = false;
+  size_t numRecomputedIntermediateLQNodes_ = 0;
+  size_t numIntermediateLQNodes_ = 0;
+  // the intermediate LQ approximation of optimizedPrimalSolution_ computed together with its dual update
+  std::vector<ModelData> pipelinedModelDataTrajectory_;
+  bool isPipelinedIntermediateLQValid_ = false;
+  std::atomic_bool isEventMultiplierUpdateClaimed_{false};
+  // whether the LQ approximation in nominalPrimalData_ is of the current nominal solution, i.e., the previous step was rejected
+  bool isNominalLQValid_ = false;
+  // the multiple-shooting nodes of the forward pass and the linear state increment along the nominal trajectory
+  search_strategy::ShootingNodes shootingNodes_;
+  vector_array_t stateIncrementTrajectory_;
 
   struct ConstraintPenaltyCoefficients {
     scalar_t penaltyTol = 1e-3;
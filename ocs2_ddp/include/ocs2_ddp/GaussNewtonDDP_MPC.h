@@ -64,6 +64,9 @@ class GaussNewtonDDP_MPC final : public MPC_BASE {
       default:
         throw std::runtime_error("Undefined ddp::Algorithm type!");
     }
+    if (settings().timeBudget_ > 0.0) {
+      ddpPtr_->setTimeBudget(settings().timeBudget_);
+    }
   }
 
   /** Default destructor. */
@@ -64,6 +64,11 @@ class ILQR : public GaussNewtonDDP {
   void riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
                               const ScalarFunctionQuadraticApproximation& finalValueFunction) override;
 
+  void riccatiSensitivityWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
+                                const ScalarFunctionQuadraticApproximation& finalValueFunction,
+                                ScalarFunctionQuadraticApproximation& initialValueFunction,
+                                riccati_sensitivity::Data& sensitivity) override;
+
   void calculateControllerWorker(size_t timeIndex, const PrimalDataContainer& primalData, const DualDataContainer& dualData,
                                  LinearController& dstController) override;
 
@@ -71,6 +76,9 @@ class ILQR : public GaussNewtonDDP {
 
   void approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) override;
 
+  void approximateIntermediateLQWorker(size_t workerIndex, size_t timeIndex, const PrimalSolution& primalSolution,
+                                       const MultiplierCollection& multipliers, ModelData& modelData) override;
+
   /**
    * Calculates the discrete-time LQ approximation from the continuous-time LQ approximation.
    *
@@ -91,7 +99,9 @@ class ILQR : public GaussNewtonDDP {
   matrix_array_t projectedKmTrajectoryStock_;  // projected feedback
   vector_array_t projectedLvTrajectoryStock_;  // projected feedforward
 
+  SensitivityIntegratorType sensitivityIntegratorType_;
   DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
+  std::vector<ModelData> continuousTimeModelDataStock_;
   std::vector<std::unique_ptr<DiscreteTimeRiccatiEquations>> riccatiEquationsPtrStock_;
 };
 
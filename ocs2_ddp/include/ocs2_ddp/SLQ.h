@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ddp/GaussNewtonDDP.h"
 #include "ocs2_ddp/riccati_equations/ContinuousTimeRiccatiEquations.h"
+#include "ocs2_ddp/riccati_equations/FixedStepRiccatiIntegrator.h"
 
 namespace ocs2 {
 
@@ -63,6 +64,9 @@ class SLQ final : public GaussNewtonDDP {
 
   void approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) override;
 
+  void approximateIntermediateLQWorker(size_t workerIndex, size_t timeIndex, const PrimalSolution& primalSolution,
+                                       const MultiplierCollection& multipliers, ModelData& modelData) override;
+
   void calculateControllerWorker(size_t timeIndex, const PrimalDataContainer& primalData, const DualDataContainer& dualData,
                                  LinearController& dstController) override;
 
@@ -71,6 +75,11 @@ class SLQ final : public GaussNewtonDDP {
   void riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
                               const ScalarFunctionQuadraticApproximation& finalValueFunction) override;
 
+  void riccatiSensitivityWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
+                                const ScalarFunctionQuadraticApproximation& finalValueFunction,
+                                ScalarFunctionQuadraticApproximation& initialValueFunction,
+                                riccati_sensitivity::Data& sensitivity) override;
+
   /**
    * Integrates the riccati equation and generates the value function at the times set in nominal Time Trajectory.
    *
@@ -94,6 +103,7 @@ class SLQ final : public GaussNewtonDDP {
    ****************/
   std::vector<std::shared_ptr<ContinuousTimeRiccatiEquations>> riccatiEquationsPtrStock_;
   std::vector<std::unique_ptr<IntegratorBase>> riccatiIntegratorPtrStock_;
+  std::vector<std::unique_ptr<FixedStepRiccatiIntegrator>> fixedStepRiccatiIntegratorPtrStock_;
   vector_array2_t allSsTrajectoryStock_;
   scalar_array2_t SsNormalizedTimeTrajectoryStock_;
   size_array2_t SsNormalizedEventsPastTheEndIndecesStock_;
@@ -39,6 +39,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/model_data/ModelData.h>
 
 #include "ocs2_ddp/riccati_equations/RiccatiModification.h"
+#include "ocs2_ddp/riccati_equations/RiccatiSensitivity.h"
 
 namespace ocs2 {
 
@@ -76,6 +77,11 @@ struct ContinuousTimeRiccatiData {
   // risk sensitive data
   vector_t Sigma_Sv_;
   matrix_t Sigma_Sm_;
+
+  // terminal sensitivity data
+  riccati_sensitivity::Data sensitivity_;
+  riccati_sensitivity::Data dSensitivity_;
+  matrix_t projectedBm_T_M_;
 };
 
 /**
@@ -100,6 +106,17 @@ static constexpr int riccati_matrix_dim(int flattened_dim) {
   return flattened_dim == Eigen::Dynamic ? Eigen::Dynamic : (static_cast<int>(std::sqrt(8 * flattened_dim + 1)) - 3) / 2;
 }
 
+/**
+ * Helper function to define the dimension of the flattened terminal sensitivity, also supports dynamic size -1.
+ *
+ * @param [in] state_dim: Dimension of the state space.
+ * @return Dimension of the flattened and concatenated vector from M, N and n.
+ */
+static constexpr int sensitivity_vector_dim(int state_dim) {
+  /** If STATE_DIM=n, Then: n^2 entries from each of the matrices M and N, n entries from vector n */
+  return state_dim == Eigen::Dynamic ? Eigen::Dynamic : (2 * state_dim * state_dim + state_dim);
+}
+
 /**
  * This class implements the Riccati differential equations for SLQ problem.
  */
@@ -111,8 +128,10 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
    * @param [in] reducedFormRiccati: The reduced form of the Riccati equation is yield by assuming that Hessein of
    * the Hamiltonian is positive definite. In this case, the computation of Riccati equation is more efficient.
    * @param [in] isRiskSensitive: Neither the risk sensitive variant is used or not.
+   * @param [in] useFixedSizeKernels: Use the compile-time sized flow map of fixed_size_riccati if the problem dimensions have an
+   * instantiation. It is not used for the risk sensitive variant and the terminal sensitivity.
    */
-  explicit ContinuousTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive = false);
+  explicit ContinuousTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive = false, bool useFixedSizeKernels = false);
 
   /**
    * Default destructor.
@@ -164,6 +183,51 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
     ContinuousTimeRiccatiEquations::convert2Matrix(allSs, valueFunction.dfdxx, valueFunction.dfdx, valueFunction.f);
   }
 
+  /**
+   * Transcribe symmetric matrix Sm, vector Sv, scalar s and the terminal sensitivity into a single vector.
+   *
+   * @param [in] Sm: \f$ S_m \f$
+   * @param [in] Sv: \f$ S_v \f$
+   * @param [in] s: \f$ s \f$
+   * @param [in] sensitivity: terminal sensitivity
+   * @return Single vector constructed by concatenating Sm, Sv, s, M, N and n.
+   */
+  static vector_t convert2Vector(const matrix_t& Sm, const vector_t& Sv, const scalar_t& s, const riccati_sensitivity::Data& sensitivity);
+
+  /**
+   * Transcribe value function approximation and the terminal sensitivity into a single vector.
+   *
+   * @param [in] valueFunction: value function approximation
+   * @param [in] sensitivity: terminal sensitivity
+   * @return Single vector constructed by concatenating Sm, Sv, s, M, N and n.
+   */
+  static vector_t convert2Vector(const ScalarFunctionQuadraticApproximation& valueFunction, const riccati_sensitivity::Data& sensitivity) {
+    return ContinuousTimeRiccatiEquations::convert2Vector(valueFunction.dfdxx, valueFunction.dfdx, valueFunction.f, sensitivity);
+  }
+
+  /**
+   * Transcribes the stacked vector allSs into a symmetric matrix, Sm, a vector, Sv, a single scalar, s, and the terminal sensitivity.
+   *
+   * @param [in] allSs: Single vector constructed by concatenating Sm, Sv, s, M, N and n.
+   * @param [out] Sm: \f$ S_m \f$
+   * @param [out] Sv: \f$ S_v \f$
+   * @param [out] s: \f$ s \f$
+   * @param [out] sensitivity: terminal sensitivity
+   */
+  static void convert2Matrix(const vector_t& allSs, matrix_t& Sm, vector_t& Sv, scalar_t& s, riccati_sensitivity::Data& sensitivity);
+
+  /**
+   * Transcribes the stacked vector allSs into value function approximation and the terminal sensitivity.
+   *
+   * @param [in] allSs: Single vector constructed by concatenating Sm, Sv, s, M, N and n.
+   * @param [out] valueFunction: value function approximation
+   * @param [out] sensitivity: terminal sensitivity
+   */
+  static void convert2Matrix(const vector_t& allSs, ScalarFunctionQuadraticApproximation& valueFunction,
+                             riccati_sensitivity::Data& sensitivity) {
+    ContinuousTimeRiccatiEquations::convert2Matrix(allSs, valueFunction.dfdxx, valueFunction.dfdx, valueFunction.f, sensitivity);
+  }
+
   /**
    * Sets coefficients of the model.
    *
@@ -172,10 +236,12 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
    * @param [in] eventsPastTheEndIndecesPtr: A pointer to the post event indices.
    * @param [in] modelDataEventTimesPtr: A pointer to the model data at event times.
    * @param [in] riccatiModificationPtr: A pointer to the RiccatiModification trajectory.
+   * @param [in] computeTerminalSensitivity: Whether to integrate the terminal sensitivity (riccati_sensitivity::Data) along with the
+   * value function. The flattened vectors then also contain M, N and n.
    */
   void setData(const scalar_array_t* timeStampPtr, const std::vector<ModelData>* projectedModelDataPtr,
                const size_array_t* eventsPastTheEndIndecesPtr, const std::vector<ModelData>* modelDataEventTimesPtr,
-               const std::vector<riccati_modification::Data>* riccatiModificationPtr);
+               const std::vector<riccati_modification::Data>* riccatiModificationPtr, bool computeTerminalSensitivity = false);
 
   /**
    * Riccati jump map at switching moments
@@ -226,10 +292,23 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
   void computeFlowMapILEG(std::pair<int, scalar_t> indexAlpha, const matrix_t& Sm, const vector_t& Sv, const scalar_t& s,
                           ContinuousTimeRiccatiData& creCache, matrix_t& dSm, vector_t& dSv, scalar_t& ds) const;
 
+  /**
+   * Computes the time derivative of the terminal sensitivity. It should be called after computeFlowMapSLQ or computeFlowMapILEG, which
+   * set the projected model and the controller in the cache. The risk-sensitive terms are not considered.
+   *
+   * @param [in] sensitivity: The current terminal sensitivity.
+   * @param [in,out] creCache: The continuous-time Riccati equation cache date.
+   * @param [out] dSensitivity: The time derivative of the terminal sensitivity.
+   */
+  void computeSensitivityFlowMap(const riccati_sensitivity::Data& sensitivity, ContinuousTimeRiccatiData& creCache,
+                                 riccati_sensitivity::Data& dSensitivity) const;
+
  private:
   bool reducedFormRiccati_;
   bool isRiskSensitive_;
+  bool useFixedSizeKernels_;
   scalar_t riskSensitiveCoeff_ = 0.0;
+  bool computeTerminalSensitivity_ = false;
 
   // array pointers
   const scalar_array_t* timeStampPtr_ = nullptr;
@@ -76,8 +76,10 @@ class DiscreteTimeRiccatiEquations {
    * @param [in] reducedFormRiccati: The reduced form of the Riccati equation is yield by assuming that Hessein of
    * the Hamiltonian is positive definite. In this case, the computation of Riccati equation is more efficient.
    * @param [in] isRiskSensitive: Neither the risk sensitive variant is used or not.
+   * @param [in] useFixedSizeKernels: Use the compile-time sized kernels of fixed_size_riccati for the ILQR variant if the problem
+   * dimensions have an instantiation. Otherwise, the dynamic-size kernels are used.
    */
-  explicit DiscreteTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive = false);
+  explicit DiscreteTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive = false, bool useFixedSizeKernels = false);
 
   /**
    * Default destructor.
@@ -149,6 +151,7 @@ class DiscreteTimeRiccatiEquations {
  private:
   bool reducedFormRiccati_;
   bool isRiskSensitive_;
+  bool useFixedSizeKernels_;
   scalar_t riskSensitiveCoeff_ = 0.0;
 
   DiscreteTimeRiccatiData discreteTimeRiccatiData_;
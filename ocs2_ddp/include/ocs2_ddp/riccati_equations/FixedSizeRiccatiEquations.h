@@ -0,0 +1,97 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/model_data/ModelData.h>
+
+#include "ocs2_ddp/riccati_equations/RiccatiModification.h"
+
+namespace ocs2 {
+namespace fixed_size_riccati {
+
+/**
+ * Checks whether a compile-time sized instantiation of the Riccati kernels exists for the given dimensions. The instantiations have a
+ * fixed state dimension and a bounded input dimension, such that all projected input dimensions up to the bound are covered.
+ *
+ * @param [in] stateDim: The state dimension.
+ * @param [in] projectedInputDim: The projected input dimension.
+ */
+bool isSupported(size_t stateDim, size_t projectedInputDim);
+
+/**
+ * Computes one step of the ILQR Riccati difference equations with compile-time sized kernels. It returns the same result as
+ * DiscreteTimeRiccatiEquations, but lets Eigen unroll and vectorize the small matrix products and keeps the temporaries on the stack.
+ *
+ * @param [in] reducedFormRiccati: Whether the reduced form of the Riccati equation is used.
+ * @param [in] projectedModelData: The projected model data.
+ * @param [in] riccatiModification: The RiccatiModification.
+ * @param [in] SmNext: The Riccati matrix of the next time step.
+ * @param [in] SvNext: The Riccati vector of the next time step.
+ * @param [in] sNext: The Riccati scalar of the next time step.
+ * @param [out] projectedKm: The projected feedback controller.
+ * @param [out] projectedLv: The projected feedforward controller.
+ * @param [out] Sm: The current Riccati matrix.
+ * @param [out] Sv: The current Riccati vector.
+ * @param [out] s: The current Riccati scalar.
+ * @return false if there is no instantiation for the dimensions of projectedModelData. In this case, the outputs are not modified.
+ */
+bool computeMapILQR(bool reducedFormRiccati, const ModelData& projectedModelData, const riccati_modification::Data& riccatiModification,
+                    const matrix_t& SmNext, const vector_t& SvNext, scalar_t sNext, matrix_t& projectedKm, vector_t& projectedLv,
+                    matrix_t& Sm, vector_t& Sv, scalar_t& s);
+
+/**
+ * Computes the flow map of the SLQ Riccati differential equations with compile-time sized kernels. It returns the same result as
+ * ContinuousTimeRiccatiEquations without the risk-sensitive variant and the terminal sensitivity. The projected model data and the
+ * Riccati modification are linearly interpolated at indexAlpha.
+ *
+ * @param [in] reducedFormRiccati: Whether the reduced form of the Riccati equation is used.
+ * @param [in] indexAlpha: The interpolation index and coefficient.
+ * @param [in] projectedModelDataTrajectory: The projected model data trajectory.
+ * @param [in] riccatiModificationTrajectory: The RiccatiModification trajectory.
+ * @param [in] Sm: The current Riccati matrix.
+ * @param [in] Sv: The current Riccati vector.
+ * @param [out] dSm: The time derivative of the Riccati matrix.
+ * @param [out] dSv: The time derivative of the Riccati vector.
+ * @param [out] ds: The time derivative of the Riccati scalar.
+ * @return false if there is no instantiation for the dimensions or the projected input dimension changes over the interpolated
+ * interval. In this case, the outputs are not modified.
+ */
+bool computeFlowMapSLQ(bool reducedFormRiccati, std::pair<int, scalar_t> indexAlpha,
+                       const std::vector<ModelData>& projectedModelDataTrajectory,
+                       const std::vector<riccati_modification::Data>& riccatiModificationTrajectory, const matrix_t& Sm,
+                       const vector_t& Sv, matrix_t& dSm, vector_t& dSv, scalar_t& ds);
+
+}  // namespace fixed_size_riccati
+}  // namespace ocs2
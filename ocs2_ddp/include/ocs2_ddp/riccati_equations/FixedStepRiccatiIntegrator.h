@@ -0,0 +1,186 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/model_data/ModelData.h>
+
+#include "ocs2_ddp/riccati_equations/RiccatiModification.h"
+#include "ocs2_ddp/riccati_equations/RiccatiSensitivity.h"
+
+namespace ocs2 {
+
+/**
+ * A fixed-step RK4 integrator for the continuous-time Riccati equations of SLQ. It is a dedicated alternative to integrating
+ * ContinuousTimeRiccatiEquations through IntegratorBase:
+ * - The Riccati state is kept in the packed layout of ContinuousTimeRiccatiEquations::convert2Vector, i.e. only the upper triangle of
+ *   Sm is stored and the RK4 stages are combined on the packed vector.
+ * - Each interval of the time stamp is integrated with an integer number of equal steps. Therefore the model data at the RK4 stages are
+ *   interpolated from the two nodes of the interval with fixed coefficients, without a time lookup. The data at the end of a step are
+ *   reused at the start of the next one.
+ * - All the buffers are allocated once for a given problem dimension and the solution is written directly into the value function
+ *   trajectory.
+ *
+ * The risk-sensitive variant is not supported.
+ */
+class FixedStepRiccatiIntegrator {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] reducedFormRiccati: The reduced form of the Riccati equation is yield by assuming that Hessein of
+   * the Hamiltonian is positive definite. In this case, the computation of Riccati equation is more efficient.
+   */
+  explicit FixedStepRiccatiIntegrator(bool reducedFormRiccati);
+
+  /**
+   * Sets coefficients of the model.
+   *
+   * @param [in] timeStampPtr: A pointer to the time stamp trajectory.
+   * @param [in] projectedModelDataPtr: A pointer to the projected model data trajectory.
+   * @param [in] postEventIndicesPtr: A pointer to the post event indices.
+   * @param [in] modelDataEventTimesPtr: A pointer to the model data at event times.
+   * @param [in] riccatiModificationPtr: A pointer to the RiccatiModification trajectory.
+   */
+  void setData(const scalar_array_t* timeStampPtr, const std::vector<ModelData>* projectedModelDataPtr,
+               const size_array_t* postEventIndicesPtr, const std::vector<ModelData>* modelDataEventTimesPtr,
+               const std::vector<riccati_modification::Data>* riccatiModificationPtr);
+
+  /**
+   * Integrates the Riccati equations backward in time over a partition of the time stamp.
+   *
+   * @param [in] partitionInterval: The partition interval of the time stamp.
+   * @param [in] maxTimeStep: The maximum integration step. Each interval of the time stamp is divided into equal steps.
+   * @param [in] finalValueFunction: The value function at the end of the partition, i.e. at partitionInterval.second.
+   * @param [out] valueFunctionTrajectory: The value function trajectory. Only the elements in [partitionInterval.first,
+   * partitionInterval.second) are written.
+   */
+  void integrate(const std::pair<int, int>& partitionInterval, scalar_t maxTimeStep,
+                 const ScalarFunctionQuadraticApproximation& finalValueFunction,
+                 std::vector<ScalarFunctionQuadraticApproximation>& valueFunctionTrajectory);
+
+  /**
+   * Integrates the Riccati equations backward in time over a partition of the time stamp along with the terminal sensitivity.
+   *
+   * @param [in] partitionInterval: The partition interval of the time stamp.
+   * @param [in] maxTimeStep: The maximum integration step. Each interval of the time stamp is divided into equal steps.
+   * @param [in] finalValueFunction: The value function at the end of the partition, i.e. at partitionInterval.second.
+   * @param [out] initialValueFunction: The value function at the start of the partition.
+   * @param [out] sensitivity: The terminal sensitivity of the partition.
+   */
+  void integrate(const std::pair<int, int>& partitionInterval, scalar_t maxTimeStep,
+                 const ScalarFunctionQuadraticApproximation& finalValueFunction, ScalarFunctionQuadraticApproximation& initialValueFunction,
+                 riccati_sensitivity::Data& sensitivity);
+
+  /** Returns the number of the flow map evaluations since the last call to setData. */
+  size_t getNumFunctionCalls() const { return numFunctionCalls_; }
+
+ private:
+  /** The model data interpolated at an integration stage. */
+  struct Coefficients {
+    vector_t Hv;
+    matrix_t Am;
+    matrix_t Bm;
+    scalar_t q = 0.0;
+    vector_t Qv;
+    matrix_t Qm;
+    vector_t Rv;
+    matrix_t Rm;
+    matrix_t Pm;
+    matrix_t deltaQm;
+    matrix_t deltaGm;
+    vector_t deltaGv;
+  };
+
+  /** Resizes the packed buffers for the given state dimension. It does not allocate if the dimension has not changed. */
+  void resize(int stateDim, bool computeTerminalSensitivity);
+
+  /** Integrates backward from the final packed state at partitionInterval.second to partitionInterval.first. */
+  void integratePartition(const std::pair<int, int>& partitionInterval, scalar_t maxTimeStep,
+                          std::vector<ScalarFunctionQuadraticApproximation>* valueFunctionTrajectoryPtr);
+
+  /** Interpolates the model data of the interval [t_k, t_{k+1}] with weight alpha of the k-th node. */
+  void interpolate(size_t k, scalar_t alpha, Coefficients& coefficients) const;
+
+  /** Computes the derivative of the packed Riccati state w.r.t. the normalized time, i.e. -t. */
+  void computeFlowMap(const Coefficients& coefficients, const vector_t& packedState, vector_t& packedDerivative);
+
+  /** Applies the Riccati jump map at an event, in place. */
+  void computeJumpMap(const ModelData& jumpModelData, vector_t& packedState);
+
+  void pack(const matrix_t& Sm, const vector_t& Sv, scalar_t s, vector_t& packedState) const;
+  void unpack(const vector_t& packedState, matrix_t& Sm, vector_t& Sv, scalar_t& s) const;
+  void packSensitivity(const riccati_sensitivity::Data& sensitivity, vector_t& packedState) const;
+  void unpackSensitivity(const vector_t& packedState, riccati_sensitivity::Data& sensitivity) const;
+
+  bool reducedFormRiccati_;
+  bool computeTerminalSensitivity_ = false;
+  size_t numFunctionCalls_ = 0;
+
+  // array pointers
+  const scalar_array_t* timeStampPtr_ = nullptr;
+  const std::vector<ModelData>* projectedModelDataPtr_ = nullptr;
+  const size_array_t* postEventIndicesPtr_ = nullptr;
+  const std::vector<ModelData>* modelDataEventTimesPtr_ = nullptr;
+  const std::vector<riccati_modification::Data>* riccatiModificationPtr_ = nullptr;
+
+  // RK4 buffers
+  int stateDim_ = 0;
+  vector_t y_, yStage_, k1_, k2_, k3_, k4_;
+  Coefficients start_, mid_, end_;
+
+  // flow map buffers
+  scalar_t s_ = 0.0;
+  vector_t Sv_;
+  matrix_t Sm_;
+  scalar_t ds_ = 0.0;
+  vector_t dSv_;
+  matrix_t dSm_;
+  matrix_t Gm_;
+  vector_t Gv_;
+  matrix_t Km_;
+  vector_t Lv_;
+  matrix_t SmTrans_Am_;
+  matrix_t Km_T_Gm_;
+  matrix_t Rm_Km_;
+  vector_t Rm_Lv_;
+  riccati_sensitivity::Data sensitivity_;
+  riccati_sensitivity::Data dSensitivity_;
+  matrix_t Bm_T_M_;
+
+  // jump map buffers
+  matrix_t SmTrans_jumpAm_;
+  vector_t Sv_plus_SmHv_;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,70 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+namespace riccati_sensitivity {
+
+/**
+ * The sensitivity of the final state of a partition's optimal trajectory with respect to its initial state and to a perturbation lambda
+ * of the gradient of the final value function:
+ *    dx_final = M^T * dx_initial + N * lambda + n
+ *
+ * M is the transpose of the closed-loop state transition matrix over the partition.
+ */
+struct Data {
+  matrix_t M;
+  matrix_t N;
+  vector_t n;
+
+  /** The sensitivity of an empty partition. */
+  static Data Identity(int stateDim);
+};
+
+/**
+ * Computes the value function at the start of a partition for a new final value function, without solving the Riccati equations
+ * again. The result is exact for the Riccati equations of an LQ problem, i.e. when the Riccati modification terms do not depend on
+ * the value function.
+ *
+ * @param [in] initialValueFunction: The value function at the start of the partition, solved for the final value function finalGuess.
+ * @param [in] sensitivity: The sensitivity of the partition, solved for the final value function finalGuess.
+ * @param [in] finalGuess: The final value function that was used to solve the partition.
+ * @param [in] finalValueFunction: The new final value function.
+ * @return The value function at the start of the partition for finalValueFunction. The constant term is not corrected.
+ */
+ScalarFunctionQuadraticApproximation correctInitialValueFunction(const ScalarFunctionQuadraticApproximation& initialValueFunction,
+                                                                 const Data& sensitivity,
+                                                                 const ScalarFunctionQuadraticApproximation& finalGuess,
+                                                                 const ScalarFunctionQuadraticApproximation& finalValueFunction);
+
+}  // namespace riccati_sensitivity
+}  // namespace ocs2
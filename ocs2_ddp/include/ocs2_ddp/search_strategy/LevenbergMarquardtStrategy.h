@@ -74,6 +74,8 @@ class LevenbergMarquardtStrategy final : public SearchStrategyBase {
            const LinearController& unoptimizedController, const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
            search_strategy::SolutionRef solution) override;
 
+  size_t getMaxNumTrials() const override { return settings_.maxNumTrialsPerIteration; }
+
   std::pair<bool, std::string> checkConvergence(bool unreliableControllerIncrement, const PerformanceIndex& previousPerformanceIndex,
                                                 const PerformanceIndex& currentPerformanceIndex) const override;
 
@@ -29,7 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -60,11 +62,14 @@ class LineSearchStrategy final : public SearchStrategyBase {
    * @param [in] rolloutRefStock: An array of references to the rollout.
    * @param [in] optimalControlProblemRef: An array of references to the optimal control problem.
    * @param [in] meritFunc: the merit function which gets the PerformanceIndex and returns the merit function value.
+   * @param [in] shootingNodesPtr: A pointer to the multiple-shooting nodes which are updated by the caller before each run. If it is
+   *                               nullptr or has no nodes, the trajectories are rolled out with a single shooting.
    */
   LineSearchStrategy(search_strategy::Settings baseSettings, line_search::Settings settings, ThreadPool& threadPoolRef,
                      std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock,
                      std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRef,
-                     std::function<scalar_t(const PerformanceIndex&)> meritFunc);
+                     std::function<scalar_t(const PerformanceIndex&)> meritFunc,
+                     const search_strategy::ShootingNodes* shootingNodesPtr = nullptr);
 
   ~LineSearchStrategy() override = default;
   LineSearchStrategy(const LineSearchStrategy&) = delete;
@@ -93,18 +98,78 @@ class LineSearchStrategy final : public SearchStrategyBase {
     const ModeSchedule* modeSchedulePtr;
   };
 
+  /** The rollout of one segment of a multiple-shooting trial. */
+  struct ShootingSegment {
+    scalar_array_t timeTrajectory;
+    size_array_t postEventIndices;
+    vector_array_t stateTrajectory;
+    vector_array_t inputTrajectory;
+    vector_t finalState;
+  };
+
+  /** A step length of the multiple-shooting line search. Its segments are rolled out by any of the workers. */
+  struct ShootingTrial {
+    scalar_t stepLength = 0.0;
+    search_strategy::Solution solution;
+    vector_array_t shootingStates;
+    std::vector<ShootingSegment> segments;
+    vector_array_t dynamicsViolationTrajectory;
+    std::atomic_bool isPrepared{false};
+    std::atomic_bool isFailed{false};
+    std::atomic_size_t numUnfinishedSegments{0};
+  };
+
   /** number of line search iterations (the if statements order is important) */
   size_t maxNumOfSearches() const;
 
   /** Computes the solution on a thread and a given stepLength  */
   void computeSolution(size_t taskId, scalar_t stepLength, search_strategy::Solution& solution);
 
+  /**
+   * Computes the dual solution, the metrics, and the performance index of the rolled out primal solution.
+   *
+   * @param [in] taskId: The index of the worker.
+   * @param [in] stepLength: The step length of the solution.
+   * @param [in, out] solution: The solution.
+   * @param [in] dynamicsViolationTrajectoryPtr: The defects of the multiple-shooting segments which are swapped into the metrics.
+   */
+  void evaluateSolution(size_t taskId, scalar_t stepLength, search_strategy::Solution& solution,
+                        vector_array_t* dynamicsViolationTrajectoryPtr = nullptr);
+
+  /**
+   * Prepares the multiple-shooting trials of the next shootingTask() jobs. The trial i uses the step length
+   * maxStepLength * contractionRate^i, or zero for the baseline.
+   */
+  void runShootingTrials(size_t numTrials, bool isBaseline);
+
+  /**
+   * Rolls out the segments of the multiple-shooting trials on a thread. The segments of all trials are shared between the workers in
+   * the order of decreasing step lengths. The worker which finishes the last segment of a trial evaluates and accepts or rejects it.
+   */
+  void shootingTask(size_t taskId);
+
+  /** Rolls out a segment of a multiple-shooting trial. */
+  void rolloutShootingSegment(size_t taskId, size_t segment, ShootingTrial& trial);
+
+  /** Stitches the segments of a multiple-shooting trial to its primal solution and its dynamics violation. */
+  void stitchShootingSegments(ShootingTrial& trial) const;
+
+  /**
+   * Accepts the solution of the step length if it satisfies the Armijo condition and has the largest step length so far.
+   *
+   * @return whether the line search can terminate, i.e., the step is accepted and all the larger step lengths are processed.
+   */
+  bool acceptOrRejectStep(size_t alphaExp, scalar_t stepLength, search_strategy::Solution& solution);
+
   /**
    * Defines line search task on a thread with various learning rates and choose the largest acceptable step-size.
    * The class computes the nominal controller and the nominal trajectories as well the corresponding performance indices.
    */
   void lineSearchTask(const size_t taskId);
 
+  /** Marks the best solution as settled. The first call decides whether the settled solution task runs. */
+  void settleSearch();
+
   /** Prints to output. */
   void printString(const std::string& text) const;
 
@@ -115,6 +180,8 @@ class LineSearchStrategy final : public SearchStrategyBase {
   std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock_;
   std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRefStock_;
   std::function<scalar_t(PerformanceIndex)> meritFunc_;
+  const search_strategy::ShootingNodes* shootingNodesPtr_;
+  std::vector<std::unique_ptr<ShootingTrial>> shootingTrials_;
 
   // input
   LineSearchInputRef lineSearchInputRef_;
@@ -130,6 +197,11 @@ class LineSearchStrategy final : public SearchStrategyBase {
   std::atomic_size_t nextTaskId_{0};
   std::atomic_size_t alphaExpNext_{0};
   std::vector<bool> alphaProcessed_;
+  std::atomic_size_t nextShootingItem_{0};
+  size_t numShootingItems_ = 0;
+  bool isShootingBaseline_ = false;
+  std::atomic_int settleState_{0};  // 0: searching, 1: deciding on the settled solution task, 2: settled
+  bool isSettledSolutionTaskRunning_ = false;
   std::mutex lineSearchResultMutex_;
   mutable std::mutex outputDisplayGuardMutex_;
 };
@@ -90,6 +90,12 @@ class SearchStrategyBase {
                    const LinearController& unoptimizedController, const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
                    search_strategy::SolutionRef solution) = 0;
 
+  /**
+   * The maximum number of trials in one iteration. After a rejected trial, the caller solves the same LQ problem again with the
+   * Riccati modification which the rejection has adapted, and calls run() on the new controller.
+   */
+  virtual size_t getMaxNumTrials() const { return 1; }
+
   /**
    * Checks convergence of the main loop of DDP.
    *
@@ -123,8 +129,26 @@ class SearchStrategyBase {
    */
   virtual matrix_t augmentHamiltonianHessian(const ModelData& modelData, const matrix_t& Hm) const = 0;
 
+  /**
+   * Sets a task which the workers of the search start as soon as the search has settled on its solution, i.e., while the remaining
+   * trials are still being aborted. isTaskRequired is called once on the settled solution before any worker starts the task. The task
+   * only runs on the workers which are still searching at that point, possibly on none of them. Therefore, the caller finishes the
+   * task after run() if isTaskRequired has returned true. The strategies which cannot tell the settled solution before the end of the
+   * search ignore the task.
+   *
+   * @param [in] isTaskRequired: Gets the performance index of the settled solution and returns whether the task should run. The
+   *                             settled solution is already in the output of run().
+   * @param [in] task: The task which is called by the workers with their worker index. Set nullptr to remove the task.
+   */
+  void setSettledSolutionTask(std::function<bool(const PerformanceIndex&)> isTaskRequired, std::function<void(size_t)> task) {
+    isSettledSolutionTaskRequired_ = std::move(isTaskRequired);
+    settledSolutionTask_ = std::move(task);
+  }
+
  protected:
   const search_strategy::Settings baseSettings_;
+  std::function<bool(const PerformanceIndex&)> isSettledSolutionTaskRequired_;
+  std::function<void(size_t)> settledSolutionTask_;
 };
 
 }  // namespace ocs2
@@ -166,6 +190,16 @@ struct SolutionRef {
   PerformanceIndex& performanceIndex;
 };
 
+/**
+ * The initial nodes of the multiple-shooting segments after the first one. For a step length alpha, the segment s starts at
+ * (times[s], nominalStates[s] + alpha * stateIncrements[s]).
+ */
+struct ShootingNodes {
+  scalar_array_t times;
+  vector_array_t nominalStates;
+  vector_array_t stateIncrements;
+};
+
 inline void swap(SolutionRef lhs, SolutionRef rhs) {
   std::swap(lhs.avgTimeStep, rhs.avgTimeStep);
   lhs.dualSolution.swap(rhs.dualSolution);
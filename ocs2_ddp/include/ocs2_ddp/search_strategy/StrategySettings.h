@@ -129,6 +129,10 @@ struct Settings {
   scalar_t riccatiMultipleDefaultFactor = 1e-6;
   /** Maximum number of successive rejections of the iteration's solution. */
   size_t maxNumSuccessiveRejections = 5;
+  /** The maximum number of trials in one iteration. A rejected trial is retried on the same LQ approximation with the increased Riccati
+   * multiple, so it does not cost a new iteration. The backward pass of a trial is only computed after the previous trial is rejected.
+   * One trial is the sequential algorithm. */
+  size_t maxNumTrialsPerIteration = 1;
 };  // end of Settings
 
 /**
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <algorithm>
 #include <iostream>
+#include <iterator>
 
 #include <ocs2_core/PreComputation.h>
 #include <ocs2_core/integration/TrapezoidalIntegration.h>
@@ -119,7 +120,10 @@ PerformanceIndex computeRolloutPerformanceIndex(const scalar_array_t& timeTrajec
   performanceIndex.cost += trapezoidalIntegration(timeTrajectory, costTrajectory);
 
   // Dynamics violation:
+  // - Intermediates: defects between the multiple-shooting segments
   performanceIndex.dynamicsViolationSSE = 0.0;
+  std::for_each(problemMetrics.intermediates.begin(), problemMetrics.intermediates.end(),
+                [&](const MetricsCollection& m) { performanceIndex.dynamicsViolationSSE += m.dynamicsViolation.squaredNorm(); });
 
   // Equality constraints' SSE:
   // - Final: state equality constraints
@@ -198,6 +202,9 @@ void projectLQ(const ModelData& modelData, const matrix_t& constraintRangeProjec
   // unhandled constraints
   projectedModelData.stateEqConstraint.f = vector_t();
 
+  // the covariance of the dynamics does not depend on the input
+  projectedModelData.dynamicsCovariance = modelData.dynamicsCovariance;
+
   if (modelData.stateInputEqConstraint.f.rows() == 0) {
     // Change of variables u = Pu * tilde{u}
     // Pu = constraintNullProjector;
@@ -404,4 +411,80 @@ std::vector<std::pair<int, int>> computePartitionIntervals(const scalar_array_t&
   return partitionIntervals;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool isMultiplierCollectionNear(const MultiplierCollection& lhs, const MultiplierCollection& rhs, scalar_t tol) {
+  auto isNear = [tol](const std::vector<Multiplier>& lhsTerms, const std::vector<Multiplier>& rhsTerms) {
+    if (lhsTerms.size() != rhsTerms.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < lhsTerms.size(); i++) {
+      if (std::abs(lhsTerms[i].penalty - rhsTerms[i].penalty) > tol || lhsTerms[i].lagrangian.size() != rhsTerms[i].lagrangian.size()) {
+        return false;
+      }
+      if (lhsTerms[i].lagrangian.size() > 0 && (lhsTerms[i].lagrangian - rhsTerms[i].lagrangian).lpNorm<Eigen::Infinity>() > tol) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  return isNear(lhs.stateEq, rhs.stateEq) && isNear(lhs.stateIneq, rhs.stateIneq) && isNear(lhs.stateInputEq, rhs.stateInputEq) &&
+         isNear(lhs.stateInputIneq, rhs.stateInputIneq);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void updateIntermediateLQ(const vector_t& deltaState, const vector_t& deltaInput, ModelData& modelData) {
+  auto& cost = modelData.cost;
+
+  // cost value: second order
+  const vector_t Qm_deltaState = cost.dfdxx * deltaState;
+  const vector_t Rm_deltaInput = cost.dfduu * deltaInput;
+  const vector_t Pm_deltaState = cost.dfdux * deltaState;
+  cost.f += cost.dfdx.dot(deltaState) + cost.dfdu.dot(deltaInput) + 0.5 * deltaState.dot(Qm_deltaState) +
+            deltaInput.dot(Pm_deltaState) + 0.5 * deltaInput.dot(Rm_deltaInput);
+
+  // cost gradients: first order
+  cost.dfdx += Qm_deltaState;
+  cost.dfdx.noalias() += cost.dfdux.transpose() * deltaInput;
+  cost.dfdu += Pm_deltaState + Rm_deltaInput;
+
+  // constraint values: first order
+  if (modelData.stateEqConstraint.f.size() > 0) {
+    modelData.stateEqConstraint.f.noalias() += modelData.stateEqConstraint.dfdx * deltaState;
+  }
+  if (modelData.stateInputEqConstraint.f.size() > 0) {
+    modelData.stateInputEqConstraint.f.noalias() += modelData.stateInputEqConstraint.dfdx * deltaState;
+    modelData.stateInputEqConstraint.f.noalias() += modelData.stateInputEqConstraint.dfdu * deltaInput;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void copyPrimalSolution(const PrimalSolution& src, PrimalSolution& dst) {
+  dst.timeTrajectory_ = src.timeTrajectory_;
+  dst.stateTrajectory_ = src.stateTrajectory_;
+  dst.inputTrajectory_ = src.inputTrajectory_;
+  dst.postEventIndices_ = src.postEventIndices_;
+  dst.modeSchedule_ = src.modeSchedule_;
+
+  if (src.controllerPtr_ == nullptr) {
+    dst.controllerPtr_.reset();
+  } else if (dst.controllerPtr_ == nullptr) {
+    dst.controllerPtr_.reset(src.controllerPtr_->clone());
+  } else {
+    // the copy assignment of LinearController uses copy-and-swap, therefore the arrays are assigned one by one
+    const auto& srcController = getLinearController(src);
+    auto& dstController = getLinearController(dst);
+    dstController.timeStamp_ = srcController.timeStamp_;
+    dstController.biasArray_ = srcController.biasArray_;
+    dstController.deltaBiasArray_ = srcController.deltaBiasArray_;
+    dstController.gainArray_ = srcController.gainArray_;
+  }
+}
+
 }  // namespace ocs2
@@ -69,6 +69,7 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
 
   loadData::loadPtreeValue(pt, settings.nThreads_, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority_, fieldName + ".threadPriority", verbose);
+  loadData::loadStdVector(filename, fieldName + ".cpuAffinity", settings.cpuAffinity_, verbose);
 
   loadData::loadPtreeValue(pt, settings.maxNumIterations_, fieldName + ".maxNumIterations", verbose);
   loadData::loadPtreeValue(pt, settings.minRelCost_, fieldName + ".minRelCost", verbose);
@@ -86,11 +87,19 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   auto integratorName = integrator_type::toString(settings.backwardPassIntegratorType_);  // keep default
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".backwardPassIntegratorType", verbose);
   settings.backwardPassIntegratorType_ = integrator_type::fromString(integratorName);
+  loadData::loadPtreeValue(pt, settings.useFixedStepRiccatiIntegrator_, fieldName + ".useFixedStepRiccatiIntegrator", verbose);
 
   loadData::loadPtreeValue(pt, settings.constraintPenaltyInitialValue_, fieldName + ".constraintPenaltyInitialValue", verbose);
   loadData::loadPtreeValue(pt, settings.constraintPenaltyIncreaseRate_, fieldName + ".constraintPenaltyIncreaseRate", verbose);
 
+  loadData::loadPtreeValue(pt, settings.incrementalLQApproximation_, fieldName + ".incrementalLQApproximation", verbose);
+  loadData::loadPtreeValue(pt, settings.incrementalLQApproximationTolerance_, fieldName + ".incrementalLQApproximationTolerance",
+                           verbose);
+  loadData::loadPtreeValue(pt, settings.pipelinedIteration_, fieldName + ".pipelinedIteration", verbose);
+  loadData::loadPtreeValue(pt, settings.numShootingSegments_, fieldName + ".numShootingSegments", verbose);
+
   loadData::loadPtreeValue(pt, settings.preComputeRiccatiTerms_, fieldName + ".preComputeRiccatiTerms", verbose);
+  loadData::loadPtreeValue(pt, settings.useFixedSizeRiccatiKernels_, fieldName + ".useFixedSizeRiccatiKernels", verbose);
 
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy_, fieldName + ".useFeedbackPolicy", verbose);
 
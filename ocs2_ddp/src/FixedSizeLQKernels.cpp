@@ -0,0 +1,284 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ddp/FixedSizeLQKernels.h"
+
+#include "ocs2_ddp/riccati_equations/FixedSizeRiccatiEquations.h"
+
+namespace ocs2 {
+namespace fixed_size_lq {
+
+namespace {
+
+/**
+ * The projection of ocs2::projectLQ with a compile-time state dimension and an input dimension bounded by MAX_INPUT_DIM. The change of
+ * input variables u = Pu * tilde{u} + Px * x + u0 follows changeOfInputVariables.
+ */
+template <int STATE_DIM, int MAX_INPUT_DIM>
+void projectLQImpl(const ModelData& modelData, const matrix_t& constraintRangeProjector, const matrix_t& constraintNullProjector,
+                   ModelData& projectedModelData) {
+  using state_matrix_t = Eigen::Matrix<scalar_t, STATE_DIM, STATE_DIM>;
+  using state_vector_t = Eigen::Matrix<scalar_t, STATE_DIM, 1>;
+  using state_input_matrix_t = Eigen::Matrix<scalar_t, STATE_DIM, Eigen::Dynamic, Eigen::ColMajor, STATE_DIM, MAX_INPUT_DIM>;
+  using input_state_matrix_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, STATE_DIM, Eigen::ColMajor, MAX_INPUT_DIM, STATE_DIM>;
+  using input_matrix_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor, MAX_INPUT_DIM, MAX_INPUT_DIM>;
+  using input_vector_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, 1, Eigen::ColMajor, MAX_INPUT_DIM, 1>;
+  using state_input_map_t = Eigen::Matrix<scalar_t, STATE_DIM, Eigen::Dynamic>;
+  using input_state_map_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, STATE_DIM>;
+
+  const auto inputDim = modelData.dynamics.dfdu.cols();
+  const auto numConstraints = modelData.stateInputEqConstraint.f.rows();
+  const Eigen::Map<const state_input_map_t> Bm(modelData.dynamics.dfdu.data(), STATE_DIM, inputDim);
+  const Eigen::Map<const input_state_map_t> Pm(modelData.cost.dfdux.data(), inputDim, STATE_DIM);
+  const Eigen::Map<const matrix_t> Pu(constraintNullProjector.data(), inputDim, constraintNullProjector.cols());
+  const input_matrix_t Rm = modelData.cost.dfduu;
+
+  // dimensions and time
+  projectedModelData.time = modelData.time;
+  projectedModelData.stateDim = modelData.stateDim;
+  projectedModelData.inputDim = modelData.inputDim - numConstraints;
+
+  // unhandled constraints
+  projectedModelData.stateEqConstraint.f = vector_t();
+
+  // the covariance of the dynamics does not depend on the input
+  projectedModelData.dynamicsCovariance = modelData.dynamicsCovariance;
+
+  // shared terms of the cost: P + R * Px and r + R * u0
+  input_state_matrix_t P_plus_R_Px = Pm;
+  input_vector_t r_plus_R_u0 = modelData.cost.dfdu;
+  state_matrix_t Qm = modelData.cost.dfdxx;
+  state_vector_t Qv = modelData.cost.dfdx;
+  scalar_t q = modelData.cost.f;
+  state_matrix_t Am = modelData.dynamics.dfdx;
+  state_vector_t dynamicsF = modelData.dynamics.f;
+  state_vector_t Hv = modelData.dynamicsBias;
+
+  if (numConstraints == 0) {
+    // Change of variables u = Pu * tilde{u}
+    projectedModelData.stateInputEqConstraint.f.setZero(projectedModelData.inputDim);
+    projectedModelData.stateInputEqConstraint.dfdx.setZero(projectedModelData.inputDim, projectedModelData.stateDim);
+    projectedModelData.stateInputEqConstraint.dfdu.setZero(modelData.inputDim, modelData.inputDim);
+
+  } else {
+    // Change of variables u = Pu * tilde{u} + Px * x + u0
+    // Px (= -CmProjected) = -constraintRangeProjector * C
+    // u0 (= -EvProjected) = -constraintRangeProjector * e
+    const Eigen::Map<const matrix_t> rangeProjector(constraintRangeProjector.data(), inputDim, numConstraints);
+    const Eigen::Map<const matrix_t> Cm(modelData.stateInputEqConstraint.dfdx.data(), numConstraints, STATE_DIM);
+    const Eigen::Map<const matrix_t> Dm(modelData.stateInputEqConstraint.dfdu.data(), numConstraints, inputDim);
+
+    /* projected state-input equality constraints */
+    const input_vector_t EvProjected = rangeProjector * modelData.stateInputEqConstraint.f;
+    const input_state_matrix_t CmProjected = rangeProjector * Cm;
+    const input_matrix_t DmProjected = rangeProjector * Dm;
+    projectedModelData.stateInputEqConstraint.f = EvProjected;
+    projectedModelData.stateInputEqConstraint.dfdx = CmProjected;
+    projectedModelData.stateInputEqConstraint.dfdu = DmProjected;
+
+    // dynamics: A = A + B * Px, b = b + B * u0, and the dynamics bias Hv = Hv + B * u0
+    Am.noalias() -= Bm * CmProjected;
+    const state_vector_t Bm_u0 = -Bm * EvProjected;
+    dynamicsF += Bm_u0;
+    Hv += Bm_u0;
+
+    // cost
+    P_plus_R_Px.noalias() -= Rm * CmProjected;
+    r_plus_R_u0.noalias() -= Rm * EvProjected;
+    // Q = Q + P' * Px + Px' * (P + R * Px)
+    Qm.noalias() -= Pm.transpose() * CmProjected;
+    Qm.noalias() -= CmProjected.transpose() * P_plus_R_Px;
+    // q = q + P' * u0 + Px' * (R * u0 + r)
+    Qv.noalias() -= Pm.transpose() * EvProjected;
+    Qv.noalias() -= CmProjected.transpose() * r_plus_R_u0;
+    // c = c + 1/2 * u0' * ((R * u0 + r) + r)
+    q -= 0.5 * EvProjected.dot(r_plus_R_u0 + modelData.cost.dfdu);
+  }
+
+  // dynamics: B = B * Pu
+  const state_input_matrix_t Bm_Pu = Bm * Pu;
+  projectedModelData.dynamics.f = dynamicsF;
+  projectedModelData.dynamics.dfdx = Am;
+  projectedModelData.dynamics.dfdu = Bm_Pu;
+  projectedModelData.dynamicsBias = Hv;
+
+  // cost: P = Pu' * (P + R * Px), R = Pu' * R * Pu, r = Pu' * (R * u0 + r)
+  const input_matrix_t R_Pu = Rm * Pu;
+  const input_matrix_t projectedRm = Pu.transpose() * R_Pu;
+  projectedModelData.cost.f = q;
+  projectedModelData.cost.dfdx = Qv;
+  projectedModelData.cost.dfdxx = Qm;
+  projectedModelData.cost.dfdux.noalias() = Pu.transpose() * P_plus_R_Px;
+  projectedModelData.cost.dfduu = projectedRm;
+  projectedModelData.cost.dfdu.noalias() = Pu.transpose() * r_plus_R_u0;
+}
+
+/**
+ * The sensitivity discretizations of SensitivityIntegratorImpl with a compile-time state dimension and an input dimension bounded by
+ * MAX_INPUT_DIM.
+ */
+template <int STATE_DIM, int MAX_INPUT_DIM>
+void sensitivityDiscretizationImpl(SensitivityIntegratorType integratorType, SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                   const vector_t& u, scalar_t dt, VectorFunctionLinearApproximation& discreteDynamics) {
+  using state_matrix_t = Eigen::Matrix<scalar_t, STATE_DIM, STATE_DIM>;
+  using state_vector_t = Eigen::Matrix<scalar_t, STATE_DIM, 1>;
+  using state_input_matrix_t = Eigen::Matrix<scalar_t, STATE_DIM, Eigen::Dynamic, Eigen::ColMajor, STATE_DIM, MAX_INPUT_DIM>;
+
+  state_matrix_t Am;
+  state_input_matrix_t Bm;
+  state_vector_t f;
+
+  switch (integratorType) {
+    case SensitivityIntegratorType::EULER: {
+      const auto k1 = system.linearApproximation(t, x, u);
+      Am = dt * k1.dfdx;
+      Bm = dt * k1.dfdu;
+      f = x + dt * k1.f;
+      break;
+    }
+    case SensitivityIntegratorType::RK2: {
+      const scalar_t dt_halve = dt / 2.0;
+      const auto k1 = system.linearApproximation(t, x, u);
+      const auto k2 = system.linearApproximation(t + dt, x + dt * k1.f, u);
+
+      // the sensitivities of the stages: dk2dxk = A2 * (I + dt * A1), dk2duk = A2 * dt * B1 + B2
+      const state_matrix_t A1 = k1.dfdx;
+      const state_matrix_t A2 = k2.dfdx;
+      const state_input_matrix_t B1 = k1.dfdu;
+      state_input_matrix_t dk2du = k2.dfdu;
+      dk2du.noalias() += dt * A2 * B1;
+      state_matrix_t dk2dx = A2;
+      dk2dx.noalias() += dt * A2 * A1;
+
+      Am = dt_halve * (A1 + dk2dx);
+      Bm = dt_halve * (B1 + dk2du);
+      f = x + dt_halve * (k1.f + k2.f);
+      break;
+    }
+    case SensitivityIntegratorType::RK4: {
+      const scalar_t dt_halve = dt / 2.0;
+      const scalar_t dt_sixth = dt / 6.0;
+      const scalar_t dt_third = dt / 3.0;
+      const auto k1 = system.linearApproximation(t, x, u);
+      const auto k2 = system.linearApproximation(t + dt_halve, x + dt_halve * k1.f, u);
+      const auto k3 = system.linearApproximation(t + dt_halve, x + dt_halve * k2.f, u);
+      const auto k4 = system.linearApproximation(t + dt, x + dt * k3.f, u);
+
+      // the sensitivities of the stages
+      const state_matrix_t dk1dx = k1.dfdx;
+      const state_input_matrix_t dk1du = k1.dfdu;
+      const state_matrix_t A2 = k2.dfdx;
+      state_matrix_t dk2dx = A2;
+      dk2dx.noalias() += dt_halve * A2 * dk1dx;
+      state_input_matrix_t dk2du = k2.dfdu;
+      dk2du.noalias() += dt_halve * A2 * dk1du;
+      const state_matrix_t A3 = k3.dfdx;
+      state_matrix_t dk3dx = A3;
+      dk3dx.noalias() += dt_halve * A3 * dk2dx;
+      state_input_matrix_t dk3du = k3.dfdu;
+      dk3du.noalias() += dt_halve * A3 * dk2du;
+      const state_matrix_t A4 = k4.dfdx;
+      state_matrix_t dk4dx = A4;
+      dk4dx.noalias() += dt * A4 * dk3dx;
+      state_input_matrix_t dk4du = k4.dfdu;
+      dk4du.noalias() += dt * A4 * dk3du;
+
+      Am = dt_sixth * dk1dx + dt_third * dk2dx + dt_third * dk3dx + dt_sixth * dk4dx;
+      Bm = dt_sixth * dk1du + dt_third * dk2du + dt_third * dk3du + dt_sixth * dk4du;
+      f = x + dt_sixth * k1.f + dt_third * k2.f + dt_third * k3.f + dt_sixth * k4.f;
+      break;
+    }
+  }
+  Am.diagonal().array() += 1.0;  // plus Identity()
+
+  discreteDynamics.dfdx = Am;
+  discreteDynamics.dfdu = Bm;
+  discreteDynamics.f = f;
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool isSupported(size_t stateDim, size_t inputDim) {
+  return fixed_size_riccati::isSupported(stateDim, inputDim);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool projectLQ(const ModelData& modelData, const matrix_t& constraintRangeProjector, const matrix_t& constraintNullProjector,
+               ModelData& projectedModelData) {
+  const auto stateDim = modelData.dynamics.dfdx.rows();
+  const auto inputDim = modelData.dynamics.dfdu.cols();
+  // the kernels map the data with the sizes of the dynamics
+  const bool isWellSized = modelData.stateDim == stateDim && modelData.dynamics.f.size() == stateDim &&
+                           modelData.dynamicsBias.size() == stateDim && constraintNullProjector.rows() == inputDim;
+  if (!isWellSized || !isSupported(stateDim, inputDim)) {
+    return false;
+  }
+
+  // the instantiations have to match isSupported
+  switch (stateDim) {
+    case 12:
+      projectLQImpl<12, 4>(modelData, constraintRangeProjector, constraintNullProjector, projectedModelData);
+      break;
+    case 24:
+      projectLQImpl<24, 24>(modelData, constraintRangeProjector, constraintNullProjector, projectedModelData);
+      break;
+  }
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool sensitivityDiscretization(SensitivityIntegratorType integratorType, SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                               const vector_t& u, scalar_t dt, VectorFunctionLinearApproximation& discreteDynamics) {
+  const size_t stateDim = x.size();
+  const size_t inputDim = u.size();
+  if (!isSupported(stateDim, inputDim)) {
+    return false;
+  }
+
+  // the instantiations have to match isSupported
+  switch (stateDim) {
+    case 12:
+      sensitivityDiscretizationImpl<12, 4>(integratorType, system, t, x, u, dt, discreteDynamics);
+      break;
+    case 24:
+      sensitivityDiscretizationImpl<24, 24>(integratorType, system, t, x, u, dt, discreteDynamics);
+      break;
+  }
+  return true;
+}
+
+}  // namespace fixed_size_lq
+}  // namespace ocs2
@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/trajectory_adjustment/TrajectorySpreadingHelperFunctions.h>
 
 #include <ocs2_ddp/DDP_HelperFunctions.h>
+#include <ocs2_ddp/FixedSizeLQKernels.h>
 #include <ocs2_ddp/HessianCorrection.h>
 #include <ocs2_ddp/riccati_equations/RiccatiModificationInterpolation.h>
 #include <ocs2_ddp/search_strategy/LevenbergMarquardtStrategy.h>
@@ -53,7 +54,8 @@ namespace ocs2 {
 /******************************************************************************************************/
 GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
                                const Initializer& initializer)
-    : ddpSettings_(std::move(ddpSettings)), threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_) {
+    : ddpSettings_(std::move(ddpSettings)),
+      threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_, ddpSettings_.cpuAffinity_) {
   Eigen::setNbThreads(1);  // no multithreading within Eigen.
   Eigen::initParallel();
 
@@ -74,6 +76,20 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
         "method!");
   }
 
+  // check multiple-shooting
+  if (ddpSettings_.numShootingSegments_ == 0) {
+    throw std::runtime_error("[GaussNewtonDDP] The number of shooting segments (a.k.a. numShootingSegments) should be at least one!");
+  }
+  if (ddpSettings_.numShootingSegments_ > 1 &&
+      (ddpSettings_.algorithm_ != ddp::Algorithm::ILQR || ddpSettings_.strategy_ != search_strategy::Type::LINE_SEARCH)) {
+    throw std::runtime_error("[GaussNewtonDDP] The multiple-shooting forward pass (a.k.a. numShootingSegments > 1) is only supported by "
+                             "ILQR with the line-search strategy!");
+  }
+  if (ddpSettings_.numShootingSegments_ > 1 && dynamic_cast<const TimeTriggeredRollout*>(&rollout) == nullptr) {
+    throw std::runtime_error("[GaussNewtonDDP] The multiple-shooting forward pass (a.k.a. numShootingSegments > 1) requires a "
+                             "TimeTriggeredRollout!");
+  }
+
   // initializer Rollout
   initializerRolloutPtr_.reset(new InitializerRollout(initializer, rollout.settings()));
 
@@ -104,7 +120,8 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
         problemRefStock.emplace_back(optimalControlProblemStock_[i]);
       }  // end of i loop
       searchStrategyPtr_.reset(new LineSearchStrategy(basicStrategySettings, ddpSettings_.lineSearch_, threadPool_,
-                                                      std::move(rolloutRefStock), std::move(problemRefStock), meritFunc));
+                                                      std::move(rolloutRefStock), std::move(problemRefStock), meritFunc,
+                                                      &shootingNodes_));
       break;
     }
     case search_strategy::Type::LEVENBERG_MARQUARDT: {
@@ -162,6 +179,14 @@ std::string GaussNewtonDDP::getBenchmarkingInfo() const {
                << searchStrategyTotal / benchmarkTotal * 100 << "%)\n";
     infoStream << "\tDual Solution      :\t" << totalDualSolutionTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << dualSolutionTotal / benchmarkTotal * 100 << "%)\n\n";
+    if (ddpSettings_.incrementalLQApproximation_) {
+      infoStream << "Incremental LQ approximation recomputed " << numRecomputedIntermediateLQNodes_ << " out of " << numIntermediateLQNodes_
+                 << " intermediate nodes.\n\n";
+    }
+    if (totalNumIterations_ > 0) {
+      infoStream << "Trajectory allocations per iteration: " << static_cast<scalar_t>(numTrajectoryAllocations_) / totalNumIterations_
+                 << "\n\n";
+    }
   }
   return infoStream.str();
 }
@@ -178,6 +203,9 @@ void GaussNewtonDDP::reset() {
   nominalPrimalData_.clear();
   cachedDualData_.clear();
   cachedPrimalData_.clear();
+  isCachedIntermediateLQValid_ = false;
+  isPipelinedIntermediateLQValid_ = false;
+  isNominalLQValid_ = false;
 
   // optimized data
   optimizedDualSolution_.clear();
@@ -189,6 +217,9 @@ void GaussNewtonDDP::reset() {
   avgTimeStepBP_ = 0.0;
   totalNumIterations_ = 0;
   performanceIndexHistory_.clear();
+  numRecomputedIntermediateLQNodes_ = 0;
+  numIntermediateLQNodes_ = 0;
+  numTrajectoryAllocations_ = 0;
 
   // benchmarking timers
   initializationTimer_.reset();
@@ -221,36 +252,44 @@ void GaussNewtonDDP::getPrimalSolution(scalar_t finalTime, PrimalSolution* prima
   const int length = getRequestedDataLength(optimizedPrimalSolution_.timeTrajectory_, finalTime);
   const int eventLenght = getRequestedEventDataLength(optimizedPrimalSolution_.postEventIndices_, length - 1);
 
-  // fill trajectories
-  primalSolutionPtr->timeTrajectory_.clear();
-  primalSolutionPtr->timeTrajectory_.reserve(length);
-  primalSolutionPtr->stateTrajectory_.clear();
-  primalSolutionPtr->stateTrajectory_.reserve(length);
-  primalSolutionPtr->inputTrajectory_.clear();
-  primalSolutionPtr->inputTrajectory_.reserve(length);
-  primalSolutionPtr->postEventIndices_.clear();
-  primalSolutionPtr->postEventIndices_.reserve(eventLenght);
-
-  primalSolutionPtr->timeTrajectory_.insert(primalSolutionPtr->timeTrajectory_.end(), optimizedPrimalSolution_.timeTrajectory_.begin(),
+  // fill trajectories (the elements of a reused primalSolutionPtr are copy-assigned, so their memory is reused as long as the length
+  // does not change, while a different length allocates or frees the difference)
+  primalSolutionPtr->timeTrajectory_.assign(optimizedPrimalSolution_.timeTrajectory_.begin(),
                                             optimizedPrimalSolution_.timeTrajectory_.begin() + length);
-  primalSolutionPtr->stateTrajectory_.insert(primalSolutionPtr->stateTrajectory_.end(), optimizedPrimalSolution_.stateTrajectory_.begin(),
+  primalSolutionPtr->stateTrajectory_.assign(optimizedPrimalSolution_.stateTrajectory_.begin(),
                                              optimizedPrimalSolution_.stateTrajectory_.begin() + length);
-  primalSolutionPtr->inputTrajectory_.insert(primalSolutionPtr->inputTrajectory_.end(), optimizedPrimalSolution_.inputTrajectory_.begin(),
+  primalSolutionPtr->inputTrajectory_.assign(optimizedPrimalSolution_.inputTrajectory_.begin(),
                                              optimizedPrimalSolution_.inputTrajectory_.begin() + length);
-  primalSolutionPtr->postEventIndices_.insert(primalSolutionPtr->postEventIndices_.end(),
-                                              optimizedPrimalSolution_.postEventIndices_.begin(),
+  primalSolutionPtr->postEventIndices_.assign(optimizedPrimalSolution_.postEventIndices_.begin(),
                                               optimizedPrimalSolution_.postEventIndices_.begin() + eventLenght);
 
-  // fill controller
+  // fill controller (the controller of a reused primalSolutionPtr is reused as well)
   if (ddpSettings_.useFeedbackPolicy_) {
-    primalSolutionPtr->controllerPtr_.reset(new LinearController);
+    auto* controllerPtr = dynamic_cast<LinearController*>(primalSolutionPtr->controllerPtr_.get());
+    if (controllerPtr == nullptr) {
+      controllerPtr = new LinearController;
+      primalSolutionPtr->controllerPtr_.reset(controllerPtr);
+    }
+    const auto& optimizedController = getLinearController(optimizedPrimalSolution_);
     // length of the copy
-    const int length = getRequestedDataLength(getLinearController(optimizedPrimalSolution_).timeStamp_, finalTime);
-    primalSolutionPtr->controllerPtr_->concatenate(optimizedPrimalSolution_.controllerPtr_.get(), 0, length);
-
+    const int controllerLength = getRequestedDataLength(optimizedController.timeStamp_, finalTime);
+    controllerPtr->timeStamp_.assign(optimizedController.timeStamp_.begin(), optimizedController.timeStamp_.begin() + controllerLength);
+    controllerPtr->biasArray_.assign(optimizedController.biasArray_.begin(), optimizedController.biasArray_.begin() + controllerLength);
+    controllerPtr->gainArray_.assign(optimizedController.gainArray_.begin(), optimizedController.gainArray_.begin() + controllerLength);
+    if (controllerLength <= static_cast<int>(optimizedController.deltaBiasArray_.size())) {
+      controllerPtr->deltaBiasArray_.assign(optimizedController.deltaBiasArray_.begin(),
+                                            optimizedController.deltaBiasArray_.begin() + controllerLength);
+    } else {
+      controllerPtr->deltaBiasArray_.clear();
+    }
   } else {
-    primalSolutionPtr->controllerPtr_.reset(
-        new FeedforwardController(primalSolutionPtr->timeTrajectory_, primalSolutionPtr->inputTrajectory_));
+    auto* controllerPtr = dynamic_cast<FeedforwardController*>(primalSolutionPtr->controllerPtr_.get());
+    if (controllerPtr == nullptr) {
+      controllerPtr = new FeedforwardController;
+      primalSolutionPtr->controllerPtr_.reset(controllerPtr);
+    }
+    controllerPtr->timeStamp_.assign(primalSolutionPtr->timeTrajectory_.begin(), primalSolutionPtr->timeTrajectory_.end());
+    controllerPtr->uffArray_.assign(primalSolutionPtr->inputTrajectory_.begin(), primalSolutionPtr->inputTrajectory_.end());
   }
 
   // fill mode schedule
@@ -502,6 +541,8 @@ scalar_t GaussNewtonDDP::calculateRolloutMerit(const PerformanceIndex& performan
   scalar_t merit = performanceIndex.cost;
   // state/state-input equality constraints
   merit += constraintPenaltyCoefficients_.penaltyCoeff * std::sqrt(performanceIndex.equalityConstraintsSSE);
+  // defects of the multiple-shooting segments
+  merit += constraintPenaltyCoefficients_.penaltyCoeff * std::sqrt(performanceIndex.dynamicsViolationSSE);
   // state/state-input equality Lagrangian
   merit += performanceIndex.equalityLagrangian;
   // state/state-input inequality Lagrangian
@@ -510,14 +551,66 @@ scalar_t GaussNewtonDDP::calculateRolloutMerit(const PerformanceIndex& performan
   return merit;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t GaussNewtonDDP::getExpectedIterationDurationInMilliseconds() const {
+  return linearQuadraticApproximationTimer_.getExpectedIntervalInMilliseconds() + backwardPassTimer_.getExpectedIntervalInMilliseconds() +
+         computeControllerTimer_.getExpectedIntervalInMilliseconds() + searchStrategyTimer_.getExpectedIntervalInMilliseconds() +
+         totalDualSolutionTimer_.getExpectedIntervalInMilliseconds();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+namespace {
+bool isWithinConstraintTolerance(const PerformanceIndex& performanceIndex, scalar_t constraintTolerance) {
+  return performanceIndex.equalityConstraintsSSE <= constraintTolerance && performanceIndex.dynamicsViolationSSE <= constraintTolerance;
+}
+
+// the merit is not comparable between iterations since the constraint penalty coefficients are updated
+scalar_t totalCost(const PerformanceIndex& performanceIndex) {
+  return performanceIndex.cost + performanceIndex.equalityLagrangian + performanceIndex.inequalityLagrangian;
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::updateBestFeasibleIterate() {
+  if (!isWithinConstraintTolerance(performanceIndex_, ddpSettings_.constraintTolerance_) ||
+      (hasBestFeasibleIterate_ && totalCost(performanceIndex_) > totalCost(bestFeasiblePerformanceIndex_))) {
+    return;
+  }
+  bestFeasibleDualSolution_ = optimizedDualSolution_;
+  copyPrimalSolution(optimizedPrimalSolution_, bestFeasiblePrimalSolution_);
+  bestFeasibleProblemMetrics_ = optimizedProblemMetrics_;
+  bestFeasiblePerformanceIndex_ = performanceIndex_;
+  hasBestFeasibleIterate_ = true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool GaussNewtonDDP::restoreBestFeasibleIterate() {
+  if (!hasBestFeasibleIterate_ || (isWithinConstraintTolerance(performanceIndex_, ddpSettings_.constraintTolerance_) &&
+                                   totalCost(performanceIndex_) <= totalCost(bestFeasiblePerformanceIndex_))) {
+    return false;
+  }
+  optimizedDualSolution_.swap(bestFeasibleDualSolution_);
+  optimizedPrimalSolution_.swap(bestFeasiblePrimalSolution_);
+  optimizedProblemMetrics_.swap(bestFeasibleProblemMetrics_);
+  performanceIndex_ = bestFeasiblePerformanceIndex_;
+  return true;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctionQuadraticApproximation& finalValueFunction) {
   // pre-allocate memory for dual solution
   const size_t outputN = nominalPrimalData_.primalSolution.timeTrajectory_.size();
-  nominalDualData_.valueFunctionTrajectory.clear();
-  nominalDualData_.valueFunctionTrajectory.resize(outputN);
+  numTrajectoryAllocations_ += resizeTrajectory(outputN, nominalDualData_.valueFunctionTrajectory);
 
   // the last index of the partition is excluded, namely [first, last), so the value function approximation of the end point of the end
   // partition is filled manually.
@@ -525,30 +618,81 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
   // [first1,last1), [first2(last1), last2).
   nominalDualData_.valueFunctionTrajectory.back() = finalValueFunction;
 
-  // solve it sequentially for the first iteration
-  if (totalNumIterations_ == 0) {
-    const std::pair<int, int> partitionInterval{0, outputN - 1};
-    riccatiEquationsWorker(0, partitionInterval, finalValueFunction);
-  } else {  // solve it in parallel
-    // do equal-time partitions based on available thread resource
-    const auto partitionIntervals = computePartitionIntervals(nominalPrimalData_.primalSolution.timeTrajectory_, ddpSettings_.nThreads_);
+  // do equal-time partitions based on available thread resource. The sensitivity propagation of step (1) below does not model the
+  // risk-sensitive terms, therefore the risk-sensitive Riccati equations are always solved in a single sweep.
+  const bool isRiskSensitive = !numerics::almost_eq(ddpSettings_.riskSensitiveCoeff_, 0.0);
+  const int numPartitionThreads = isRiskSensitive ? 1 : static_cast<int>(ddpSettings_.nThreads_);
+  const auto partitionIntervals = computePartitionIntervals(nominalPrimalData_.primalSolution.timeTrajectory_, numPartitionThreads);
+  const int numPartitions = partitionIntervals.size();
 
-    // hold the final value function of each partition
-    std::vector<ScalarFunctionQuadraticApproximation> finalValueFunctionOfEachPartition(partitionIntervals.size());
+  if (numPartitions == 1) {
+    riccatiEquationsWorker(0, partitionIntervals.front(), finalValueFunction);
+
+  } else {
+    /*
+     * The partitions are solved in parallel in three steps:
+     * (1) Each partition is solved for a guess of its final value function, together with its sensitivity to the final value function.
+     *     The last partition is solved for the exact final value function.
+     * (2) From the last partition to the first, the exact final value function of each partition is computed from the one at the start
+     *     of the next partition. This only requires the sensitivities, and no integration.
+     * (3) Each partition, except the last one, is solved again for its exact final value function.
+     */
+    const auto& timeTrajectory = nominalPrimalData_.primalSolution.timeTrajectory_;
+    const auto& stateTrajectory = nominalPrimalData_.primalSolution.stateTrajectory_;
+
+    // hold the final value function of each partition. The value function of the previous iteration is used as the guess.
+    std::vector<ScalarFunctionQuadraticApproximation> finalValueFunctionOfEachPartition(numPartitions);
     finalValueFunctionOfEachPartition.back() = finalValueFunction;
-    for (size_t i = 0; i < partitionIntervals.size() - 1; i++) {
+    for (int i = 0; i < numPartitions - 1; i++) {
       const int startIndexOfNextPartition = partitionIntervals[i + 1].first;
-      const vector_t& xFinalUpdated = nominalPrimalData_.primalSolution.stateTrajectory_[startIndexOfNextPartition];
+      const vector_t& xFinalUpdated = stateTrajectory[startIndexOfNextPartition];
       finalValueFunctionOfEachPartition[i] =
-          getValueFunctionFromCache(nominalPrimalData_.primalSolution.timeTrajectory_[startIndexOfNextPartition], xFinalUpdated);
+          (totalNumIterations_ > 0) ? getValueFunctionFromCache(timeTrajectory[startIndexOfNextPartition], xFinalUpdated)
+                                    : ScalarFunctionQuadraticApproximation::Zero(xFinalUpdated.size());
+    }  // end of loop
+
+    // (1)
+    std::vector<ScalarFunctionQuadraticApproximation> initialValueFunctionOfEachPartition(numPartitions);
+    std::vector<riccati_sensitivity::Data> sensitivityOfEachPartition(numPartitions);
+    nextTaskId_ = 0;
+    auto sensitivityTask = [&]() {
+      const int taskId = nextTaskId_++;  // assign task ID (atomic)
+      if (taskId < numPartitions - 1) {
+        riccatiSensitivityWorker(taskId, partitionIntervals[taskId], finalValueFunctionOfEachPartition[taskId],
+                                 initialValueFunctionOfEachPartition[taskId], sensitivityOfEachPartition[taskId]);
+      } else {
+        riccatiEquationsWorker(taskId, partitionIntervals[taskId], finalValueFunctionOfEachPartition[taskId]);
+      }
+    };
+    runParallel(sensitivityTask, numPartitions);
+
+    // (2) The constant term of the value function is corrected after (3).
+    initialValueFunctionOfEachPartition.back() = nominalDualData_.valueFunctionTrajectory[partitionIntervals.back().first];
+    for (int i = numPartitions - 2; i >= 0; i--) {
+      const auto& nextInitialValueFunction = initialValueFunctionOfEachPartition[i + 1];
+      auto& finalValueFunctionOfPartition = finalValueFunctionOfEachPartition[i];
+      initialValueFunctionOfEachPartition[i] = riccati_sensitivity::correctInitialValueFunction(
+          initialValueFunctionOfEachPartition[i], sensitivityOfEachPartition[i], finalValueFunctionOfPartition, nextInitialValueFunction);
+      finalValueFunctionOfPartition.dfdxx = nextInitialValueFunction.dfdxx;
+      finalValueFunctionOfPartition.dfdx = nextInitialValueFunction.dfdx;
+      finalValueFunctionOfPartition.f = 0.0;
     }  // end of loop
 
+    // (3)
     nextTaskId_ = 0;
     auto task = [this, &partitionIntervals, &finalValueFunctionOfEachPartition]() {
       const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
       riccatiEquationsWorker(taskId, partitionIntervals[taskId], finalValueFunctionOfEachPartition[taskId]);
     };
-    runParallel(task, partitionIntervals.size());
+    runParallel(task, numPartitions - 1);
+
+    // the constant term is additive. Add the one of the next partition, which is already corrected.
+    for (int i = numPartitions - 2; i >= 0; i--) {
+      const scalar_t sFinal = nominalDualData_.valueFunctionTrajectory[partitionIntervals[i].second].f;
+      for (int k = partitionIntervals[i].first; k < partitionIntervals[i].second; k++) {
+        nominalDualData_.valueFunctionTrajectory[k].f += sFinal;
+      }
+    }  // end of loop
   }
 
   // testing the numerical stability of the Riccati equations
@@ -588,11 +732,13 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
 void GaussNewtonDDP::calculateController() {
   const size_t N = nominalPrimalData_.primalSolution.timeTrajectory_.size();
 
-  unoptimizedController_.clear();
-  unoptimizedController_.timeStamp_ = nominalPrimalData_.primalSolution.timeTrajectory_;
-  unoptimizedController_.gainArray_.resize(N);
-  unoptimizedController_.biasArray_.resize(N);
-  unoptimizedController_.deltaBiasArray_.resize(N);
+  // the controller arrays are fully overwritten, therefore they are resized in place to keep their memory
+  numTrajectoryAllocations_ += resizeTrajectory(N, unoptimizedController_.timeStamp_);
+  std::copy(nominalPrimalData_.primalSolution.timeTrajectory_.cbegin(), nominalPrimalData_.primalSolution.timeTrajectory_.cend(),
+            unoptimizedController_.timeStamp_.begin());
+  numTrajectoryAllocations_ += resizeTrajectory(N, unoptimizedController_.gainArray_);
+  numTrajectoryAllocations_ += resizeTrajectory(N, unoptimizedController_.biasArray_);
+  numTrajectoryAllocations_ += resizeTrajectory(N, unoptimizedController_.deltaBiasArray_);
 
   nextTimeIndex_ = 0;
   auto task = [this, N] {
@@ -649,15 +795,30 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
    * compute and augment the LQ approximation of intermediate times
    */
   // perform the LQ approximation for intermediate times
-  approximateIntermediateLQ(nominalDualData_.dualSolution, nominalPrimalData_);
+  if (isPipelinedIntermediateLQValid_) {
+    // already computed together with the dual update of the previous iteration
+    nominalPrimalData_.modelDataTrajectory.swap(pipelinedModelDataTrajectory_);
+    isPipelinedIntermediateLQValid_ = false;
+  } else {
+    approximateIntermediateLQ(nominalDualData_.dualSolution, nominalPrimalData_);
+  }
+
+  // the defects of the multiple-shooting segments are the affine terms of the discrete dynamics
+  if (ddpSettings_.numShootingSegments_ > 1) {
+    const auto& intermediateMetrics = nominalPrimalData_.problemMetrics.intermediates;
+    for (size_t k = 0; k < intermediateMetrics.size(); k++) {
+      if (intermediateMetrics[k].dynamicsViolation.size() > 0) {
+        nominalPrimalData_.modelDataTrajectory[k].dynamicsBias = intermediateMetrics[k].dynamicsViolation;
+      }
+    }
+  }
 
   /*
    * compute and augment the LQ approximation of the event times.
    * also call shiftHessian on the event time's cost 2nd order derivative.
    */
   const size_t NE = nominalPrimalData_.primalSolution.postEventIndices_.size();
-  nominalPrimalData_.modelDataEventTimes.clear();
-  nominalPrimalData_.modelDataEventTimes.resize(NE);
+  numTrajectoryAllocations_ += resizeTrajectory(NE, nominalPrimalData_.modelDataEventTimes);
   if (NE > 0) {
     nextTimeIndex_ = 0;
     nextTaskId_ = 0;
@@ -728,6 +889,81 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<bool> GaussNewtonDDP::reuseIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) {
+  const auto& timeTrajectory = primalData.primalSolution.timeTrajectory_;
+  const auto& stateTrajectory = primalData.primalSolution.stateTrajectory_;
+  const auto& inputTrajectory = primalData.primalSolution.inputTrajectory_;
+  const auto& cachedTimeTrajectory = cachedPrimalData_.primalSolution.timeTrajectory_;
+  const auto& cachedStateTrajectory = cachedPrimalData_.primalSolution.stateTrajectory_;
+  const auto& cachedInputTrajectory = cachedPrimalData_.primalSolution.inputTrajectory_;
+  const auto& cachedMultiplierTrajectory = cachedDualData_.dualSolution.intermediates;
+  auto& modelDataTrajectory = primalData.modelDataTrajectory;
+  auto& cachedModelDataTrajectory = cachedPrimalData_.modelDataTrajectory;
+  const size_t N = timeTrajectory.size();
+
+  std::vector<bool> recomputeFlags(N, true);
+  numIntermediateLQNodes_ += N;
+
+  const size_t cachedN = cachedTimeTrajectory.size();
+  const bool isReusable = ddpSettings_.incrementalLQApproximation_ && isCachedIntermediateLQValid_ && &primalData != &cachedPrimalData_ &&
+                          cachedModelDataTrajectory.size() == cachedN && cachedMultiplierTrajectory.size() == cachedN &&
+                          dualSolution.intermediates.size() == N &&
+                          cachedPrimalData_.primalSolution.postEventIndices_.size() == primalData.primalSolution.postEventIndices_.size();
+  if (!isReusable) {
+    numTrajectoryAllocations_ += resizeTrajectory(N, modelDataTrajectory);
+    numRecomputedIntermediateLQNodes_ += N;
+    return recomputeFlags;
+  }
+
+  numTrajectoryAllocations_ += resizeTrajectory(N, modelDataTrajectory);
+  const scalar_t tol = ddpSettings_.incrementalLQApproximationTolerance_;
+  vector_t deltaState, deltaInput;
+  size_t cachedIndex = 0;
+  for (size_t k = 0; k < N; k++) {
+    // find the cached node with the same time. At an event, the pre- and post-event nodes are matched in order.
+    while (cachedIndex < cachedN && cachedTimeTrajectory[cachedIndex] < timeTrajectory[k] &&
+           !numerics::almost_eq(cachedTimeTrajectory[cachedIndex], timeTrajectory[k])) {
+      cachedIndex++;
+    }
+    if (cachedIndex == cachedN) {
+      break;
+    }
+    if (!numerics::almost_eq(cachedTimeTrajectory[cachedIndex], timeTrajectory[k])) {
+      continue;
+    }
+    const size_t j = cachedIndex++;
+
+    // ILQR discretizes the LQ approximation with the time step to the next node
+    const bool isSameTimeStep = (k + 1 == N) ? (j + 1 == cachedN)
+                                             : (j + 1 < cachedN && numerics::almost_eq(timeTrajectory[k + 1], cachedTimeTrajectory[j + 1]));
+    if (!isSameTimeStep || stateTrajectory[k].size() != cachedStateTrajectory[j].size() ||
+        inputTrajectory[k].size() != cachedInputTrajectory[j].size()) {
+      continue;
+    }
+
+    deltaState = stateTrajectory[k] - cachedStateTrajectory[j];
+    deltaInput = inputTrajectory[k] - cachedInputTrajectory[j];
+    if (deltaState.lpNorm<Eigen::Infinity>() <= tol && (deltaInput.size() == 0 || deltaInput.lpNorm<Eigen::Infinity>() <= tol) &&
+        isMultiplierCollectionNear(dualSolution.intermediates[k], cachedMultiplierTrajectory[j], tol)) {
+      // the cached model data is not used after this point, therefore it is moved rather than copied
+      std::swap(modelDataTrajectory[k], cachedModelDataTrajectory[j]);
+      updateIntermediateLQ(deltaState, deltaInput, modelDataTrajectory[k]);
+      recomputeFlags[k] = false;
+    }
+  }  // end of k loop
+
+  const auto numRecomputed = std::count(recomputeFlags.cbegin(), recomputeFlags.cend(), true);
+  numRecomputedIntermediateLQNodes_ += numRecomputed;
+  if (ddpSettings_.displayInfo_) {
+    std::cerr << "Incremental LQ approximation recomputes " << numRecomputed << " out of " << N << " intermediate nodes.\n";
+  }
+
+  return recomputeFlags;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -742,7 +978,11 @@ void GaussNewtonDDP::computeProjectionAndRiccatiModification(const ModelData& mo
                      riccatiModification.constraintRangeProjector_, riccatiModification.constraintNullProjector_);
 
   // project LQ
-  projectLQ(modelData, riccatiModification.constraintRangeProjector_, riccatiModification.constraintNullProjector_, projectedModelData);
+  if (!ddpSettings_.useFixedSizeRiccatiKernels_ ||
+      !fixed_size_lq::projectLQ(modelData, riccatiModification.constraintRangeProjector_, riccatiModification.constraintNullProjector_,
+                                projectedModelData)) {
+    projectLQ(modelData, riccatiModification.constraintRangeProjector_, riccatiModification.constraintNullProjector_, projectedModelData);
+  }
 
   // compute deltaQm, deltaGv, deltaGm
   searchStrategyPtr_->computeRiccatiModification(projectedModelData, riccatiModification.deltaQm_, riccatiModification.deltaGv_,
@@ -831,8 +1071,8 @@ void GaussNewtonDDP::updateConstraintPenalties(scalar_t equalityConstraintsSSE)
 /******************************************************************************************************/
 bool GaussNewtonDDP::initializePrimalSolution() {
   try {
-    // clear before starting to fill
-    nominalPrimalData_.clear();
+    // clear before starting to fill. The model data is kept as preallocated memory for the LQ approximation.
+    nominalPrimalData_.clearRetainingModelData();
 
     // for non-StateTriggeredRollout case, set modeSchedule
     nominalPrimalData_.primalSolution.modeSchedule_ = getReferenceManager().getModeSchedule();
@@ -871,9 +1111,11 @@ bool GaussNewtonDDP::initializePrimalSolution() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::initializeDualSolutionAndMetrics() {
-  // adjust dual solution
+  // adjust dual solution (a dual solution on the same fixed time grid is used as is)
   totalDualSolutionTimer_.startTimer();
-  if (!optimizedDualSolution_.timeTrajectory.empty()) {
+  const auto& primalSolution = nominalPrimalData_.primalSolution;
+  if (!optimizedDualSolution_.timeTrajectory.empty() &&
+      !isDefinedOnTimeGrid(optimizedDualSolution_, primalSolution.timeTrajectory_, primalSolution.postEventIndices_)) {
     const auto status =
         trajectorySpread(optimizedPrimalSolution_.modeSchedule_, nominalPrimalData_.primalSolution.modeSchedule_, optimizedDualSolution_);
   }
@@ -900,9 +1142,10 @@ void GaussNewtonDDP::initializeDualSolutionAndMetrics() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void GaussNewtonDDP::takePrimalDualStep(scalar_t lqModelExpectedCost) {
+bool GaussNewtonDDP::takePrimalDualStep(scalar_t lqModelExpectedCost) {
   // update primal: run search strategy and find the optimal stepLength
   searchStrategyTimer_.startTimer();
+  isPipelinedIntermediateLQValid_ = false;  // set by the settled solution task of the search strategy
   scalar_t avgTimeStep;
   const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
   search_strategy::SolutionRef solution(avgTimeStep, optimizedDualSolution_, optimizedPrimalSolution_, optimizedProblemMetrics_,
@@ -915,10 +1158,19 @@ void GaussNewtonDDP::takePrimalDualStep(scalar_t lqModelExpectedCost) {
   }
   searchStrategyTimer_.endTimer();
 
-  // update dual
+  // update dual, unless it is already updated with the pipelined LQ approximation
   totalDualSolutionTimer_.startTimer();
-  if (success) {
+  isPipelinedIntermediateLQValid_ = isPipelinedIntermediateLQValid_ && success;
+  if (isPipelinedIntermediateLQValid_) {
+    // finish the nodes which the workers of the search have not taken
+    if (!isEventMultiplierUpdateClaimed_ || nextTimeIndex_ < optimizedPrimalSolution_.timeTrajectory_.size()) {
+      nextTaskId_ = 0;
+      runParallel([this]() { updateDualSolutionAndIntermediateLQWorker(nextTaskId_++); }, ddpSettings_.nThreads_);
+    }
+  } else if (success) {
     ocs2::updateDualSolution(optimalControlProblemStock_[0], optimizedPrimalSolution_, optimizedProblemMetrics_, optimizedDualSolution_);
+  }
+  if (success) {
     performanceIndex_ = computeRolloutPerformanceIndex(optimizedPrimalSolution_.timeTrajectory_, optimizedProblemMetrics_);
     performanceIndex_.merit = calculateRolloutMerit(performanceIndex_);
   }
@@ -927,10 +1179,121 @@ void GaussNewtonDDP::takePrimalDualStep(scalar_t lqModelExpectedCost) {
   // if failed, use nominal and to keep the consistency of cached data, all cache should be left untouched
   if (!success) {
     optimizedDualSolution_ = nominalDualData_.dualSolution;
-    optimizedPrimalSolution_ = nominalPrimalData_.primalSolution;
+    copyPrimalSolution(nominalPrimalData_.primalSolution, optimizedPrimalSolution_);
     optimizedProblemMetrics_ = nominalPrimalData_.problemMetrics;
     performanceIndex_ = performanceIndexHistory_.back();
   }
+
+  return success;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::initializeDualSolutionAndIntermediateLQUpdate() {
+  const size_t N = optimizedPrimalSolution_.timeTrajectory_.size();
+  numTrajectoryAllocations_ += resizeTrajectory(N, pipelinedModelDataTrajectory_);
+  numIntermediateLQNodes_ += N;
+  numRecomputedIntermediateLQNodes_ += N;
+  nextTimeIndex_ = 0;
+  isEventMultiplierUpdateClaimed_ = false;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::updateDualSolutionAndIntermediateLQWorker(size_t taskId) {
+  const auto& primalSolution = optimizedPrimalSolution_;
+  const size_t N = primalSolution.timeTrajectory_.size();
+  auto& problem = optimalControlProblemStock_[taskId];
+
+  // the final and pre-jump multipliers are updated by the first worker while the others start with the intermediate nodes
+  if (!isEventMultiplierUpdateClaimed_.exchange(true)) {
+    if (N > 0) {
+      updateFinalMultiplierCollection(problem, primalSolution.timeTrajectory_.back(), primalSolution.stateTrajectory_.back(),
+                                      optimizedProblemMetrics_.final, optimizedDualSolution_.final);
+    }
+    for (size_t i = 0; i < primalSolution.postEventIndices_.size(); i++) {
+      const auto timeIndex = primalSolution.postEventIndices_[i] - 1;
+      updatePreJumpMultiplierCollection(problem, primalSolution.timeTrajectory_[timeIndex], primalSolution.stateTrajectory_[timeIndex],
+                                        optimizedProblemMetrics_.preJumps[i], optimizedDualSolution_.preJumps[i]);
+    }
+  }
+
+  size_t timeIndex;
+  while ((timeIndex = nextTimeIndex_++) < N) {
+    auto& multipliers = optimizedDualSolution_.intermediates[timeIndex];
+    updateIntermediateMultiplierCollection(problem, primalSolution.timeTrajectory_[timeIndex], primalSolution.stateTrajectory_[timeIndex],
+                                           primalSolution.inputTrajectory_[timeIndex], optimizedProblemMetrics_.intermediates[timeIndex],
+                                           multipliers);
+    approximateIntermediateLQWorker(taskId, timeIndex, primalSolution, multipliers, pipelinedModelDataTrajectory_[timeIndex]);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::initializeShootingNodes() {
+  shootingNodes_.times.clear();
+  shootingNodes_.nominalStates.clear();
+  shootingNodes_.stateIncrements.clear();
+
+  const auto& eventTimes = nominalPrimalData_.primalSolution.modeSchedule_.eventTimes;
+  const size_t numSegments = ddpSettings_.numShootingSegments_;
+  const scalar_t segmentLength = (finalTime_ - initTime_) / static_cast<scalar_t>(numSegments);
+  for (size_t s = 1; s < numSegments; s++) {
+    const scalar_t time = initTime_ + s * segmentLength;
+    const bool isCloseToEvent =
+        std::any_of(eventTimes.cbegin(), eventTimes.cend(), [&](scalar_t te) { return std::abs(te - time) < ddpSettings_.timeStep_; });
+    if (!isCloseToEvent) {
+      shootingNodes_.times.push_back(time);
+    }
+  }  // end of s loop
+
+  shootingNodes_.nominalStates.resize(shootingNodes_.times.size());
+  shootingNodes_.stateIncrements.resize(shootingNodes_.times.size());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::updateShootingNodes() {
+  const auto& timeTrajectory = nominalPrimalData_.primalSolution.timeTrajectory_;
+  const auto& stateTrajectory = nominalPrimalData_.primalSolution.stateTrajectory_;
+  const auto& postEventIndices = nominalPrimalData_.primalSolution.postEventIndices_;
+  const size_t N = timeTrajectory.size();
+
+  // linear forward pass: dx_{k+1} = Am * dx_k + Bm * (deltaBias_k + K_k * dx_k) + Hv
+  numTrajectoryAllocations_ += resizeTrajectory(N, stateIncrementTrajectory_);
+  stateIncrementTrajectory_.front().setZero(initState_.size());
+  vector_t inputIncrement;
+  auto nextEventItr = postEventIndices.cbegin();
+  for (size_t k = 0; k + 1 < N; k++) {
+    const auto& curStateIncrement = stateIncrementTrajectory_[k];
+    auto& nextStateIncrement = stateIncrementTrajectory_[k + 1];
+    if (nextEventItr != postEventIndices.cend() && *nextEventItr == k + 1) {
+      // jump from the pre-event to the post-event node
+      const auto& jumpModelData = nominalPrimalData_.modelDataEventTimes[std::distance(postEventIndices.cbegin(), nextEventItr)];
+      nextStateIncrement = jumpModelData.dynamicsBias;
+      nextStateIncrement.noalias() += jumpModelData.dynamics.dfdx * curStateIncrement;
+      ++nextEventItr;
+    } else {
+      const auto& modelData = nominalPrimalData_.modelDataTrajectory[k];
+      inputIncrement = unoptimizedController_.deltaBiasArray_[k];
+      inputIncrement.noalias() += unoptimizedController_.gainArray_[k] * curStateIncrement;
+      nextStateIncrement = modelData.dynamicsBias;
+      nextStateIncrement.noalias() += modelData.dynamics.dfdx * curStateIncrement;
+      nextStateIncrement.noalias() += modelData.dynamics.dfdu * inputIncrement;
+    }
+  }  // end of k loop
+
+  // the rollout of a segment starts slightly after the shooting time (see RolloutBase::findActiveModesTimeInterval)
+  constexpr auto eps = numeric_traits::weakEpsilon<scalar_t>();
+  for (size_t s = 0; s < shootingNodes_.times.size(); s++) {
+    const auto indexAlpha = LinearInterpolation::timeSegment(shootingNodes_.times[s] + eps, timeTrajectory);
+    shootingNodes_.nominalStates[s] = LinearInterpolation::interpolate(indexAlpha, stateTrajectory);
+    shootingNodes_.stateIncrements[s] = LinearInterpolation::interpolate(indexAlpha, stateIncrementTrajectory_);
+  }  // end of s loop
 }
 
 /******************************************************************************************************/
@@ -1009,6 +1372,10 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
   // swap primal and dual data to cache
   nominalDualData_.swap(cachedDualData_);
   nominalPrimalData_.swap(cachedPrimalData_);
+  // the cached LQ approximation might belong to a different reference or mode schedule
+  isCachedIntermediateLQValid_ = false;
+  isPipelinedIntermediateLQValid_ = false;
+  isNominalLQValid_ = false;
 
   // optimized --> nominal: initializes the nominal primal and dual solutions based on the optimized ones
   initializationTimer_.startTimer();
@@ -1017,6 +1384,9 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
   performanceIndexHistory_.push_back(performanceIndex_);
   initializationTimer_.endTimer();
 
+  // the initial solution is a single-shooting rollout which has no defects
+  initializeShootingNodes();
+
   // display
   if (ddpSettings_.displayInfo_) {
     std::cerr << performanceIndex_ << '\n';
@@ -1024,8 +1394,27 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 
   // convergence variables of the main loop
   bool isConverged = false;
+  bool isTimeBudgetExhausted = false;
   std::string convergenceInfo;
 
+  // pipelined iteration: once the search has settled on a solution, the next iteration is certain if the solution has not converged
+  // and neither the maximum number of iterations nor the time budget is reached. Only then, its dual update and LQ approximation
+  // start on the workers of the search while the remaining trials are aborted.
+  if (ddpSettings_.pipelinedIteration_ && !ddpSettings_.incrementalLQApproximation_) {
+    auto isNextIterationCertain = [&](const PerformanceIndex& settledPerformanceIndex) {
+      const bool isLastIteration = (totalNumIterations_ + 1 - initIteration) >= ddpSettings_.maxNumIterations_;
+      if (isLastIteration || !fitsInTimeBudget(getExpectedIterationDurationInMilliseconds()) ||
+          searchStrategyPtr_->checkConvergence(!initialSolutionExists, performanceIndexHistory_.back(), settledPerformanceIndex).first) {
+        return false;
+      }
+      initializeDualSolutionAndIntermediateLQUpdate();
+      isPipelinedIntermediateLQValid_ = true;
+      return true;
+    };
+    searchStrategyPtr_->setSettledSolutionTask(isNextIterationCertain,
+                                               [this](size_t workerIndex) { updateDualSolutionAndIntermediateLQWorker(workerIndex); });
+  }
+
   // DDP main loop
   while (true) {
     if (ddpSettings_.displayInfo_) {
@@ -1036,28 +1425,51 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 
     // nominal --> nominal: constructs the LQ problem around the nominal trajectories
     linearQuadraticApproximationTimer_.startTimer();
-    approximateOptimalControlProblem();
+    if (!isNominalLQValid_) {
+      approximateOptimalControlProblem();
+    }
+    isCachedIntermediateLQValid_ = true;
     linearQuadraticApproximationTimer_.endTimer();
 
-    // nominal --> nominal: solves the LQ problem
-    backwardPassTimer_.startTimer();
-    avgTimeStepBP_ = solveSequentialRiccatiEquations(nominalPrimalData_.modelDataFinalTime.cost);
-    backwardPassTimer_.endTimer();
+    // A rejected trial is retried on the same LQ approximation with the Riccati modification which the search strategy has adapted.
+    // Therefore, the backward pass of a trial is only computed after the previous trial is rejected.
+    bool isStepAccepted = false;
+    const size_t maxNumTrials = searchStrategyPtr_->getMaxNumTrials();
+    for (size_t trialIndex = 0; trialIndex < maxNumTrials && !isStepAccepted; trialIndex++) {
+      // a retry should not overrun the time budget
+      const auto expectedTrialDuration = backwardPassTimer_.getExpectedIntervalInMilliseconds() +
+                                         computeControllerTimer_.getExpectedIntervalInMilliseconds() +
+                                         searchStrategyTimer_.getExpectedIntervalInMilliseconds();
+      if (trialIndex > 0 && !fitsInTimeBudget(expectedTrialDuration)) {
+        break;
+      }
+
+      // nominal --> nominal: solves the LQ problem
+      backwardPassTimer_.startTimer();
+      avgTimeStepBP_ = solveSequentialRiccatiEquations(nominalPrimalData_.modelDataFinalTime.cost);
+      backwardPassTimer_.endTimer();
 
-    // calculate controller and store the result in unoptimizedController_
-    computeControllerTimer_.startTimer();
-    calculateController();
-    computeControllerTimer_.endTimer();
+      // calculate controller and store the result in unoptimizedController_
+      computeControllerTimer_.startTimer();
+      calculateController();
+      if (!shootingNodes_.times.empty()) {
+        updateShootingNodes();
+      }
+      computeControllerTimer_.endTimer();
 
-    // the expected cost/merit calculated by the Riccati solution is not reliable
-    const auto lqModelExpectedCost = initialSolutionExists ? nominalDualData_.valueFunctionTrajectory.front().f : performanceIndex_.merit;
+      // the expected cost/merit calculated by the Riccati solution is not reliable
+      const auto lqModelExpectedCost = initialSolutionExists ? nominalDualData_.valueFunctionTrajectory.front().f : performanceIndex_.merit;
 
-    // nominal --> optimized: based on the current LQ solution updates the optimized primal and dual solutions
-    takePrimalDualStep(lqModelExpectedCost);
+      // nominal --> optimized: based on the current LQ solution updates the optimized primal and dual solutions
+      isStepAccepted = takePrimalDualStep(lqModelExpectedCost);
+    }  // end of trialIndex loop
 
     // iteration info
     ++totalNumIterations_;
     performanceIndexHistory_.push_back(performanceIndex_);
+    if (getTimeBudget() > 0.0) {
+      updateBestFeasibleIterate();
+    }
 
     // display
     if (ddpSettings_.displayInfo_) {
@@ -1069,22 +1481,36 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
         !initialSolutionExists, *std::prev(performanceIndexHistory_.end(), 2), performanceIndexHistory_.back());
     initialSolutionExists = true;
 
-    if (isConverged || (totalNumIterations_ - initIteration) == ddpSettings_.maxNumIterations_) {
+    // the next iteration should not overrun the time budget. The pipelined iteration has already committed to the next iteration.
+    isTimeBudgetExhausted = !isPipelinedIntermediateLQValid_ && !fitsInTimeBudget(getExpectedIterationDurationInMilliseconds());
+
+    if (isConverged || (totalNumIterations_ - initIteration) == ddpSettings_.maxNumIterations_ || isTimeBudgetExhausted) {
       break;
 
     } else {
       // update the constraint penalty coefficients
-      updateConstraintPenalties(performanceIndex_.equalityConstraintsSSE);
-
-      // optimized --> nominal: use the optimized solution as the nominal for the next iteration
-      nominalDualData_.swap(cachedDualData_);
-      nominalPrimalData_.swap(cachedPrimalData_);
-      optimizedDualSolution_.swap(nominalDualData_.dualSolution);
-      optimizedPrimalSolution_.swap(nominalPrimalData_.primalSolution);
-      optimizedProblemMetrics_.swap(nominalPrimalData_.problemMetrics);
+      updateConstraintPenalties(performanceIndex_.equalityConstraintsSSE + performanceIndex_.dynamicsViolationSSE);
+
+      // optimized --> nominal: use the optimized solution as the nominal for the next iteration. A rejected step keeps the nominal
+      // solution, therefore its LQ approximation is reused by the next iteration.
+      if (isStepAccepted) {
+        nominalDualData_.swap(cachedDualData_);
+        nominalPrimalData_.swap(cachedPrimalData_);
+        optimizedDualSolution_.swap(nominalDualData_.dualSolution);
+        optimizedPrimalSolution_.swap(nominalPrimalData_.primalSolution);
+        optimizedProblemMetrics_.swap(nominalPrimalData_.problemMetrics);
+      }
+      isNominalLQValid_ = !isStepAccepted;
     }
   }  // end of while loop
 
+  // the settled solution task refers to the local variables of this run
+  searchStrategyPtr_->setSettledSolutionTask(nullptr, nullptr);
+
+  // an exhausted time budget might have stopped at an iterate which is infeasible or worse than an earlier one
+  const bool isBestFeasibleIterateRestored = isTimeBudgetExhausted && restoreBestFeasibleIterate();
+  hasBestFeasibleIterate_ = false;
+
   // display
   if (ddpSettings_.displayInfo_ || ddpSettings_.displayShortSummary_) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
@@ -1100,6 +1526,12 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
     } else if (totalNumIterations_ - initIteration == ddpSettings_.maxNumIterations_) {
       std::cerr << "The algorithm has terminated as: \n";
       std::cerr << "    * The maximum number of iterations (i.e., " << ddpSettings_.maxNumIterations_ << ") has reached." << std::endl;
+    } else if (isTimeBudgetExhausted) {
+      std::cerr << "The algorithm has terminated as: \n";
+      std::cerr << "    * The next iteration does not fit into the time budget (i.e., " << getTimeBudget() << " [s])." << std::endl;
+      if (isBestFeasibleIterateRestored) {
+        std::cerr << "    * The best feasible iterate (i.e., total cost " << totalCost(performanceIndex_) << ") is returned." << std::endl;
+      }
     } else {
       std::cerr << "The algorithm has terminated for an unknown reason!" << std::endl;
     }
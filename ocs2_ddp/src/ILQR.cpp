@@ -28,6 +28,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include "ocs2_ddp/ILQR.h"
+
+#include <ocs2_ddp/FixedSizeLQKernels.h>
 #include <ocs2_ddp/riccati_equations/RiccatiTransversalityConditions.h>
 
 namespace ocs2 {
@@ -44,21 +46,22 @@ ILQR::ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalC
   }
 
   // dynamics discretizer
-  sensitivityDiscretizer_ = [&]() {
+  sensitivityIntegratorType_ = [&]() {
     switch (settings().backwardPassIntegratorType_) {
       case IntegratorType::EULER:
-        return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::EULER);
+        return SensitivityIntegratorType::EULER;
       case IntegratorType::RK4:
-        return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+        return SensitivityIntegratorType::RK4;
       case IntegratorType::ODE45:
-        return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+        return SensitivityIntegratorType::RK4;
       case IntegratorType::ODE45_OCS2:
-        return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+        return SensitivityIntegratorType::RK4;
       default:
         throw std::runtime_error("[ILQR] Integrator of type " + integrator_type::toString(settings().backwardPassIntegratorType_) +
                                  " is not supported for sensitivity discretization! Modify ddp::Settings::backwardPassIntegratorType_.");
     }
   }();
+  sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(sensitivityIntegratorType_);
 
   // Riccati solver
   riccatiEquationsPtrStock_.clear();
@@ -66,10 +69,13 @@ ILQR::ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalC
   for (size_t i = 0; i < settings().nThreads_; i++) {
     const bool isRiskSensitive = !numerics::almost_eq(settings().riskSensitiveCoeff_, 0.0);
     const bool preComputeRiccatiTerms = settings().preComputeRiccatiTerms_ && (settings().strategy_ == search_strategy::Type::LINE_SEARCH);
-    riccatiEquationsPtrStock_.emplace_back(new DiscreteTimeRiccatiEquations(preComputeRiccatiTerms, isRiskSensitive));
+    riccatiEquationsPtrStock_.emplace_back(
+        new DiscreteTimeRiccatiEquations(preComputeRiccatiTerms, isRiskSensitive, settings().useFixedSizeRiccatiKernels_));
     riccatiEquationsPtrStock_.back()->setRiskSensitiveCoefficient(settings().riskSensitiveCoeff_);
   }  // end of i loop
 
+  continuousTimeModelDataStock_.resize(settings().nThreads_);
+
   Eigen::initParallel();
 }
 
@@ -77,53 +83,21 @@ ILQR::ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalC
 /******************************************************************************************************/
 /******************************************************************************************************/
 void ILQR::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) {
-  // create alias
-  const auto& timeTrajectory = primalData.primalSolution.timeTrajectory_;
-  const auto& stateTrajectory = primalData.primalSolution.stateTrajectory_;
-  const auto& inputTrajectory = primalData.primalSolution.inputTrajectory_;
-  const auto& postEventIndices = primalData.primalSolution.postEventIndices_;
-  const auto& multiplierTrajectory = dualSolution.intermediates;
-  auto& modelDataTrajectory = primalData.modelDataTrajectory;
-
-  modelDataTrajectory.clear();
-  modelDataTrajectory.resize(timeTrajectory.size());
+  // resizes modelDataTrajectory and reuses the unchanged nodes of the previous iteration if it is active
+  const auto recomputeFlags = reuseIntermediateLQ(dualSolution, primalData);
 
+  const size_t N = primalData.primalSolution.timeTrajectory_.size();
   nextTimeIndex_ = 0;
   nextTaskId_ = 0;
   auto task = [&]() {
-    size_t taskId = nextTaskId_++;  // assign task ID (atomic)
-
-    ModelData continuousTimeModelData;
+    const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
 
     // get next time index is atomic
     size_t timeIndex;
-    while ((timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
-      // approximate continuous LQ for the given time index
-      ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
-                                      inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], continuousTimeModelData);
-
-      // checking the numerical properties
-      if (settings().checkNumericalStability_) {
-        const auto errSize = checkSize(continuousTimeModelData, stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
-        if (!errSize.empty()) {
-          throw std::runtime_error("[ILQR::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errSize);
-        }
-        const auto errProperties = checkDynamicsProperties(continuousTimeModelData) + checkCostProperties(continuousTimeModelData) +
-                                   checkConstraintProperties(continuousTimeModelData);
-        if (!errProperties.empty()) {
-          throw std::runtime_error("[ILQR::approximateIntermediateLQ] Ill-posed problem at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errProperties);
-        }
-      }
-
-      // discretize LQ problem
-      const scalar_t timeStep = (timeIndex + 1 < timeTrajectory.size()) ? (timeTrajectory[timeIndex + 1] - timeTrajectory[timeIndex]) : 0.0;
-      if (!numerics::almost_eq(timeStep, 0.0)) {
-        discreteLQWorker(*optimalControlProblemStock_[taskId].dynamicsPtr, timeTrajectory[timeIndex], stateTrajectory[timeIndex],
-                         inputTrajectory[timeIndex], timeStep, continuousTimeModelData, modelDataTrajectory[timeIndex]);
-      } else {
-        modelDataTrajectory[timeIndex] = continuousTimeModelData;
+    while ((timeIndex = nextTimeIndex_++) < N) {
+      if (recomputeFlags[timeIndex]) {
+        approximateIntermediateLQWorker(taskId, timeIndex, primalData.primalSolution, dualSolution.intermediates[timeIndex],
+                                        primalData.modelDataTrajectory[timeIndex]);
       }
     }
   };
@@ -131,6 +105,45 @@ void ILQR::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDat
   runParallel(task, settings().nThreads_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ILQR::approximateIntermediateLQWorker(size_t workerIndex, size_t timeIndex, const PrimalSolution& primalSolution,
+                                           const MultiplierCollection& multipliers, ModelData& modelData) {
+  const auto& timeTrajectory = primalSolution.timeTrajectory_;
+  const auto& state = primalSolution.stateTrajectory_[timeIndex];
+  const auto& input = primalSolution.inputTrajectory_[timeIndex];
+  auto& continuousTimeModelData = continuousTimeModelDataStock_[workerIndex];
+
+  // approximate continuous LQ for the given time index
+  ocs2::approximateIntermediateLQ(optimalControlProblemStock_[workerIndex], timeTrajectory[timeIndex], state, input, multipliers,
+                                  continuousTimeModelData);
+
+  // checking the numerical properties
+  if (settings().checkNumericalStability_) {
+    const auto errSize = checkSize(continuousTimeModelData, state.rows(), input.rows());
+    if (!errSize.empty()) {
+      throw std::runtime_error("[ILQR::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
+                               std::to_string(timeTrajectory[timeIndex]) + "\n" + errSize);
+    }
+    const auto errProperties = checkDynamicsProperties(continuousTimeModelData) + checkCostProperties(continuousTimeModelData) +
+                               checkConstraintProperties(continuousTimeModelData);
+    if (!errProperties.empty()) {
+      throw std::runtime_error("[ILQR::approximateIntermediateLQ] Ill-posed problem at intermediate time: " +
+                               std::to_string(timeTrajectory[timeIndex]) + "\n" + errProperties);
+    }
+  }
+
+  // discretize LQ problem
+  const scalar_t timeStep = (timeIndex + 1 < timeTrajectory.size()) ? (timeTrajectory[timeIndex + 1] - timeTrajectory[timeIndex]) : 0.0;
+  if (!numerics::almost_eq(timeStep, 0.0)) {
+    discreteLQWorker(*optimalControlProblemStock_[workerIndex].dynamicsPtr, timeTrajectory[timeIndex], state, input, timeStep,
+                     continuousTimeModelData, modelData);
+  } else {
+    modelData = continuousTimeModelData;
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -142,7 +155,10 @@ void ILQR::discreteLQWorker(SystemDynamicsBase& system, scalar_t time, const vec
 
   // linearize system dynamics
   modelData.dynamicsBias.setZero(modelData.stateDim);
-  modelData.dynamics = sensitivityDiscretizer_(system, time, state, input, timeStep);
+  if (!settings().useFixedSizeRiccatiKernels_ ||
+      !fixed_size_lq::sensitivityDiscretization(sensitivityIntegratorType_, system, time, state, input, timeStep, modelData.dynamics)) {
+    modelData.dynamics = sensitivityDiscretizer_(system, time, state, input, timeStep);
+  }
   modelData.dynamics.f.setZero(modelData.stateDim);
 
   // quadratic approximation to the cost function
@@ -188,8 +204,8 @@ scalar_t ILQR::solveSequentialRiccatiEquations(const ScalarFunctionQuadraticAppr
   projectedLvTrajectoryStock_.resize(N);
   projectedKmTrajectoryStock_.resize(N);
 
-  nominalDualData_.riccatiModificationTrajectory.resize(N);
-  nominalDualData_.projectedModelDataTrajectory.resize(N);
+  numTrajectoryAllocations_ += resizeTrajectory(N, nominalDualData_.riccatiModificationTrajectory);
+  numTrajectoryAllocations_ += resizeTrajectory(N, nominalDualData_.projectedModelDataTrajectory);
 
   const auto& finalModelData = nominalPrimalData_.modelDataTrajectory.back();
   auto& finalRiccatiModification = nominalDualData_.riccatiModificationTrajectory.back();
@@ -297,4 +313,55 @@ void ILQR::riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>&
     --curIndex;
   }  // while
 }
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ILQR::riccatiSensitivityWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
+                                    const ScalarFunctionQuadraticApproximation& finalValueFunction,
+                                    ScalarFunctionQuadraticApproximation& initialValueFunction, riccati_sensitivity::Data& sensitivity) {
+  riccatiEquationsWorker(workerIndex, partitionInterval, finalValueFunction);
+  initialValueFunction = nominalDualData_.valueFunctionTrajectory[partitionInterval.first];
+
+  // find all events belonging to the current partition
+  const auto& postEventIndices = nominalPrimalData_.primalSolution.postEventIndices_;
+  const auto firstEventItr = std::upper_bound(postEventIndices.begin(), postEventIndices.end(), partitionInterval.first);
+  const auto lastEventItr = std::upper_bound(postEventIndices.begin(), postEventIndices.end(), partitionInterval.second);
+
+  /*
+   * Propagates the sensitivity backwards along the same steps as riccatiEquationsWorker. With a perturbation lambda of the final value
+   * function gradient, the closed-loop dynamics read: x_{k+1} = (Am + Bm * Km) * x_k + Bm * (Lv - Bm^T * M_{k+1} * lambda) + Hv
+   */
+  sensitivity = riccati_sensitivity::Data::Identity(finalValueFunction.dfdx.size());
+  matrix_t projectedBmTransM;
+
+  int curIndex = partitionInterval.second - 1;
+  auto nextEventItr = lastEventItr - 1;
+  const int stopIndex = partitionInterval.first;
+  while (curIndex >= stopIndex) {
+    const auto& curProjectedModelData = nominalDualData_.projectedModelDataTrajectory[curIndex];
+    projectedBmTransM.noalias() = curProjectedModelData.dynamics.dfdu.transpose() * sensitivity.M;
+
+    sensitivity.N.noalias() -= projectedBmTransM.transpose() * projectedBmTransM;
+    sensitivity.n.noalias() += sensitivity.M.transpose() * curProjectedModelData.dynamicsBias;
+    sensitivity.n.noalias() += projectedBmTransM.transpose() * projectedLvTrajectoryStock_[curIndex];
+    sensitivity.M = (curProjectedModelData.dynamics.dfdx.transpose() * sensitivity.M).eval();
+    sensitivity.M.noalias() += projectedKmTrajectoryStock_[curIndex].transpose() * projectedBmTransM;
+
+    if (std::distance(firstEventItr, nextEventItr) >= 0 && curIndex == static_cast<int>(*nextEventItr)) {
+      // move to pre-event index: x_postEvent = Am * x_preEvent + Hv
+      --curIndex;
+
+      const int index = std::distance(postEventIndices.begin(), nextEventItr);
+      const auto& jumpModelData = nominalPrimalData_.modelDataEventTimes[index];
+      sensitivity.n.noalias() += sensitivity.M.transpose() * jumpModelData.dynamicsBias;
+      sensitivity.M = (jumpModelData.dynamics.dfdx.transpose() * sensitivity.M).eval();
+
+      --nextEventItr;
+    }
+
+    --curIndex;
+  }  // while
+}
+
 }  // namespace ocs2
@@ -60,13 +60,20 @@ SLQ::SLQ(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalCon
     throw(std::runtime_error("Unsupported Riccati equation integrator type: " +
                              integrator_type::toString(settings().backwardPassIntegratorType_)));
   }
+  if (settings().useFixedStepRiccatiIntegrator_ && !numerics::almost_eq(settings().riskSensitiveCoeff_, 0.0)) {
+    throw std::runtime_error("[SLQ] The fixed-step Riccati integrator does not support the risk-sensitive variant!");
+  }
 
   for (size_t i = 0; i < settings().nThreads_; i++) {
     bool preComputeRiccatiTerms = settings().preComputeRiccatiTerms_ && (settings().strategy_ == search_strategy::Type::LINE_SEARCH);
     bool isRiskSensitive = !numerics::almost_eq(settings().riskSensitiveCoeff_, 0.0);
-    riccatiEquationsPtrStock_.emplace_back(new ContinuousTimeRiccatiEquations(preComputeRiccatiTerms, isRiskSensitive));
+    riccatiEquationsPtrStock_.emplace_back(
+        new ContinuousTimeRiccatiEquations(preComputeRiccatiTerms, isRiskSensitive, settings().useFixedSizeRiccatiKernels_));
     riccatiEquationsPtrStock_.back()->setRiskSensitiveCoefficient(settings().riskSensitiveCoeff_);
     riccatiIntegratorPtrStock_.emplace_back(newIntegrator(integratorType));
+    if (settings().useFixedStepRiccatiIntegrator_) {
+      fixedStepRiccatiIntegratorPtrStock_.emplace_back(new FixedStepRiccatiIntegrator(preComputeRiccatiTerms));
+    }
   }  // end of i loop
 
   Eigen::initParallel();
@@ -76,17 +83,10 @@ SLQ::SLQ(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalCon
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SLQ::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) {
-  // create alias
-  const auto& timeTrajectory = primalData.primalSolution.timeTrajectory_;
-  const auto& stateTrajectory = primalData.primalSolution.stateTrajectory_;
-  const auto& inputTrajectory = primalData.primalSolution.inputTrajectory_;
-  const auto& postEventIndices = primalData.primalSolution.postEventIndices_;
-  const auto& multiplierTrajectory = dualSolution.intermediates;
-  auto& modelDataTrajectory = primalData.modelDataTrajectory;
-
-  modelDataTrajectory.clear();
-  modelDataTrajectory.resize(timeTrajectory.size());
+  // resizes modelDataTrajectory and reuses the unchanged nodes of the previous iteration if it is active
+  const auto recomputeFlags = reuseIntermediateLQ(dualSolution, primalData);
 
+  const size_t N = primalData.primalSolution.timeTrajectory_.size();
   nextTimeIndex_ = 0;
   nextTaskId_ = 0;
   auto task = [&]() {
@@ -94,26 +94,10 @@ void SLQ::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalData
 
     // get next time index is atomic
     size_t timeIndex;
-    while ((timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
-      // approximate LQ for the given time index
-      ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
-                                      inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], modelDataTrajectory[timeIndex]);
-
-      // checking the numerical properties
-      if (settings().checkNumericalStability_) {
-        const auto errSize =
-            checkSize(modelDataTrajectory[timeIndex], stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
-        if (!errSize.empty()) {
-          throw std::runtime_error("[SLQ::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errSize);
-        }
-        const std::string errProperties = checkDynamicsProperties(modelDataTrajectory[timeIndex]) +
-                                          checkCostProperties(modelDataTrajectory[timeIndex]) +
-                                          checkConstraintProperties(modelDataTrajectory[timeIndex]);
-        if (!errProperties.empty()) {
-          throw std::runtime_error("[SLQ::approximateIntermediateLQ] Ill-posed problem at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errProperties);
-        }
+    while ((timeIndex = nextTimeIndex_++) < N) {
+      if (recomputeFlags[timeIndex]) {
+        approximateIntermediateLQWorker(taskId, timeIndex, primalData.primalSolution, dualSolution.intermediates[timeIndex],
+                                        primalData.modelDataTrajectory[timeIndex]);
       }
     }  // end of while loop
   };
@@ -121,6 +105,34 @@ void SLQ::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalData
   runParallel(task, settings().nThreads_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SLQ::approximateIntermediateLQWorker(size_t workerIndex, size_t timeIndex, const PrimalSolution& primalSolution,
+                                          const MultiplierCollection& multipliers, ModelData& modelData) {
+  const auto& time = primalSolution.timeTrajectory_[timeIndex];
+  const auto& state = primalSolution.stateTrajectory_[timeIndex];
+  const auto& input = primalSolution.inputTrajectory_[timeIndex];
+
+  // approximate LQ for the given time index
+  ocs2::approximateIntermediateLQ(optimalControlProblemStock_[workerIndex], time, state, input, multipliers, modelData);
+
+  // checking the numerical properties
+  if (settings().checkNumericalStability_) {
+    const auto errSize = checkSize(modelData, state.rows(), input.rows());
+    if (!errSize.empty()) {
+      throw std::runtime_error("[SLQ::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " + std::to_string(time) +
+                               "\n" + errSize);
+    }
+    const std::string errProperties =
+        checkDynamicsProperties(modelData) + checkCostProperties(modelData) + checkConstraintProperties(modelData);
+    if (!errProperties.empty()) {
+      throw std::runtime_error("[SLQ::approximateIntermediateLQ] Ill-posed problem at intermediate time: " + std::to_string(time) + "\n" +
+                               errProperties);
+    }
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -176,8 +188,8 @@ scalar_t SLQ::solveSequentialRiccatiEquations(const ScalarFunctionQuadraticAppro
   // number of the intermediate LQ variables
   const size_t N = nominalPrimalData_.primalSolution.timeTrajectory_.size();
 
-  nominalDualData_.riccatiModificationTrajectory.resize(N);
-  nominalDualData_.projectedModelDataTrajectory.resize(N);
+  numTrajectoryAllocations_ += resizeTrajectory(N, nominalDualData_.riccatiModificationTrajectory);
+  numTrajectoryAllocations_ += resizeTrajectory(N, nominalDualData_.projectedModelDataTrajectory);
 
   if (N > 0) {
     // perform the computeRiccatiModificationTerms for partition i
@@ -212,6 +224,15 @@ matrix_t SLQ::computeHamiltonianHessian(const ModelData& modelData, const matrix
 /******************************************************************************************************/
 void SLQ::riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
                                  const ScalarFunctionQuadraticApproximation& finalValueFunction) {
+  if (settings().useFixedStepRiccatiIntegrator_) {
+    auto& riccatiIntegrator = *fixedStepRiccatiIntegratorPtrStock_[workerIndex];
+    riccatiIntegrator.setData(&(nominalPrimalData_.primalSolution.timeTrajectory_), &(nominalDualData_.projectedModelDataTrajectory),
+                              &(nominalPrimalData_.primalSolution.postEventIndices_), &(nominalPrimalData_.modelDataEventTimes),
+                              &(nominalDualData_.riccatiModificationTrajectory));
+    riccatiIntegrator.integrate(partitionInterval, settings().timeStep_, finalValueFunction, nominalDualData_.valueFunctionTrajectory);
+    return;
+  }
+
   // set data for Riccati equations
   riccatiEquationsPtrStock_[workerIndex]->resetNumFunctionCalls();
   riccatiEquationsPtrStock_[workerIndex]->setData(
@@ -250,6 +271,43 @@ void SLQ::riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>&
   }  // end of k loop
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SLQ::riccatiSensitivityWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
+                                   const ScalarFunctionQuadraticApproximation& finalValueFunction,
+                                   ScalarFunctionQuadraticApproximation& initialValueFunction, riccati_sensitivity::Data& sensitivity) {
+  if (settings().useFixedStepRiccatiIntegrator_) {
+    auto& riccatiIntegrator = *fixedStepRiccatiIntegratorPtrStock_[workerIndex];
+    riccatiIntegrator.setData(&(nominalPrimalData_.primalSolution.timeTrajectory_), &(nominalDualData_.projectedModelDataTrajectory),
+                              &(nominalPrimalData_.primalSolution.postEventIndices_), &(nominalPrimalData_.modelDataEventTimes),
+                              &(nominalDualData_.riccatiModificationTrajectory));
+    riccatiIntegrator.integrate(partitionInterval, settings().timeStep_, finalValueFunction, initialValueFunction, sensitivity);
+    return;
+  }
+
+  // set data for Riccati equations, with the terminal sensitivity
+  riccatiEquationsPtrStock_[workerIndex]->resetNumFunctionCalls();
+  riccatiEquationsPtrStock_[workerIndex]->setData(
+      &(nominalPrimalData_.primalSolution.timeTrajectory_), &(nominalDualData_.projectedModelDataTrajectory),
+      &(nominalPrimalData_.primalSolution.postEventIndices_), &(nominalPrimalData_.modelDataEventTimes),
+      &(nominalDualData_.riccatiModificationTrajectory), true);
+
+  // the sensitivity is the identity at the end of the partition
+  const auto finalSensitivity = riccati_sensitivity::Data::Identity(finalValueFunction.dfdx.size());
+  vector_t allSsFinal = ContinuousTimeRiccatiEquations::convert2Vector(finalValueFunction, finalSensitivity);
+
+  vector_array_t& allSsTrajectory = allSsTrajectoryStock_[workerIndex];
+  integrateRiccatiEquationNominalTime(*riccatiIntegratorPtrStock_[workerIndex], *riccatiEquationsPtrStock_[workerIndex], partitionInterval,
+                                      nominalPrimalData_.primalSolution.timeTrajectory_,
+                                      nominalPrimalData_.primalSolution.postEventIndices_, std::move(allSsFinal),
+                                      SsNormalizedTimeTrajectoryStock_[workerIndex], SsNormalizedEventsPastTheEndIndecesStock_[workerIndex],
+                                      allSsTrajectory);
+
+  // the Riccati equations are solved backwards in time, the last element is the start of the partition
+  ContinuousTimeRiccatiEquations::convert2Matrix(allSsTrajectory.back(), initialValueFunction, sensitivity);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -27,10 +27,13 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  ******************************************************************************/
 
+#include <cmath>
+
 #include <ocs2_core/misc/Lookup.h>
 #include <ocs2_core/model_data/ModelDataLinearInterpolation.h>
 
 #include <ocs2_ddp/riccati_equations/ContinuousTimeRiccatiEquations.h>
+#include <ocs2_ddp/riccati_equations/FixedSizeRiccatiEquations.h>
 #include <ocs2_ddp/riccati_equations/RiccatiModificationInterpolation.h>
 #include <ocs2_ddp/riccati_equations/RiccatiTransversalityConditions.h>
 
@@ -39,8 +42,8 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-ContinuousTimeRiccatiEquations::ContinuousTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive)
-    : reducedFormRiccati_(reducedFormRiccati), isRiskSensitive_(isRiskSensitive) {}
+ContinuousTimeRiccatiEquations::ContinuousTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive, bool useFixedSizeKernels)
+    : reducedFormRiccati_(reducedFormRiccati), isRiskSensitive_(isRiskSensitive), useFixedSizeKernels_(useFixedSizeKernels) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -107,14 +110,60 @@ void ContinuousTimeRiccatiEquations::convert2Matrix(const vector_t& allSs, matri
   s = allSs.template tail<1>()(0);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t ContinuousTimeRiccatiEquations::convert2Vector(const matrix_t& Sm, const vector_t& Sv, const scalar_t& s,
+                                                        const riccati_sensitivity::Data& sensitivity) {
+  const int state_dim = Sm.cols();
+  assert(sensitivity.M.rows() == state_dim && sensitivity.M.cols() == state_dim);
+  assert(sensitivity.N.rows() == state_dim && sensitivity.N.cols() == state_dim);
+  assert(sensitivity.n.rows() == state_dim);
+
+  vector_t allSs(s_vector_dim(state_dim) + sensitivity_vector_dim(state_dim));
+  allSs.head(s_vector_dim(state_dim)) = convert2Vector(Sm, Sv, s);
+
+  /* add M, N and n column-wise */
+  scalar_t* dataPtr = allSs.data() + s_vector_dim(state_dim);
+  Eigen::Map<matrix_t>(dataPtr, state_dim, state_dim) = sensitivity.M;
+  dataPtr += state_dim * state_dim;
+  Eigen::Map<matrix_t>(dataPtr, state_dim, state_dim) = sensitivity.N;
+  dataPtr += state_dim * state_dim;
+  Eigen::Map<vector_t>(dataPtr, state_dim) = sensitivity.n;
+
+  return allSs;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ContinuousTimeRiccatiEquations::convert2Matrix(const vector_t& allSs, matrix_t& Sm, vector_t& Sv, scalar_t& s,
+                                                    riccati_sensitivity::Data& sensitivity) {
+  /* Inverse of s_vector_dim(n) + sensitivity_vector_dim(n) = 2.5 * n^2 + 2.5 * n + 1 */
+  const int state_dim = static_cast<int>(std::lround((std::sqrt(40.0 * allSs.size() - 15.0) - 5.0) / 10.0));
+  assert(state_dim > 0);
+  assert(allSs.size() == s_vector_dim(state_dim) + sensitivity_vector_dim(state_dim));
+
+  convert2Matrix(allSs.head(s_vector_dim(state_dim)), Sm, Sv, s);
+
+  const scalar_t* dataPtr = allSs.data() + s_vector_dim(state_dim);
+  sensitivity.M = Eigen::Map<const matrix_t>(dataPtr, state_dim, state_dim);
+  dataPtr += state_dim * state_dim;
+  sensitivity.N = Eigen::Map<const matrix_t>(dataPtr, state_dim, state_dim);
+  dataPtr += state_dim * state_dim;
+  sensitivity.n = Eigen::Map<const vector_t>(dataPtr, state_dim);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void ContinuousTimeRiccatiEquations::setData(const scalar_array_t* timeStampPtr, const std::vector<ModelData>* projectedModelDataPtr,
                                              const size_array_t* eventsPastTheEndIndecesPtr,
                                              const std::vector<ModelData>* modelDataEventTimesPtr,
-                                             const std::vector<riccati_modification::Data>* riccatiModificationPtr) {
+                                             const std::vector<riccati_modification::Data>* riccatiModificationPtr,
+                                             bool computeTerminalSensitivity) {
   OdeBase::resetNumFunctionCalls();
+  computeTerminalSensitivity_ = computeTerminalSensitivity;
 
   // saving array pointers
   timeStampPtr_ = timeStampPtr;
@@ -133,17 +182,31 @@ void ContinuousTimeRiccatiEquations::setData(const scalar_array_t* timeStampPtr,
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t ContinuousTimeRiccatiEquations::computeJumpMap(scalar_t z, const vector_t& allSs) {
+  auto& sensitivity = continuousTimeRiccatiData_.sensitivity_;
+
   // convert to Riccati coefficients
-  convert2Matrix(allSs, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_);
+  if (computeTerminalSensitivity_) {
+    convert2Matrix(allSs, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_, sensitivity);
+  } else {
+    convert2Matrix(allSs, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_);
+  }
 
   // epsilon is set to include times past event times which have been artificially increased in the rollout
   const auto time = -z;
   const auto index = lookup::findFirstIndexWithinTol(eventTimes_, time, 1e-5);
+  const auto& jumpModelData = (*modelDataEventTimesPtr_)[index];
 
-  const auto SsPreEvent = riccatiTransversalityConditions((*modelDataEventTimesPtr_)[index], continuousTimeRiccatiData_.Sm_,
-                                                          continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_);
+  const auto SsPreEvent = riccatiTransversalityConditions(jumpModelData, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_,
+                                                          continuousTimeRiccatiData_.s_);
 
-  return convert2Vector(std::get<0>(SsPreEvent), std::get<1>(SsPreEvent), std::get<2>(SsPreEvent));
+  if (computeTerminalSensitivity_) {
+    // x_postEvent = Am * x_preEvent + Hv
+    sensitivity.n.noalias() += sensitivity.M.transpose() * jumpModelData.dynamicsBias;
+    sensitivity.M = (jumpModelData.dynamics.dfdx.transpose() * sensitivity.M).eval();
+    return convert2Vector(std::get<0>(SsPreEvent), std::get<1>(SsPreEvent), std::get<2>(SsPreEvent), sensitivity);
+  } else {
+    return convert2Vector(std::get<0>(SsPreEvent), std::get<1>(SsPreEvent), std::get<2>(SsPreEvent));
+  }
 }
 
 /******************************************************************************************************/
@@ -154,18 +217,35 @@ vector_t ContinuousTimeRiccatiEquations::computeFlowMap(scalar_t z, const vector
   const scalar_t t = -z;  // denormalized time
   const auto indexAlpha = LinearInterpolation::timeSegment(t, *timeStampPtr_);
 
-  convert2Matrix(allSs, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_);
+  if (computeTerminalSensitivity_) {
+    convert2Matrix(allSs, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_,
+                   continuousTimeRiccatiData_.sensitivity_);
+  } else {
+    convert2Matrix(allSs, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_);
+  }
   if (isRiskSensitive_) {
     computeFlowMapILEG(indexAlpha, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_,
                        continuousTimeRiccatiData_, continuousTimeRiccatiData_.dSm_, continuousTimeRiccatiData_.dSv_,
                        continuousTimeRiccatiData_.ds_);
-  } else {
+  } else if (computeTerminalSensitivity_ || !useFixedSizeKernels_ ||
+             !fixed_size_riccati::computeFlowMapSLQ(reducedFormRiccati_, indexAlpha, *projectedModelDataPtr_, *riccatiModificationPtr_,
+                                                    continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_,
+                                                    continuousTimeRiccatiData_.dSm_, continuousTimeRiccatiData_.dSv_,
+                                                    continuousTimeRiccatiData_.ds_)) {
+    // the terminal sensitivity reuses the intermediate results of the dynamic-size flow map
     computeFlowMapSLQ(indexAlpha, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_,
                       continuousTimeRiccatiData_, continuousTimeRiccatiData_.dSm_, continuousTimeRiccatiData_.dSv_,
                       continuousTimeRiccatiData_.ds_);
   }
 
-  return convert2Vector(continuousTimeRiccatiData_.dSm_, continuousTimeRiccatiData_.dSv_, continuousTimeRiccatiData_.ds_);
+  if (computeTerminalSensitivity_) {
+    computeSensitivityFlowMap(continuousTimeRiccatiData_.sensitivity_, continuousTimeRiccatiData_,
+                              continuousTimeRiccatiData_.dSensitivity_);
+    return convert2Vector(continuousTimeRiccatiData_.dSm_, continuousTimeRiccatiData_.dSv_, continuousTimeRiccatiData_.ds_,
+                          continuousTimeRiccatiData_.dSensitivity_);
+  } else {
+    return convert2Vector(continuousTimeRiccatiData_.dSm_, continuousTimeRiccatiData_.dSv_, continuousTimeRiccatiData_.ds_);
+  }
 }
 
 /******************************************************************************************************/
@@ -310,4 +390,30 @@ void ContinuousTimeRiccatiEquations::computeFlowMapILEG(std::pair<int, scalar_t>
   ds += 0.5 * creCache.Sigma_Sm_.trace() + 0.5 * riskSensitiveCoeff_ * Sv.dot(creCache.Sigma_Sv_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ContinuousTimeRiccatiEquations::computeSensitivityFlowMap(const riccati_sensitivity::Data& sensitivity,
+                                                               ContinuousTimeRiccatiData& creCache,
+                                                               riccati_sensitivity::Data& dSensitivity) const {
+  /*
+   * With a perturbation lambda of the final value function gradient, the closed-loop dynamics read
+   * dx/dt = (Am + Bm * Km) * x + Bm * (Lv - Bm^T * M * lambda) + Hv
+   * The derivatives below are with respect to the normalized time, i.e. -t.
+   */
+  // Bm^T * M [COMPLEXITY: nx^2 * np]
+  creCache.projectedBm_T_M_.noalias() = creCache.projectedBm_.transpose() * sensitivity.M;
+
+  // dM = (Am + Bm * Km)^T * M [COMPLEXITY: nx^3 + nx^2 * np]
+  dSensitivity.M.noalias() = creCache.projectedAm_.transpose() * sensitivity.M;
+  dSensitivity.M.noalias() += creCache.projectedKm_.transpose() * creCache.projectedBm_T_M_;
+
+  // dN = -M^T * Bm * Bm^T * M [COMPLEXITY: nx^2 * np]
+  dSensitivity.N.noalias() = -creCache.projectedBm_T_M_.transpose() * creCache.projectedBm_T_M_;
+
+  // dn = M^T * (Bm * Lv + Hv) [COMPLEXITY: nx^2 + nx * np]
+  dSensitivity.n.noalias() = sensitivity.M.transpose() * creCache.projectedHv_;
+  dSensitivity.n.noalias() += creCache.projectedBm_T_M_.transpose() * creCache.projectedLv_;
+}
+
 }  // namespace ocs2
@@ -29,13 +29,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_ddp/riccati_equations/DiscreteTimeRiccatiEquations.h>
 
+#include <ocs2_ddp/riccati_equations/FixedSizeRiccatiEquations.h>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-DiscreteTimeRiccatiEquations::DiscreteTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive)
-    : reducedFormRiccati_(reducedFormRiccati), isRiskSensitive_(isRiskSensitive) {}
+DiscreteTimeRiccatiEquations::DiscreteTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive, bool useFixedSizeKernels)
+    : reducedFormRiccati_(reducedFormRiccati), isRiskSensitive_(isRiskSensitive), useFixedSizeKernels_(useFixedSizeKernels) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -53,7 +55,8 @@ void DiscreteTimeRiccatiEquations::computeMap(const ModelData& projectedModelDat
   if (isRiskSensitive_) {
     computeMapILEG(projectedModelData, riccatiModification, SmNext, SvNext, sNext, discreteTimeRiccatiData_, projectedKm, projectedLv, Sm,
                    Sv, s);
-  } else {
+  } else if (!useFixedSizeKernels_ || !fixed_size_riccati::computeMapILQR(reducedFormRiccati_, projectedModelData, riccatiModification,
+                                                                          SmNext, SvNext, sNext, projectedKm, projectedLv, Sm, Sv, s)) {
     computeMapILQR(projectedModelData, riccatiModification, SmNext, SvNext, sNext, discreteTimeRiccatiData_, projectedKm, projectedLv, Sm,
                    Sv, s);
   }
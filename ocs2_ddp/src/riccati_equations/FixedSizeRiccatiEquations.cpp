@@ -0,0 +1,296 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include "ocs2_ddp/riccati_equations/FixedSizeRiccatiEquations.h"
+
+namespace ocs2 {
+namespace fixed_size_riccati {
+
+namespace {
+
+/**
+ * The ILQR Riccati step of DiscreteTimeRiccatiEquations::computeMapILQR with a compile-time state dimension and an input dimension
+ * bounded by MAX_INPUT_DIM. The dynamic-size data is mapped without copying.
+ */
+template <int STATE_DIM, int MAX_INPUT_DIM>
+void computeMapILQRImpl(bool reducedFormRiccati, const ModelData& projectedModelData,
+                        const riccati_modification::Data& riccatiModification, const matrix_t& SmNext, const vector_t& SvNext,
+                        scalar_t sNext, matrix_t& projectedKm, vector_t& projectedLv, matrix_t& Sm, vector_t& Sv, scalar_t& s) {
+  using state_matrix_t = Eigen::Matrix<scalar_t, STATE_DIM, STATE_DIM>;
+  using state_vector_t = Eigen::Matrix<scalar_t, STATE_DIM, 1>;
+  using state_input_matrix_t = Eigen::Matrix<scalar_t, STATE_DIM, Eigen::Dynamic, Eigen::ColMajor, STATE_DIM, MAX_INPUT_DIM>;
+  using input_state_matrix_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, STATE_DIM, Eigen::ColMajor, MAX_INPUT_DIM, STATE_DIM>;
+  using input_matrix_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor, MAX_INPUT_DIM, MAX_INPUT_DIM>;
+  using input_vector_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, 1, Eigen::ColMajor, MAX_INPUT_DIM, 1>;
+  using state_input_map_t = Eigen::Matrix<scalar_t, STATE_DIM, Eigen::Dynamic>;
+  using input_state_map_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, STATE_DIM>;
+
+  const auto inputDim = projectedModelData.dynamics.dfdu.cols();
+  const Eigen::Map<const state_matrix_t> SmNextMap(SmNext.data());
+  const Eigen::Map<const state_vector_t> SvNextMap(SvNext.data());
+  const Eigen::Map<const state_matrix_t> Am(projectedModelData.dynamics.dfdx.data());
+  const Eigen::Map<const state_input_map_t> Bm(projectedModelData.dynamics.dfdu.data(), STATE_DIM, inputDim);
+  const Eigen::Map<const state_vector_t> Hv(projectedModelData.dynamicsBias.data());
+  const Eigen::Map<const state_matrix_t> Qm(projectedModelData.cost.dfdxx.data());
+  const Eigen::Map<const state_vector_t> Qv(projectedModelData.cost.dfdx.data());
+  const Eigen::Map<const input_state_map_t> Pm(projectedModelData.cost.dfdux.data(), inputDim, STATE_DIM);
+  const Eigen::Map<const state_matrix_t> deltaQm(riccatiModification.deltaQm_.data());
+  const Eigen::Map<const input_state_map_t> deltaGm(riccatiModification.deltaGm_.data(), inputDim, STATE_DIM);
+
+  // precomputation (1)
+  const state_vector_t Sm_projectedHv = SmNextMap * Hv;
+  const state_matrix_t Sm_projectedAm = SmNextMap * Am;
+  const state_vector_t Sv_plus_Sm_projectedHv = SvNextMap + Sm_projectedHv;
+
+  // projectedGm = projectedPm + projectedBm^T * Sm * projectedAm
+  input_state_matrix_t projectedGm = Pm;
+  projectedGm.noalias() += Bm.transpose() * Sm_projectedAm;
+
+  // projectedGv = projectedRv + projectedBm^T * (Sv + Sm * projectedHv)
+  input_vector_t projectedGv = projectedModelData.cost.dfdu;
+  projectedGv.noalias() += Bm.transpose() * Sv_plus_Sm_projectedHv;
+
+  // projected feedback and feedforward
+  projectedKm.resize(inputDim, STATE_DIM);
+  projectedLv.resize(inputDim);
+  Eigen::Map<input_state_map_t> Km(projectedKm.data(), inputDim, STATE_DIM);
+  Km = -projectedGm - deltaGm;
+  projectedLv = -projectedGv - riccatiModification.deltaGv_;
+
+  // precomputation (2)
+  const state_matrix_t projectedKm_T_projectedGm = Km.transpose() * projectedGm;
+  input_state_matrix_t projectedHm_projectedKm;
+  input_vector_t projectedHm_projectedLv;
+  if (!reducedFormRiccati) {
+    const state_input_matrix_t Sm_projectedBm = SmNextMap * Bm;
+    input_matrix_t projectedHm = projectedModelData.cost.dfduu;
+    projectedHm.noalias() += Sm_projectedBm.transpose() * Bm;
+    projectedHm_projectedKm.noalias() = projectedHm * Km;
+    projectedHm_projectedLv.noalias() = projectedHm * projectedLv;
+  }
+
+  // Sm
+  Sm.resize(STATE_DIM, STATE_DIM);
+  Eigen::Map<state_matrix_t> SmMap(Sm.data());
+  SmMap = Qm + deltaQm;
+  SmMap.noalias() += Sm_projectedAm.transpose() * Am;
+  if (reducedFormRiccati) {
+    SmMap += projectedKm_T_projectedGm;
+  } else {
+    SmMap += projectedKm_T_projectedGm + projectedKm_T_projectedGm.transpose();
+    SmMap.noalias() += Km.transpose() * projectedHm_projectedKm;
+  }
+
+  // Sv
+  Sv.resize(STATE_DIM);
+  Eigen::Map<state_vector_t> SvMap(Sv.data());
+  SvMap = Qv;
+  SvMap.noalias() += Am.transpose() * Sv_plus_Sm_projectedHv;
+  SvMap.noalias() += projectedGm.transpose() * projectedLv;
+  if (!reducedFormRiccati) {
+    SvMap.noalias() += Km.transpose() * projectedGv;
+    SvMap.noalias() += projectedHm_projectedKm.transpose() * projectedLv;
+  }
+
+  // s
+  s = sNext + projectedModelData.cost.f;
+  s += Hv.dot(Sv_plus_Sm_projectedHv);
+  s -= 0.5 * Hv.dot(Sm_projectedHv);
+  if (reducedFormRiccati) {
+    s += 0.5 * projectedLv.dot(projectedGv);
+  } else {
+    s += projectedLv.dot(projectedGv);
+    s += 0.5 * projectedLv.dot(projectedHm_projectedLv);
+  }
+}
+
+/**
+ * The flow map of ContinuousTimeRiccatiEquations::computeFlowMapSLQ with a compile-time state dimension and an input dimension bounded
+ * by MAX_INPUT_DIM. The interpolation of the model data is carried out on the fixed-size types.
+ */
+template <int STATE_DIM, int MAX_INPUT_DIM>
+void computeFlowMapSLQImpl(bool reducedFormRiccati, std::pair<int, scalar_t> indexAlpha,
+                           const std::vector<ModelData>& projectedModelDataTrajectory,
+                           const std::vector<riccati_modification::Data>& riccatiModificationTrajectory, const matrix_t& Sm,
+                           const vector_t& Sv, matrix_t& dSm, vector_t& dSv, scalar_t& ds) {
+  using state_matrix_t = Eigen::Matrix<scalar_t, STATE_DIM, STATE_DIM>;
+  using state_vector_t = Eigen::Matrix<scalar_t, STATE_DIM, 1>;
+  using state_input_matrix_t = Eigen::Matrix<scalar_t, STATE_DIM, Eigen::Dynamic, Eigen::ColMajor, STATE_DIM, MAX_INPUT_DIM>;
+  using input_state_matrix_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, STATE_DIM, Eigen::ColMajor, MAX_INPUT_DIM, STATE_DIM>;
+  using input_matrix_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor, MAX_INPUT_DIM, MAX_INPUT_DIM>;
+  using input_vector_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, 1, Eigen::ColMajor, MAX_INPUT_DIM, 1>;
+
+  // the same interpolation as LinearInterpolation::interpolate, the caller has checked that the sizes match
+  const bool isSingleNode = projectedModelDataTrajectory.size() == 1;
+  const size_t lhsIndex = isSingleNode ? 0 : indexAlpha.first;
+  const size_t rhsIndex = isSingleNode ? 0 : indexAlpha.first + 1;
+  const scalar_t alpha = isSingleNode ? 1.0 : indexAlpha.second;
+  const auto& lhs = projectedModelDataTrajectory[lhsIndex];
+  const auto& rhs = projectedModelDataTrajectory[rhsIndex];
+  const auto& lhsModification = riccatiModificationTrajectory[lhsIndex];
+  const auto& rhsModification = riccatiModificationTrajectory[rhsIndex];
+
+  const state_vector_t Hv = alpha * lhs.dynamicsBias + (1.0 - alpha) * rhs.dynamicsBias;
+  const state_matrix_t Am = alpha * lhs.dynamics.dfdx + (1.0 - alpha) * rhs.dynamics.dfdx;
+  const state_input_matrix_t Bm = alpha * lhs.dynamics.dfdu + (1.0 - alpha) * rhs.dynamics.dfdu;
+  const state_matrix_t deltaQm = alpha * lhsModification.deltaQm_ + (1.0 - alpha) * rhsModification.deltaQm_;
+  const Eigen::Map<const state_matrix_t> SmMap(Sm.data());
+  const Eigen::Map<const state_vector_t> SvMap(Sv.data());
+
+  // projectedGm = projectedPm + projectedBm^T * Sm
+  input_state_matrix_t projectedGm = alpha * lhs.cost.dfdux + (1.0 - alpha) * rhs.cost.dfdux;
+  projectedGm.noalias() += Bm.transpose() * SmMap;
+
+  // projectedGv = projectedRv + projectedBm^T * Sv
+  input_vector_t projectedGv = alpha * lhs.cost.dfdu + (1.0 - alpha) * rhs.cost.dfdu;
+  projectedGv.noalias() += Bm.transpose() * SvMap;
+
+  // projected feedback and feedforward
+  const input_state_matrix_t projectedKm = -projectedGm - alpha * lhsModification.deltaGm_ - (1.0 - alpha) * rhsModification.deltaGm_;
+  const input_vector_t projectedLv = -projectedGv - alpha * lhsModification.deltaGv_ - (1.0 - alpha) * rhsModification.deltaGv_;
+
+  // precomputation
+  const state_matrix_t SmTrans_projectedAm = SmMap.transpose() * Am;
+  const state_matrix_t projectedKm_T_projectedGm = projectedKm.transpose() * projectedGm;
+  input_state_matrix_t projectedRm_projectedKm;
+  input_vector_t projectedRm_projectedLv;
+  if (!reducedFormRiccati) {
+    const input_matrix_t projectedRm = alpha * lhs.cost.dfduu + (1.0 - alpha) * rhs.cost.dfduu;
+    projectedRm_projectedKm.noalias() = projectedRm * projectedKm;
+    projectedRm_projectedLv.noalias() = projectedRm * projectedLv;
+  }
+
+  // dSm
+  state_matrix_t dSmFixed = alpha * lhs.cost.dfdxx + (1.0 - alpha) * rhs.cost.dfdxx;
+  dSmFixed += deltaQm + SmTrans_projectedAm + SmTrans_projectedAm.transpose();
+  if (reducedFormRiccati) {
+    dSmFixed += projectedKm_T_projectedGm;
+  } else {
+    dSmFixed += projectedKm_T_projectedGm + projectedKm_T_projectedGm.transpose();
+    dSmFixed.noalias() += projectedKm.transpose() * projectedRm_projectedKm;
+  }
+  dSm = dSmFixed;
+
+  // dSv
+  state_vector_t dSvFixed = alpha * lhs.cost.dfdx + (1.0 - alpha) * rhs.cost.dfdx;
+  dSvFixed.noalias() += SmMap.transpose() * Hv;
+  dSvFixed.noalias() += Am.transpose() * SvMap;
+  dSvFixed.noalias() += projectedGm.transpose() * projectedLv;
+  if (!reducedFormRiccati) {
+    dSvFixed.noalias() += projectedKm.transpose() * projectedGv;
+    dSvFixed.noalias() += projectedRm_projectedKm.transpose() * projectedLv;
+  }
+  dSv = dSvFixed;
+
+  // ds
+  ds = alpha * lhs.cost.f + (1.0 - alpha) * rhs.cost.f;
+  ds += Hv.dot(SvMap);
+  if (reducedFormRiccati) {
+    ds += 0.5 * projectedLv.dot(projectedGv);
+  } else {
+    ds += projectedLv.dot(projectedGv);
+    ds += 0.5 * projectedLv.dot(projectedRm_projectedLv);
+  }
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool isSupported(size_t stateDim, size_t projectedInputDim) {
+  switch (stateDim) {
+    case 12:
+      return projectedInputDim <= 4;
+    case 24:
+      return projectedInputDim <= 24;
+    default:
+      return false;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool computeMapILQR(bool reducedFormRiccati, const ModelData& projectedModelData, const riccati_modification::Data& riccatiModification,
+                    const matrix_t& SmNext, const vector_t& SvNext, scalar_t sNext, matrix_t& projectedKm, vector_t& projectedLv,
+                    matrix_t& Sm, vector_t& Sv, scalar_t& s) {
+  const size_t stateDim = projectedModelData.stateDim;
+  const size_t projectedInputDim = projectedModelData.dynamics.dfdu.cols();
+  if (!isSupported(stateDim, projectedInputDim)) {
+    return false;
+  }
+
+  // the instantiations have to match isSupported
+  switch (stateDim) {
+    case 12:
+      computeMapILQRImpl<12, 4>(reducedFormRiccati, projectedModelData, riccatiModification, SmNext, SvNext, sNext, projectedKm,
+                                projectedLv, Sm, Sv, s);
+      break;
+    case 24:
+      computeMapILQRImpl<24, 24>(reducedFormRiccati, projectedModelData, riccatiModification, SmNext, SvNext, sNext, projectedKm,
+                                 projectedLv, Sm, Sv, s);
+      break;
+  }
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool computeFlowMapSLQ(bool reducedFormRiccati, std::pair<int, scalar_t> indexAlpha,
+                       const std::vector<ModelData>& projectedModelDataTrajectory,
+                       const std::vector<riccati_modification::Data>& riccatiModificationTrajectory, const matrix_t& Sm,
+                       const vector_t& Sv, matrix_t& dSm, vector_t& dSv, scalar_t& ds) {
+  const auto& lhs = projectedModelDataTrajectory[projectedModelDataTrajectory.size() == 1 ? 0 : indexAlpha.first];
+  const auto& rhs = projectedModelDataTrajectory[projectedModelDataTrajectory.size() == 1 ? 0 : indexAlpha.first + 1];
+  const size_t stateDim = lhs.stateDim;
+  const size_t projectedInputDim = lhs.dynamics.dfdu.cols();
+  // LinearInterpolation snaps to the closest node if the sizes differ, e.g., at a change of the number of constraints
+  if (!isSupported(stateDim, projectedInputDim) || static_cast<size_t>(rhs.dynamics.dfdu.cols()) != projectedInputDim) {
+    return false;
+  }
+
+  // the instantiations have to match isSupported
+  switch (stateDim) {
+    case 12:
+      computeFlowMapSLQImpl<12, 4>(reducedFormRiccati, indexAlpha, projectedModelDataTrajectory, riccatiModificationTrajectory, Sm, Sv,
+                                   dSm, dSv, ds);
+      break;
+    case 24:
+      computeFlowMapSLQImpl<24, 24>(reducedFormRiccati, indexAlpha, projectedModelDataTrajectory, riccatiModificationTrajectory, Sm, Sv,
+                                    dSm, dSv, ds);
+      break;
+  }
+  return true;
+}
+
+}  // namespace fixed_size_riccati
+}  // namespace ocs2
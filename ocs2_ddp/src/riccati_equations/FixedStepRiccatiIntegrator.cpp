@@ -0,0 +1,370 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ddp/riccati_equations/FixedStepRiccatiIntegrator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ocs2_ddp/riccati_equations/ContinuousTimeRiccatiEquations.h"
+
+namespace ocs2 {
+
+namespace {
+/** Interpolates with weight alpha of x0. Similar to LinearInterpolation, it snaps to the closest data if the sizes are not equal. */
+template <typename Derived>
+void interpolateLinear(scalar_t alpha, const Eigen::MatrixBase<Derived>& x0, const Eigen::MatrixBase<Derived>& x1, Derived& out) {
+  if (alpha == 1.0 || (x0.size() != x1.size() && alpha > 0.5)) {
+    out = x0;
+  } else if (alpha == 0.0 || x0.size() != x1.size()) {
+    out = x1;
+  } else {
+    out = alpha * x0 + (1.0 - alpha) * x1;
+  }
+}
+
+inline void interpolateLinear(scalar_t alpha, scalar_t x0, scalar_t x1, scalar_t& out) {
+  out = alpha * x0 + (1.0 - alpha) * x1;
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FixedStepRiccatiIntegrator::FixedStepRiccatiIntegrator(bool reducedFormRiccati) : reducedFormRiccati_(reducedFormRiccati) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepRiccatiIntegrator::setData(const scalar_array_t* timeStampPtr, const std::vector<ModelData>* projectedModelDataPtr,
+                                         const size_array_t* postEventIndicesPtr, const std::vector<ModelData>* modelDataEventTimesPtr,
+                                         const std::vector<riccati_modification::Data>* riccatiModificationPtr) {
+  numFunctionCalls_ = 0;
+  timeStampPtr_ = timeStampPtr;
+  projectedModelDataPtr_ = projectedModelDataPtr;
+  postEventIndicesPtr_ = postEventIndicesPtr;
+  modelDataEventTimesPtr_ = modelDataEventTimesPtr;
+  riccatiModificationPtr_ = riccatiModificationPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepRiccatiIntegrator::integrate(const std::pair<int, int>& partitionInterval, scalar_t maxTimeStep,
+                                           const ScalarFunctionQuadraticApproximation& finalValueFunction,
+                                           std::vector<ScalarFunctionQuadraticApproximation>& valueFunctionTrajectory) {
+  resize(finalValueFunction.dfdx.size(), false);
+  pack(finalValueFunction.dfdxx, finalValueFunction.dfdx, finalValueFunction.f, y_);
+  integratePartition(partitionInterval, maxTimeStep, &valueFunctionTrajectory);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepRiccatiIntegrator::integrate(const std::pair<int, int>& partitionInterval, scalar_t maxTimeStep,
+                                           const ScalarFunctionQuadraticApproximation& finalValueFunction,
+                                           ScalarFunctionQuadraticApproximation& initialValueFunction,
+                                           riccati_sensitivity::Data& sensitivity) {
+  resize(finalValueFunction.dfdx.size(), true);
+  pack(finalValueFunction.dfdxx, finalValueFunction.dfdx, finalValueFunction.f, y_);
+
+  // the sensitivity is the identity at the end of the partition
+  sensitivity_.M.setIdentity(stateDim_, stateDim_);
+  sensitivity_.N.setZero(stateDim_, stateDim_);
+  sensitivity_.n.setZero(stateDim_);
+  packSensitivity(sensitivity_, y_);
+
+  integratePartition(partitionInterval, maxTimeStep, nullptr);
+
+  unpack(y_, initialValueFunction.dfdxx, initialValueFunction.dfdx, initialValueFunction.f);
+  unpackSensitivity(y_, sensitivity);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepRiccatiIntegrator::resize(int stateDim, bool computeTerminalSensitivity) {
+  stateDim_ = stateDim;
+  computeTerminalSensitivity_ = computeTerminalSensitivity;
+
+  const int packedDim = s_vector_dim(stateDim) + (computeTerminalSensitivity ? sensitivity_vector_dim(stateDim) : 0);
+  y_.resize(packedDim);
+  yStage_.resize(packedDim);
+  k1_.resize(packedDim);
+  k2_.resize(packedDim);
+  k3_.resize(packedDim);
+  k4_.resize(packedDim);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepRiccatiIntegrator::integratePartition(const std::pair<int, int>& partitionInterval, scalar_t maxTimeStep,
+                                                    std::vector<ScalarFunctionQuadraticApproximation>* valueFunctionTrajectoryPtr) {
+  const auto& timeStamp = *timeStampPtr_;
+  const auto& postEventIndices = *postEventIndicesPtr_;
+
+  // the last event which is not after the end of the partition
+  int eventIndex = std::distance(postEventIndices.cbegin(),
+                                 std::upper_bound(postEventIndices.cbegin(), postEventIndices.cend(), partitionInterval.second)) -
+                   1;
+
+  // whether end_ contains the data of node k + 1
+  bool isEndValid = false;
+  for (int k = partitionInterval.second - 1; k >= partitionInterval.first; k--) {
+    if (eventIndex >= 0 && postEventIndices[eventIndex] == static_cast<size_t>(k + 1)) {
+      // nodes k and k + 1 are the pre- and post-event nodes
+      computeJumpMap((*modelDataEventTimesPtr_)[eventIndex], y_);
+      eventIndex--;
+      isEndValid = false;
+
+    } else {
+      const scalar_t dt = timeStamp[k + 1] - timeStamp[k];
+      if (dt > 0.0) {
+        const int numSteps = std::max(1, static_cast<int>(std::ceil(dt / maxTimeStep - 1e-6)));
+        const scalar_t h = dt / numSteps;
+
+        if (!isEndValid) {
+          interpolate(k, 0.0, end_);
+        }
+        for (int i = 0; i < numSteps; i++) {
+          // the end of the previous step is the start of this one
+          std::swap(start_, end_);
+          interpolate(k, (i + 0.5) / numSteps, mid_);
+          interpolate(k, (i + 1.0) / numSteps, end_);
+
+          computeFlowMap(start_, y_, k1_);
+          yStage_ = y_ + (0.5 * h) * k1_;
+          computeFlowMap(mid_, yStage_, k2_);
+          yStage_ = y_ + (0.5 * h) * k2_;
+          computeFlowMap(mid_, yStage_, k3_);
+          yStage_ = y_ + h * k3_;
+          computeFlowMap(end_, yStage_, k4_);
+          y_ += (h / 6.0) * (k1_ + 2.0 * k2_ + 2.0 * k3_ + k4_);
+        }  // end of i loop
+        isEndValid = true;
+      }
+    }
+
+    if (valueFunctionTrajectoryPtr != nullptr) {
+      auto& valueFunction = (*valueFunctionTrajectoryPtr)[k];
+      unpack(y_, valueFunction.dfdxx, valueFunction.dfdx, valueFunction.f);
+    }
+  }  // end of k loop
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepRiccatiIntegrator::interpolate(size_t k, scalar_t alpha, Coefficients& coefficients) const {
+  const auto& modelData0 = (*projectedModelDataPtr_)[k];
+  const auto& modelData1 = (*projectedModelDataPtr_)[k + 1];
+  const auto& modification0 = (*riccatiModificationPtr_)[k];
+  const auto& modification1 = (*riccatiModificationPtr_)[k + 1];
+
+  interpolateLinear(alpha, modelData0.dynamicsBias, modelData1.dynamicsBias, coefficients.Hv);
+  interpolateLinear(alpha, modelData0.dynamics.dfdx, modelData1.dynamics.dfdx, coefficients.Am);
+  interpolateLinear(alpha, modelData0.dynamics.dfdu, modelData1.dynamics.dfdu, coefficients.Bm);
+  interpolateLinear(alpha, modelData0.cost.f, modelData1.cost.f, coefficients.q);
+  interpolateLinear(alpha, modelData0.cost.dfdx, modelData1.cost.dfdx, coefficients.Qv);
+  interpolateLinear(alpha, modelData0.cost.dfdxx, modelData1.cost.dfdxx, coefficients.Qm);
+  interpolateLinear(alpha, modelData0.cost.dfdu, modelData1.cost.dfdu, coefficients.Rv);
+  interpolateLinear(alpha, modelData0.cost.dfdux, modelData1.cost.dfdux, coefficients.Pm);
+  if (!reducedFormRiccati_) {
+    interpolateLinear(alpha, modelData0.cost.dfduu, modelData1.cost.dfduu, coefficients.Rm);
+  }
+  interpolateLinear(alpha, modification0.deltaQm_, modification1.deltaQm_, coefficients.deltaQm);
+  interpolateLinear(alpha, modification0.deltaGm_, modification1.deltaGm_, coefficients.deltaGm);
+  interpolateLinear(alpha, modification0.deltaGv_, modification1.deltaGv_, coefficients.deltaGv);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepRiccatiIntegrator::computeFlowMap(const Coefficients& coefficients, const vector_t& packedState, vector_t& packedDerivative) {
+  numFunctionCalls_++;
+  unpack(packedState, Sm_, Sv_, s_);
+
+  // The same as ContinuousTimeRiccatiEquations::computeFlowMapSLQ
+  ds_ = coefficients.q;
+  dSv_ = coefficients.Qv;
+  dSm_ = coefficients.Qm;
+
+  // projectedGm = projectedPm + projectedBm^T * Sm
+  Gm_ = coefficients.Pm;
+  Gm_.noalias() += coefficients.Bm.transpose() * Sm_;
+  // projectedGv = projectedRv + projectedBm^T * Sv
+  Gv_ = coefficients.Rv;
+  Gv_.noalias() += coefficients.Bm.transpose() * Sv_;
+
+  // projected feedback and feedforward
+  Km_ = -(Gm_ + coefficients.deltaGm);
+  Lv_ = -(Gv_ + coefficients.deltaGv);
+
+  // precomputation
+  SmTrans_Am_.noalias() = Sm_.transpose() * coefficients.Am;
+  Km_T_Gm_.noalias() = Km_.transpose() * Gm_;
+  if (!reducedFormRiccati_) {
+    Rm_Km_.noalias() = coefficients.Rm * Km_;
+    Rm_Lv_.noalias() = coefficients.Rm * Lv_;
+  }
+
+  // Sm
+  dSm_ += coefficients.deltaQm + SmTrans_Am_ + SmTrans_Am_.transpose();
+  if (reducedFormRiccati_) {
+    dSm_ += Km_T_Gm_;
+  } else {
+    dSm_ += Km_T_Gm_ + Km_T_Gm_.transpose();
+    dSm_.noalias() += Km_.transpose() * Rm_Km_;
+  }
+
+  // Sv
+  dSv_.noalias() += Sm_.transpose() * coefficients.Hv;
+  dSv_.noalias() += coefficients.Am.transpose() * Sv_;
+  dSv_.noalias() += Gm_.transpose() * Lv_;
+  if (!reducedFormRiccati_) {
+    dSv_.noalias() += Km_.transpose() * Gv_;
+    dSv_.noalias() += Rm_Km_.transpose() * Lv_;
+  }
+
+  // s
+  ds_ += coefficients.Hv.dot(Sv_);
+  if (reducedFormRiccati_) {
+    ds_ += 0.5 * Lv_.dot(Gv_);
+  } else {
+    ds_ += Lv_.dot(Gv_);
+    ds_ += 0.5 * Lv_.dot(Rm_Lv_);
+  }
+
+  pack(dSm_, dSv_, ds_, packedDerivative);
+
+  // The same as ContinuousTimeRiccatiEquations::computeSensitivityFlowMap
+  if (computeTerminalSensitivity_) {
+    unpackSensitivity(packedState, sensitivity_);
+
+    Bm_T_M_.noalias() = coefficients.Bm.transpose() * sensitivity_.M;
+    dSensitivity_.M.noalias() = coefficients.Am.transpose() * sensitivity_.M;
+    dSensitivity_.M.noalias() += Km_.transpose() * Bm_T_M_;
+    dSensitivity_.N.noalias() = -Bm_T_M_.transpose() * Bm_T_M_;
+    dSensitivity_.n.noalias() = sensitivity_.M.transpose() * coefficients.Hv;
+    dSensitivity_.n.noalias() += Bm_T_M_.transpose() * Lv_;
+
+    packSensitivity(dSensitivity_, packedDerivative);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepRiccatiIntegrator::computeJumpMap(const ModelData& jumpModelData, vector_t& packedState) {
+  // The same as riccatiTransversalityConditions
+  unpack(packedState, Sm_, Sv_, s_);
+  const auto& Am = jumpModelData.dynamics.dfdx;
+  const auto& Hv = jumpModelData.dynamicsBias;
+
+  // s += q + Hv^T * (Sv + 0.5 * Sm * Hv)
+  Sv_plus_SmHv_ = Sv_;
+  Sv_plus_SmHv_.noalias() += 0.5 * Sm_ * Hv;
+  s_ += jumpModelData.cost.f + Hv.dot(Sv_plus_SmHv_);
+
+  // Sv = Qv + Am^T * (Sv + Sm * Hv)
+  Sv_plus_SmHv_.noalias() += 0.5 * Sm_ * Hv;
+  dSv_ = jumpModelData.cost.dfdx;
+  dSv_.noalias() += Am.transpose() * Sv_plus_SmHv_;
+
+  // Sm = Qm + Am^T * Sm * Am
+  SmTrans_jumpAm_.noalias() = Sm_.transpose() * Am;
+  dSm_ = jumpModelData.cost.dfdxx;
+  dSm_.noalias() += SmTrans_jumpAm_.transpose() * Am;
+
+  pack(dSm_, dSv_, s_, packedState);
+
+  if (computeTerminalSensitivity_) {
+    // x_postEvent = Am * x_preEvent + Hv
+    unpackSensitivity(packedState, sensitivity_);
+    sensitivity_.n.noalias() += sensitivity_.M.transpose() * Hv;
+    dSensitivity_.M.noalias() = Am.transpose() * sensitivity_.M;
+    sensitivity_.M.swap(dSensitivity_.M);
+    packSensitivity(sensitivity_, packedState);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepRiccatiIntegrator::pack(const matrix_t& Sm, const vector_t& Sv, scalar_t s, vector_t& packedState) const {
+  // upper triangular part of Sm in column-wise fashion, the same layout as ContinuousTimeRiccatiEquations::convert2Vector
+  int count = 0;
+  for (int col = 0; col < stateDim_; col++) {
+    packedState.segment(count, col + 1) = Sm.col(col).head(col + 1);
+    count += col + 1;
+  }
+  packedState.segment(count, stateDim_) = Sv;
+  packedState(count + stateDim_) = s;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepRiccatiIntegrator::unpack(const vector_t& packedState, matrix_t& Sm, vector_t& Sv, scalar_t& s) const {
+  Sm.resize(stateDim_, stateDim_);
+  int count = 0;
+  for (int col = 0; col < stateDim_; col++) {
+    for (int row = 0; row < col; row++) {
+      Sm(row, col) = Sm(col, row) = packedState(count++);
+    }
+    Sm(col, col) = packedState(count++);
+  }
+  Sv = packedState.segment(count, stateDim_);
+  s = packedState(count + stateDim_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepRiccatiIntegrator::packSensitivity(const riccati_sensitivity::Data& sensitivity, vector_t& packedState) const {
+  const int nn = stateDim_ * stateDim_;
+  scalar_t* dataPtr = packedState.data() + s_vector_dim(stateDim_);
+  Eigen::Map<matrix_t>(dataPtr, stateDim_, stateDim_) = sensitivity.M;
+  Eigen::Map<matrix_t>(dataPtr + nn, stateDim_, stateDim_) = sensitivity.N;
+  Eigen::Map<vector_t>(dataPtr + 2 * nn, stateDim_) = sensitivity.n;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepRiccatiIntegrator::unpackSensitivity(const vector_t& packedState, riccati_sensitivity::Data& sensitivity) const {
+  const int nn = stateDim_ * stateDim_;
+  const scalar_t* dataPtr = packedState.data() + s_vector_dim(stateDim_);
+  sensitivity.M = Eigen::Map<const matrix_t>(dataPtr, stateDim_, stateDim_);
+  sensitivity.N = Eigen::Map<const matrix_t>(dataPtr + nn, stateDim_, stateDim_);
+  sensitivity.n = Eigen::Map<const vector_t>(dataPtr + 2 * nn, stateDim_);
+}
+
+}  // namespace ocs2
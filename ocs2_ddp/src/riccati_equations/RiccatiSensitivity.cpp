@@ -0,0 +1,74 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ddp/riccati_equations/RiccatiSensitivity.h"
+
+namespace ocs2 {
+namespace riccati_sensitivity {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Data Data::Identity(int stateDim) {
+  Data sensitivity;
+  sensitivity.M.setIdentity(stateDim, stateDim);
+  sensitivity.N.setZero(stateDim, stateDim);
+  sensitivity.n.setZero(stateDim);
+  return sensitivity;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation correctInitialValueFunction(const ScalarFunctionQuadraticApproximation& initialValueFunction,
+                                                                 const Data& sensitivity,
+                                                                 const ScalarFunctionQuadraticApproximation& finalGuess,
+                                                                 const ScalarFunctionQuadraticApproximation& finalValueFunction) {
+  const matrix_t deltaSm = finalValueFunction.dfdxx - finalGuess.dfdxx;
+  const vector_t deltaSv = finalValueFunction.dfdx - finalGuess.dfdx;
+
+  // lambda = deltaSm * dx_final + deltaSv, with dx_final = M^T * dx_initial + N * lambda + n. Hence, lambda = L * dx_initial + l
+  matrix_t I_minus_deltaSm_N = -deltaSm * sensitivity.N;
+  I_minus_deltaSm_N.diagonal().array() += 1.0;
+  const auto luDecomposition = I_minus_deltaSm_N.partialPivLu();
+  const matrix_t L = luDecomposition.solve(deltaSm * sensitivity.M.transpose());
+  const vector_t l = luDecomposition.solve(deltaSm * sensitivity.n + deltaSv);
+
+  ScalarFunctionQuadraticApproximation valueFunction;
+  valueFunction.f = initialValueFunction.f;
+  valueFunction.dfdx = initialValueFunction.dfdx;
+  valueFunction.dfdx.noalias() += sensitivity.M * l;
+  valueFunction.dfdxx = initialValueFunction.dfdxx;
+  valueFunction.dfdxx.noalias() += sensitivity.M * L;
+  valueFunction.dfdxx = 0.5 * (valueFunction.dfdxx + valueFunction.dfdxx.transpose()).eval();
+  return valueFunction;
+}
+
+}  // namespace riccati_sensitivity
+}  // namespace ocs2
@@ -47,7 +47,11 @@ LevenbergMarquardtStrategy::LevenbergMarquardtStrategy(search_strategy::Settings
       settings_(std::move(settings)),
       rolloutRef_(rolloutRef),
       optimalControlProblemRef_(optimalControlProblemRef),
-      meritFunc_(std::move(meritFunc)) {}
+      meritFunc_(std::move(meritFunc)) {
+  if (settings_.maxNumTrialsPerIteration == 0) {
+    throw std::runtime_error("[LevenbergMarquardtStrategy] The maximum number of trials per iteration should be at least one!");
+  }
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -78,9 +82,10 @@ bool LevenbergMarquardtStrategy::run(const std::pair<scalar_t, scalar_t>& timePe
     incrementController(stepLength, unoptimizedController, getLinearController(solution.primalSolution));
     solution.avgTimeStep = rolloutTrajectory(rolloutRef_, timePeriod.first, initState, timePeriod.second, solution.primalSolution);
 
-    // adjust dual solution only if it is required
+    // adjust dual solution only if it is required (a dual solution on the same fixed time grid is used as is)
     const DualSolution* adjustedDualSolutionPtr = &dualSolution;
-    if (!dualSolution.timeTrajectory.empty()) {
+    const auto& timeGrid = solution.primalSolution.timeTrajectory_;
+    if (!dualSolution.timeTrajectory.empty() && !isDefinedOnTimeGrid(dualSolution, timeGrid, solution.primalSolution.postEventIndices_)) {
       // trajectory spreading
       constexpr bool debugPrint = false;
       TrajectorySpreading trajectorySpreading(debugPrint);
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ddp/search_strategy/LineSearchStrategy.h"
 
+#include <thread>
+
 #include "ocs2_ddp/DDP_HelperFunctions.h"
 #include "ocs2_ddp/HessianCorrection.h"
 
@@ -43,7 +45,8 @@ namespace ocs2 {
 LineSearchStrategy::LineSearchStrategy(search_strategy::Settings baseSettings, line_search::Settings settings, ThreadPool& threadPoolRef,
                                        std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock,
                                        std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRefStock,
-                                       std::function<scalar_t(const PerformanceIndex&)> meritFunc)
+                                       std::function<scalar_t(const PerformanceIndex&)> meritFunc,
+                                       const search_strategy::ShootingNodes* shootingNodesPtr)
     : SearchStrategyBase(std::move(baseSettings)),
       settings_(std::move(settings)),
       threadPoolRef_(threadPoolRef),
@@ -51,7 +54,8 @@ LineSearchStrategy::LineSearchStrategy(search_strategy::Settings baseSettings, l
       workersSolution_(threadPoolRef.numThreads() + 1),
       rolloutRefStock_(std::move(rolloutRefStock)),
       optimalControlProblemRefStock_(std::move(optimalControlProblemRefStock)),
-      meritFunc_(std::move(meritFunc)) {
+      meritFunc_(std::move(meritFunc)),
+      shootingNodesPtr_(shootingNodesPtr) {
   // infeasible learning rate adjustment scheme
   if (!numerics::almost_ge(settings_.maxStepLength, settings_.minStepLength)) {
     throw std::runtime_error("The maximum learning rate is smaller than the minimum learning rate.");
@@ -84,18 +88,28 @@ size_t LineSearchStrategy::maxNumOfSearches() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, search_strategy::Solution& solution) {
-  auto& problem = optimalControlProblemRefStock_[taskId];
-  auto& rollout = rolloutRefStock_[taskId];
-
   // compute primal solution
   solution.primalSolution.modeSchedule_ = *lineSearchInputRef_.modeSchedulePtr;
   incrementController(stepLength, *lineSearchInputRef_.unoptimizedControllerPtr, getLinearController(solution.primalSolution));
-  solution.avgTimeStep = rolloutTrajectory(rollout, lineSearchInputRef_.timePeriodPtr->first, *lineSearchInputRef_.initStatePtr,
-                                           lineSearchInputRef_.timePeriodPtr->second, solution.primalSolution);
+  solution.avgTimeStep = rolloutTrajectory(rolloutRefStock_[taskId], lineSearchInputRef_.timePeriodPtr->first,
+                                           *lineSearchInputRef_.initStatePtr, lineSearchInputRef_.timePeriodPtr->second,
+                                           solution.primalSolution);
 
-  // adjust dual solution only if it is required
+  evaluateSolution(taskId, stepLength, solution);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LineSearchStrategy::evaluateSolution(size_t taskId, scalar_t stepLength, search_strategy::Solution& solution,
+                                          vector_array_t* dynamicsViolationTrajectoryPtr) {
+  auto& problem = optimalControlProblemRefStock_[taskId];
+
+  // adjust dual solution only if it is required (a dual solution on the same fixed time grid is used as is)
   const DualSolution* adjustedDualSolutionPtr = lineSearchInputRef_.dualSolutionPtr;
-  if (!lineSearchInputRef_.dualSolutionPtr->timeTrajectory.empty()) {
+  const auto& cachedDualSolution = *lineSearchInputRef_.dualSolutionPtr;
+  if (!cachedDualSolution.timeTrajectory.empty() &&
+      !isDefinedOnTimeGrid(cachedDualSolution, solution.primalSolution.timeTrajectory_, solution.primalSolution.postEventIndices_)) {
     // trajectory spreading
     constexpr bool debugPrint = false;
     TrajectorySpreading trajectorySpreading(debugPrint);
@@ -112,6 +126,12 @@ void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, sea
 
   // compute problem metrics
   computeRolloutMetrics(problem, solution.primalSolution, solution.dualSolution, solution.problemMetrics);
+  if (dynamicsViolationTrajectoryPtr != nullptr) {
+    auto& dynamicsViolationTrajectory = *dynamicsViolationTrajectoryPtr;
+    for (size_t k = 0; k < dynamicsViolationTrajectory.size(); k++) {
+      solution.problemMetrics.intermediates[k].dynamicsViolation.swap(dynamicsViolationTrajectory[k]);
+    }
+  }
 
   // compute performanceIndex
   solution.performanceIndex = computeRolloutPerformanceIndex(solution.primalSolution.timeTrajectory_, solution.problemMetrics);
@@ -126,6 +146,178 @@ void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, sea
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LineSearchStrategy::runShootingTrials(size_t numTrials, bool isBaseline) {
+  const size_t numSegments = shootingNodesPtr_->times.size() + 1;
+  while (shootingTrials_.size() < numTrials) {
+    shootingTrials_.emplace_back(new ShootingTrial);
+    shootingTrials_.back()->solution.primalSolution.controllerPtr_.reset(new LinearController);
+  }
+  for (size_t i = 0; i < numTrials; i++) {
+    auto& trial = *shootingTrials_[i];
+    trial.stepLength = isBaseline ? 0.0 : settings_.maxStepLength * std::pow(settings_.contractionRate, i);
+    trial.segments.resize(numSegments);
+    trial.isPrepared = false;
+    trial.isFailed = false;
+    trial.numUnfinishedSegments = numSegments;
+  }
+
+  isShootingBaseline_ = isBaseline;
+  numShootingItems_ = numTrials * numSegments;
+  nextShootingItem_ = 0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LineSearchStrategy::shootingTask(size_t taskId) {
+  const size_t numSegments = shootingNodesPtr_->times.size() + 1;
+
+  // the trials are claimed segment by segment in the order of decreasing step lengths
+  size_t item;
+  while ((item = nextShootingItem_++) < numShootingItems_) {
+    const size_t alphaExp = item / numSegments;
+    const size_t segment = item % numSegments;
+    auto& trial = *shootingTrials_[alphaExp];
+
+    // skip if a larger step length is already accepted
+    auto isSkipped = [&]() { return trial.isFailed || (!isShootingBaseline_ && trial.stepLength < bestStepSize_); };
+
+    // the first segment prepares the controller and the shooting states of the trial
+    if (segment == 0) {
+      if (!isSkipped()) {
+        auto& primalSolution = trial.solution.primalSolution;
+        primalSolution.modeSchedule_ = *lineSearchInputRef_.modeSchedulePtr;
+        incrementController(trial.stepLength, *lineSearchInputRef_.unoptimizedControllerPtr, getLinearController(primalSolution));
+        // shooting states are moved along the linear state increment similar to the feedforward inputs
+        trial.shootingStates.resize(numSegments - 1);
+        for (size_t s = 0; s < trial.shootingStates.size(); s++) {
+          trial.shootingStates[s] = shootingNodesPtr_->nominalStates[s];
+          trial.shootingStates[s].noalias() += trial.stepLength * shootingNodesPtr_->stateIncrements[s];
+        }
+      }
+      trial.isPrepared = true;
+    } else {
+      while (!trial.isPrepared) {
+        std::this_thread::yield();
+      }
+    }
+
+    if (!isSkipped()) {
+      try {
+        rolloutShootingSegment(taskId, segment, trial);
+      } catch (const std::exception& error) {
+        trial.isFailed = true;
+        if (baseSettings_.displayInfo) {
+          printString("    [Thread " + std::to_string(taskId) + "] rollout of segment " + std::to_string(segment) + " with step length " +
+                      std::to_string(trial.stepLength) + " is terminated: " + error.what() + '\n');
+        }
+      }
+    }
+
+    // the worker which finishes the last segment of the trial evaluates it
+    if (--trial.numUnfinishedSegments > 0) {
+      continue;
+    }
+    if (!isSkipped()) {
+      try {
+        stitchShootingSegments(trial);
+        evaluateSolution(taskId, trial.stepLength, trial.solution, &trial.dynamicsViolationTrajectory);
+      } catch (const std::exception& error) {
+        trial.isFailed = true;
+        if (baseSettings_.displayInfo) {
+          printString("    [Thread " + std::to_string(taskId) + "] evaluation of step length " + std::to_string(trial.stepLength) +
+                      " is terminated: " + error.what() + '\n');
+        }
+      }
+    }
+    if (isShootingBaseline_) {
+      continue;
+    }
+    if (isSkipped()) {
+      trial.solution.performanceIndex.merit = std::numeric_limits<scalar_t>::max();
+      trial.solution.performanceIndex.cost = std::numeric_limits<scalar_t>::max();
+    }
+
+    // kill other ongoing line search tasks
+    if (acceptOrRejectStep(alphaExp, trial.stepLength, trial.solution)) {
+      for (RolloutBase& rollout : rolloutRefStock_) {
+        rollout.abortRollout();
+      }
+      // no larger step length is left, therefore the best solution is settled
+      if (settledSolutionTask_) {
+        settleSearch();
+      }
+      if (baseSettings_.displayInfo) {
+        printString("    LS: interrupt other rollout's integrations.\n");
+      }
+    }
+  }  // end of while loop
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LineSearchStrategy::rolloutShootingSegment(size_t taskId, size_t segment, ShootingTrial& trial) {
+  // the segment s > 0 starts at the shooting node s - 1
+  const bool isLastSegment = segment == shootingNodesPtr_->times.size();
+  const scalar_t initTime = (segment == 0) ? lineSearchInputRef_.timePeriodPtr->first : shootingNodesPtr_->times[segment - 1];
+  const vector_t& initState = (segment == 0) ? *lineSearchInputRef_.initStatePtr : trial.shootingStates[segment - 1];
+  const scalar_t finalTime = isLastSegment ? lineSearchInputRef_.timePeriodPtr->second : shootingNodesPtr_->times[segment];
+
+  auto& primalSolution = trial.solution.primalSolution;
+  auto& shootingSegment = trial.segments[segment];
+  shootingSegment.finalState = rolloutRefStock_[taskId].get().run(
+      initTime, initState, finalTime, primalSolution.controllerPtr_.get(), primalSolution.modeSchedule_, shootingSegment.timeTrajectory,
+      shootingSegment.postEventIndices, shootingSegment.stateTrajectory, shootingSegment.inputTrajectory);
+  if (!shootingSegment.finalState.allFinite()) {
+    throw std::runtime_error("[LineSearchStrategy::rolloutShootingSegment] System became unstable during the rollout!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LineSearchStrategy::stitchShootingSegments(ShootingTrial& trial) const {
+  auto& primalSolution = trial.solution.primalSolution;
+  primalSolution.timeTrajectory_.clear();
+  primalSolution.postEventIndices_.clear();
+  primalSolution.stateTrajectory_.clear();
+  primalSolution.inputTrajectory_.clear();
+  trial.dynamicsViolationTrajectory.clear();
+
+  const auto stateDim = lineSearchInputRef_.initStatePtr->size();
+  for (size_t s = 0; s < trial.segments.size(); s++) {
+    const bool isLastSegment = (s + 1 == trial.segments.size());
+    const auto& shootingSegment = trial.segments[s];
+
+    // the final node of an intermediate segment is replaced by the initial node of the next segment
+    const size_t numNodes = isLastSegment ? shootingSegment.timeTrajectory.size() : shootingSegment.timeTrajectory.size() - 1;
+    const size_t offset = primalSolution.timeTrajectory_.size();
+    for (const auto index : shootingSegment.postEventIndices) {
+      primalSolution.postEventIndices_.push_back(offset + index);
+    }
+    const auto& t = shootingSegment.timeTrajectory;
+    const auto& x = shootingSegment.stateTrajectory;
+    const auto& u = shootingSegment.inputTrajectory;
+    primalSolution.timeTrajectory_.insert(primalSolution.timeTrajectory_.end(), t.begin(), t.begin() + numNodes);
+    primalSolution.stateTrajectory_.insert(primalSolution.stateTrajectory_.end(), x.begin(), x.begin() + numNodes);
+    primalSolution.inputTrajectory_.insert(primalSolution.inputTrajectory_.end(), u.begin(), u.begin() + numNodes);
+
+    // defects: the predicted final state of this segment minus the shooting state of the next segment
+    trial.dynamicsViolationTrajectory.resize(primalSolution.timeTrajectory_.size(), vector_t::Zero(stateDim));
+    if (!isLastSegment) {
+      trial.dynamicsViolationTrajectory.back() = shootingSegment.finalState - trial.shootingStates[s];
+    }
+  }  // end of s loop
+
+  // average time step
+  const auto& timePeriod = *lineSearchInputRef_.timePeriodPtr;
+  trial.solution.avgTimeStep = (timePeriod.second - timePeriod.first) / static_cast<scalar_t>(primalSolution.timeTrajectory_.size());
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -140,17 +332,31 @@ bool LineSearchStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, co
   lineSearchInputRef_.modeSchedulePtr = &modeSchedule;
   bestSolutionRef_ = &solutionRef;
 
+  // the segments of a multiple-shooting rollout are dispatched to the workers
+  const bool isMultipleShooting = shootingNodesPtr_ != nullptr && !shootingNodesPtr_->times.empty();
+
   // perform a rollout with steplength zero.
   constexpr size_t taskId = 0;
   constexpr scalar_t stepLength = 0.0;
   try {
-    computeSolution(taskId, stepLength, workersSolution_[taskId]);
-    baselineMerit_ = workersSolution_[taskId].performanceIndex.merit;
+    auto* baselineSolutionPtr = &workersSolution_[taskId];
+    if (isMultipleShooting) {
+      runShootingTrials(1, true);
+      nextTaskId_ = 0;
+      threadPoolRef_.runParallel([&](int) { shootingTask(nextTaskId_++); }, threadPoolRef_.numThreads());
+      if (shootingTrials_.front()->isFailed) {
+        throw std::runtime_error("The rollout of a segment has failed.");
+      }
+      baselineSolutionPtr = &shootingTrials_.front()->solution;
+    } else {
+      computeSolution(taskId, stepLength, *baselineSolutionPtr);
+    }
+    baselineMerit_ = baselineSolutionPtr->performanceIndex.merit;
     unoptimizedControllerUpdateIS_ = computeControllerUpdateIS(unoptimizedController);
 
     // record solution
     bestStepSize_ = stepLength;
-    swap(*bestSolutionRef_, workersSolution_[taskId]);
+    swap(*bestSolutionRef_, *baselineSolutionPtr);
 
   } catch (const std::exception& error) {
     if (baseSettings_.displayInfo) {
@@ -164,9 +370,30 @@ bool LineSearchStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, co
   nextTaskId_ = 0;
   alphaExpNext_ = 0;
   alphaProcessed_ = std::vector<bool>(maxNumOfSearches(), false);
-  auto task = [&](int) { lineSearchTask(nextTaskId_++); };
+  settleState_ = 0;
+  isSettledSolutionTaskRunning_ = false;
+  if (isMultipleShooting) {
+    runShootingTrials(alphaProcessed_.size(), false);
+  }
+  auto task = [&](int) {
+    const size_t taskId = nextTaskId_++;
+    if (isMultipleShooting) {
+      shootingTask(taskId);
+    } else {
+      lineSearchTask(taskId);
+    }
+    // the workers which finish after an accepted step has settled the search join the settled solution task
+    if (settleState_ == 2 && isSettledSolutionTaskRunning_) {
+      settledSolutionTask_(taskId);
+    }
+  };
   threadPoolRef_.runParallel(task, threadPoolRef_.numThreads());
 
+  // the search has only settled with its end
+  if (settledSolutionTask_) {
+    settleSearch();
+  }
+
   // revitalize all integrators
   for (RolloutBase& rollout : rolloutRefStock_) {
     rollout.reactivateRollout();
@@ -221,31 +448,17 @@ void LineSearchStrategy::lineSearchTask(const size_t taskId) {
     }
 
     // whether to accept the step or reject it
-    bool terminateLinesearchTasks = false;
-    {
-      std::lock_guard<std::mutex> lock(lineSearchResultMutex_);
-
-      /*
-       * based on the "Armijo backtracking" step length selection policy:
-       * cost should be better than the baseline cost but learning rate should
-       * be as high as possible. This is equivalent to a single core line search.
-       */
-      const bool armijoCondition = workersSolution_[taskId].performanceIndex.merit <
-                                   (baselineMerit_ - settings_.armijoCoefficient * stepLength * unoptimizedControllerUpdateIS_);
-      if (armijoCondition && stepLength > bestStepSize_) {  // save solution
-        bestStepSize_ = stepLength;
-        swap(*bestSolutionRef_, workersSolution_[taskId]);
-        terminateLinesearchTasks = std::all_of(alphaProcessed_.cbegin(), alphaProcessed_.cbegin() + alphaExp, [](bool f) { return f; });
-      }
-
-      alphaProcessed_[alphaExp] = true;
-    }  // end lock
+    const bool terminateLinesearchTasks = acceptOrRejectStep(alphaExp, stepLength, workersSolution_[taskId]);
 
     // kill other ongoing line search tasks
     if (terminateLinesearchTasks) {
       for (RolloutBase& rollout : rolloutRefStock_) {
         rollout.abortRollout();
       }
+      // no larger step length is left, therefore the best solution is settled
+      if (settledSolutionTask_) {
+        settleSearch();
+      }
       if (baseSettings_.displayInfo) {
         printString("    LS: interrupt other rollout's integrations.\n");
       }
@@ -255,6 +468,41 @@ void LineSearchStrategy::lineSearchTask(const size_t taskId) {
   }  // end of while loop
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool LineSearchStrategy::acceptOrRejectStep(size_t alphaExp, scalar_t stepLength, search_strategy::Solution& solution) {
+  std::lock_guard<std::mutex> lock(lineSearchResultMutex_);
+
+  /*
+   * based on the "Armijo backtracking" step length selection policy:
+   * cost should be better than the baseline cost but learning rate should
+   * be as high as possible. This is equivalent to a single core line search.
+   */
+  bool terminateLinesearchTasks = false;
+  const bool armijoCondition =
+      solution.performanceIndex.merit < (baselineMerit_ - settings_.armijoCoefficient * stepLength * unoptimizedControllerUpdateIS_);
+  if (armijoCondition && stepLength > bestStepSize_) {  // save solution
+    bestStepSize_ = stepLength;
+    swap(*bestSolutionRef_, solution);
+    terminateLinesearchTasks = std::all_of(alphaProcessed_.cbegin(), alphaProcessed_.cbegin() + alphaExp, [](bool f) { return f; });
+  }
+
+  alphaProcessed_[alphaExp] = true;
+  return terminateLinesearchTasks;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LineSearchStrategy::settleSearch() {
+  int searching = 0;
+  if (settleState_.compare_exchange_strong(searching, 1)) {
+    isSettledSolutionTaskRunning_ = isSettledSolutionTaskRequired_(bestSolutionRef_->performanceIndex);
+    settleState_ = 2;
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -268,7 +516,8 @@ std::pair<bool, std::string> LineSearchStrategy::checkConvergence(bool unreliabl
       previousPerformanceIndex.cost + previousPerformanceIndex.equalityLagrangian + previousPerformanceIndex.inequalityLagrangian;
   const scalar_t relCost = std::abs(currentTotalCost - previousTotalCost);
   const bool isCostFunctionConverged = relCost <= baseSettings_.minRelCost;
-  const bool isConstraintsSatisfied = currentPerformanceIndex.equalityConstraintsSSE <= baseSettings_.constraintTolerance;
+  const bool isConstraintsSatisfied = currentPerformanceIndex.equalityConstraintsSSE <= baseSettings_.constraintTolerance &&
+                                      currentPerformanceIndex.dynamicsViolationSSE <= baseSettings_.constraintTolerance;
   const bool isOptimizationConverged = isCostFunctionConverged && isConstraintsSatisfied;
 
   // convergence info
@@ -111,6 +111,7 @@ Settings load(const std::string& filename, const std::string& fieldName, bool ve
   loadData::loadPtreeValue(pt, settings.riccatiMultipleDefaultRatio, fieldName + ".riccatiMultipleDefaultRatio", verbose);
   loadData::loadPtreeValue(pt, settings.riccatiMultipleDefaultFactor, fieldName + ".riccatiMultipleDefaultFactor", verbose);
   loadData::loadPtreeValue(pt, settings.maxNumSuccessiveRejections, fieldName + ".maxNumSuccessiveRejections", verbose);
+  loadData::loadPtreeValue(pt, settings.maxNumTrialsPerIteration, fieldName + ".maxNumTrialsPerIteration", verbose);
   if (verbose) {
     std::cerr << " #### }" << std::endl;
   }
@@ -180,6 +180,52 @@ TEST_F(Exp0, ddp_feedforward_policy) {
   EXPECT_DOUBLE_EQ(solution.timeTrajectory_.back(), finalTime) << "MESSAGE: SLQ failed in policy final time of trajectory!";
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_reused_primal_solution) {
+  // ddp settings
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 2, ocs2::search_strategy::Type::LINE_SEARCH);
+  ddpSettings.useFeedbackPolicy_ = true;
+
+  // dynamics and rollout
+  ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  // instantiate
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+
+  // run ddp
+  ddp.run(startTime, initState, finalTime);
+
+  // retrieve the full policy and then a shorter one into the same primal solution
+  ocs2::PrimalSolution solution;
+  ddp.getPrimalSolution(finalTime, &solution);
+  const auto* ctrlPtr = solution.controllerPtr_.get();
+  const ocs2::scalar_t shorterFinalTime = 0.5 * (startTime + finalTime);
+  ddp.getPrimalSolution(shorterFinalTime, &solution);
+  const auto expectedSolution = ddp.primalSolution(shorterFinalTime);
+
+  EXPECT_EQ(solution.controllerPtr_.get(), ctrlPtr) << "MESSAGE: SLQ did not reuse the controller!";
+  EXPECT_EQ(solution.timeTrajectory_, expectedSolution.timeTrajectory_);
+  const auto& controller = dynamic_cast<const ocs2::LinearController&>(*solution.controllerPtr_);
+  const auto& expectedController = dynamic_cast<const ocs2::LinearController&>(*expectedSolution.controllerPtr_);
+  EXPECT_EQ(controller.timeStamp_, expectedController.timeStamp_);
+  ASSERT_EQ(controller.gainArray_.size(), expectedController.gainArray_.size());
+  for (size_t k = 0; k < controller.gainArray_.size(); k++) {
+    EXPECT_TRUE(controller.biasArray_[k].isApprox(expectedController.biasArray_[k]));
+    EXPECT_TRUE(controller.gainArray_[k].isApprox(expectedController.gainArray_[k]));
+  }
+
+  // the same length reuses the memory of the elements
+  const auto* gainDataPtr = controller.gainArray_.back().data();
+  const auto* stateDataPtr = solution.stateTrajectory_.back().data();
+  ddp.getPrimalSolution(shorterFinalTime, &solution);
+  EXPECT_EQ(controller.gainArray_.back().data(), gainDataPtr) << "MESSAGE: SLQ did not reuse the gain memory!";
+  EXPECT_EQ(solution.stateTrajectory_.back().data(), stateDataPtr) << "MESSAGE: SLQ did not reuse the state memory!";
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -31,9 +31,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
+#include <tuple>
 
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_oc/rollout/InitializerRollout.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 #include <ocs2_oc/test/EXP1.h>
 
@@ -203,6 +205,276 @@ TEST_F(Exp1, ddp_hamiltonian) {
   EXPECT_FALSE(dHdu3.isZero(precision)) << "MESSAGE for test 3: Derivative of Hamiltonian w.r.t. to u is zero: " << dHdu3.transpose();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, incremental_lq_approximation) {
+  // ddp settings
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 2, ocs2::search_strategy::Type::LINE_SEARCH);
+  ddpSettings.minRelCost_ = 1e-9;  // to have iterations with small changes
+
+  // the nodes are only reused if they have the same time, therefore a fixed-step rollout is used
+  auto fixedStepRolloutSettings = rolloutSettings();
+  fixedStepRolloutSettings.integratorType = ocs2::IntegratorType::RK4;
+
+  // dynamics and rollout
+  ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, fixedStepRolloutSettings);
+
+  // full LQ approximation
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+  ddp.run(startTime, initState, finalTime);
+  const auto numLQApproximations = ddp.getNumIntermediateLQApproximations();
+  EXPECT_EQ(numLQApproximations.first, numLQApproximations.second);
+
+  // incremental LQ approximation
+  ddpSettings.incrementalLQApproximation_ = true;
+  ddpSettings.incrementalLQApproximationTolerance_ = 1e-4;
+  ocs2::SLQ ddpIncremental(ddpSettings, rollout, problem, *initializerPtr);
+  ddpIncremental.setReferenceManager(referenceManagerPtr);
+  ddpIncremental.run(startTime, initState, finalTime);
+  const auto numIncrementalLQApproximations = ddpIncremental.getNumIntermediateLQApproximations();
+  EXPECT_LT(numIncrementalLQApproximations.first, numIncrementalLQApproximations.second);
+
+  performanceIndexTest(ddpSettings, ddpIncremental.getPerformanceIndeces());
+  EXPECT_NEAR(ddpIncremental.getPerformanceIndeces().merit, ddp.getPerformanceIndeces().merit, 1e-6);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, trajectory_allocations) {
+  // ddp settings
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 2, ocs2::search_strategy::Type::LINE_SEARCH);
+
+  // the horizon length is only settled with a fixed time grid
+  auto fixedGridRolloutSettings = rolloutSettings();
+  fixedGridRolloutSettings.useFixedTimeGrid = true;
+
+  // dynamics and rollout
+  ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, fixedGridRolloutSettings);
+
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+  ddp.run(startTime, initState, finalTime);
+  const auto numAllocations = ddp.getNumTrajectoryAllocations();
+  EXPECT_GT(numAllocations, 0);
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+
+  // the warm-started run on the same time grid reuses the memory of the first one
+  ddp.run(startTime, initState, finalTime);
+  EXPECT_EQ(ddp.getNumTrajectoryAllocations(), numAllocations);
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, pipelined_iteration) {
+  for (const auto algorithm : {ocs2::ddp::Algorithm::SLQ, ocs2::ddp::Algorithm::ILQR}) {
+    // ddp settings
+    auto ddpSettings = getSettings(algorithm, 3, ocs2::search_strategy::Type::LINE_SEARCH);
+
+    // dynamics and rollout
+    ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+    ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+    auto runDdp = [&](const ocs2::ddp::Settings& settings) {
+      std::unique_ptr<ocs2::GaussNewtonDDP> ddpPtr;
+      if (algorithm == ocs2::ddp::Algorithm::SLQ) {
+        ddpPtr.reset(new ocs2::SLQ(settings, rollout, problem, *initializerPtr));
+      } else {
+        ddpPtr.reset(new ocs2::ILQR(settings, rollout, problem, *initializerPtr));
+      }
+      ddpPtr->setReferenceManager(referenceManagerPtr);
+      ddpPtr->run(startTime, initState, finalTime);
+      return std::make_tuple(ddpPtr->getPerformanceIndeces(), ddpPtr->getIterationsLog().size(),
+                             ddpPtr->getNumIntermediateLQApproximations().second);
+    };
+
+    const auto sequential = runDdp(ddpSettings);
+    ddpSettings.pipelinedIteration_ = true;
+    const auto pipelined = runDdp(ddpSettings);
+
+    // the pipelined iteration computes the same LQ approximation
+    performanceIndexTest(ddpSettings, std::get<0>(pipelined));
+    EXPECT_EQ(std::get<1>(pipelined), std::get<1>(sequential));
+    EXPECT_DOUBLE_EQ(std::get<0>(pipelined).merit, std::get<0>(sequential).merit);
+    EXPECT_DOUBLE_EQ(std::get<0>(pipelined).cost, std::get<0>(sequential).cost);
+    // the last iteration does not compute an LQ approximation for an iteration that never comes
+    EXPECT_EQ(std::get<2>(pipelined), std::get<2>(sequential));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, multiple_shooting) {
+  // dynamics and rollout
+  ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  // the segments are shared between the threads
+  for (const size_t numThreads : {1, 3}) {
+    // ddp settings
+    auto ddpSettings = getSettings(ocs2::ddp::Algorithm::ILQR, numThreads, ocs2::search_strategy::Type::LINE_SEARCH);
+    ddpSettings.numShootingSegments_ = 4;
+
+    ocs2::ILQR ddp(ddpSettings, rollout, problem, *initializerPtr);
+    ddp.setReferenceManager(referenceManagerPtr);
+    ddp.run(startTime, initState, finalTime);
+
+    // the defects between the segments are closed at the solution
+    const auto performanceIndex = ddp.getPerformanceIndeces();
+    performanceIndexTest(ddpSettings, performanceIndex);
+    EXPECT_NEAR(performanceIndex.dynamicsViolationSSE, 0.0, ddpSettings.constraintTolerance_);
+  }
+
+  // SLQ does not support the multiple-shooting forward pass
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 3, ocs2::search_strategy::Type::LINE_SEARCH);
+  ddpSettings.numShootingSegments_ = 4;
+  EXPECT_THROW(ocs2::SLQ(ddpSettings, rollout, problem, *initializerPtr), std::runtime_error);
+
+  // neither does a rollout other than the time-triggered one
+  ddpSettings.algorithm_ = ocs2::ddp::Algorithm::ILQR;
+  ocs2::InitializerRollout initializerRollout(*initializerPtr, rolloutSettings());
+  EXPECT_THROW(ocs2::ILQR(ddpSettings, initializerRollout, problem, *initializerPtr), std::runtime_error);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, time_budget) {
+  // ddp settings
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 2, ocs2::search_strategy::Type::LINE_SEARCH);
+
+  // dynamics and rollout
+  ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+
+  // a generous budget does not change the solution
+  ddp.setTimeBudget(10.0);
+  ddp.run(startTime, initState, finalTime);
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+  EXPECT_GT(ddp.getIterationsLog().size(), 2);
+
+  // an exhausted budget only allows the first iteration, i.e., the initial and the first iterate are logged
+  ddp.reset();
+  ddp.setTimeBudget(1e-9);
+  ddp.run(startTime, initState, finalTime);
+  EXPECT_EQ(ddp.getIterationsLog().size(), 2);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, levenberg_marquardt_trials) {
+  for (const auto algorithm : {ocs2::ddp::Algorithm::SLQ, ocs2::ddp::Algorithm::ILQR}) {
+    // ddp settings
+    auto ddpSettings = getSettings(algorithm, 3, ocs2::search_strategy::Type::LEVENBERG_MARQUARDT);
+
+    // dynamics and rollout
+    ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+    ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+    auto runDdp = [&](const ocs2::ddp::Settings& settings) {
+      std::unique_ptr<ocs2::GaussNewtonDDP> ddpPtr;
+      if (algorithm == ocs2::ddp::Algorithm::SLQ) {
+        ddpPtr.reset(new ocs2::SLQ(settings, rollout, problem, *initializerPtr));
+      } else {
+        ddpPtr.reset(new ocs2::ILQR(settings, rollout, problem, *initializerPtr));
+      }
+      ddpPtr->setReferenceManager(referenceManagerPtr);
+      ddpPtr->run(startTime, initState, finalTime);
+      return std::make_pair(ddpPtr->getPerformanceIndeces(), ddpPtr->getIterationsLog().size());
+    };
+
+    const auto sequential = runDdp(ddpSettings);
+    ddpSettings.levenbergMarquardt_.maxNumTrialsPerIteration = 3;
+    const auto retried = runDdp(ddpSettings);
+
+    // the rejected steps of the sequential algorithm are retried within the same iteration
+    performanceIndexTest(ddpSettings, retried.first);
+    EXPECT_LE(retried.second, sequential.second);
+    EXPECT_NEAR(retried.first.cost, sequential.first.cost, minRelCost);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, parallel_riccati) {
+  // EXP1 dynamics with a dynamics covariance, as required by the risk-sensitive variant
+  class StochasticSystem final : public ocs2::SystemDynamicsBase {
+   public:
+    explicit StochasticSystem(std::shared_ptr<ocs2::ReferenceManager> referenceManagerPtr)
+        : systemPtr_(new ocs2::EXP1_System(std::move(referenceManagerPtr))) {}
+    StochasticSystem* clone() const override { return new StochasticSystem(*this); }
+    ocs2::vector_t computeFlowMap(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                                  const ocs2::PreComputation& preComp) override {
+      return systemPtr_->computeFlowMap(t, x, u, preComp);
+    }
+    ocs2::VectorFunctionLinearApproximation linearApproximation(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                                                                const ocs2::PreComputation& preComp) override {
+      return systemPtr_->linearApproximation(t, x, u, preComp);
+    }
+    ocs2::matrix_t dynamicsCovariance(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u) override {
+      return 0.01 * ocs2::matrix_t::Identity(x.size(), x.size());
+    }
+
+   private:
+    StochasticSystem(const StochasticSystem& other) : systemPtr_(other.systemPtr_->clone()) {}
+    std::unique_ptr<ocs2::EXP1_System> systemPtr_;
+  };
+  problem.dynamicsPtr.reset(new StochasticSystem(referenceManagerPtr));
+
+  for (const auto algorithm : {ocs2::ddp::Algorithm::SLQ, ocs2::ddp::Algorithm::ILQR}) {
+    for (const ocs2::scalar_t riskSensitiveCoeff : {0.0, 0.5}) {
+      // ddp settings: a single iteration, such that the Riccati equations are solved around the same initial rollout. The line search
+      // afterwards depends on the number of threads.
+      auto ddpSettings = getSettings(algorithm, 1, ocs2::search_strategy::Type::LINE_SEARCH);
+      ddpSettings.maxNumIterations_ = 1;
+      ddpSettings.riskSensitiveCoeff_ = riskSensitiveCoeff;
+
+      // dynamics and rollout
+      ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+      ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+      auto runDdp = [&](const ocs2::ddp::Settings& settings) {
+        std::unique_ptr<ocs2::GaussNewtonDDP> ddpPtr;
+        if (algorithm == ocs2::ddp::Algorithm::SLQ) {
+          ddpPtr.reset(new ocs2::SLQ(settings, rollout, problem, *initializerPtr));
+        } else {
+          ddpPtr.reset(new ocs2::ILQR(settings, rollout, problem, *initializerPtr));
+        }
+        ddpPtr->setReferenceManager(referenceManagerPtr);
+        ddpPtr->run(startTime, initState, finalTime);
+        return ddpPtr;
+      };
+
+      const auto sequentialPtr = runDdp(ddpSettings);
+      ddpSettings.nThreads_ = 3;
+      const auto parallelPtr = runDdp(ddpSettings);
+
+      // the partitioned Riccati sweep is exact and the risk-sensitive variant is not partitioned. Only SLQ integrates the partitions
+      // with a different adaptive step size, which is accurate up to the ODE tolerances.
+      const ocs2::scalar_t tol = (algorithm == ocs2::ddp::Algorithm::SLQ && riskSensitiveCoeff == 0.0) ? 1e-5 : 1e-9;
+      const auto testName = getTestName(ddpSettings) + " riskSensitiveCoeff: " + std::to_string(riskSensitiveCoeff);
+      for (const ocs2::scalar_t time : {0.1, 0.5, 0.9, 1.5, 1.9, 2.5, 2.9}) {
+        const auto sequential = sequentialPtr->getValueFunction(time, initState);
+        const auto parallel = parallelPtr->getValueFunction(time, initState);
+        EXPECT_TRUE(parallel.dfdxx.isApprox(sequential.dfdxx, tol)) << "MESSAGE: " << testName << " at time " << time;
+        EXPECT_TRUE(parallel.dfdx.isApprox(sequential.dfdx, tol)) << "MESSAGE: " << testName << " at time " << time;
+      }
+    }
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -27,13 +27,19 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <cmath>
 #include <memory>
+#include <utility>
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/integration/Integrator.h>
 #include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_core/misc/randomMatrices.h>
 #include <ocs2_ddp/riccati_equations/ContinuousTimeRiccatiEquations.h>
+#include <ocs2_ddp/riccati_equations/DiscreteTimeRiccatiEquations.h>
+#include <ocs2_ddp/riccati_equations/FixedStepRiccatiIntegrator.h>
+#include <ocs2_ddp/riccati_equations/RiccatiSensitivity.h>
 
 class RiccatiInitializer {
  public:
@@ -78,9 +84,9 @@ class RiccatiInitializer {
     riccatiModificationTrajectory = std::vector<ocs2::riccati_modification::Data>{riccatiModification, riccatiModification};
   }
 
-  void initialize(riccati_t& riccati) {
+  void initialize(riccati_t& riccati, bool computeTerminalSensitivity = false) {
     riccati.setData(&timeStamp, &projectedModelDataTrajectory, &eventsPastTheEndIndeces, &modelDataEventTimesArray,
-                    &riccatiModificationTrajectory);
+                    &riccatiModificationTrajectory, computeTerminalSensitivity);
   }
 };
 
@@ -104,6 +110,62 @@ TEST(RiccatiTest, compareImplementations) {
   EXPECT_LE((dSdz_precompute - dSdz_noPrecompute).array().abs().maxCoeff(), 1e-9);
 }
 
+TEST(RiccatiTest, fixedSizeKernels) {
+  constexpr ocs2::scalar_t precision = 1e-9;
+  // {stateDim, projectedInputDim}, where the state-input equality constraints reduce the input dimension below the bound of {24, 24}
+  for (const auto& dims : std::vector<std::pair<int, int>>{{12, 4}, {24, 24}, {24, 12}}) {
+    // time-varying data, such that the interpolation is covered
+    RiccatiInitializer ri(dims.first, dims.second);
+    const RiccatiInitializer ri2(dims.first, dims.second);
+    ri.projectedModelDataTrajectory.back() = ri2.projectedModelDataTrajectory.front();
+    ri.riccatiModificationTrajectory.back() = ri2.riccatiModificationTrajectory.front();
+    for (auto& riccatiModification : ri.riccatiModificationTrajectory) {
+      riccatiModification.deltaGm_.setRandom();
+      riccatiModification.deltaGv_.setRandom();
+    }
+
+    const ocs2::matrix_t SmNext = ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(dims.first);
+    const ocs2::vector_t SvNext = ocs2::vector_t::Random(dims.first);
+    const ocs2::vector_t S = ocs2::ContinuousTimeRiccatiEquations::convert2Vector(SmNext, SvNext, 2.0);
+
+    for (const bool reducedFormRiccati : {true, false}) {
+      // SLQ
+      ocs2::ContinuousTimeRiccatiEquations dynamicSize(reducedFormRiccati);
+      ocs2::ContinuousTimeRiccatiEquations fixedSize(reducedFormRiccati, false, true);
+      ri.initialize(dynamicSize);
+      ri.initialize(fixedSize);
+      const ocs2::vector_t dSdz_dynamicSize = dynamicSize.computeFlowMap(-0.6, S);
+      const ocs2::vector_t dSdz_fixedSize = fixedSize.computeFlowMap(-0.6, S);
+      EXPECT_TRUE(dSdz_fixedSize.isApprox(dSdz_dynamicSize, precision));
+
+      // ILQR
+      ocs2::DiscreteTimeRiccatiEquations dynamicSizeILQR(reducedFormRiccati);
+      ocs2::DiscreteTimeRiccatiEquations fixedSizeILQR(reducedFormRiccati, false, true);
+      ocs2::matrix_t projectedKm[2], Sm[2];
+      ocs2::vector_t projectedLv[2], Sv[2];
+      ocs2::scalar_t s[2];
+      dynamicSizeILQR.computeMap(ri.projectedModelDataTrajectory.front(), ri.riccatiModificationTrajectory.front(), SmNext, SvNext, 2.0,
+                                 projectedKm[0], projectedLv[0], Sm[0], Sv[0], s[0]);
+      fixedSizeILQR.computeMap(ri.projectedModelDataTrajectory.front(), ri.riccatiModificationTrajectory.front(), SmNext, SvNext, 2.0,
+                               projectedKm[1], projectedLv[1], Sm[1], Sv[1], s[1]);
+      EXPECT_TRUE(projectedKm[1].isApprox(projectedKm[0], precision));
+      EXPECT_TRUE(projectedLv[1].isApprox(projectedLv[0], precision));
+      EXPECT_TRUE(Sm[1].isApprox(Sm[0], precision));
+      EXPECT_TRUE(Sv[1].isApprox(Sv[0], precision));
+      EXPECT_NEAR(s[1], s[0], precision * std::abs(s[0]));
+    }
+  }
+
+  // no instantiation for these dimensions: falls back to the dynamic-size kernels
+  RiccatiInitializer ri(10, 3);
+  ocs2::ContinuousTimeRiccatiEquations dynamicSize(true);
+  ocs2::ContinuousTimeRiccatiEquations fixedSize(true, false, true);
+  ri.initialize(dynamicSize);
+  ri.initialize(fixedSize);
+  const ocs2::vector_t S = ocs2::vector_t::Random(ocs2::s_vector_dim(10));
+  EXPECT_TRUE(fixedSize.computeFlowMap(-0.6, S).isApprox(dynamicSize.computeFlowMap(-0.6, S)));
+}
+
 TEST(RiccatiTest, testFlattenSMatrix) {
   const int stateDim = 4;
   using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
@@ -155,3 +217,155 @@ TEST(RiccatiTest, testFlattenAndUnflatten) {
   ASSERT_TRUE(Sv.isApprox(Sv_out));
   ASSERT_TRUE(Sm.isApprox(Sm_out));
 }
+
+TEST(RiccatiTest, testFlattenAndUnflattenSensitivity) {
+  const int stateDim = 7;
+  using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
+
+  auto valueFunction = ocs2::ScalarFunctionQuadraticApproximation::Zero(stateDim);
+  valueFunction.dfdxx = ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(stateDim);
+  valueFunction.dfdx.setRandom(stateDim);
+  valueFunction.f = ocs2::vector_t::Random(1)(0);
+  ocs2::riccati_sensitivity::Data sensitivity;
+  sensitivity.M.setRandom(stateDim, stateDim);
+  sensitivity.N.setRandom(stateDim, stateDim);
+  sensitivity.n.setRandom(stateDim);
+
+  const ocs2::vector_t allSs = riccati_t::convert2Vector(valueFunction, sensitivity);
+  ASSERT_EQ(allSs.size(), ocs2::s_vector_dim(stateDim) + ocs2::sensitivity_vector_dim(stateDim));
+
+  ocs2::ScalarFunctionQuadraticApproximation valueFunction_out;
+  ocs2::riccati_sensitivity::Data sensitivity_out;
+  riccati_t::convert2Matrix(allSs, valueFunction_out, sensitivity_out);
+
+  EXPECT_EQ(valueFunction.f, valueFunction_out.f);
+  EXPECT_TRUE(valueFunction.dfdx.isApprox(valueFunction_out.dfdx));
+  EXPECT_TRUE(valueFunction.dfdxx.isApprox(valueFunction_out.dfdxx));
+  EXPECT_TRUE(sensitivity.M.isApprox(sensitivity_out.M));
+  EXPECT_TRUE(sensitivity.N.isApprox(sensitivity_out.N));
+  EXPECT_TRUE(sensitivity.n.isApprox(sensitivity_out.n));
+}
+
+TEST(RiccatiTest, correctWithTerminalSensitivity) {
+  constexpr int STATE_DIM = 6;
+  constexpr int INPUT_DIM = 3;
+  constexpr ocs2::scalar_t absTol = 1e-12;
+  constexpr ocs2::scalar_t relTol = 1e-10;
+  using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
+
+  RiccatiInitializer ri(STATE_DIM, INPUT_DIM);
+  auto integratorPtr = ocs2::newIntegrator(ocs2::IntegratorType::ODE45);
+
+  // Integrates backwards in time from t = 1 to t = 0, i.e. from z = -1 to z = 0
+  auto solve = [&](bool computeTerminalSensitivity, const ocs2::vector_t& allSsFinal) {
+    riccati_t riccatiEquation(true);
+    ri.initialize(riccatiEquation, computeTerminalSensitivity);
+    ocs2::vector_array_t allSsTrajectory;
+    ocs2::Observer observer(&allSsTrajectory);
+    integratorPtr->integrateAdaptive(riccatiEquation, observer, allSsFinal, -1.0, 0.0, 1e-3, absTol, relTol);
+    return allSsTrajectory.back();
+  };
+
+  auto getRandomValueFunction = []() {
+    auto valueFunction = ocs2::ScalarFunctionQuadraticApproximation::Zero(STATE_DIM);
+    valueFunction.dfdxx = ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(STATE_DIM);
+    valueFunction.dfdx.setRandom(STATE_DIM);
+    return valueFunction;
+  };
+  const auto finalGuess = getRandomValueFunction();
+  const auto finalValueFunction = getRandomValueFunction();
+
+  // solution for the guess, with sensitivity
+  ocs2::ScalarFunctionQuadraticApproximation initialGuess;
+  ocs2::riccati_sensitivity::Data sensitivity;
+  const auto finalSensitivity = ocs2::riccati_sensitivity::Data::Identity(STATE_DIM);
+  riccati_t::convert2Matrix(solve(true, riccati_t::convert2Vector(finalGuess, finalSensitivity)), initialGuess, sensitivity);
+
+  // exact solution
+  ocs2::ScalarFunctionQuadraticApproximation initialValueFunction;
+  riccati_t::convert2Matrix(solve(false, riccati_t::convert2Vector(finalValueFunction)), initialValueFunction);
+
+  // the guess with sensitivity also matches the solution without it
+  ocs2::ScalarFunctionQuadraticApproximation initialGuessCheck;
+  riccati_t::convert2Matrix(solve(false, riccati_t::convert2Vector(finalGuess)), initialGuessCheck);
+  EXPECT_TRUE(initialGuess.dfdxx.isApprox(initialGuessCheck.dfdxx, 1e-6));
+  EXPECT_TRUE(initialGuess.dfdx.isApprox(initialGuessCheck.dfdx, 1e-6));
+
+  const auto corrected = ocs2::riccati_sensitivity::correctInitialValueFunction(initialGuess, sensitivity, finalGuess, finalValueFunction);
+  EXPECT_TRUE(corrected.dfdxx.isApprox(initialValueFunction.dfdxx, 1e-6)) << "corrected:\n"
+                                                                          << corrected.dfdxx << "\nexact:\n"
+                                                                          << initialValueFunction.dfdxx;
+  EXPECT_TRUE(corrected.dfdx.isApprox(initialValueFunction.dfdx, 1e-6)) << "corrected:\n"
+                                                                        << corrected.dfdx.transpose() << "\nexact:\n"
+                                                                        << initialValueFunction.dfdx.transpose();
+}
+
+TEST(RiccatiTest, fixedStepIntegrator) {
+  constexpr int STATE_DIM = 6;
+  constexpr int INPUT_DIM = 3;
+  constexpr ocs2::scalar_t absTol = 1e-12;
+  constexpr ocs2::scalar_t relTol = 1e-10;
+  using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
+
+  // time-varying data with an event at t = 0.5
+  RiccatiInitializer ri(STATE_DIM, INPUT_DIM);
+  const RiccatiInitializer ri2(STATE_DIM, INPUT_DIM);
+  const auto& modelData1 = ri.projectedModelDataTrajectory.front();
+  const auto& modelData2 = ri2.projectedModelDataTrajectory.front();
+  const auto& modification1 = ri.riccatiModificationTrajectory.front();
+  const auto& modification2 = ri2.riccatiModificationTrajectory.front();
+  ri.timeStamp = ocs2::scalar_array_t{0.0, 0.5, 0.5, 1.0};
+  ri.projectedModelDataTrajectory = std::vector<ocs2::ModelData>{modelData1, modelData2, modelData2, modelData1};
+  ri.riccatiModificationTrajectory =
+      std::vector<ocs2::riccati_modification::Data>{modification1, modification2, modification2, modification1};
+  ri.eventsPastTheEndIndeces = ocs2::size_array_t{2};
+  ocs2::ModelData jumpModelData;
+  jumpModelData.dynamics.dfdx = ocs2::matrix_t::Random(STATE_DIM, STATE_DIM);
+  jumpModelData.dynamicsBias = ocs2::vector_t::Random(STATE_DIM);
+  jumpModelData.cost.f = ocs2::vector_t::Random(1)(0);
+  jumpModelData.cost.dfdx = ocs2::vector_t::Random(STATE_DIM);
+  jumpModelData.cost.dfdxx = ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(STATE_DIM);
+  ri.modelDataEventTimesArray = std::vector<ocs2::ModelData>{jumpModelData};
+
+  auto finalValueFunction = ocs2::ScalarFunctionQuadraticApproximation::Zero(STATE_DIM);
+  finalValueFunction.dfdxx = ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(STATE_DIM);
+  finalValueFunction.dfdx.setRandom(STATE_DIM);
+
+  // reference solution with the adaptive integrator
+  riccati_t riccatiEquation(false);
+  ri.initialize(riccatiEquation, true);
+  auto integratorPtr = ocs2::newIntegrator(ocs2::IntegratorType::ODE45);
+  ocs2::vector_array_t allSsTrajectory;
+  ocs2::Observer observer(&allSsTrajectory);
+  const auto finalSensitivity = ocs2::riccati_sensitivity::Data::Identity(STATE_DIM);
+  integratorPtr->integrateAdaptive(riccatiEquation, observer, riccati_t::convert2Vector(finalValueFunction, finalSensitivity), -1.0, -0.5,
+                                   1e-3, absTol, relTol);
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> valueFunctionRef(3);
+  ocs2::riccati_sensitivity::Data sensitivityRef;
+  riccati_t::convert2Matrix(allSsTrajectory.back(), valueFunctionRef[2], sensitivityRef);
+  const ocs2::vector_t allSsPreEvent = riccatiEquation.computeJumpMap(-0.5, allSsTrajectory.back());
+  riccati_t::convert2Matrix(allSsPreEvent, valueFunctionRef[1], sensitivityRef);
+  integratorPtr->integrateAdaptive(riccatiEquation, observer, allSsPreEvent, -0.5, 0.0, 1e-3, absTol, relTol);
+  riccati_t::convert2Matrix(allSsTrajectory.back(), valueFunctionRef[0], sensitivityRef);
+
+  // fixed-step integrator
+  ocs2::FixedStepRiccatiIntegrator fixedStepIntegrator(false);
+  fixedStepIntegrator.setData(&ri.timeStamp, &ri.projectedModelDataTrajectory, &ri.eventsPastTheEndIndeces, &ri.modelDataEventTimesArray,
+                              &ri.riccatiModificationTrajectory);
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> valueFunctionTrajectory(ri.timeStamp.size());
+  fixedStepIntegrator.integrate({0, 3}, 1e-3, finalValueFunction, valueFunctionTrajectory);
+  ocs2::ScalarFunctionQuadraticApproximation initialValueFunction;
+  ocs2::riccati_sensitivity::Data sensitivity;
+  fixedStepIntegrator.integrate({0, 3}, 1e-3, finalValueFunction, initialValueFunction, sensitivity);
+
+  for (size_t k = 0; k < valueFunctionRef.size(); k++) {
+    EXPECT_TRUE(valueFunctionTrajectory[k].dfdxx.isApprox(valueFunctionRef[k].dfdxx, 1e-6)) << "k: " << k;
+    EXPECT_TRUE(valueFunctionTrajectory[k].dfdx.isApprox(valueFunctionRef[k].dfdx, 1e-6)) << "k: " << k;
+    EXPECT_NEAR(valueFunctionTrajectory[k].f, valueFunctionRef[k].f, 1e-6) << "k: " << k;
+  }
+  EXPECT_TRUE(initialValueFunction.dfdxx.isApprox(valueFunctionRef[0].dfdxx, 1e-6));
+  EXPECT_TRUE(initialValueFunction.dfdx.isApprox(valueFunctionRef[0].dfdx, 1e-6));
+  EXPECT_TRUE(sensitivity.M.isApprox(sensitivityRef.M, 1e-6));
+  EXPECT_TRUE(sensitivity.N.isApprox(sensitivityRef.N, 1e-6));
+  EXPECT_TRUE(sensitivity.n.isApprox(sensitivityRef.n, 1e-6));
+}
@@ -0,0 +1,180 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+/*
+ * Benchmark of the compile-time sized LQ kernels against the dynamic-size ones. Built as a plain executable, it is not run as part of
+ * the tests. The equivalence of both paths is tested in testDdpHelperFunction and RiccatiTest.
+ */
+
+#include <iostream>
+#include <string>
+
+#include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/misc/randomMatrices.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+#include <ocs2_ddp/DDP_HelperFunctions.h>
+#include <ocs2_ddp/FixedSizeLQKernels.h>
+#include <ocs2_ddp/riccati_equations/ContinuousTimeRiccatiEquations.h>
+#include <ocs2_ddp/riccati_equations/DiscreteTimeRiccatiEquations.h>
+
+using namespace ocs2;
+
+namespace {
+
+constexpr int numRepetitions = 10000;
+
+template <typename Function>
+benchmark::RepeatedTimer measure(Function function) {
+  // warm up
+  for (int i = 0; i < 100; i++) {
+    function();
+  }
+
+  benchmark::RepeatedTimer timer;
+  for (int i = 0; i < numRepetitions; i++) {
+    timer.startTimer();
+    function();
+    timer.endTimer();
+  }
+  return timer;
+}
+
+void print(const std::string& kernel, int stateDim, int inputDim, const benchmark::RepeatedTimer& dynamicSizeTimer,
+           const benchmark::RepeatedTimer& fixedSizeTimer) {
+  std::cout << "[benchmarkFixedSizeKernels] " << kernel << " nx = " << stateDim << ", nu = " << inputDim << ":\t dynamic "
+            << 1e3 * dynamicSizeTimer.getAverageInMilliseconds() << " [us], fixed " << 1e3 * fixedSizeTimer.getAverageInMilliseconds()
+            << " [us]\n";
+}
+
+/** Projected model data with random values. */
+ModelData getRandomModelData(int stateDim, int inputDim, int numConstraints) {
+  ModelData modelData;
+  modelData.stateDim = stateDim;
+  modelData.inputDim = inputDim;
+  modelData.dynamics = getRandomDynamics(stateDim, inputDim);
+  modelData.dynamicsBias = vector_t::Random(stateDim);
+  modelData.cost = getRandomCost(stateDim, inputDim);
+  modelData.stateInputEqConstraint = getRandomConstraints(stateDim, inputDim, numConstraints);
+  return modelData;
+}
+
+riccati_modification::Data getRandomRiccatiModification(int stateDim, int inputDim) {
+  riccati_modification::Data riccatiModification;
+  riccatiModification.deltaQm_ = 0.1 * LinearAlgebra::generateSPDmatrix<matrix_t>(stateDim);
+  riccatiModification.deltaGm_.setRandom(inputDim, stateDim);
+  riccatiModification.deltaGv_.setRandom(inputDim);
+  return riccatiModification;
+}
+
+void benchmarkDiscretization(int stateDim, int inputDim) {
+  const auto dynamicsPtr = getOcs2Dynamics(getRandomDynamics(stateDim, inputDim));
+  const vector_t x = vector_t::Random(stateDim);
+  const vector_t u = vector_t::Random(inputDim);
+  const auto discretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+
+  VectorFunctionLinearApproximation discreteDynamics;
+  const auto dynamicSizeTimer = measure([&]() { discreteDynamics = discretizer(*dynamicsPtr, 0.0, x, u, 0.01); });
+  const auto fixedSizeTimer = measure([&]() {
+    fixed_size_lq::sensitivityDiscretization(SensitivityIntegratorType::RK4, *dynamicsPtr, 0.0, x, u, 0.01, discreteDynamics);
+  });
+  print("RK4 discretization", stateDim, inputDim, dynamicSizeTimer, fixedSizeTimer);
+}
+
+void benchmarkProjectLQ(int stateDim, int inputDim, int numConstraints) {
+  const auto modelData = getRandomModelData(stateDim, inputDim, numConstraints);
+  const matrix_t constraintRangeProjector = matrix_t::Random(inputDim, numConstraints);
+  const matrix_t constraintNullProjector = matrix_t::Random(inputDim, inputDim - numConstraints);
+
+  ModelData projectedModelData;
+  const auto dynamicSizeTimer =
+      measure([&]() { projectLQ(modelData, constraintRangeProjector, constraintNullProjector, projectedModelData); });
+  const auto fixedSizeTimer =
+      measure([&]() { fixed_size_lq::projectLQ(modelData, constraintRangeProjector, constraintNullProjector, projectedModelData); });
+  print("projectLQ (" + std::to_string(numConstraints) + " constraints)", stateDim, inputDim, dynamicSizeTimer, fixedSizeTimer);
+}
+
+void benchmarkRiccati(int stateDim, int projectedInputDim, bool reducedFormRiccati) {
+  const scalar_array_t timeStamp{0.0, 1.0};
+  const std::vector<ModelData> projectedModelDataTrajectory{getRandomModelData(stateDim, projectedInputDim, 0),
+                                                            getRandomModelData(stateDim, projectedInputDim, 0)};
+  const std::vector<riccati_modification::Data> riccatiModificationTrajectory{getRandomRiccatiModification(stateDim, projectedInputDim),
+                                                                              getRandomRiccatiModification(stateDim, projectedInputDim)};
+  const size_array_t eventsPastTheEndIndeces;
+  const std::vector<ModelData> modelDataEventTimes;
+  const matrix_t SmNext = LinearAlgebra::generateSPDmatrix<matrix_t>(stateDim);
+  const vector_t SvNext = vector_t::Random(stateDim);
+  const std::string form = reducedFormRiccati ? " (reduced form)" : " (full form)";
+
+  // SLQ
+  ContinuousTimeRiccatiEquations dynamicSize(reducedFormRiccati);
+  ContinuousTimeRiccatiEquations fixedSize(reducedFormRiccati, false, true);
+  for (auto* riccatiEquations : {&dynamicSize, &fixedSize}) {
+    riccatiEquations->setData(&timeStamp, &projectedModelDataTrajectory, &eventsPastTheEndIndeces, &modelDataEventTimes,
+                              &riccatiModificationTrajectory, false);
+  }
+  const vector_t S = ContinuousTimeRiccatiEquations::convert2Vector(SmNext, SvNext, 2.0);
+  vector_t dSdz;
+  const auto dynamicSizeTimer = measure([&]() { dSdz = dynamicSize.computeFlowMap(-0.6, S); });
+  const auto fixedSizeTimer = measure([&]() { dSdz = fixedSize.computeFlowMap(-0.6, S); });
+  print("SLQ Riccati flow map" + form, stateDim, projectedInputDim, dynamicSizeTimer, fixedSizeTimer);
+
+  // ILQR
+  DiscreteTimeRiccatiEquations dynamicSizeILQR(reducedFormRiccati);
+  DiscreteTimeRiccatiEquations fixedSizeILQR(reducedFormRiccati, false, true);
+  matrix_t projectedKm, Sm;
+  vector_t projectedLv, Sv;
+  scalar_t s;
+  auto computeMap = [&](DiscreteTimeRiccatiEquations& riccatiEquations) {
+    riccatiEquations.computeMap(projectedModelDataTrajectory.front(), riccatiModificationTrajectory.front(), SmNext, SvNext, 2.0,
+                                projectedKm, projectedLv, Sm, Sv, s);
+  };
+  const auto dynamicSizeTimerILQR = measure([&]() { computeMap(dynamicSizeILQR); });
+  const auto fixedSizeTimerILQR = measure([&]() { computeMap(fixedSizeILQR); });
+  print("ILQR Riccati map" + form, stateDim, projectedInputDim, dynamicSizeTimerILQR, fixedSizeTimerILQR);
+}
+
+}  // unnamed namespace
+
+int main() {
+  // quadrotor
+  benchmarkDiscretization(12, 4);
+  benchmarkProjectLQ(12, 4, 0);
+  benchmarkRiccati(12, 4, true);
+  benchmarkRiccati(12, 4, false);
+
+  // legged robot centroidal model, where the state-input equality constraints reduce the projected input dimension
+  benchmarkDiscretization(24, 24);
+  benchmarkProjectLQ(24, 24, 12);
+  benchmarkRiccati(24, 12, true);
+  benchmarkRiccati(24, 12, false);
+  return 0;
+}
@@ -27,11 +27,17 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <array>
+#include <cmath>
 #include <iostream>
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
 #include <ocs2_ddp/DDP_HelperFunctions.h>
+#include <ocs2_ddp/FixedSizeLQKernels.h>
 
 using namespace ocs2;
 
@@ -99,3 +105,73 @@ TEST(extractPrimalSolution, eventAtInitTime) {
   //  std::cerr << ">>>>>> Test 3\n" << PrimalSolutionTest3 << "\n";
   EXPECT_EQ(PrimalSolutionTest3.timeTrajectory_.size(), 1);
 }
+
+namespace {
+bool isApprox(const VectorFunctionLinearApproximation& lhs, const VectorFunctionLinearApproximation& rhs, scalar_t precision) {
+  return lhs.f.isApprox(rhs.f, precision) && lhs.dfdx.isApprox(rhs.dfdx, precision) && lhs.dfdu.isApprox(rhs.dfdu, precision);
+}
+
+bool isApprox(const ScalarFunctionQuadraticApproximation& lhs, const ScalarFunctionQuadraticApproximation& rhs, scalar_t precision) {
+  return std::abs(lhs.f - rhs.f) <= precision * std::abs(rhs.f) && lhs.dfdx.isApprox(rhs.dfdx, precision) &&
+         lhs.dfdu.isApprox(rhs.dfdu, precision) && lhs.dfdxx.isApprox(rhs.dfdxx, precision) &&
+         lhs.dfdux.isApprox(rhs.dfdux, precision) && lhs.dfduu.isApprox(rhs.dfduu, precision);
+}
+}  // unnamed namespace
+
+TEST(projectLQ, fixedSizeKernels) {
+  constexpr scalar_t precision = 1e-9;
+  // {stateDim, inputDim, numConstraints}
+  for (const auto& dims : std::vector<std::array<int, 3>>{{12, 4, 0}, {12, 4, 2}, {24, 24, 0}, {24, 24, 12}}) {
+    const int stateDim = dims[0];
+    const int inputDim = dims[1];
+    const int numConstraints = dims[2];
+
+    ModelData modelData;
+    modelData.stateDim = stateDim;
+    modelData.inputDim = inputDim;
+    modelData.dynamics = getRandomDynamics(stateDim, inputDim);
+    modelData.dynamicsBias = vector_t::Random(stateDim);
+    modelData.cost = getRandomCost(stateDim, inputDim);
+    modelData.stateInputEqConstraint = getRandomConstraints(stateDim, inputDim, numConstraints);
+    const matrix_t constraintRangeProjector = matrix_t::Random(inputDim, numConstraints);
+    const matrix_t constraintNullProjector = matrix_t::Random(inputDim, inputDim - numConstraints);
+
+    ModelData dynamicSize;
+    projectLQ(modelData, constraintRangeProjector, constraintNullProjector, dynamicSize);
+    ModelData fixedSize;
+    ASSERT_TRUE(fixed_size_lq::projectLQ(modelData, constraintRangeProjector, constraintNullProjector, fixedSize));
+
+    EXPECT_EQ(fixedSize.inputDim, dynamicSize.inputDim);
+    EXPECT_TRUE(isApprox(fixedSize.dynamics, dynamicSize.dynamics, precision));
+    EXPECT_TRUE(fixedSize.dynamicsBias.isApprox(dynamicSize.dynamicsBias, precision));
+    EXPECT_TRUE(isApprox(fixedSize.cost, dynamicSize.cost, precision));
+    EXPECT_TRUE(isApprox(fixedSize.stateInputEqConstraint, dynamicSize.stateInputEqConstraint, precision));
+  }
+
+  // no instantiation for these dimensions
+  ModelData modelData;
+  modelData.stateDim = 10;
+  modelData.inputDim = 3;
+  modelData.dynamics = getRandomDynamics(10, 3);
+  modelData.dynamicsBias = vector_t::Random(10);
+  ModelData projectedModelData;
+  EXPECT_FALSE(fixed_size_lq::projectLQ(modelData, matrix_t(3, 0), matrix_t::Identity(3, 3), projectedModelData));
+}
+
+TEST(sensitivityDiscretization, fixedSizeKernels) {
+  constexpr scalar_t precision = 1e-9;
+  constexpr scalar_t t = 0.5;
+  constexpr scalar_t dt = 0.01;
+  for (const auto& dims : std::vector<std::array<int, 2>>{{12, 4}, {24, 24}, {24, 6}}) {
+    const auto dynamicsPtr = getOcs2Dynamics(getRandomDynamics(dims[0], dims[1]));
+    const vector_t x = vector_t::Random(dims[0]);
+    const vector_t u = vector_t::Random(dims[1]);
+
+    for (const auto type : {SensitivityIntegratorType::EULER, SensitivityIntegratorType::RK2, SensitivityIntegratorType::RK4}) {
+      const auto dynamicSize = selectDynamicsSensitivityDiscretization(type)(*dynamicsPtr, t, x, u, dt);
+      VectorFunctionLinearApproximation fixedSize;
+      ASSERT_TRUE(fixed_size_lq::sensitivityDiscretization(type, *dynamicsPtr, t, x, u, dt, fixedSize));
+      EXPECT_TRUE(isApprox(fixedSize, dynamicSize, precision));
+    }
+  }
+}
@@ -67,6 +67,14 @@ class MPC_BASE {
    */
   virtual bool run(scalar_t currentTime, const vector_t& currentState);
 
+  /**
+   * Prepares the next run() call before its state is known, e.g., the preparation phase of a real-time iteration scheme. This moves work
+   * out of the time between receiving the state and providing the policy. The default implementation does nothing.
+   *
+   * @param [in] nextTime: The expected time of the next run() call.
+   */
+  virtual void prepareNextRun(scalar_t nextTime) {}
+
   /** Gets a pointer to the underlying solver used in the MPC. */
   virtual SolverBase* getSolverPtr() = 0;
 
@@ -49,6 +49,14 @@ struct Settings {
    * */
   scalar_t solutionTimeWindow_ = -1;
 
+  /**
+   * The wall-clock time budget (in seconds) of the solver in each MPC run. The solver terminates with its best feasible iterate when
+   * its next iteration, predicted from the timing of the previous ones, does not fit into the budget. A positive value is passed to
+   * the solver once at the construction of the MPC, such that a budget set later through SolverBase::setTimeBudget is kept. Any
+   * non-positive number leaves the solver's own budget (disabled by default) untouched.
+   */
+  scalar_t timeBudget_ = -1;
+
   /** This value determines to display the log output of MPC. */
   bool debugPrint_ = false;
 
@@ -34,14 +34,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <atomic>
 #include <cstddef>
 #include <memory>
-#include <mutex>
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/ControllerBase.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/reference/ModeSchedule.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_core/thread_support/TripleBuffer.h>
 #include <ocs2_oc/oc_data/PerformanceIndex.h>
+#include <ocs2_oc/oc_data/PolicyEvaluator.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 #include <ocs2_oc/rollout/RolloutBase.h>
 
@@ -54,6 +55,10 @@ namespace ocs2 {
 /**
  * This class implements core MRT (Model Reference Tracking) functionality.
  * The responsibility of filling the buffer variables is left to the deriving classes.
+ *
+ * The policies are exchanged through a wait-free triple buffer of preallocated slots. The deriving class fills a slot in place and
+ * publishes it, while updatePolicy() picks up the latest published slot with a single atomic exchange. Only one thread may fill the
+ * buffer and only one thread may call updatePolicy() and access the active policy.
  */
 class MRT_BASE {
  public:
@@ -63,6 +68,7 @@ class MRT_BASE {
 
   /**
    * Resets the class to its instantiated state.
+   * @note This method discards the active policy, therefore it should be called from the thread which calls updatePolicy().
    */
   void reset();
 
@@ -125,6 +131,23 @@ class MRT_BASE {
    */
   void evaluatePolicy(scalar_t currentTime, const vector_t& currentState, vector_t& mpcState, vector_t& mpcInput, size_t& mode);
 
+  /**
+   * @brief Evaluates the controller and its feedback gain.
+   *
+   * The evaluation caches the last queried time interval of the policy, so a sequence of increasing query times is evaluated with an
+   * O(1) amortized lookup. For linear and feedforward controllers, this method does not allocate heap memory once the output buffers
+   * have the correct sizes.
+   *
+   * @param [in] currentTime: the query time.
+   * @param [in] currentState: the query state.
+   * @param [out] mpcState: the current nominal state of MPC.
+   * @param [out] mpcInput: the optimized control input.
+   * @param [out] mpcFeedbackGain: the feedback gain of the controller. It is zero if the controller has no feedback gain.
+   * @param [out] mode: the active mode.
+   */
+  void evaluatePolicy(scalar_t currentTime, const vector_t& currentState, vector_t& mpcState, vector_t& mpcInput,
+                      matrix_t& mpcFeedbackGain, size_t& mode);
+
   /**
    * @brief Rolls out the control policy from the current time and state to get the next state and input using the MPC policy.
    *
@@ -143,6 +166,8 @@ class MRT_BASE {
    * is available on the buffer this method will load it to the in-use policy.
    * This method also calls the modifyActiveSolution() method.
    *
+   * This method is wait-free, i.e. it never blocks the thread which fills the buffer nor misses a published policy.
+   *
    * @return True if the policy is updated.
    */
   bool updatePolicy();
@@ -159,35 +184,43 @@ class MRT_BASE {
   void addMrtObserver(std::shared_ptr<MrtObserver> mrtObserver) { observerPtrArray_.push_back(std::move(mrtObserver)); };
 
  protected:
+  /** The data which is exchanged for each MPC policy. */
+  struct PolicyBuffer {
+    CommandData command;
+    PrimalSolution primalSolution;
+    PerformanceIndex performanceIndices;
+  };
+
+  /**
+   * Gets the buffer slot which can be filled in place with a new policy. The slot holds an older policy whose memory can be reused.
+   * It becomes available to updatePolicy() only after calling publishPolicyBuffer().
+   */
+  PolicyBuffer& getPolicyBufferToFill() { return policyBuffer_.getWriteBuffer(); }
+
+  /** Publishes the slot returned by getPolicyBufferToFill(). This method also calls the modifyBufferedSolution() method. */
+  void publishPolicyBuffer();
+
   void moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::unique_ptr<PrimalSolution> primalSolutionPtr,
                     std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
 
  private:
-  /** Calls modifyActiveSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** Calls modifyActiveSolution on all mrt observers. This function is called from the thread which calls updatePolicy() */
   void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution);
 
-  /** Calls modifyBufferedSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** Calls modifyBufferedSolution on all mrt observers. This function is called from the thread which fills the buffer */
   void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer);
 
   // flags on state of the class
   std::atomic_bool policyReceivedEver_;
-  bool newPolicyInBuffer_;  // whether a new policy is waiting to be swapped in
+  bool activePolicyValid_;  // whether updatePolicy() has loaded a policy since the last reset
 
   // variables related to the MPC output
-  std::unique_ptr<CommandData> activeCommandPtr_;
-  std::unique_ptr<CommandData> bufferCommandPtr_;
-  std::unique_ptr<PrimalSolution> activePrimalSolutionPtr_;
-  std::unique_ptr<PrimalSolution> bufferPrimalSolutionPtr_;
-  std::unique_ptr<PerformanceIndex> activePerformanceIndicesPtr_;
-  std::unique_ptr<PerformanceIndex> bufferPerformanceIndicesPtr_;
-
-  // thread safety
-  mutable std::mutex bufferMutex_;  // for policy variables with the prefix (buffer*)
-  const size_t mrtTrylockWarningThreshold_ = 5;
-  size_t mrtTrylockWarningCount_;
+  TripleBuffer<PolicyBuffer> policyBuffer_;
 
   // variables needed for policy evaluation
   std::unique_ptr<RolloutBase> rolloutPtr_;
+  PolicyEvaluator policyEvaluator_;
+  matrix_t mpcFeedbackGain_;
 
   std::vector<std::shared_ptr<MrtObserver>> observerPtrArray_;
 };
@@ -46,7 +46,10 @@ namespace ocs2 {
  * When a user requests an update, the in-use policy is swapped for the buffered policy.
  *      - At this point the "modifyActiveSolution" of this class is called.
  *
- * Both filling of the buffer and the update swapping are protected by the same mutex.
+ * The buffer is a wait-free triple buffer, therefore the two methods are not protected by a mutex. "modifyBufferedSolution" is called
+ * from the thread which provides the policies and "modifyActiveSolution" from the thread which calls updatePolicy. The two calls
+ * always work on different policies, but they can run simultaneously. An observer which shares data between them is responsible for
+ * its own synchronization.
  */
 class MrtObserver {
  public:
@@ -66,7 +69,7 @@ class MrtObserver {
    * This function is executed sequentially with updatePolicy and thus blocks the main thread. Computationally expensive modifications
    * should therefore rather be done in "modifyBufferedSolution".
    *
-   * A call to this function is protected by the same mutex as modifyBufferedSolution.
+   * A call to this function can run simultaneously with modifyBufferedSolution.
    */
   virtual void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution) {}
 
@@ -76,7 +79,7 @@ class MrtObserver {
    *
    * When using a multi-threaded MRT, this function does not block the main thread.
    *
-   * A call to this function is protected by the same mutex as modifyActiveSolution.
+   * A call to this function can run simultaneously with modifyActiveSolution.
    */
   virtual void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer) {}
 };
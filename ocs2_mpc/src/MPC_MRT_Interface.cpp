@@ -110,29 +110,34 @@ void MPC_MRT_Interface::advanceMpc() {
     std::cerr << "\n###   Average : " << mpcTimer_.getAverageInMilliseconds() << "[ms].";
     std::cerr << "\n###   Latest  : " << mpcTimer_.getLastIntervalInMilliseconds() << "[ms]." << std::endl;
   }
+
+  // prepare the next iteration while waiting for the next observation
+  const scalar_t mpcPeriod = (mpc_.settings().mpcDesiredFrequency_ > 0.0) ? 1.0 / mpc_.settings().mpcDesiredFrequency_
+                                                                          : mpcTimer_.getLastIntervalInMilliseconds() * 1e-3;
+  mpc_.prepareNextRun(currentObservation.time + mpcPeriod);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MPC_MRT_Interface::copyToBuffer(const SystemObservation& mpcInitObservation) {
+  // the buffer holds an old policy whose memory is reused
+  auto& policyBuffer = this->getPolicyBufferToFill();
+
   // policy
-  std::unique_ptr<PrimalSolution> primalSolutionPtr(new PrimalSolution);
   const scalar_t startTime = mpcInitObservation.time;
   const scalar_t finalTime =
       (mpc_.settings().solutionTimeWindow_ < 0) ? mpc_.getSolverPtr()->getFinalTime() : startTime + mpc_.settings().solutionTimeWindow_;
-  mpc_.getSolverPtr()->getPrimalSolution(finalTime, primalSolutionPtr.get());
+  mpc_.getSolverPtr()->getPrimalSolution(finalTime, &policyBuffer.primalSolution);
 
   // command
-  std::unique_ptr<CommandData> commandPtr(new CommandData);
-  commandPtr->mpcInitObservation_ = mpcInitObservation;
-  commandPtr->mpcTargetTrajectories_ = mpc_.getSolverPtr()->getReferenceManager().getTargetTrajectories();
+  policyBuffer.command.mpcInitObservation_ = mpcInitObservation;
+  policyBuffer.command.mpcTargetTrajectories_ = mpc_.getSolverPtr()->getReferenceManager().getTargetTrajectories();
 
   // performance indices
-  std::unique_ptr<PerformanceIndex> performanceIndicesPtr(new PerformanceIndex);
-  *performanceIndicesPtr = mpc_.getSolverPtr()->getPerformanceIndeces();
+  policyBuffer.performanceIndices = mpc_.getSolverPtr()->getPerformanceIndeces();
 
-  this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
+  this->publishPolicyBuffer();
 }
 
 /******************************************************************************************************/
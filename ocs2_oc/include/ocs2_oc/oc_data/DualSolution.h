@@ -29,7 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <algorithm>
+
 #include <ocs2_core/Types.h>
+#include <ocs2_core/misc/Numerics.h>
 #include <ocs2_core/model_data/Multiplier.h>
 
 namespace ocs2 {
@@ -94,6 +97,23 @@ struct DualSolutionConstRef {
   const std::vector<MultiplierCollection>& intermediates;
 };
 
+/**
+ * Checks whether the dual solution is defined on the given time grid node by node. This is the case for the successive rollouts
+ * of a fixed time grid (see rollout::Settings::useFixedTimeGrid) where the dual solution can be indexed by node instead of time.
+ *
+ * @param [in] dualSolution: The dual solution
+ * @param [in] timeTrajectory: The time grid
+ * @param [in] postEventIndices: The post event indices of the time grid
+ * @return True if the time stamps and the post event indices match.
+ */
+inline bool isDefinedOnTimeGrid(const DualSolution& dualSolution, const scalar_array_t& timeTrajectory, const size_array_t& postEventIndices) {
+  if (dualSolution.timeTrajectory.size() != timeTrajectory.size() || dualSolution.postEventIndices != postEventIndices) {
+    return false;
+  }
+  return std::equal(timeTrajectory.cbegin(), timeTrajectory.cend(), dualSolution.timeTrajectory.cbegin(),
+                    [](scalar_t t1, scalar_t t2) { return numerics::almost_eq(t1, t2); });
+}
+
 /**
  * Calculates the intermediate dual solution at the given time.
  *
@@ -0,0 +1,97 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+
+#include "ocs2_oc/oc_data/PrimalSolution.h"
+
+namespace ocs2 {
+
+/**
+ * Evaluates a policy (PrimalSolution) at a sequence of query times, e.g. in a control loop.
+ *
+ * The state trajectory, the controller and the mode schedule each keep a time cursor at the last queried interval. For monotonically
+ * increasing query times, the lookup therefore only moves the cursors by a few steps, i.e. it has an O(1) amortized cost. Queries
+ * which jump far ahead or go back in time fall back to a binary search.
+ *
+ * For LinearController and FeedforwardController policies, evaluate() does not allocate heap memory once the output buffers have the
+ * correct sizes. Other controller types are evaluated through ControllerBase::computeInput.
+ */
+class PolicyEvaluator {
+ public:
+  /** Default constructor, setPolicy should be called before evaluate. */
+  PolicyEvaluator() = default;
+
+  /**
+   * Sets the policy to evaluate and resets the time cursors.
+   * @note The evaluator keeps a reference to the policy, so it should outlive the evaluator or be replaced by another call to setPolicy.
+   *
+   * @param [in] primalSolution: The policy.
+   */
+  void setPolicy(const PrimalSolution& primalSolution);
+
+  /**
+   * Evaluates the policy in a single pass.
+   *
+   * @param [in] time: The query time.
+   * @param [in] state: The query state.
+   * @param [out] nominalState: The state trajectory of the policy interpolated at the query time.
+   * @param [out] input: The input of the controller.
+   * @param [out] feedbackGain: The feedback gain of the controller. It is set to zero if the controller has no feedback gain.
+   * @param [out] mode: The active mode at the query time.
+   */
+  void evaluate(scalar_t time, const vector_t& state, vector_t& nominalState, vector_t& input, matrix_t& feedbackGain, size_t& mode);
+
+ private:
+  /** Cached position in a sorted time array */
+  class TimeCursor {
+   public:
+    /** Moves the cursor to the given time and returns the index of the first element which is not smaller than the time. */
+    int lowerBound(const scalar_array_t& timeArray, scalar_t time);
+
+    void reset() { index_ = 0; }
+
+   private:
+    int index_ = 0;
+  };
+
+  const PrimalSolution* primalSolutionPtr_ = nullptr;
+  const LinearController* linearControllerPtr_ = nullptr;
+  const FeedforwardController* feedforwardControllerPtr_ = nullptr;
+
+  TimeCursor stateCursor_;
+  TimeCursor controllerCursor_;
+  TimeCursor modeCursor_;
+};
+
+}  // namespace ocs2
@@ -40,7 +40,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 
 /**
- * Initializes the dual solution based on the cached dual solution. It will use interpolation if cachedDualSolution has any component
+ * Initializes the dual solution based on the cached dual solution. If cachedDualSolution is defined on the time grid of primalSolution
+ * (see isDefinedOnTimeGrid), it is copied node by node. Otherwise, it will use interpolation if cachedDualSolution has any component
  * in the same mode otherwise it will use the Lagrangian initialization method of ocp.
  *
  * @param [in] ocp : A const reference to the optimal control problem.
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -141,6 +142,19 @@ class SolverBase {
     augmentedLagrangianObservers_.push_back(std::move(observerModule));
   }
 
+  /**
+   * Sets the wall-clock time budget of each run in seconds. Before starting a new iteration, the solver predicts the duration of the
+   * iteration from the previous ones and terminates if the iteration does not fit into the remaining budget. On such a termination,
+   * the solver returns the iterate with the lowest cost among the ones that satisfy its constraint tolerance, or its latest iterate
+   * if none of them does. The first iteration is always performed. Any non-positive number disables the time budget.
+   *
+   * @param [in] timeBudget: The time budget in seconds.
+   */
+  void setTimeBudget(scalar_t timeBudget) { timeBudget_ = timeBudget; }
+
+  /** Gets the wall-clock time budget of each run in seconds. */
+  scalar_t getTimeBudget() const { return timeBudget_; }
+
   /**
    * @brief Returns a const reference to the definition of optimal control problem.
    *
@@ -254,6 +268,15 @@ class SolverBase {
    */
   void printString(const std::string& text) const;
 
+ protected:
+  /**
+   * Checks whether an iteration with the given expected duration still fits into the time budget of the current run. It is always true
+   * if the time budget is disabled.
+   *
+   * @param [in] expectedDurationInMilliseconds: The expected duration of the next iteration.
+   */
+  bool fitsInTimeBudget(scalar_t expectedDurationInMilliseconds) const;
+
  private:
   virtual void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) = 0;
 
@@ -269,6 +292,8 @@ class SolverBase {
    * Variables
    ***********/
   mutable std::mutex outputDisplayGuardMutex_;
+  scalar_t timeBudget_ = 0.0;
+  std::chrono::steady_clock::time_point runStartTime_;
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;  // this pointer cannot be nullptr
   std::vector<std::shared_ptr<SolverSynchronizedModule>> synchronizedModules_;
   std::vector<std::unique_ptr<AugmentedLagrangianObserver>> augmentedLagrangianObservers_;
@@ -53,6 +53,11 @@ struct Settings {
   scalar_t timeStep = 1e-2;
   /** Rollout integration scheme type */
   IntegratorType integratorType = IntegratorType::ODE45;
+  /** Whether the time-triggered rollout should use a fixed time grid. The grid is aligned with the event times and uses equal steps of
+   * at most timeStep within each mode, so it stays the same for all rollouts with the same horizon and mode schedule. The integration
+   * scheme on this grid is RK4 and integratorType is ignored. DDP then reuses its dual solution node by node without trajectory
+   * spreading. Together with ddp.useFixedStepRiccatiIntegrator, the SLQ backward pass is also indexed by node. */
+  bool useFixedTimeGrid = false;
 
   /** Whether to check that the rollout is numerically stable */
   bool checkNumericalStability = false;
@@ -69,6 +69,20 @@ class TimeTriggeredRollout : public RolloutBase {
                vector_array_t& inputTrajectory) override;
 
  private:
+  /**
+   * Integrates the controlled system with RK4 on a fixed grid of equal steps of at most timeStep between the start and final time.
+   * The grid nodes, including both ends, are appended to the output trajectories.
+   *
+   * @param [in] initState: The state at the start time.
+   * @param [in] startTime: The start time of the interval.
+   * @param [in] finalTime: The final time of the interval.
+   * @param [in] numSteps: The number of integration steps.
+   * @param [out] timeTrajectory: The time trajectory to be extended.
+   * @param [out] stateTrajectory: The state trajectory to be extended.
+   */
+  void integrateFixedTimeGrid(const vector_t& initState, scalar_t startTime, scalar_t finalTime, size_t numSteps,
+                              scalar_array_t& timeTrajectory, vector_array_t& stateTrajectory);
+
   std::unique_ptr<PreComputation> preCompPtr_;
   std::unique_ptr<ControlledSystemBase> systemDynamicsPtr_;
 
@@ -48,6 +48,7 @@ struct FilterLinesearch {
   scalar_t g_min = 1e-6;         // (2): ELSE IF (g{i} < g_min AND g{i+1} < g_min AND dc/dw'{i} * delta_w < 0) REQUIRE Armijo condition
   scalar_t gamma_c = 1e-6;       // (3): ELSE REQUIRE c{i+1} < (c{i} - gamma_c * g{i}) OR g{i+1} < (1-gamma_c) * g{i}
   scalar_t armijoFactor = 1e-4;  // Armijo condition: c{i+1} < c{i} + armijoFactor * armijoDescentMetric{i}
+  bool includeInequalityConstraints = false;  // Include the inequality constraints in g, e.g. when they are hard constraints of the QP
 
   /**
    * Checks that the step is accepted.
@@ -60,8 +61,9 @@ struct FilterLinesearch {
                                        scalar_t armijoDescentMetric) const;
 
   /** Compute total constraint violation */
-  static scalar_t totalConstraintViolation(const PerformanceIndex& performance) {
-    return std::sqrt(performance.dynamicsViolationSSE + performance.equalityConstraintsSSE);
+  scalar_t totalConstraintViolation(const PerformanceIndex& performance) const {
+    const scalar_t inequalityConstraintsSSE = includeInequalityConstraints ? performance.inequalityConstraintsSSE : 0.0;
+    return std::sqrt(performance.dynamicsViolationSSE + performance.equalityConstraintsSSE + inequalityConstraintsSSE);
   }
 };
 
@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/oc_data/DualSolution.h>
 #include <ocs2_oc/oc_data/LoopshapingPrimalSolution.h>
 #include <ocs2_oc/oc_data/PerformanceIndex.h>
+#include <ocs2_oc/oc_data/PolicyEvaluator.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 
 // oc_problem
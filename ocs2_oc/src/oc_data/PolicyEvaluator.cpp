@@ -0,0 +1,140 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/oc_data/PolicyEvaluator.h"
+
+#include <algorithm>
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+namespace ocs2 {
+
+namespace {
+
+/** Interpolates into the given output. Same as LinearInterpolation::interpolate, but without creating a new object. */
+template <typename Data, class Alloc>
+void interpolateInto(LinearInterpolation::index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataArray, Data& output) {
+  if (dataArray.size() > 1) {
+    const auto& lhs = dataArray[indexAlpha.first];
+    const auto& rhs = dataArray[indexAlpha.first + 1];
+    if (lhs.rows() == rhs.rows() && lhs.cols() == rhs.cols()) {
+      output = indexAlpha.second * lhs + (scalar_t(1.0) - indexAlpha.second) * rhs;
+    } else {
+      output = (indexAlpha.second > 0.5) ? lhs : rhs;
+    }
+  } else {
+    output = dataArray.front();
+  }
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+int PolicyEvaluator::TimeCursor::lowerBound(const scalar_array_t& timeArray, scalar_t time) {
+  // number of linear steps before switching to a binary search
+  constexpr int maxNumSteps = 8;
+
+  const int size = timeArray.size();
+  index_ = std::min(index_, size);
+
+  if (index_ > 0 && timeArray[index_ - 1] >= time) {
+    // going back in time
+    index_ = std::lower_bound(timeArray.begin(), timeArray.begin() + index_, time) - timeArray.begin();
+  } else {
+    const int lastStep = std::min(index_ + maxNumSteps, size);
+    while (index_ < lastStep && timeArray[index_] < time) {
+      ++index_;
+    }
+    if (index_ == lastStep && index_ < size) {
+      index_ = std::lower_bound(timeArray.begin() + index_, timeArray.end(), time) - timeArray.begin();
+    }
+  }
+
+  return index_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyEvaluator::setPolicy(const PrimalSolution& primalSolution) {
+  primalSolutionPtr_ = &primalSolution;
+  linearControllerPtr_ = dynamic_cast<const LinearController*>(primalSolution.controllerPtr_.get());
+  feedforwardControllerPtr_ = dynamic_cast<const FeedforwardController*>(primalSolution.controllerPtr_.get());
+
+  stateCursor_.reset();
+  controllerCursor_.reset();
+  modeCursor_.reset();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyEvaluator::evaluate(scalar_t time, const vector_t& state, vector_t& nominalState, vector_t& input, matrix_t& feedbackGain,
+                               size_t& mode) {
+  if (primalSolutionPtr_ == nullptr) {
+    throw std::runtime_error("[PolicyEvaluator::evaluate] setPolicy() should be called first!");
+  }
+  if (primalSolutionPtr_->timeTrajectory_.empty() || primalSolutionPtr_->controllerPtr_ == nullptr) {
+    throw std::runtime_error("[PolicyEvaluator::evaluate] The policy should have a time trajectory and a controller!");
+  }
+
+  // nominal state
+  const auto& timeTrajectory = primalSolutionPtr_->timeTrajectory_;
+  const int stateInterval = stateCursor_.lowerBound(timeTrajectory, time) - 1;
+  interpolateInto(LinearInterpolation::timeSegment(time, timeTrajectory, stateInterval), primalSolutionPtr_->stateTrajectory_,
+                  nominalState);
+
+  // controller
+  if (linearControllerPtr_ != nullptr) {
+    const auto& timeStamp = linearControllerPtr_->timeStamp_;
+    const int controllerInterval = controllerCursor_.lowerBound(timeStamp, time) - 1;
+    const auto indexAlpha = LinearInterpolation::timeSegment(time, timeStamp, controllerInterval);
+    interpolateInto(indexAlpha, linearControllerPtr_->gainArray_, feedbackGain);
+    interpolateInto(indexAlpha, linearControllerPtr_->biasArray_, input);
+    input.noalias() += feedbackGain * state;
+
+  } else if (feedforwardControllerPtr_ != nullptr) {
+    const auto& timeStamp = feedforwardControllerPtr_->timeStamp_;
+    const int controllerInterval = controllerCursor_.lowerBound(timeStamp, time) - 1;
+    interpolateInto(LinearInterpolation::timeSegment(time, timeStamp, controllerInterval), feedforwardControllerPtr_->uffArray_, input);
+    feedbackGain.setZero(input.size(), state.size());
+
+  } else {
+    input = primalSolutionPtr_->controllerPtr_->computeInput(time, state);
+    feedbackGain.setZero(input.size(), state.size());
+  }
+
+  // mode
+  const auto& modeSchedule = primalSolutionPtr_->modeSchedule_;
+  mode = modeSchedule.modeSequence[modeCursor_.lowerBound(modeSchedule.eventTimes, time)];
+}
+
+}  // namespace ocs2
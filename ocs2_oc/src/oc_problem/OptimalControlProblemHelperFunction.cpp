@@ -36,6 +36,18 @@ namespace ocs2 {
 /******************************************************************************************************/
 void initializeDualSolution(const OptimalControlProblem& ocp, const PrimalSolution& primalSolution, const DualSolution& cachedDualSolution,
                             DualSolution& dualSolution) {
+  // on a fixed time grid, the cached dual solution is copied node by node
+  if (isDefinedOnTimeGrid(cachedDualSolution, primalSolution.timeTrajectory_, primalSolution.postEventIndices_) &&
+      !cachedDualSolution.final.empty() && cachedDualSolution.preJumps.size() == primalSolution.postEventIndices_.size() &&
+      cachedDualSolution.intermediates.size() == primalSolution.timeTrajectory_.size()) {
+    dualSolution.timeTrajectory = primalSolution.timeTrajectory_;
+    dualSolution.postEventIndices = primalSolution.postEventIndices_;
+    dualSolution.final = cachedDualSolution.final;
+    dualSolution.preJumps = cachedDualSolution.preJumps;
+    dualSolution.intermediates = cachedDualSolution.intermediates;
+    return;
+  }
+
   // find the time period that we can interpolate the cached dual solution
   const auto timePeriod = std::make_pair(primalSolution.timeTrajectory_.front(), primalSolution.timeTrajectory_.back());
   const auto interpolatableTimePeriod =
@@ -87,10 +87,23 @@ void SolverBase::printString(const std::string& text) const {
   std::cerr << text << '\n';
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SolverBase::fitsInTimeBudget(scalar_t expectedDurationInMilliseconds) const {
+  if (timeBudget_ <= 0.0) {
+    return true;
+  }
+  const auto elapsedTime = std::chrono::duration<scalar_t, std::milli>(std::chrono::steady_clock::now() - runStartTime_).count();
+  return elapsedTime + expectedDurationInMilliseconds <= 1000.0 * timeBudget_;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::preRun(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  runStartTime_ = std::chrono::steady_clock::now();
+
   referenceManagerPtr_->preSolverRun(initTime, finalTime, initState);
 
   for (auto& module : synchronizedModules_) {
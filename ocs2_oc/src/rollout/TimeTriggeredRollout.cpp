@@ -29,8 +29,24 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/rollout/TimeTriggeredRollout.h"
 
+#include <cmath>
+
+#include <ocs2_core/NumericTraits.h>
+
 namespace ocs2 {
 
+namespace {
+/** Number of equal steps of at most dt between startTime and finalTime. Zero-length intervals have no step. */
+size_t numFixedTimeGridSteps(scalar_t startTime, scalar_t finalTime, scalar_t dt) {
+  if (startTime < finalTime) {
+    const auto numSteps = std::ceil((finalTime - startTime) / dt - numeric_traits::weakEpsilon<scalar_t>());
+    return std::max(static_cast<size_t>(numSteps), size_t(1));
+  } else {
+    return 0;
+  }
+}
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -61,13 +77,29 @@ vector_t TimeTriggeredRollout::run(scalar_t initTime, const vector_t& initState,
   // max number of steps for integration
   const auto maxNumSteps = static_cast<size_t>(this->settings().maxNumStepsPerSecond * std::max(1.0, finalTime - initTime));
 
+  // number of steps per subsystem on the fixed time grid
+  const bool useFixedTimeGrid = this->settings().useFixedTimeGrid;
+  size_array_t numFixedSteps;
+  size_t numNodes = maxNumSteps + 1;
+  if (useFixedTimeGrid) {
+    numFixedSteps.reserve(numSubsystems);
+    numNodes = 0;
+    for (const auto& interval : timeIntervalArray) {
+      numFixedSteps.push_back(numFixedTimeGridSteps(interval.first, interval.second, this->settings().timeStep));
+      numNodes += numFixedSteps.back() + 1;
+    }
+    if (numNodes > maxNumSteps + numSubsystems) {
+      throw std::runtime_error("[TimeTriggeredRollout::run] The fixed time grid exceeds the maximum number of steps!");
+    }
+  }
+
   // clearing the output trajectories
   timeTrajectory.clear();
-  timeTrajectory.reserve(maxNumSteps + 1);
+  timeTrajectory.reserve(numNodes);
   stateTrajectory.clear();
-  stateTrajectory.reserve(maxNumSteps + 1);
+  stateTrajectory.reserve(numNodes);
   inputTrajectory.clear();
-  inputTrajectory.reserve(maxNumSteps + 1);
+  inputTrajectory.reserve(numNodes);
   postEventIndices.clear();
   postEventIndices.reserve(numEvents);
 
@@ -83,7 +115,10 @@ vector_t TimeTriggeredRollout::run(scalar_t initTime, const vector_t& initState,
   vector_t beginState = initState;
   int k_u = 0;  // control input iterator
   for (int i = 0; i < numSubsystems; i++) {
-    if (timeIntervalArray[i].first < timeIntervalArray[i].second) {
+    if (useFixedTimeGrid && timeIntervalArray[i].first < timeIntervalArray[i].second) {
+      integrateFixedTimeGrid(beginState, timeIntervalArray[i].first, timeIntervalArray[i].second, numFixedSteps[i], timeTrajectory,
+                             stateTrajectory);
+    } else if (timeIntervalArray[i].first < timeIntervalArray[i].second) {
       Observer observer(&stateTrajectory, &timeTrajectory);  // concatenate trajectory
       // integrate controlled system
       dynamicsIntegratorPtr_->integrateAdaptive(*systemDynamicsPtr_, observer, beginState, timeIntervalArray[i].first,
@@ -115,4 +150,37 @@ vector_t TimeTriggeredRollout::run(scalar_t initTime, const vector_t& initState,
   return stateTrajectory.back();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void TimeTriggeredRollout::integrateFixedTimeGrid(const vector_t& initState, scalar_t startTime, scalar_t finalTime, size_t numSteps,
+                                                  scalar_array_t& timeTrajectory, vector_array_t& stateTrajectory) {
+  auto& system = *systemDynamicsPtr_;
+  const scalar_t dt = (finalTime - startTime) / static_cast<scalar_t>(numSteps);
+
+  timeTrajectory.push_back(startTime);
+  stateTrajectory.push_back(initState);
+  for (size_t k = 0; k < numSteps; k++) {
+    if (systemEventHandlersPtr_->killIntegration_) {
+      throw std::runtime_error("Integration terminated due to an external signal triggered by a program.");
+    }
+
+    const scalar_t t = timeTrajectory.back();
+    const vector_t& x = stateTrajectory.back();
+    // the last node is set to the final time to avoid round-off drift
+    const scalar_t tNext = (k + 1 < numSteps) ? startTime + static_cast<scalar_t>(k + 1) * dt : finalTime;
+    const scalar_t h = tNext - t;
+
+    const vector_t k1 = system.computeFlowMap(t, x);
+    const vector_t k2 = system.computeFlowMap(t + 0.5 * h, x + (0.5 * h) * k1);
+    const vector_t k3 = system.computeFlowMap(t + 0.5 * h, x + (0.5 * h) * k2);
+    const vector_t k4 = system.computeFlowMap(tNext, x + h * k3);
+
+    vector_t xNext = x;
+    xNext.noalias() += (h / 6.0) * (k1 + 2.0 * k2 + 2.0 * k3 + k4);
+    timeTrajectory.push_back(tNext);
+    stateTrajectory.push_back(std::move(xNext));
+  }  // end of k loop
+}
+
 }  // namespace ocs2
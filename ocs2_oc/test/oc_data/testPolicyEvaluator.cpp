@@ -0,0 +1,200 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <cstdlib>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_oc/oc_data/PolicyEvaluator.h>
+
+// Counts the heap allocations of this process while countAllocations is set. Both std containers and Eigen allocate through malloc.
+#ifdef __GLIBC__
+namespace {
+bool countAllocations = false;
+size_t numAllocations = 0;
+}  // unnamed namespace
+
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* malloc(size_t size) {
+  if (countAllocations) {
+    ++numAllocations;
+  }
+  return __libc_malloc(size);
+}
+#endif
+
+using namespace ocs2;
+
+class PolicyEvaluatorTest : public testing::Test {
+ protected:
+  static constexpr size_t STATE_DIM = 4;
+  static constexpr size_t INPUT_DIM = 2;
+  static constexpr size_t N = 50;
+
+  PolicyEvaluatorTest() {
+    // time trajectory with a pre- and post-event node at t = 1.0
+    scalar_array_t timeTrajectory;
+    for (size_t i = 0; i < N; i++) {
+      timeTrajectory.push_back(0.05 * i);
+      if (i == 20) {
+        timeTrajectory.push_back(0.05 * i);
+      }
+    }
+    primalSolution.timeTrajectory_ = timeTrajectory;
+    primalSolution.postEventIndices_ = {21};
+    for (size_t i = 0; i < timeTrajectory.size(); i++) {
+      primalSolution.stateTrajectory_.push_back(vector_t::Random(STATE_DIM));
+      primalSolution.inputTrajectory_.push_back(vector_t::Random(INPUT_DIM));
+      gainArray.push_back(matrix_t::Random(INPUT_DIM, STATE_DIM));
+    }
+    primalSolution.modeSchedule_ = ModeSchedule({0.5, 1.0, 1.0, 2.0}, {0, 1, 2, 3, 4});
+  }
+
+  /** Compares the evaluator with the evaluation through the controller, LinearInterpolation and ModeSchedule. */
+  void compareAtTimes(const scalar_array_t& queryTimes) {
+    PolicyEvaluator evaluator;
+    evaluator.setPolicy(primalSolution);
+
+    vector_t nominalState, input;
+    matrix_t feedbackGain;
+    size_t mode;
+    for (const auto t : queryTimes) {
+      const vector_t state = vector_t::Random(STATE_DIM);
+      evaluator.evaluate(t, state, nominalState, input, feedbackGain, mode);
+
+      const vector_t expectedNominalState =
+          LinearInterpolation::interpolate(t, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+      const vector_t expectedInput = primalSolution.controllerPtr_->computeInput(t, state);
+      EXPECT_TRUE(nominalState.isApprox(expectedNominalState)) << "time: " << t;
+      EXPECT_TRUE(input.isApprox(expectedInput)) << "time: " << t;
+      EXPECT_EQ(mode, primalSolution.modeSchedule_.modeAtTime(t)) << "time: " << t;
+      if (primalSolution.controllerPtr_->getType() == ControllerType::LINEAR) {
+        matrix_t expectedGain;
+        dynamic_cast<const LinearController&>(*primalSolution.controllerPtr_).getFeedbackGain(t, expectedGain);
+        EXPECT_TRUE(feedbackGain.isApprox(expectedGain)) << "time: " << t;
+      } else {
+        EXPECT_TRUE(feedbackGain.isZero()) << "time: " << t;
+      }
+    }
+  }
+
+  scalar_array_t getQueryTimes() const {
+    scalar_array_t queryTimes;
+    // increasing times, including exactly the event time and the node times
+    for (scalar_t t = -0.1; t < 2.6; t += 0.001) {
+      queryTimes.push_back(t);
+    }
+    queryTimes.insert(queryTimes.end(), {0.5, 1.0, 1.0, 0.05, 2.45, 0.0, 3.0, 1.0, 0.7, 0.71, 2.0});
+    // random times
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<scalar_t> distribution(-0.1, 2.6);
+    for (size_t i = 0; i < 200; i++) {
+      queryTimes.push_back(distribution(generator));
+    }
+    return queryTimes;
+  }
+
+  PrimalSolution primalSolution;
+  matrix_array_t gainArray;
+};
+
+constexpr size_t PolicyEvaluatorTest::STATE_DIM;
+constexpr size_t PolicyEvaluatorTest::INPUT_DIM;
+constexpr size_t PolicyEvaluatorTest::N;
+
+TEST_F(PolicyEvaluatorTest, linearController) {
+  primalSolution.controllerPtr_.reset(new LinearController(primalSolution.timeTrajectory_, primalSolution.inputTrajectory_, gainArray));
+  compareAtTimes(getQueryTimes());
+}
+
+TEST_F(PolicyEvaluatorTest, feedforwardController) {
+  primalSolution.controllerPtr_.reset(new FeedforwardController(primalSolution.timeTrajectory_, primalSolution.inputTrajectory_));
+  compareAtTimes(getQueryTimes());
+}
+
+TEST_F(PolicyEvaluatorTest, coarseController) {
+  // controller with fewer nodes than the state trajectory
+  scalar_array_t controllerTime;
+  vector_array_t controllerBias;
+  matrix_array_t controllerGain;
+  for (size_t i = 0; i < primalSolution.timeTrajectory_.size(); i += 4) {
+    controllerTime.push_back(primalSolution.timeTrajectory_[i]);
+    controllerBias.push_back(primalSolution.inputTrajectory_[i]);
+    controllerGain.push_back(gainArray[i]);
+  }
+  primalSolution.controllerPtr_.reset(new LinearController(controllerTime, controllerBias, controllerGain));
+  compareAtTimes(getQueryTimes());
+}
+
+#ifdef __GLIBC__
+TEST_F(PolicyEvaluatorTest, noAllocation) {
+  primalSolution.controllerPtr_.reset(new LinearController(primalSolution.timeTrajectory_, primalSolution.inputTrajectory_, gainArray));
+  const auto queryTimes = getQueryTimes();
+  const vector_t state = vector_t::Random(STATE_DIM);
+
+  PolicyEvaluator evaluator;
+  evaluator.setPolicy(primalSolution);
+
+  // preallocated output buffers
+  vector_t nominalState = vector_t::Zero(STATE_DIM);
+  vector_t input = vector_t::Zero(INPUT_DIM);
+  matrix_t feedbackGain = matrix_t::Zero(INPUT_DIM, STATE_DIM);
+  size_t mode;
+
+  numAllocations = 0;
+  countAllocations = true;
+  for (const auto t : queryTimes) {
+    evaluator.evaluate(t, state, nominalState, input, feedbackGain, mode);
+  }
+  countAllocations = false;
+  ASSERT_EQ(numAllocations, 0);
+
+  // the same holds for feedforward controllers
+  primalSolution.controllerPtr_.reset(new FeedforwardController(primalSolution.timeTrajectory_, primalSolution.inputTrajectory_));
+  evaluator.setPolicy(primalSolution);
+
+  countAllocations = true;
+  for (const auto t : queryTimes) {
+    evaluator.evaluate(t, state, nominalState, input, feedbackGain, mode);
+  }
+  countAllocations = false;
+  ASSERT_EQ(numAllocations, 0);
+
+  // sanity check of the allocation counter
+  countAllocations = true;
+  const vector_t newState = vector_t::Random(STATE_DIM);
+  countAllocations = false;
+  ASSERT_GT(numAllocations, 0);
+}
+#endif
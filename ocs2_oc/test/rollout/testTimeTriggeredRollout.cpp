@@ -37,6 +37,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 
 using namespace ocs2;
@@ -87,3 +88,138 @@ TEST(time_rollout_test, time_rollout_test) {
   ASSERT_EQ(totalSize, stateTrajectory.size());
   ASSERT_EQ(totalSize, inputTrajectory.size());
 }
+
+TEST(time_rollout_test, fixed_time_grid) {
+  constexpr size_t nx = 2;
+  constexpr size_t nu = 1;
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 2.0;
+  const vector_t initState = vector_t::Ones(nx);
+
+  // ModeSchedule
+  ModeSchedule modeSchedule({0.55, 1.2, 1.2}, {0, 1, 2, 3});
+
+  const matrix_t A = (matrix_t(nx, nx) << -2.0, -1.0, 1.0, 0.0).finished();
+  const matrix_t B = (matrix_t(nx, nu) << 1.0, 0.0).finished();
+  LinearSystemDynamics systemDynamics(A, B);
+
+  // controllers
+  const scalar_array_t cntTimeStamp{initTime, finalTime};
+  const matrix_array_t k(2, -matrix_t::Ones(nu, nx));
+  LinearController controller1(cntTimeStamp, vector_array_t(2, vector_t::Ones(nu)), k);
+  LinearController controller2(cntTimeStamp, vector_array_t(2, -vector_t::Ones(nu)), k);
+
+  // Rollout Settings
+  rollout::Settings rolloutSettings;
+  rolloutSettings.absTolODE = 1e-10;
+  rolloutSettings.relTolODE = 1e-8;
+  rolloutSettings.timeStep = 0.1;
+  TimeTriggeredRollout referenceRollout(systemDynamics, rolloutSettings);
+  rolloutSettings.useFixedTimeGrid = true;
+  TimeTriggeredRollout fixedGridRollout(systemDynamics, rolloutSettings);
+
+  scalar_array_t timeTrajectory, referenceTimeTrajectory;
+  size_array_t postEventIndices, referencePostEventIndices;
+  vector_array_t stateTrajectory, referenceStateTrajectory;
+  vector_array_t inputTrajectory, referenceInputTrajectory;
+
+  const vector_t finalState = fixedGridRollout.run(initTime, initState, finalTime, &controller1, modeSchedule, timeTrajectory,
+                                                   postEventIndices, stateTrajectory, inputTrajectory);
+  const vector_t referenceFinalState =
+      referenceRollout.run(initTime, initState, finalTime, &controller1, modeSchedule, referenceTimeTrajectory, referencePostEventIndices,
+                           referenceStateTrajectory, referenceInputTrajectory);
+
+  // sizes and event alignment (up to the subsystem recognition offset at the start of each interval)
+  constexpr scalar_t timeTol = 1e-8;
+  ASSERT_EQ(timeTrajectory.size(), stateTrajectory.size());
+  ASSERT_EQ(timeTrajectory.size(), inputTrajectory.size());
+  ASSERT_EQ(postEventIndices.size(), modeSchedule.eventTimes.size());
+  for (size_t i = 0; i < postEventIndices.size(); i++) {
+    EXPECT_DOUBLE_EQ(timeTrajectory[postEventIndices[i] - 1], modeSchedule.eventTimes[i]);
+    EXPECT_NEAR(timeTrajectory[postEventIndices[i]], modeSchedule.eventTimes[i], timeTol);
+  }
+  EXPECT_NEAR(timeTrajectory.front(), initTime, timeTol);
+  EXPECT_DOUBLE_EQ(timeTrajectory.back(), finalTime);
+  for (size_t k = 1; k < timeTrajectory.size(); k++) {
+    EXPECT_LE(timeTrajectory[k] - timeTrajectory[k - 1], rolloutSettings.timeStep + timeTol);
+  }
+  // 0.0 -> 0.55: 6 steps, 0.55 -> 1.2: 7 steps, 1.2 -> 1.2: empty, 1.2 -> 2.0: 8 steps
+  EXPECT_EQ(timeTrajectory.size(), 7 + 8 + 1 + 9);
+
+  // RK4 accuracy compared to the adaptive rollout
+  EXPECT_TRUE(finalState.isApprox(referenceFinalState, 1e-5)) << finalState.transpose() << "\n" << referenceFinalState.transpose();
+
+  // the grid is independent of the controller
+  scalar_array_t timeTrajectory2;
+  fixedGridRollout.run(initTime, initState, finalTime, &controller2, modeSchedule, timeTrajectory2, postEventIndices, stateTrajectory,
+                       inputTrajectory);
+  EXPECT_EQ(timeTrajectory, timeTrajectory2);
+}
+
+TEST(time_rollout_test, fixed_time_grid_dual_solution) {
+  constexpr size_t nx = 2;
+  constexpr size_t nu = 1;
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 2.0;
+  const vector_t initState = vector_t::Ones(nx);
+  ModeSchedule modeSchedule({0.55, 1.2}, {0, 1, 2});
+
+  const matrix_t A = (matrix_t(nx, nx) << -2.0, -1.0, 1.0, 0.0).finished();
+  const matrix_t B = (matrix_t(nx, nu) << 1.0, 0.0).finished();
+  LinearSystemDynamics systemDynamics(A, B);
+
+  const scalar_array_t cntTimeStamp{initTime, finalTime};
+  const matrix_array_t k(2, -matrix_t::Ones(nu, nx));
+  LinearController controller1(cntTimeStamp, vector_array_t(2, vector_t::Ones(nu)), k);
+  LinearController controller2(cntTimeStamp, vector_array_t(2, -vector_t::Ones(nu)), k);
+
+  rollout::Settings rolloutSettings;
+  rolloutSettings.timeStep = 0.1;
+  rolloutSettings.useFixedTimeGrid = true;
+  TimeTriggeredRollout rollout(systemDynamics, rolloutSettings);
+
+  // the cached dual solution on the grid of the first rollout, with a different multiplier per node
+  PrimalSolution primalSolution;
+  primalSolution.modeSchedule_ = modeSchedule;
+  vector_array_t stateTrajectory, inputTrajectory;
+  rollout.run(initTime, initState, finalTime, &controller1, modeSchedule, primalSolution.timeTrajectory_, primalSolution.postEventIndices_,
+              stateTrajectory, inputTrajectory);
+  ASSERT_EQ(primalSolution.postEventIndices_.size(), modeSchedule.eventTimes.size());
+
+  DualSolution cachedDualSolution;
+  cachedDualSolution.timeTrajectory = primalSolution.timeTrajectory_;
+  cachedDualSolution.postEventIndices = primalSolution.postEventIndices_;
+  cachedDualSolution.final.stateEq.emplace_back(-1.0, vector_t::Constant(1, -1.0));
+  cachedDualSolution.preJumps.resize(primalSolution.postEventIndices_.size());
+  for (size_t i = 0; i < cachedDualSolution.preJumps.size(); i++) {
+    cachedDualSolution.preJumps[i].stateEq.emplace_back(-2.0 - i, vector_t::Constant(1, -2.0 - i));
+  }
+  cachedDualSolution.intermediates.resize(primalSolution.timeTrajectory_.size());
+  for (size_t i = 0; i < cachedDualSolution.intermediates.size(); i++) {
+    cachedDualSolution.intermediates[i].stateInputEq.emplace_back(i, vector_t::Constant(1, i));
+  }
+
+  // the second rollout lands on the same grid, so the dual solution is copied node by node
+  rollout.run(initTime, initState, finalTime, &controller2, modeSchedule, primalSolution.timeTrajectory_, primalSolution.postEventIndices_,
+              stateTrajectory, inputTrajectory);
+  ASSERT_TRUE(isDefinedOnTimeGrid(cachedDualSolution, primalSolution.timeTrajectory_, primalSolution.postEventIndices_));
+
+  DualSolution dualSolution;
+  initializeDualSolution(OptimalControlProblem(), primalSolution, cachedDualSolution, dualSolution);
+  EXPECT_EQ(dualSolution.timeTrajectory, primalSolution.timeTrajectory_);
+  EXPECT_EQ(dualSolution.postEventIndices, primalSolution.postEventIndices_);
+  ASSERT_EQ(dualSolution.final.stateEq.size(), 1);
+  EXPECT_EQ(dualSolution.final.stateEq[0].penalty, -1.0);
+  ASSERT_EQ(dualSolution.preJumps.size(), cachedDualSolution.preJumps.size());
+  for (size_t i = 0; i < dualSolution.preJumps.size(); i++) {
+    ASSERT_EQ(dualSolution.preJumps[i].stateEq.size(), 1);
+    EXPECT_EQ(dualSolution.preJumps[i].stateEq[0].penalty, -2.0 - i);
+  }
+  // including the pre- and post-event nodes which a time lookup cannot tell apart
+  ASSERT_EQ(dualSolution.intermediates.size(), cachedDualSolution.intermediates.size());
+  for (size_t i = 0; i < dualSolution.intermediates.size(); i++) {
+    ASSERT_EQ(dualSolution.intermediates[i].stateInputEq.size(), 1);
+    EXPECT_EQ(dualSolution.intermediates[i].stateInputEq[0].penalty, i);
+    EXPECT_EQ(dualSolution.intermediates[i].stateInputEq[0].lagrangian(0), i);
+  }
+}
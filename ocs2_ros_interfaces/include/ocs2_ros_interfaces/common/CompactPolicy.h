@@ -0,0 +1,139 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_mpc/CommandData.h>
+#include <ocs2_mpc/SystemObservation.h>
+#include <ocs2_oc/oc_data/PerformanceIndex.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+namespace ocs2 {
+namespace compact_policy {
+
+/**
+ * Compact binary encoding of an MPC policy, i.e. the command data, the primal solution and the performance indices, in one contiguous
+ * buffer. It is an alternative to ocs2_msgs::mpc_flattened_controller with a much smaller size for linear controllers:
+ *
+ *  - The state, input, and target trajectories are stored in single precision, times in double precision.
+ *  - The feedback gains can be truncated to a time window. Beyond the window, the policy becomes a feedforward policy along the
+ *    nominal trajectory, i.e. the gain is zero and the bias is the input of the linear controller at the nominal state.
+ *  - The feedback gains can be stored in single precision, in half precision, or as 16-bit quantized differences to the gains of
+ *    the previous node.
+ *
+ * The controller is encoded on its own time stamps, so the distinct pre- and post-event nodes at duplicated event times are kept.
+ *
+ * The buffer starts with a header which contains a magic number and the format version. The data is in the native byte order of the
+ * platform (little-endian on all supported platforms).
+ */
+
+/** Format version. It is increased for every change to the format. */
+constexpr uint8_t VERSION = 2;
+
+/** Encoding of the feedback gains */
+enum class GainEncoding : uint8_t {
+  /** single precision floats */
+  FLOAT32 = 0,
+  /** half precision floats, i.e. about 3 significant digits. Values beyond the half precision range are saturated. */
+  FLOAT16 = 1,
+  /** 16-bit integers which quantize the difference to the gain of the previous node with a per-node scale */
+  DELTA16 = 2,
+};
+
+/** Encoding settings */
+struct Settings {
+  /** The encoding of the feedback gains. */
+  GainEncoding gainEncoding = GainEncoding::FLOAT32;
+
+  /**
+   * The gains are only sent up to this time window after the initial observation time (plus one node beyond it). A negative value
+   * sends the gains over the whole policy.
+   */
+  scalar_t gainTimeWindow = -1.0;
+};
+
+/**
+ * Encodes a policy. Only FeedforwardController and LinearController policies are supported.
+ *
+ * @param [in] commandData: The command data of the MPC.
+ * @param [in] primalSolution: The policy data of the MPC.
+ * @param [in] performanceIndices: The performance indices data of the solver.
+ * @param [in] settings: The encoding settings.
+ * @param [out] buffer: The encoded policy. Its memory is reused.
+ */
+void encode(const CommandData& commandData, const PrimalSolution& primalSolution, const PerformanceIndex& performanceIndices,
+            const Settings& settings, std::vector<uint8_t>& buffer);
+
+/**
+ * Decodes a policy which is encoded by encode(). The controller is defined on the time stamps of the encoded controller.
+ *
+ * @param [in] buffer: The encoded policy.
+ * @param [out] commandData: The command data of the MPC.
+ * @param [out] primalSolution: The policy data of the MPC.
+ * @param [out] performanceIndices: The performance indices data of the solver.
+ */
+void decode(const std::vector<uint8_t>& buffer, CommandData& commandData, PrimalSolution& primalSolution,
+            PerformanceIndex& performanceIndices);
+
+/**
+ * Decodes a policy which is encoded by encode() from a raw memory range, e.g. a shared memory segment. All sizes in the encoding are
+ * validated against the range before they are used, so an invalid range results in an exception rather than an out-of-range access.
+ *
+ * @param [in] data: Pointer to the encoded policy.
+ * @param [in] size: Number of bytes of the encoded policy.
+ * @param [out] commandData: The command data of the MPC.
+ * @param [out] primalSolution: The policy data of the MPC.
+ * @param [out] performanceIndices: The performance indices data of the solver.
+ */
+void decode(const uint8_t* data, size_t size, CommandData& commandData, PrimalSolution& primalSolution,
+            PerformanceIndex& performanceIndices);
+
+/**
+ * Encodes an observation in the same conventions as the initial observation of a policy, i.e. in double precision.
+ *
+ * @param [in] observation: The observation.
+ * @param [out] buffer: The encoded observation. Its memory is reused.
+ */
+void encodeObservation(const SystemObservation& observation, std::vector<uint8_t>& buffer);
+
+/**
+ * Decodes an observation which is encoded by encodeObservation().
+ *
+ * @param [in] data: Pointer to the encoded observation.
+ * @param [in] size: Number of bytes of the encoded observation.
+ * @param [out] observation: The observation.
+ */
+void decodeObservation(const uint8_t* data, size_t size, SystemObservation& observation);
+
+}  // namespace compact_policy
+}  // namespace ocs2
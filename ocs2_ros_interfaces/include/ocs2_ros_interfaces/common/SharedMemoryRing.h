@@ -0,0 +1,212 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ocs2 {
+
+namespace shared_memory_ring {
+// The memory layout of the segment is defined in SharedMemoryRing.cpp
+struct SlotHeader;
+}  // namespace shared_memory_ring
+
+/**
+ * A ring of fixed-capacity slots in a POSIX shared memory segment which transfers the latest message of a single writer to readers
+ * in other processes on the same machine.
+ *
+ * Every slot is guarded by a sequence lock: the writer makes the slot's sequence odd before it copies a message into the slot and even
+ * afterwards. A reader reads the latest slot in place and validates that the sequence has not changed meanwhile, otherwise it retries
+ * with the then latest slot. Since the writer cycles through the slots, a slot is only overwritten after numSlots further messages, so
+ * a reader is rarely retried while neither side ever blocks the other.
+ *
+ * The segment is named after the POSIX shm_open() conventions, i.e. "/name" without any further slash. It is created by the writer
+ * and unlinked when the writer is destroyed.
+ *
+ * This class is the writer of a ring. There must be only one writer per ring.
+ */
+class SharedMemoryRingWriter {
+ public:
+  /**
+   * Creates the shared memory segment. An existing segment with the same name, e.g. from a process which is not terminated
+   * gracefully, is replaced.
+   *
+   * @param [in] name: The name of the shared memory segment, e.g. "/robot_mpc_policy".
+   * @param [in] numSlots: The number of slots in the ring. At least two slots are required.
+   * @param [in] slotCapacity: The maximum number of bytes of a message.
+   */
+  SharedMemoryRingWriter(std::string name, size_t numSlots, size_t slotCapacity);
+
+  /** Marks the ring as closed for its readers and unlinks the segment. */
+  ~SharedMemoryRingWriter();
+
+  SharedMemoryRingWriter(const SharedMemoryRingWriter&) = delete;
+  SharedMemoryRingWriter& operator=(const SharedMemoryRingWriter&) = delete;
+
+  /**
+   * Copies a message into the next slot and publishes it as the latest message.
+   *
+   * @param [in] data: Pointer to the message.
+   * @param [in] size: Number of bytes of the message. It should not exceed the slot capacity.
+   */
+  void write(const uint8_t* data, size_t size);
+
+  /** Gets the number of published messages. */
+  uint64_t getNumPublished() const { return numPublished_; }
+
+  const std::string& getName() const { return name_; }
+  size_t getNumSlots() const { return numSlots_; }
+  size_t getSlotCapacity() const { return slotCapacity_; }
+
+ private:
+  std::string name_;
+  size_t numSlots_;
+  size_t slotCapacity_;
+  size_t slotStride_;
+  size_t segmentSize_;
+  uint8_t* segment_ = nullptr;
+  uint64_t numPublished_ = 0;
+};
+
+/**
+ * A reader of a shared memory ring. The segment is opened lazily, so the reader can be created before the writer. It is reopened if
+ * the writer is closed, or if the name refers to another segment, e.g. of a writer process which is restarted after it is not
+ * terminated gracefully. The latter is checked periodically, such that a restarted writer process is picked up again.
+ */
+class SharedMemoryRingReader {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] name: The name of the shared memory segment, e.g. "/robot_mpc_policy".
+   */
+  explicit SharedMemoryRingReader(std::string name);
+
+  ~SharedMemoryRingReader();
+
+  SharedMemoryRingReader(const SharedMemoryRingReader&) = delete;
+  SharedMemoryRingReader& operator=(const SharedMemoryRingReader&) = delete;
+
+  /**
+   * Reads the latest message in place if a new message is published since the last successful read.
+   *
+   * The message is passed to readFunc as (const uint8_t* data, size_t size) while it is in the shared memory. If the writer
+   * overwrites the slot meanwhile, readFunc might see an inconsistent message. Then its result must be discarded, any exception of
+   * it is ignored, and it is called again with the then latest message. Therefore, readFunc must only write to its output and
+   * must not have other side effects.
+   *
+   * A message which stays inconsistent, e.g. since the writer has died while writing it, is given up after a bounded number of
+   * attempts, such that readLatest() never blocks.
+   *
+   * @param [in] readFunc: The function which reads the message.
+   * @return true if a new message is read.
+   */
+  template <typename ReadFunc>
+  bool readLatest(ReadFunc&& readFunc);
+
+  /** Whether the segment of the writer is opened. */
+  bool isConnected() const { return segment_ != nullptr; }
+
+  const std::string& getName() const { return name_; }
+
+ private:
+  /** A message in the shared memory together with the slot sequence at the beginning of reading it. */
+  struct SlotRange {
+    const shared_memory_ring::SlotHeader* slot;
+    uint64_t sequence;
+    const uint8_t* data;
+    size_t size;
+  };
+
+  /** Opens the segment if required. Returns true if the segment is open. */
+  bool connect();
+
+  /** Whether the name refers to another segment or to none anymore. It is checked at most every 100 ms, otherwise false is returned. */
+  bool isOrphaned();
+
+  void disconnect();
+
+  /**
+   * Gets the latest message. Returns false if there is no message newer than the last read one, or if the latest slot is still
+   * being written after a bounded number of attempts.
+   */
+  bool beginRead(SlotRange& range);
+
+  /** Checks whether the message has not been overwritten while it is read and marks it as read if so. */
+  bool endRead(const SlotRange& range);
+
+  std::string name_;
+  size_t numSlots_ = 0;
+  size_t slotCapacity_ = 0;
+  size_t slotStride_ = 0;
+  size_t segmentSize_ = 0;
+  const uint8_t* segment_ = nullptr;
+  uint64_t numRead_ = 0;
+  uint64_t device_ = 0;
+  uint64_t inode_ = 0;
+  std::chrono::steady_clock::time_point nextOrphanCheckTime_;
+};
+
+/**
+ * Converts a name, e.g. a ROS topic name, to a valid shared memory segment name, i.e. a leading slash and no further slashes.
+ *
+ * @param [in] name: The name, e.g. "robot_mpc_policy" or "/robot/mpc_policy".
+ * @return The shared memory name, e.g. "/robot_mpc_policy".
+ */
+std::string toSharedMemoryName(const std::string& name);
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename ReadFunc>
+bool SharedMemoryRingReader::readLatest(ReadFunc&& readFunc) {
+  constexpr size_t maxNumAttempts = 64;
+  SlotRange range;
+  for (size_t attempt = 0; attempt < maxNumAttempts && beginRead(range); attempt++) {
+    try {
+      readFunc(range.data, range.size);
+    } catch (...) {
+      // an exception on a consistent message is an error of readFunc
+      if (endRead(range)) {
+        throw;
+      }
+      continue;
+    }
+    if (endRead(range)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace ocs2
@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ros/transport_hints.h>
 
 #include <ocs2_msgs/mode_schedule.h>
+#include <ocs2_msgs/mpc_compact_policy.h>
 #include <ocs2_msgs/mpc_flattened_controller.h>
 #include <ocs2_msgs/mpc_observation.h>
 #include <ocs2_msgs/mpc_target_trajectories.h>
@@ -56,6 +57,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_mpc/SystemObservation.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 
+#include "ocs2_ros_interfaces/common/CompactPolicy.h"
+#include "ocs2_ros_interfaces/common/SharedMemoryRing.h"
+
 #define PUBLISH_THREAD
 
 namespace ocs2 {
@@ -102,6 +106,26 @@ class MPC_ROS_Interface {
    */
   void launchNodes(ros::NodeHandle& nodeHandle);
 
+  /**
+   * Publishes the policy in the compact format of compact_policy on the topic "topicPrefix_mpc_compact_policy" instead of the
+   * ocs2_msgs::mpc_flattened_controller message on "topicPrefix_mpc_policy". This method should be called before launchNodes().
+   *
+   * @param [in] settings: The encoding settings of the compact policy.
+   */
+  void useCompactPolicy(const compact_policy::Settings& settings);
+
+  /**
+   * Exchanges the policy and the observation with an MRT on the same machine through POSIX shared memory instead of ROS topics.
+   * The policy is written in the compact format of compact_policy into the shared memory "/topicPrefix_mpc_policy", with the settings
+   * of useCompactPolicy() if it is called. The latest observation is polled from "/topicPrefix_mpc_observation". The MRT should
+   * call MRT_ROS_Interface::useSharedMemory(). The reset service is still a ROS service. This method should be called before
+   * launchNodes().
+   *
+   * @param [in] policySlotCapacity: The initial maximum size of an encoded policy in bytes. A larger policy recreates the shared
+   *                                 memory with at least twice the capacity, which the MRT picks up automatically.
+   */
+  void useSharedMemory(size_t policySlotCapacity = 8 * 1024 * 1024);
+
  protected:
   /**
    * Callback to reset MPC.
@@ -122,6 +146,11 @@ class MPC_ROS_Interface {
   static ocs2_msgs::mpc_flattened_controller createMpcPolicyMsg(const PrimalSolution& primalSolution, const CommandData& commandData,
                                                                 const PerformanceIndex& performanceIndices);
 
+  /**
+   * Publishes the policy either as a flattened controller or as a compact policy.
+   */
+  void publishPolicy(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices);
+
   /**
    * Handles ROS publishing thread.
    */
@@ -142,6 +171,18 @@ class MPC_ROS_Interface {
    */
   void mpcObservationCallback(const ocs2_msgs::mpc_observation::ConstPtr& msg);
 
+  /**
+   * Invokes the MPC algorithm for the current observation and publishes the optimized policy.
+   *
+   * @param [in] currentObservation: The current observation.
+   */
+  void advanceMpc(const SystemObservation& currentObservation);
+
+  /**
+   * Spins ROS while polling the observation from the shared memory.
+   */
+  void spinSharedMemory();
+
  protected:
   /*
    * Variables
@@ -156,6 +197,7 @@ class MPC_ROS_Interface {
   ::ros::Subscriber mpcObservationSubscriber_;
   ::ros::Subscriber mpcTargetTrajectoriesSubscriber_;
   ::ros::Publisher mpcPolicyPublisher_;
+  ::ros::Publisher mpcCompactPolicyPublisher_;
   ::ros::ServiceServer mpcResetServiceServer_;
 
   std::unique_ptr<CommandData> bufferCommandPtr_;
@@ -167,6 +209,17 @@ class MPC_ROS_Interface {
 
   mutable std::mutex bufferMutex_;  // for policy variables with prefix (buffer*)
 
+  // compact policy
+  bool useCompactPolicy_ = false;
+  compact_policy::Settings compactPolicySettings_;
+  ocs2_msgs::mpc_compact_policy compactPolicyMsg_;
+
+  // shared memory transport
+  bool useSharedMemory_ = false;
+  size_t policySlotCapacity_ = 0;
+  std::unique_ptr<SharedMemoryRingWriter> mpcPolicyRingWriterPtr_;
+  std::unique_ptr<SharedMemoryRingReader> mpcObservationRingReaderPtr_;
+
   // multi-threading for publishers
   std::atomic_bool terminateThread_{false};
   std::atomic_bool readyToPublish_{false};
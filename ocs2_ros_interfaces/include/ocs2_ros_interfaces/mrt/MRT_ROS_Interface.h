@@ -34,20 +34,25 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <csignal>
 #include <ctime>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <ros/callback_queue.h>
 #include <ros/ros.h>
 #include <ros/transport_hints.h>
 
 // MPC messages
+#include <ocs2_msgs/mpc_compact_policy.h>
 #include <ocs2_msgs/mpc_flattened_controller.h>
 #include <ocs2_msgs/reset.h>
 
 #include <ocs2_mpc/MRT_BASE.h>
 
 #include "ocs2_ros_interfaces/common/RosMsgConversions.h"
+#include "ocs2_ros_interfaces/common/SharedMemoryRing.h"
 
 #define PUBLISH_THREAD
 
@@ -62,7 +67,8 @@ class MRT_ROS_Interface : public MRT_BASE {
    * Constructor
    *
    * @param [in] topicPrefix: The prefix defines the names for: observation's publishing topic "topicPrefix_mpc_observation",
-   * policy's receiving topic "topicPrefix_mpc_policy", and MPC reset service "topicPrefix_mpc_reset".
+   * policy's receiving topics "topicPrefix_mpc_policy" and "topicPrefix_mpc_compact_policy", and MPC reset service
+   * "topicPrefix_mpc_reset".
    * @param [in] mrtTransportHints: ROS transmission protocol.
    */
   explicit MRT_ROS_Interface(std::string topicPrefix = "anonymousRobot",
@@ -96,6 +102,14 @@ class MRT_ROS_Interface : public MRT_BASE {
    */
   void launchNodes(::ros::NodeHandle& nodeHandle);
 
+  /**
+   * Exchanges the policy and the observation with an MPC on the same machine through POSIX shared memory instead of ROS topics, see
+   * MPC_ROS_Interface::useSharedMemory(). The observation is written into "/topicPrefix_mpc_observation" and spinMRT() polls the
+   * latest policy from "/topicPrefix_mpc_policy", which is decoded in place into the policy buffer. This method should be called
+   * before launchNodes().
+   */
+  void useSharedMemory();
+
   void setCurrentObservation(const SystemObservation& currentObservation) override;
 
  private:
@@ -107,6 +121,13 @@ class MRT_ROS_Interface : public MRT_BASE {
    */
   void mpcPolicyCallback(const ocs2_msgs::mpc_flattened_controller::ConstPtr& msg);
 
+  /**
+   * Callback method to receive the MPC policy in the compact format of compact_policy.
+   *
+   * @param [in] msg: A constant pointer to the message
+   */
+  void mpcCompactPolicyCallback(const ocs2_msgs::mpc_compact_policy::ConstPtr& msg);
+
   /**
    * Helper function to read a MPC policy message.
    *
@@ -129,12 +150,19 @@ class MRT_ROS_Interface : public MRT_BASE {
   // Publishers and subscribers
   ::ros::Publisher mpcObservationPublisher_;
   ::ros::Subscriber mpcPolicySubscriber_;
+  ::ros::Subscriber mpcCompactPolicySubscriber_;
   ::ros::ServiceClient mpcResetServiceClient_;
 
   // ROS messages
   ocs2_msgs::mpc_observation mpcObservationMsg_;
   ocs2_msgs::mpc_observation mpcObservationMsgBuffer_;
 
+  // shared memory transport
+  bool useSharedMemory_ = false;
+  std::unique_ptr<SharedMemoryRingWriter> mpcObservationRingWriterPtr_;
+  std::unique_ptr<SharedMemoryRingReader> mpcPolicyRingReaderPtr_;
+  std::vector<uint8_t> observationBuffer_;
+
   ::ros::CallbackQueue mrtCallbackQueue_;
   ::ros::TransportHints mrtTransportHints_;
 
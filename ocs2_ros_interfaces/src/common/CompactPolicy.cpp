@@ -0,0 +1,614 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ros_interfaces/common/CompactPolicy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+namespace ocs2 {
+namespace compact_policy {
+
+namespace {
+
+constexpr uint8_t MAGIC[3] = {'O', 'C', 'P'};
+
+/** Tags the gain of a node in the DELTA16 encoding */
+enum class DeltaTag : uint8_t { FULL = 0, DELTA = 1 };
+
+/** Converts a float to a half precision float with round-to-nearest-even. Values beyond the half precision range are saturated. */
+uint16_t floatToHalf(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+  const int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xff) - 127 + 15;
+  uint32_t mantissa = bits & 0x7fffff;
+
+  if (((bits >> 23) & 0xff) == 0xff) {
+    // infinity or NaN
+    return sign | 0x7c00 | (mantissa != 0 ? 0x200 : 0);
+  } else if (exponent >= 0x1f) {
+    // saturate to the largest finite value
+    return sign | 0x7bff;
+  } else if (exponent <= 0) {
+    // subnormal or zero
+    if (exponent < -10) {
+      return sign;
+    }
+    mantissa |= 0x800000;
+    const uint32_t shift = 14 - exponent;
+    uint32_t half = mantissa >> shift;
+    const uint32_t remainder = mantissa & ((1u << shift) - 1);
+    const uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (half & 1) != 0)) {
+      ++half;
+    }
+    return sign | static_cast<uint16_t>(half);
+  } else {
+    uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    const uint32_t remainder = mantissa & 0x1fff;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1) != 0)) {
+      ++half;  // a carry into the exponent is the correct rounding
+    }
+    return sign | static_cast<uint16_t>(std::min(half, uint32_t(0x7bff)));
+  }
+}
+
+/** Converts a half precision float to a float */
+float halfToFloat(uint16_t half) {
+  const int exponent = (half >> 10) & 0x1f;
+  const int mantissa = half & 0x3ff;
+  float value;
+  if (exponent == 0) {
+    value = std::ldexp(static_cast<float>(mantissa), -24);
+  } else if (exponent == 0x1f) {
+    value = (mantissa == 0) ? std::numeric_limits<float>::infinity() : std::numeric_limits<float>::quiet_NaN();
+  } else {
+    value = std::ldexp(static_cast<float>(mantissa | 0x400), exponent - 25);
+  }
+  return (half & 0x8000) != 0 ? -value : value;
+}
+
+/** Appends plain values to a byte buffer */
+class BufferWriter {
+ public:
+  explicit BufferWriter(std::vector<uint8_t>& buffer) : buffer_(buffer) { buffer_.clear(); }
+
+  template <typename T>
+  void write(T value) {
+    static_assert(std::is_arithmetic<T>::value, "Only arithmetic types can be written.");
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer_.insert(buffer_.end(), bytes, bytes + sizeof(T));
+  }
+
+  template <typename T>
+  void writeSize(size_t size) {
+    if (size > std::numeric_limits<T>::max()) {
+      throw std::runtime_error("[compact_policy::encode] Size " + std::to_string(size) + " is too large for the format!");
+    }
+    write<T>(static_cast<T>(size));
+  }
+
+  /** Writes the size and the coefficients of a vector in precision T. */
+  template <typename T>
+  void writeVector(const vector_t& vector) {
+    writeSize<uint16_t>(vector.size());
+    for (Eigen::Index i = 0; i < vector.size(); i++) {
+      write<T>(static_cast<T>(vector(i)));
+    }
+  }
+
+ private:
+  std::vector<uint8_t>& buffer_;
+};
+
+/** Reads plain values from a byte buffer. All sizes are checked against the buffer size before any memory is allocated for them. */
+class BufferReader {
+ public:
+  BufferReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  T read() {
+    static_assert(std::is_arithmetic<T>::value, "Only arithmetic types can be read.");
+    if (sizeof(T) > remaining()) {
+      throw std::runtime_error("[compact_policy::decode] The buffer is too short!");
+    }
+    T value;
+    std::memcpy(&value, data_ + position_, sizeof(T));
+    position_ += sizeof(T);
+    return value;
+  }
+
+  /** Reads a number of elements of type SizeType, where each element occupies at least minElementBytes in the rest of the buffer. */
+  template <typename SizeType>
+  size_t readSize(size_t minElementBytes) {
+    const size_t size = read<SizeType>();
+    checkSize(size, minElementBytes);
+    return size;
+  }
+
+  /** Throws if the rest of the buffer is too short for size elements of minElementBytes each. */
+  void checkSize(size_t size, size_t minElementBytes) const {
+    if (minElementBytes > 0 && size > remaining() / minElementBytes) {
+      throw std::runtime_error("[compact_policy::decode] The buffer is too short!");
+    }
+  }
+
+  /** Reads the size and the coefficients of a vector which are stored in precision T. */
+  template <typename T>
+  void readVector(vector_t& vector) {
+    vector.resize(readSize<uint16_t>(sizeof(T)));
+    for (Eigen::Index i = 0; i < vector.size(); i++) {
+      vector(i) = static_cast<scalar_t>(read<T>());
+    }
+  }
+
+  bool atEnd() const { return position_ == size_; }
+
+ private:
+  size_t remaining() const { return size_ - position_; }
+
+  const uint8_t* data_;
+  size_t size_;
+  size_t position_ = 0;
+};
+
+/** Writes a gain in the given encoding. previousGain holds the decoded gain of the previous node and is updated to the decoded gain. */
+void writeGain(const matrix_t& gain, GainEncoding gainEncoding, matrix_t& previousGain, BufferWriter& writer) {
+  writer.writeSize<uint16_t>(gain.rows());
+  writer.writeSize<uint16_t>(gain.cols());
+
+  switch (gainEncoding) {
+    case GainEncoding::FLOAT32: {
+      for (Eigen::Index i = 0; i < gain.size(); i++) {
+        writer.write<float>(static_cast<float>(gain(i)));
+      }
+      break;
+    }
+    case GainEncoding::FLOAT16: {
+      for (Eigen::Index i = 0; i < gain.size(); i++) {
+        writer.write<uint16_t>(floatToHalf(static_cast<float>(gain(i))));
+      }
+      break;
+    }
+    case GainEncoding::DELTA16: {
+      if (previousGain.rows() != gain.rows() || previousGain.cols() != gain.cols()) {
+        writer.write<uint8_t>(static_cast<uint8_t>(DeltaTag::FULL));
+        previousGain.resize(gain.rows(), gain.cols());
+        for (Eigen::Index i = 0; i < gain.size(); i++) {
+          const auto value = static_cast<float>(gain(i));
+          writer.write<float>(value);
+          previousGain(i) = static_cast<scalar_t>(value);
+        }
+      } else {
+        writer.write<uint8_t>(static_cast<uint8_t>(DeltaTag::DELTA));
+        const float scale = static_cast<float>((gain - previousGain).cwiseAbs().maxCoeff() / std::numeric_limits<int16_t>::max());
+        writer.write<float>(scale);
+        constexpr long maxQuantized = std::numeric_limits<int16_t>::max();
+        for (Eigen::Index i = 0; i < gain.size(); i++) {
+          const long rounded = (scale > 0.0f) ? std::lround((gain(i) - previousGain(i)) / static_cast<scalar_t>(scale)) : 0;
+          const auto quantized = static_cast<int16_t>(std::max(-maxQuantized, std::min(rounded, maxQuantized)));
+          writer.write<int16_t>(quantized);
+          // track the decoded value such that the quantization errors do not accumulate
+          previousGain(i) += static_cast<scalar_t>(scale) * static_cast<scalar_t>(quantized);
+        }
+      }
+      break;
+    }
+    default:
+      throw std::runtime_error("[compact_policy::encode] Unknown gain encoding!");
+  }
+}
+
+/** Reads a gain in the given encoding. previousGain holds the decoded gain of the previous node. */
+void readGain(GainEncoding gainEncoding, const matrix_t& previousGain, matrix_t& gain, BufferReader& reader) {
+  const auto rows = reader.read<uint16_t>();
+  const auto cols = reader.read<uint16_t>();
+  reader.checkSize(static_cast<size_t>(rows) * cols, sizeof(uint16_t));
+  gain.resize(rows, cols);
+
+  switch (gainEncoding) {
+    case GainEncoding::FLOAT32: {
+      for (Eigen::Index i = 0; i < gain.size(); i++) {
+        gain(i) = static_cast<scalar_t>(reader.read<float>());
+      }
+      break;
+    }
+    case GainEncoding::FLOAT16: {
+      for (Eigen::Index i = 0; i < gain.size(); i++) {
+        gain(i) = static_cast<scalar_t>(halfToFloat(reader.read<uint16_t>()));
+      }
+      break;
+    }
+    case GainEncoding::DELTA16: {
+      const auto tag = static_cast<DeltaTag>(reader.read<uint8_t>());
+      if (tag == DeltaTag::FULL) {
+        for (Eigen::Index i = 0; i < gain.size(); i++) {
+          gain(i) = static_cast<scalar_t>(reader.read<float>());
+        }
+      } else if (tag == DeltaTag::DELTA && previousGain.rows() == rows && previousGain.cols() == cols) {
+        const auto scale = static_cast<scalar_t>(reader.read<float>());
+        for (Eigen::Index i = 0; i < gain.size(); i++) {
+          gain(i) = previousGain(i) + scale * static_cast<scalar_t>(reader.read<int16_t>());
+        }
+      } else {
+        throw std::runtime_error("[compact_policy::decode] Invalid gain difference!");
+      }
+      break;
+    }
+    default:
+      throw std::runtime_error("[compact_policy::decode] Unknown gain encoding!");
+  }
+}
+
+/** Writes the size and the time stamps of a time trajectory in double precision */
+void writeTimeTrajectory(const scalar_array_t& timeTrajectory, BufferWriter& writer) {
+  writer.writeSize<uint32_t>(timeTrajectory.size());
+  for (const auto t : timeTrajectory) {
+    writer.write<scalar_t>(t);
+  }
+}
+
+/** Reads a time trajectory which is written by writeTimeTrajectory(). Each node occupies at least a time stamp and a vector size. */
+void readTimeTrajectory(BufferReader& reader, scalar_array_t& timeTrajectory) {
+  timeTrajectory.resize(reader.readSize<uint32_t>(sizeof(scalar_t) + sizeof(uint16_t)));
+  for (auto& t : timeTrajectory) {
+    t = reader.read<scalar_t>();
+  }
+}
+
+/** Writes an observation in double precision */
+void writeObservation(const SystemObservation& observation, BufferWriter& writer) {
+  writer.writeSize<uint32_t>(observation.mode);
+  writer.write<scalar_t>(observation.time);
+  writer.writeVector<scalar_t>(observation.state);
+  writer.writeVector<scalar_t>(observation.input);
+}
+
+/** Reads an observation which is written by writeObservation() */
+void readObservation(BufferReader& reader, SystemObservation& observation) {
+  observation.mode = reader.read<uint32_t>();
+  observation.time = reader.read<scalar_t>();
+  reader.readVector<scalar_t>(observation.state);
+  reader.readVector<scalar_t>(observation.input);
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void encode(const CommandData& commandData, const PrimalSolution& primalSolution, const PerformanceIndex& performanceIndices,
+            const Settings& settings, std::vector<uint8_t>& buffer) {
+  if (primalSolution.controllerPtr_ == nullptr) {
+    throw std::runtime_error("[compact_policy::encode] The policy has no controller!");
+  }
+  const auto controllerType = primalSolution.controllerPtr_->getType();
+  if (controllerType != ControllerType::FEEDFORWARD && controllerType != ControllerType::LINEAR) {
+    throw std::runtime_error("[compact_policy::encode] Only feedforward and linear controllers are supported!");
+  }
+
+  BufferWriter writer(buffer);
+
+  // header
+  for (const auto c : MAGIC) {
+    writer.write<uint8_t>(c);
+  }
+  writer.write<uint8_t>(VERSION);
+  writer.write<uint8_t>(static_cast<uint8_t>(controllerType));
+  writer.write<uint8_t>(static_cast<uint8_t>(settings.gainEncoding));
+
+  // initial observation
+  writeObservation(commandData.mpcInitObservation_, writer);
+
+  // target trajectories
+  const auto& targetTrajectories = commandData.mpcTargetTrajectories_;
+  writer.writeSize<uint32_t>(targetTrajectories.timeTrajectory.size());
+  for (const auto t : targetTrajectories.timeTrajectory) {
+    writer.write<scalar_t>(t);
+  }
+  writer.writeSize<uint32_t>(targetTrajectories.stateTrajectory.size());
+  for (const auto& x : targetTrajectories.stateTrajectory) {
+    writer.writeVector<float>(x);
+  }
+  writer.writeSize<uint32_t>(targetTrajectories.inputTrajectory.size());
+  for (const auto& u : targetTrajectories.inputTrajectory) {
+    writer.writeVector<float>(u);
+  }
+
+  // mode schedule
+  const auto& modeSchedule = primalSolution.modeSchedule_;
+  if (modeSchedule.modeSequence.size() != modeSchedule.eventTimes.size() + 1) {
+    throw std::runtime_error("[compact_policy::encode] The mode sequence must have one element more than the event times!");
+  }
+  writer.writeSize<uint32_t>(modeSchedule.eventTimes.size());
+  for (const auto t : modeSchedule.eventTimes) {
+    writer.write<scalar_t>(t);
+  }
+  for (const auto mode : modeSchedule.modeSequence) {
+    writer.writeSize<uint32_t>(mode);
+  }
+
+  // performance indices
+  writer.write<scalar_t>(performanceIndices.merit);
+  writer.write<scalar_t>(performanceIndices.cost);
+  writer.write<scalar_t>(performanceIndices.dynamicsViolationSSE);
+  writer.write<scalar_t>(performanceIndices.equalityConstraintsSSE);
+  writer.write<scalar_t>(performanceIndices.inequalityConstraintsSSE);
+  writer.write<scalar_t>(performanceIndices.dualFeasibilitiesSSE);
+  writer.write<scalar_t>(performanceIndices.equalityLagrangian);
+  writer.write<scalar_t>(performanceIndices.inequalityLagrangian);
+
+  // time trajectory and post-event indices
+  const size_t N = primalSolution.timeTrajectory_.size();
+  if (primalSolution.stateTrajectory_.size() != N || primalSolution.inputTrajectory_.size() != N) {
+    throw std::runtime_error("[compact_policy::encode] State and input trajectories must have the same length as the time trajectory!");
+  }
+  writer.writeSize<uint32_t>(N);
+  for (const auto t : primalSolution.timeTrajectory_) {
+    writer.write<scalar_t>(t);
+  }
+  writer.writeSize<uint32_t>(primalSolution.postEventIndices_.size());
+  for (const auto ind : primalSolution.postEventIndices_) {
+    writer.writeSize<uint32_t>(ind);
+  }
+
+  // state and input trajectories
+  for (size_t k = 0; k < N; k++) {
+    writer.writeVector<float>(primalSolution.stateTrajectory_[k]);
+    writer.writeVector<float>(primalSolution.inputTrajectory_[k]);
+  }
+
+  // controller on its own time stamps, which keeps the distinct pre- and post-event nodes at the duplicated event times
+  if (controllerType == ControllerType::FEEDFORWARD) {
+    const auto& feedforwardController = dynamic_cast<const FeedforwardController&>(*primalSolution.controllerPtr_);
+    const auto& controllerTime = feedforwardController.timeStamp_;
+    if (feedforwardController.uffArray_.size() != controllerTime.size()) {
+      throw std::runtime_error("[compact_policy::encode] The feedforward array must have the same length as the controller time!");
+    }
+    writeTimeTrajectory(controllerTime, writer);
+    for (const auto& uff : feedforwardController.uffArray_) {
+      writer.writeVector<float>(uff);
+    }
+
+  } else {
+    const auto& linearController = dynamic_cast<const LinearController&>(*primalSolution.controllerPtr_);
+    const auto& controllerTime = linearController.timeStamp_;
+    const size_t controllerSize = controllerTime.size();
+    if (linearController.biasArray_.size() != controllerSize || linearController.gainArray_.size() != controllerSize) {
+      throw std::runtime_error("[compact_policy::encode] The bias and gain arrays must have the same length as the controller time!");
+    }
+    writeTimeTrajectory(controllerTime, writer);
+
+    // number of nodes with a gain: the nodes in the gain time window and one node beyond
+    size_t numGainNodes = controllerSize;
+    if (settings.gainTimeWindow >= 0.0) {
+      const scalar_t gainFinalTime = commandData.mpcInitObservation_.time + settings.gainTimeWindow;
+      const auto firstNodeBeyond = std::upper_bound(controllerTime.cbegin(), controllerTime.cend(), gainFinalTime);
+      numGainNodes = std::min(static_cast<size_t>(firstNodeBeyond - controllerTime.cbegin()) + 1, controllerSize);
+    }
+    writer.writeSize<uint32_t>(numGainNodes);
+
+    // the nominal state of a node beyond the gain window is interpolated if the controller has its own time stamps
+    const bool isOnTimeTrajectory = controllerTime == primalSolution.timeTrajectory_;
+    vector_t bias;
+    vector_t nominalState;
+    matrix_t previousGain;
+    for (size_t k = 0; k < controllerSize; k++) {
+      const auto& gain = linearController.gainArray_[k];
+      if (k < numGainNodes) {
+        writer.writeVector<float>(linearController.biasArray_[k]);
+        writeGain(gain, settings.gainEncoding, previousGain, writer);
+      } else {
+        // feedforward along the nominal trajectory
+        if (isOnTimeTrajectory) {
+          nominalState = primalSolution.stateTrajectory_[k];
+        } else {
+          const auto& timeTrajectory = primalSolution.timeTrajectory_;
+          nominalState = LinearInterpolation::interpolate(controllerTime[k], timeTrajectory, primalSolution.stateTrajectory_);
+        }
+        bias = linearController.biasArray_[k];
+        bias.noalias() += gain * nominalState;
+        writer.writeVector<float>(bias);
+        writer.writeSize<uint16_t>(nominalState.size());
+      }
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void decode(const uint8_t* data, size_t size, CommandData& commandData, PrimalSolution& primalSolution,
+            PerformanceIndex& performanceIndices) {
+  BufferReader reader(data, size);
+
+  // header
+  for (const auto c : MAGIC) {
+    if (reader.read<uint8_t>() != c) {
+      throw std::runtime_error("[compact_policy::decode] The buffer is not a compact policy!");
+    }
+  }
+  const auto version = reader.read<uint8_t>();
+  if (version != VERSION) {
+    throw std::runtime_error("[compact_policy::decode] Unsupported version " + std::to_string(version) + ", expected version " +
+                             std::to_string(VERSION) + "!");
+  }
+  const auto controllerType = static_cast<ControllerType>(reader.read<uint8_t>());
+  if (controllerType != ControllerType::FEEDFORWARD && controllerType != ControllerType::LINEAR) {
+    throw std::runtime_error("[compact_policy::decode] Unknown controller type!");
+  }
+  const auto gainEncoding = static_cast<GainEncoding>(reader.read<uint8_t>());
+
+  // initial observation
+  readObservation(reader, commandData.mpcInitObservation_);
+
+  // target trajectories
+  auto& targetTrajectories = commandData.mpcTargetTrajectories_;
+  targetTrajectories.timeTrajectory.resize(reader.readSize<uint32_t>(sizeof(scalar_t)));
+  for (auto& t : targetTrajectories.timeTrajectory) {
+    t = reader.read<scalar_t>();
+  }
+  targetTrajectories.stateTrajectory.resize(reader.readSize<uint32_t>(sizeof(uint16_t)));
+  for (auto& x : targetTrajectories.stateTrajectory) {
+    reader.readVector<float>(x);
+  }
+  targetTrajectories.inputTrajectory.resize(reader.readSize<uint32_t>(sizeof(uint16_t)));
+  for (auto& u : targetTrajectories.inputTrajectory) {
+    reader.readVector<float>(u);
+  }
+
+  // mode schedule
+  auto& modeSchedule = primalSolution.modeSchedule_;
+  modeSchedule.eventTimes.resize(reader.readSize<uint32_t>(sizeof(scalar_t) + sizeof(uint32_t)));
+  for (auto& t : modeSchedule.eventTimes) {
+    t = reader.read<scalar_t>();
+  }
+  modeSchedule.modeSequence.resize(modeSchedule.eventTimes.size() + 1);
+  for (auto& mode : modeSchedule.modeSequence) {
+    mode = reader.read<uint32_t>();
+  }
+
+  // performance indices
+  performanceIndices.merit = reader.read<scalar_t>();
+  performanceIndices.cost = reader.read<scalar_t>();
+  performanceIndices.dynamicsViolationSSE = reader.read<scalar_t>();
+  performanceIndices.equalityConstraintsSSE = reader.read<scalar_t>();
+  performanceIndices.inequalityConstraintsSSE = reader.read<scalar_t>();
+  performanceIndices.dualFeasibilitiesSSE = reader.read<scalar_t>();
+  performanceIndices.equalityLagrangian = reader.read<scalar_t>();
+  performanceIndices.inequalityLagrangian = reader.read<scalar_t>();
+
+  // time trajectory and post-event indices
+  const size_t N = reader.readSize<uint32_t>(sizeof(scalar_t) + 2 * sizeof(uint16_t));
+  if (N == 0) {
+    throw std::runtime_error("[compact_policy::decode] The policy is empty!");
+  }
+  primalSolution.timeTrajectory_.resize(N);
+  for (auto& t : primalSolution.timeTrajectory_) {
+    t = reader.read<scalar_t>();
+  }
+  primalSolution.postEventIndices_.resize(reader.readSize<uint32_t>(sizeof(uint32_t)));
+  for (auto& ind : primalSolution.postEventIndices_) {
+    ind = reader.read<uint32_t>();
+  }
+  if (!std::is_sorted(primalSolution.postEventIndices_.cbegin(), primalSolution.postEventIndices_.cend()) ||
+      (!primalSolution.postEventIndices_.empty() && primalSolution.postEventIndices_.back() > N)) {
+    throw std::runtime_error("[compact_policy::decode] The post-event indices do not match the time trajectory!");
+  }
+
+  // state and input trajectories
+  primalSolution.stateTrajectory_.resize(N);
+  primalSolution.inputTrajectory_.resize(N);
+  for (size_t k = 0; k < N; k++) {
+    reader.readVector<float>(primalSolution.stateTrajectory_[k]);
+    reader.readVector<float>(primalSolution.inputTrajectory_[k]);
+  }
+
+  // controller on its own time stamps
+  scalar_array_t controllerTime;
+  readTimeTrajectory(reader, controllerTime);
+  const size_t controllerSize = controllerTime.size();
+  if (controllerType == ControllerType::FEEDFORWARD) {
+    vector_array_t feedforwardArray(controllerSize);
+    for (auto& uff : feedforwardArray) {
+      reader.readVector<float>(uff);
+    }
+    primalSolution.controllerPtr_.reset(new FeedforwardController(std::move(controllerTime), std::move(feedforwardArray)));
+
+  } else {
+    const size_t numGainNodes = reader.read<uint32_t>();
+    if (numGainNodes > controllerSize) {
+      throw std::runtime_error("[compact_policy::decode] The number of gain nodes exceeds the controller length!");
+    }
+
+    // the encoder has used the nominal state of the node if the controller is defined on the time trajectory of the policy
+    const bool isOnTimeTrajectory = controllerTime == primalSolution.timeTrajectory_;
+    const matrix_t emptyGain;
+    vector_array_t biasArray(controllerSize);
+    matrix_array_t gainArray(controllerSize);
+    for (size_t k = 0; k < controllerSize; k++) {
+      reader.readVector<float>(biasArray[k]);
+      if (k < numGainNodes) {
+        const matrix_t& previousGain = (k > 0) ? gainArray[k - 1] : emptyGain;
+        readGain(gainEncoding, previousGain, gainArray[k], reader);
+      } else {
+        const size_t cols = reader.read<uint16_t>();
+        const auto& nominalState = isOnTimeTrajectory ? primalSolution.stateTrajectory_[k] : primalSolution.stateTrajectory_.front();
+        if (cols != static_cast<size_t>(nominalState.size())) {
+          throw std::runtime_error("[compact_policy::decode] The gain size does not match the state size!");
+        }
+        gainArray[k].setZero(biasArray[k].size(), cols);
+      }
+    }
+    primalSolution.controllerPtr_.reset(new LinearController(std::move(controllerTime), std::move(biasArray), std::move(gainArray)));
+  }
+
+  if (!reader.atEnd()) {
+    throw std::runtime_error("[compact_policy::decode] The buffer is longer than the encoded policy!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void decode(const std::vector<uint8_t>& buffer, CommandData& commandData, PrimalSolution& primalSolution,
+            PerformanceIndex& performanceIndices) {
+  decode(buffer.data(), buffer.size(), commandData, primalSolution, performanceIndices);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void encodeObservation(const SystemObservation& observation, std::vector<uint8_t>& buffer) {
+  BufferWriter writer(buffer);
+  writeObservation(observation, writer);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void decodeObservation(const uint8_t* data, size_t size, SystemObservation& observation) {
+  BufferReader reader(data, size);
+  readObservation(reader, observation);
+  if (!reader.atEnd()) {
+    throw std::runtime_error("[compact_policy::decodeObservation] The buffer is longer than the encoded observation!");
+  }
+}
+
+}  // namespace compact_policy
+}  // namespace ocs2
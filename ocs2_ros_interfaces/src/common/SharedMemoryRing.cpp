@@ -0,0 +1,338 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ros_interfaces/common/SharedMemoryRing.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ocs2 {
+namespace shared_memory_ring {
+
+struct SegmentHeader {
+  std::atomic<uint32_t> magic;  // set last by the writer, once the segment is initialized
+  uint32_t version;
+  uint64_t numSlots;
+  uint64_t slotCapacity;
+  std::atomic<uint64_t> numPublished;
+  std::atomic<uint32_t> closed;
+};
+
+struct SlotHeader {
+  std::atomic<uint64_t> sequence;  // 2 * (message count) once written, odd while being written
+  std::atomic<uint64_t> size;
+};
+
+}  // namespace shared_memory_ring
+
+namespace {
+
+using shared_memory_ring::SegmentHeader;
+using shared_memory_ring::SlotHeader;
+
+static_assert(ATOMIC_LONG_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "The shared memory ring requires address-free, i.e. lock-free, atomics.");
+
+constexpr uint32_t MAGIC = 0x4f43534d;  // "OCSM"
+constexpr uint32_t VERSION = 1;
+constexpr size_t ALIGNMENT = 64;  // cache line
+constexpr size_t MAX_NUM_SLOT_ATTEMPTS = 1024;
+constexpr std::chrono::milliseconds ORPHAN_CHECK_PERIOD(100);
+
+size_t alignUp(size_t size) {
+  return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+size_t slotsOffset() {
+  return alignUp(sizeof(SegmentHeader));
+}
+
+size_t computeSlotStride(size_t slotCapacity) {
+  return alignUp(sizeof(SlotHeader) + slotCapacity);
+}
+
+size_t computeSegmentSize(size_t numSlots, size_t slotCapacity) {
+  return slotsOffset() + numSlots * computeSlotStride(slotCapacity);
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string toSharedMemoryName(const std::string& name) {
+  std::string sharedMemoryName = "/";
+  for (const auto c : name) {
+    if (c != '/') {
+      sharedMemoryName.push_back(c);
+    } else if (sharedMemoryName.size() > 1) {
+      sharedMemoryName.push_back('_');
+    }
+  }
+  return sharedMemoryName;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemoryRingWriter::SharedMemoryRingWriter(std::string name, size_t numSlots, size_t slotCapacity)
+    : name_(std::move(name)),
+      numSlots_(numSlots),
+      slotCapacity_(slotCapacity),
+      slotStride_(computeSlotStride(slotCapacity)),
+      segmentSize_(computeSegmentSize(numSlots, slotCapacity)) {
+  if (name_.size() < 2 || name_.front() != '/' || name_.find('/', 1) != std::string::npos) {
+    throw std::runtime_error("[SharedMemoryRingWriter] The name \"" + name_ + "\" must start with a slash and contain no further slash!");
+  }
+  if (numSlots_ < 2) {
+    throw std::runtime_error("[SharedMemoryRingWriter] At least two slots are required!");
+  }
+
+  // replace a stale segment
+  ::shm_unlink(name_.c_str());
+  const int fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    throw std::runtime_error("[SharedMemoryRingWriter] Failed to create \"" + name_ + "\": " + std::strerror(errno));
+  }
+  if (::ftruncate(fd, static_cast<off_t>(segmentSize_)) != 0) {
+    const std::string error = std::strerror(errno);
+    ::close(fd);
+    ::shm_unlink(name_.c_str());
+    throw std::runtime_error("[SharedMemoryRingWriter] Failed to resize \"" + name_ + "\": " + error);
+  }
+  void* memory = ::mmap(nullptr, segmentSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (memory == MAP_FAILED) {
+    const std::string error = std::strerror(errno);
+    ::shm_unlink(name_.c_str());
+    throw std::runtime_error("[SharedMemoryRingWriter] Failed to map \"" + name_ + "\": " + error);
+  }
+  segment_ = static_cast<uint8_t*>(memory);
+
+  // the segment is zero-initialized by ftruncate
+  auto* header = new (segment_) SegmentHeader;
+  header->version = VERSION;
+  header->numSlots = numSlots_;
+  header->slotCapacity = slotCapacity_;
+  header->numPublished.store(0, std::memory_order_relaxed);
+  header->closed.store(0, std::memory_order_relaxed);
+  for (size_t i = 0; i < numSlots_; i++) {
+    auto* slot = new (segment_ + slotsOffset() + i * slotStride_) SlotHeader;
+    slot->sequence.store(0, std::memory_order_relaxed);
+    slot->size.store(0, std::memory_order_relaxed);
+  }
+  header->magic.store(MAGIC, std::memory_order_release);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemoryRingWriter::~SharedMemoryRingWriter() {
+  reinterpret_cast<SegmentHeader*>(segment_)->closed.store(1, std::memory_order_release);
+  ::munmap(segment_, segmentSize_);
+  ::shm_unlink(name_.c_str());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SharedMemoryRingWriter::write(const uint8_t* data, size_t size) {
+  if (size > slotCapacity_) {
+    throw std::runtime_error("[SharedMemoryRingWriter] The message of " + std::to_string(size) + " bytes exceeds the slot capacity of " +
+                             std::to_string(slotCapacity_) + " bytes of \"" + name_ + "\"!");
+  }
+
+  const uint64_t count = numPublished_ + 1;
+  uint8_t* slotMemory = segment_ + slotsOffset() + ((count - 1) % numSlots_) * slotStride_;
+  auto* slot = reinterpret_cast<SlotHeader*>(slotMemory);
+
+  // sequence lock: odd while the slot is written
+  slot->sequence.store(2 * count - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(slotMemory + sizeof(SlotHeader), data, size);
+  slot->size.store(size, std::memory_order_relaxed);
+  slot->sequence.store(2 * count, std::memory_order_release);
+
+  reinterpret_cast<SegmentHeader*>(segment_)->numPublished.store(count, std::memory_order_release);
+  numPublished_ = count;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemoryRingReader::SharedMemoryRingReader(std::string name) : name_(std::move(name)) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemoryRingReader::~SharedMemoryRingReader() {
+  disconnect();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SharedMemoryRingReader::connect() {
+  if (segment_ != nullptr) {
+    if (reinterpret_cast<const SegmentHeader*>(segment_)->closed.load(std::memory_order_acquire) == 0 && !isOrphaned()) {
+      return true;
+    }
+    // the writer is gone, look for a new one
+    disconnect();
+  }
+
+  const int fd = ::shm_open(name_.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat status;
+  if (::fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < slotsOffset()) {
+    ::close(fd);
+    return false;
+  }
+  const auto mappedSize = static_cast<size_t>(status.st_size);
+  void* memory = ::mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (memory == MAP_FAILED) {
+    return false;
+  }
+
+  const auto* header = static_cast<const SegmentHeader*>(memory);
+  const bool isInitialized = header->magic.load(std::memory_order_acquire) == MAGIC;
+  if (isInitialized && header->version != VERSION) {
+    ::munmap(memory, mappedSize);
+    throw std::runtime_error("[SharedMemoryRingReader] \"" + name_ + "\" has version " + std::to_string(header->version) +
+                             ", expected version " + std::to_string(VERSION) + "!");
+  }
+  if (!isInitialized || header->closed.load(std::memory_order_acquire) != 0 ||
+      mappedSize < computeSegmentSize(header->numSlots, header->slotCapacity)) {
+    ::munmap(memory, mappedSize);
+    return false;
+  }
+
+  segment_ = static_cast<const uint8_t*>(memory);
+  segmentSize_ = mappedSize;
+  device_ = static_cast<uint64_t>(status.st_dev);
+  inode_ = static_cast<uint64_t>(status.st_ino);
+  nextOrphanCheckTime_ = std::chrono::steady_clock::now() + ORPHAN_CHECK_PERIOD;
+  numSlots_ = header->numSlots;
+  slotCapacity_ = header->slotCapacity;
+  slotStride_ = computeSlotStride(slotCapacity_);
+  numRead_ = 0;
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SharedMemoryRingReader::isOrphaned() {
+  const auto now = std::chrono::steady_clock::now();
+  if (now < nextOrphanCheckTime_) {
+    return false;
+  }
+  nextOrphanCheckTime_ = now + ORPHAN_CHECK_PERIOD;
+
+  // a writer which is not terminated gracefully never closes its segment, but its successor replaces the segment under the name
+  const int fd = ::shm_open(name_.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return errno == ENOENT;
+  }
+  struct stat status;
+  const bool isReplaced = ::fstat(fd, &status) == 0 &&
+                          (static_cast<uint64_t>(status.st_dev) != device_ || static_cast<uint64_t>(status.st_ino) != inode_);
+  ::close(fd);
+  return isReplaced;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SharedMemoryRingReader::disconnect() {
+  if (segment_ != nullptr) {
+    ::munmap(const_cast<uint8_t*>(segment_), segmentSize_);
+    segment_ = nullptr;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SharedMemoryRingReader::beginRead(SlotRange& range) {
+  if (!connect()) {
+    return false;
+  }
+
+  const auto* header = reinterpret_cast<const SegmentHeader*>(segment_);
+  for (size_t attempt = 0; attempt < MAX_NUM_SLOT_ATTEMPTS; attempt++) {
+    const uint64_t numPublished = header->numPublished.load(std::memory_order_acquire);
+    if (numPublished == numRead_) {
+      return false;
+    }
+
+    const uint8_t* slotMemory = segment_ + slotsOffset() + ((numPublished - 1) % numSlots_) * slotStride_;
+    const auto* slot = reinterpret_cast<const SlotHeader*>(slotMemory);
+    const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+    const size_t size = slot->size.load(std::memory_order_relaxed);
+    if (sequence % 2 != 0 || size > slotCapacity_) {
+      continue;  // the writer has lapped the ring and is overwriting the slot
+    }
+
+    range.slot = slot;
+    range.sequence = sequence;
+    range.data = slotMemory + sizeof(SlotHeader);
+    range.size = size;
+    return true;
+  }
+
+  // the slot is still being written, e.g. since the writer has died meanwhile
+  return false;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SharedMemoryRingReader::endRead(const SlotRange& range) {
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (range.slot->sequence.load(std::memory_order_relaxed) != range.sequence) {
+    return false;
+  }
+  numRead_ = range.sequence / 2;
+  return true;
+}
+
+}  // namespace ocs2
@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ros_interfaces/mpc/MPC_ROS_Interface.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include "ocs2_ros_interfaces/common/RosMsgConversions.h"
 
 namespace ocs2 {
@@ -177,6 +180,34 @@ ocs2_msgs::mpc_flattened_controller MPC_ROS_Interface::createMpcPolicyMsg(const
   return mpcPolicyMsg;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::publishPolicy(const PrimalSolution& primalSolution, const CommandData& commandData,
+                                      const PerformanceIndex& performanceIndices) {
+  if (useSharedMemory_) {
+    compact_policy::encode(commandData, primalSolution, performanceIndices, compactPolicySettings_, compactPolicyMsg_.data);
+    const size_t policySize = compactPolicyMsg_.data.size();
+    if (policySize > mpcPolicyRingWriterPtr_->getSlotCapacity()) {
+      // The ring is replaced by a larger one. The old segment is closed and unlinked first, so the readers reconnect to the new one.
+      const std::string name = mpcPolicyRingWriterPtr_->getName();
+      const size_t numSlots = mpcPolicyRingWriterPtr_->getNumSlots();
+      policySlotCapacity_ = std::max(2 * policySlotCapacity_, policySize);
+      mpcPolicyRingWriterPtr_.reset();
+      mpcPolicyRingWriterPtr_.reset(new SharedMemoryRingWriter(name, numSlots, policySlotCapacity_));
+      ROS_WARN_STREAM("[MPC_ROS_Interface] The policy of " << policySize << " bytes exceeds the slot capacity of \"" << name
+                                                           << "\". It is recreated with a slot capacity of " << policySlotCapacity_
+                                                           << " bytes.");
+    }
+    mpcPolicyRingWriterPtr_->write(compactPolicyMsg_.data.data(), policySize);
+  } else if (useCompactPolicy_) {
+    compact_policy::encode(commandData, primalSolution, performanceIndices, compactPolicySettings_, compactPolicyMsg_.data);
+    mpcCompactPolicyPublisher_.publish(compactPolicyMsg_);
+  } else {
+    mpcPolicyPublisher_.publish(createMpcPolicyMsg(primalSolution, commandData, performanceIndices));
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -197,11 +228,8 @@ void MPC_ROS_Interface::publisherWorker() {
       publisherPerformanceIndicesPtr_.swap(bufferPerformanceIndicesPtr_);
     }
 
-    ocs2_msgs::mpc_flattened_controller mpcPolicyMsg =
-        createMpcPolicyMsg(*publisherPrimalSolutionPtr_, *publisherCommandPtr_, *publisherPerformanceIndicesPtr_);
-
     // publish the message
-    mpcPolicyPublisher_.publish(mpcPolicyMsg);
+    publishPolicy(*publisherPrimalSolutionPtr_, *publisherCommandPtr_, *publisherPerformanceIndicesPtr_);
 
     readyToPublish_ = false;
     lk.unlock();
@@ -235,6 +263,14 @@ void MPC_ROS_Interface::copyToBuffer(const SystemObservation& mpcInitObservation
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MPC_ROS_Interface::mpcObservationCallback(const ocs2_msgs::mpc_observation::ConstPtr& msg) {
+  // current time, state, input, and subsystem
+  advanceMpc(ros_msg_conversions::readObservationMsg(*msg));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::advanceMpc(const SystemObservation& currentObservation) {
   std::lock_guard<std::mutex> resetLock(resetMutex_);
 
   if (!resetRequestedEver_.load()) {
@@ -242,9 +278,6 @@ void MPC_ROS_Interface::mpcObservationCallback(const ocs2_msgs::mpc_observation:
     return;
   }
 
-  // current time, state, input, and subsystem
-  const auto currentObservation = ros_msg_conversions::readObservationMsg(*msg);
-
   // measure the delay in running MPC
   mpcTimer_.startTimer();
 
@@ -283,9 +316,7 @@ void MPC_ROS_Interface::mpcObservationCallback(const ocs2_msgs::mpc_observation:
   msgReady_.notify_one();
 
 #else
-  ocs2_msgs::mpc_flattened_controller mpcPolicyMsg =
-      createMpcPolicyMsg(*bufferPrimalSolutionPtr_, *bufferCommandPtr_, *bufferPerformanceIndicesPtr_);
-  mpcPolicyPublisher_.publish(mpcPolicyMsg);
+  publishPolicy(*bufferPrimalSolutionPtr_, *bufferCommandPtr_, *bufferPerformanceIndicesPtr_);
 #endif
 }
 
@@ -311,6 +342,9 @@ void MPC_ROS_Interface::shutdownNode() {
 
   // shutdown publishers
   mpcPolicyPublisher_.shutdown();
+  mpcCompactPolicyPublisher_.shutdown();
+  mpcPolicyRingWriterPtr_.reset();
+  mpcObservationRingReaderPtr_.reset();
 }
 
 /******************************************************************************************************/
@@ -318,24 +352,71 @@ void MPC_ROS_Interface::shutdownNode() {
 /******************************************************************************************************/
 void MPC_ROS_Interface::spin() {
   ROS_INFO_STREAM("Start spinning now ...");
+  if (useSharedMemory_) {
+    spinSharedMemory();
+    return;
+  }
+
   // Equivalent to ros::spin() + check if master is alive
   while (::ros::ok() && ::ros::master::check()) {
     ::ros::getGlobalCallbackQueue()->callAvailable(ros::WallDuration(0.1));
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::spinSharedMemory() {
+  constexpr auto pollingPeriod = std::chrono::microseconds(100);
+  constexpr auto masterCheckPeriod = std::chrono::milliseconds(100);
+
+  SystemObservation currentObservation;
+  auto readObservation = [&](const uint8_t* data, size_t size) { compact_policy::decodeObservation(data, size, currentObservation); };
+
+  bool isMasterAlive = true;
+  auto lastMasterCheck = std::chrono::steady_clock::now();
+  while (::ros::ok() && isMasterAlive) {
+    // the ROS callbacks, e.g. the reset service
+    ::ros::getGlobalCallbackQueue()->callAvailable(ros::WallDuration(0.0));
+
+    if (mpcObservationRingReaderPtr_->readLatest(readObservation)) {
+      advanceMpc(currentObservation);
+    } else {
+      std::this_thread::sleep_for(pollingPeriod);
+    }
+
+    // check if master is alive as often as in spin()
+    const auto now = std::chrono::steady_clock::now();
+    if (now - lastMasterCheck > masterCheckPeriod) {
+      isMasterAlive = ::ros::master::check();
+      lastMasterCheck = now;
+    }
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MPC_ROS_Interface::launchNodes(ros::NodeHandle& nodeHandle) {
   ROS_INFO_STREAM("MPC node is setting up ...");
 
-  // Observation subscriber
-  mpcObservationSubscriber_ = nodeHandle.subscribe(topicPrefix_ + "_mpc_observation", 1, &MPC_ROS_Interface::mpcObservationCallback, this,
-                                                   ::ros::TransportHints().tcpNoDelay());
+  if (useSharedMemory_) {
+    // shared memory transport
+    mpcPolicyRingWriterPtr_.reset(new SharedMemoryRingWriter(toSharedMemoryName(topicPrefix_ + "_mpc_policy"), 4, policySlotCapacity_));
+    mpcObservationRingReaderPtr_.reset(new SharedMemoryRingReader(toSharedMemoryName(topicPrefix_ + "_mpc_observation")));
 
-  // MPC publisher
-  mpcPolicyPublisher_ = nodeHandle.advertise<ocs2_msgs::mpc_flattened_controller>(topicPrefix_ + "_mpc_policy", 1, true);
+  } else {
+    // Observation subscriber
+    mpcObservationSubscriber_ = nodeHandle.subscribe(topicPrefix_ + "_mpc_observation", 1, &MPC_ROS_Interface::mpcObservationCallback, this,
+                                                     ::ros::TransportHints().tcpNoDelay());
+
+    // MPC publisher
+    if (useCompactPolicy_) {
+      mpcCompactPolicyPublisher_ = nodeHandle.advertise<ocs2_msgs::mpc_compact_policy>(topicPrefix_ + "_mpc_compact_policy", 1, true);
+    } else {
+      mpcPolicyPublisher_ = nodeHandle.advertise<ocs2_msgs::mpc_flattened_controller>(topicPrefix_ + "_mpc_policy", 1, true);
+    }
+  }
 
   // MPC reset service server
   mpcResetServiceServer_ = nodeHandle.advertiseService(topicPrefix_ + "_mpc_reset", &MPC_ROS_Interface::resetMpcCallback, this);
@@ -351,4 +432,20 @@ void MPC_ROS_Interface::launchNodes(ros::NodeHandle& nodeHandle) {
   spin();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::useCompactPolicy(const compact_policy::Settings& settings) {
+  useCompactPolicy_ = true;
+  compactPolicySettings_ = settings;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::useSharedMemory(size_t policySlotCapacity) {
+  useSharedMemory_ = true;
+  policySlotCapacity_ = policySlotCapacity;
+}
+
 }  // namespace ocs2
@@ -32,6 +32,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/control/LinearController.h>
 
+#include "ocs2_ros_interfaces/common/CompactPolicy.h"
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -78,6 +80,16 @@ void MRT_ROS_Interface::resetMpcNode(const TargetTrajectories& initTargetTraject
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_ROS_Interface::setCurrentObservation(const SystemObservation& currentObservation) {
+  if (useSharedMemory_) {
+    // writing into the shared memory does not block, hence it does not need the publisher thread
+    if (mpcObservationRingWriterPtr_ == nullptr) {
+      throw std::runtime_error("[MRT_ROS_Interface::setCurrentObservation] launchNodes() should be called first!");
+    }
+    compact_policy::encodeObservation(currentObservation, observationBuffer_);
+    mpcObservationRingWriterPtr_->write(observationBuffer_.data(), observationBuffer_.size());
+    return;
+  }
+
 #ifdef PUBLISH_THREAD
   std::unique_lock<std::mutex> lk(publisherMutex_);
 #endif
@@ -189,13 +201,22 @@ void MRT_ROS_Interface::readPolicyMsg(const ocs2_msgs::mpc_flattened_controller&
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_ROS_Interface::mpcPolicyCallback(const ocs2_msgs::mpc_flattened_controller::ConstPtr& msg) {
-  // read new policy and command from msg
-  std::unique_ptr<CommandData> commandPtr(new CommandData);
-  std::unique_ptr<PrimalSolution> primalSolutionPtr(new PrimalSolution);
-  std::unique_ptr<PerformanceIndex> performanceIndicesPtr(new PerformanceIndex);
-  readPolicyMsg(*msg, *commandPtr, *primalSolutionPtr, *performanceIndicesPtr);
+  // read new policy and command from msg directly into the buffer
+  auto& policyBuffer = this->getPolicyBufferToFill();
+  readPolicyMsg(*msg, policyBuffer.command, policyBuffer.primalSolution, policyBuffer.performanceIndices);
+
+  this->publishPolicyBuffer();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::mpcCompactPolicyCallback(const ocs2_msgs::mpc_compact_policy::ConstPtr& msg) {
+  // decode new policy and command directly into the buffer
+  auto& policyBuffer = this->getPolicyBufferToFill();
+  compact_policy::decode(msg->data, policyBuffer.command, policyBuffer.primalSolution, policyBuffer.performanceIndices);
 
-  this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
+  this->publishPolicyBuffer();
 }
 
 /******************************************************************************************************/
@@ -213,9 +234,12 @@ void MRT_ROS_Interface::shutdownNodes() {
   // clean up callback queue
   mrtCallbackQueue_.clear();
   mpcPolicySubscriber_.shutdown();
+  mpcCompactPolicySubscriber_.shutdown();
 
   // shutdown publishers
   mpcObservationPublisher_.shutdown();
+  mpcObservationRingWriterPtr_.reset();
+  mpcPolicyRingReaderPtr_.reset();
 }
 
 /******************************************************************************************************/
@@ -237,7 +261,18 @@ void MRT_ROS_Interface::shutdownPublisher() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_ROS_Interface::spinMRT() {
-  mrtCallbackQueue_.callOne();
+  if (useSharedMemory_) {
+    // decode the latest policy from the shared memory directly into the buffer
+    auto& policyBuffer = this->getPolicyBufferToFill();
+    const bool isUpdated = mpcPolicyRingReaderPtr_->readLatest([&](const uint8_t* data, size_t size) {
+      compact_policy::decode(data, size, policyBuffer.command, policyBuffer.primalSolution, policyBuffer.performanceIndices);
+    });
+    if (isUpdated) {
+      this->publishPolicyBuffer();
+    }
+  } else {
+    mrtCallbackQueue_.callOne();
+  }
 };
 
 /******************************************************************************************************/
@@ -249,19 +284,37 @@ void MRT_ROS_Interface::launchNodes(ros::NodeHandle& nodeHandle) {
   // display
   ROS_INFO_STREAM("MRT node is setting up ...");
 
-  // observation publisher
-  mpcObservationPublisher_ = nodeHandle.advertise<ocs2_msgs::mpc_observation>(topicPrefix_ + "_mpc_observation", 1);
-
-  // policy subscriber
-  auto ops = ros::SubscribeOptions::create<ocs2_msgs::mpc_flattened_controller>(
-      topicPrefix_ + "_mpc_policy",                                                       // topic name
-      1,                                                                                  // queue length
-      boost::bind(&MRT_ROS_Interface::mpcPolicyCallback, this, boost::placeholders::_1),  // callback
-      ros::VoidConstPtr(),                                                                // tracked object
-      &mrtCallbackQueue_                                                                  // pointer to callback queue object
-  );
-  ops.transport_hints = mrtTransportHints_;
-  mpcPolicySubscriber_ = nodeHandle.subscribe(ops);
+  if (useSharedMemory_) {
+    // shared memory transport
+    mpcObservationRingWriterPtr_.reset(new SharedMemoryRingWriter(toSharedMemoryName(topicPrefix_ + "_mpc_observation"), 4, 64 * 1024));
+    mpcPolicyRingReaderPtr_.reset(new SharedMemoryRingReader(toSharedMemoryName(topicPrefix_ + "_mpc_policy")));
+
+  } else {
+    // observation publisher
+    mpcObservationPublisher_ = nodeHandle.advertise<ocs2_msgs::mpc_observation>(topicPrefix_ + "_mpc_observation", 1);
+
+    // policy subscriber
+    auto ops = ros::SubscribeOptions::create<ocs2_msgs::mpc_flattened_controller>(
+        topicPrefix_ + "_mpc_policy",                                                       // topic name
+        1,                                                                                  // queue length
+        boost::bind(&MRT_ROS_Interface::mpcPolicyCallback, this, boost::placeholders::_1),  // callback
+        ros::VoidConstPtr(),                                                                // tracked object
+        &mrtCallbackQueue_                                                                  // pointer to callback queue object
+    );
+    ops.transport_hints = mrtTransportHints_;
+    mpcPolicySubscriber_ = nodeHandle.subscribe(ops);
+
+    // compact policy subscriber
+    auto compactOps = ros::SubscribeOptions::create<ocs2_msgs::mpc_compact_policy>(
+        topicPrefix_ + "_mpc_compact_policy",                                                      // topic name
+        1,                                                                                         // queue length
+        boost::bind(&MRT_ROS_Interface::mpcCompactPolicyCallback, this, boost::placeholders::_1),  // callback
+        ros::VoidConstPtr(),                                                                       // tracked object
+        &mrtCallbackQueue_                                                                         // pointer to callback queue object
+    );
+    compactOps.transport_hints = mrtTransportHints_;
+    mpcCompactPolicySubscriber_ = nodeHandle.subscribe(compactOps);
+  }
 
   // MPC reset service client
   mpcResetServiceClient_ = nodeHandle.serviceClient<ocs2_msgs::reset>(topicPrefix_ + "_mpc_reset");
@@ -276,4 +329,11 @@ void MRT_ROS_Interface::launchNodes(ros::NodeHandle& nodeHandle) {
   spinMRT();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::useSharedMemory() {
+  useSharedMemory_ = true;
+}
+
 }  // namespace ocs2
@@ -0,0 +1,328 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+
+#include "ocs2_ros_interfaces/common/CompactPolicy.h"
+
+using namespace ocs2;
+
+class CompactPolicyTest : public testing::Test {
+ protected:
+  static constexpr size_t STATE_DIM = 24;
+  static constexpr size_t INPUT_DIM = 24;
+  static constexpr size_t N = 100;
+
+  CompactPolicyTest() {
+    srand(0);
+
+    command.mpcInitObservation_.mode = 1;
+    command.mpcInitObservation_.time = 0.3;
+    command.mpcInitObservation_.state = vector_t::Random(STATE_DIM);
+    command.mpcInitObservation_.input = vector_t::Random(INPUT_DIM);
+    command.mpcTargetTrajectories_ = TargetTrajectories({0.3, 1.3}, {vector_t::Random(STATE_DIM), vector_t::Random(STATE_DIM)},
+                                                        {vector_t::Random(INPUT_DIM), vector_t::Random(INPUT_DIM)});
+
+    performanceIndices.merit = 1.0;
+    performanceIndices.cost = 2.0;
+    performanceIndices.dynamicsViolationSSE = 3.0;
+    performanceIndices.equalityConstraintsSSE = 4.0;
+    performanceIndices.inequalityConstraintsSSE = 5.0;
+    performanceIndices.dualFeasibilitiesSSE = 6.0;
+    performanceIndices.equalityLagrangian = 7.0;
+    performanceIndices.inequalityLagrangian = 8.0;
+
+    // smoothly varying gains as they come out of a Riccati recursion
+    const matrix_t gainStart = 10.0 * matrix_t::Random(INPUT_DIM, STATE_DIM);
+    const matrix_t gainEnd = 10.0 * matrix_t::Random(INPUT_DIM, STATE_DIM);
+    for (size_t k = 0; k < N; k++) {
+      const scalar_t s = static_cast<scalar_t>(k) / (N - 1);
+      primalSolution.timeTrajectory_.push_back(0.3 + 0.01 * k);
+      primalSolution.stateTrajectory_.push_back(vector_t::Random(STATE_DIM));
+      primalSolution.inputTrajectory_.push_back(vector_t::Random(INPUT_DIM));
+      biasArray.push_back(vector_t::Random(INPUT_DIM));
+      gainArray.push_back((1.0 - s) * gainStart + s * gainEnd + 0.01 * matrix_t::Random(INPUT_DIM, STATE_DIM));
+    }
+    primalSolution.postEventIndices_ = {40};
+    primalSolution.modeSchedule_ = ModeSchedule({0.7}, {1, 2});
+    primalSolution.controllerPtr_.reset(new LinearController(primalSolution.timeTrajectory_, biasArray, gainArray));
+  }
+
+  void roundTrip(const compact_policy::Settings& settings, CommandData& decodedCommand, PrimalSolution& decodedPrimalSolution,
+                 PerformanceIndex& decodedPerformanceIndices) const {
+    std::vector<uint8_t> buffer;
+    compact_policy::encode(command, primalSolution, performanceIndices, settings, buffer);
+    compact_policy::decode(buffer, decodedCommand, decodedPrimalSolution, decodedPerformanceIndices);
+  }
+
+  /** Checks everything except for the controller. */
+  void checkPolicyData(const CommandData& decodedCommand, const PrimalSolution& decodedPrimalSolution,
+                       const PerformanceIndex& decodedPerformanceIndices) const {
+    constexpr scalar_t floatPrecision = 1e-6;
+
+    EXPECT_EQ(decodedCommand.mpcInitObservation_.mode, command.mpcInitObservation_.mode);
+    EXPECT_EQ(decodedCommand.mpcInitObservation_.time, command.mpcInitObservation_.time);
+    EXPECT_EQ(decodedCommand.mpcInitObservation_.state, command.mpcInitObservation_.state);
+    EXPECT_EQ(decodedCommand.mpcInitObservation_.input, command.mpcInitObservation_.input);
+
+    const auto& targetTrajectories = command.mpcTargetTrajectories_;
+    const auto& decodedTargetTrajectories = decodedCommand.mpcTargetTrajectories_;
+    EXPECT_EQ(decodedTargetTrajectories.timeTrajectory, targetTrajectories.timeTrajectory);
+    ASSERT_EQ(decodedTargetTrajectories.stateTrajectory.size(), targetTrajectories.stateTrajectory.size());
+    ASSERT_EQ(decodedTargetTrajectories.inputTrajectory.size(), targetTrajectories.inputTrajectory.size());
+    for (size_t i = 0; i < targetTrajectories.size(); i++) {
+      EXPECT_TRUE(decodedTargetTrajectories.stateTrajectory[i].isApprox(targetTrajectories.stateTrajectory[i], floatPrecision));
+      EXPECT_TRUE(decodedTargetTrajectories.inputTrajectory[i].isApprox(targetTrajectories.inputTrajectory[i], floatPrecision));
+    }
+
+    EXPECT_EQ(decodedPrimalSolution.modeSchedule_.eventTimes, primalSolution.modeSchedule_.eventTimes);
+    EXPECT_EQ(decodedPrimalSolution.modeSchedule_.modeSequence, primalSolution.modeSchedule_.modeSequence);
+    EXPECT_EQ(decodedPrimalSolution.timeTrajectory_, primalSolution.timeTrajectory_);
+    EXPECT_EQ(decodedPrimalSolution.postEventIndices_, primalSolution.postEventIndices_);
+    ASSERT_EQ(decodedPrimalSolution.stateTrajectory_.size(), N);
+    ASSERT_EQ(decodedPrimalSolution.inputTrajectory_.size(), N);
+    for (size_t k = 0; k < N; k++) {
+      EXPECT_TRUE(decodedPrimalSolution.stateTrajectory_[k].isApprox(primalSolution.stateTrajectory_[k], floatPrecision));
+      EXPECT_TRUE(decodedPrimalSolution.inputTrajectory_[k].isApprox(primalSolution.inputTrajectory_[k], floatPrecision));
+    }
+
+    EXPECT_EQ(decodedPerformanceIndices.merit, performanceIndices.merit);
+    EXPECT_EQ(decodedPerformanceIndices.cost, performanceIndices.cost);
+    EXPECT_EQ(decodedPerformanceIndices.dynamicsViolationSSE, performanceIndices.dynamicsViolationSSE);
+    EXPECT_EQ(decodedPerformanceIndices.equalityConstraintsSSE, performanceIndices.equalityConstraintsSSE);
+    EXPECT_EQ(decodedPerformanceIndices.inequalityConstraintsSSE, performanceIndices.inequalityConstraintsSSE);
+    EXPECT_EQ(decodedPerformanceIndices.dualFeasibilitiesSSE, performanceIndices.dualFeasibilitiesSSE);
+    EXPECT_EQ(decodedPerformanceIndices.equalityLagrangian, performanceIndices.equalityLagrangian);
+    EXPECT_EQ(decodedPerformanceIndices.inequalityLagrangian, performanceIndices.inequalityLagrangian);
+  }
+
+  /** Returns the maximum absolute error of the gains and biases of the decoded linear controller. */
+  std::pair<scalar_t, scalar_t> getControllerErrors(const PrimalSolution& decodedPrimalSolution, size_t numNodes) const {
+    const auto& decodedController = dynamic_cast<const LinearController&>(*decodedPrimalSolution.controllerPtr_);
+    scalar_t maxGainError = 0.0;
+    scalar_t maxBiasError = 0.0;
+    for (size_t k = 0; k < numNodes; k++) {
+      maxGainError = std::max(maxGainError, (decodedController.gainArray_[k] - gainArray[k]).cwiseAbs().maxCoeff());
+      maxBiasError = std::max(maxBiasError, (decodedController.biasArray_[k] - biasArray[k]).cwiseAbs().maxCoeff());
+    }
+    return {maxGainError, maxBiasError};
+  }
+
+  CommandData command;
+  PrimalSolution primalSolution;
+  PerformanceIndex performanceIndices;
+  vector_array_t biasArray;
+  matrix_array_t gainArray;
+};
+
+constexpr size_t CompactPolicyTest::STATE_DIM;
+constexpr size_t CompactPolicyTest::INPUT_DIM;
+constexpr size_t CompactPolicyTest::N;
+
+TEST_F(CompactPolicyTest, float32Gains) {
+  CommandData decodedCommand;
+  PrimalSolution decodedPrimalSolution;
+  PerformanceIndex decodedPerformanceIndices;
+  roundTrip(compact_policy::Settings(), decodedCommand, decodedPrimalSolution, decodedPerformanceIndices);
+
+  checkPolicyData(decodedCommand, decodedPrimalSolution, decodedPerformanceIndices);
+  ASSERT_EQ(decodedPrimalSolution.controllerPtr_->getType(), ControllerType::LINEAR);
+  const auto errors = getControllerErrors(decodedPrimalSolution, N);
+  EXPECT_LT(errors.first, 1e-5);
+  EXPECT_LT(errors.second, 1e-6);
+}
+
+TEST_F(CompactPolicyTest, float16Gains) {
+  compact_policy::Settings settings;
+  settings.gainEncoding = compact_policy::GainEncoding::FLOAT16;
+  CommandData decodedCommand;
+  PrimalSolution decodedPrimalSolution;
+  PerformanceIndex decodedPerformanceIndices;
+  roundTrip(settings, decodedCommand, decodedPrimalSolution, decodedPerformanceIndices);
+
+  checkPolicyData(decodedCommand, decodedPrimalSolution, decodedPerformanceIndices);
+  // half precision has a relative precision of 2^-11 and the gains are below 11 in magnitude
+  const auto errors = getControllerErrors(decodedPrimalSolution, N);
+  EXPECT_LT(errors.first, 11.0 / 2048.0);
+  EXPECT_LT(errors.second, 1e-6);
+}
+
+TEST_F(CompactPolicyTest, delta16Gains) {
+  compact_policy::Settings settings;
+  settings.gainEncoding = compact_policy::GainEncoding::DELTA16;
+  CommandData decodedCommand;
+  PrimalSolution decodedPrimalSolution;
+  PerformanceIndex decodedPerformanceIndices;
+  roundTrip(settings, decodedCommand, decodedPrimalSolution, decodedPerformanceIndices);
+
+  checkPolicyData(decodedCommand, decodedPrimalSolution, decodedPerformanceIndices);
+  // the differences between nodes are below 0.5, so the quantization error is below 0.5 / 2^16 per node and does not accumulate
+  const auto errors = getControllerErrors(decodedPrimalSolution, N);
+  EXPECT_LT(errors.first, 1e-5);
+  EXPECT_LT(errors.second, 1e-6);
+}
+
+TEST_F(CompactPolicyTest, gainTimeWindow) {
+  compact_policy::Settings settings;
+  settings.gainTimeWindow = 0.1;
+  CommandData decodedCommand;
+  PrimalSolution decodedPrimalSolution;
+  PerformanceIndex decodedPerformanceIndices;
+  roundTrip(settings, decodedCommand, decodedPrimalSolution, decodedPerformanceIndices);
+
+  checkPolicyData(decodedCommand, decodedPrimalSolution, decodedPerformanceIndices);
+
+  // gains up to t0 + 0.1 and one node beyond
+  constexpr size_t numGainNodes = 12;
+  const auto errors = getControllerErrors(decodedPrimalSolution, numGainNodes);
+  EXPECT_LT(errors.first, 1e-5);
+  EXPECT_LT(errors.second, 1e-6);
+
+  // beyond the window, the policy is feedforward along the nominal trajectory
+  auto& decodedController = *decodedPrimalSolution.controllerPtr_;
+  for (size_t k = numGainNodes; k < N; k++) {
+    const scalar_t t = primalSolution.timeTrajectory_[k];
+    const auto& x = primalSolution.stateTrajectory_[k];
+    const vector_t expectedInput = biasArray[k] + gainArray[k] * x;
+    EXPECT_TRUE(dynamic_cast<const LinearController&>(decodedController).gainArray_[k].isZero());
+    EXPECT_TRUE(decodedController.computeInput(t, x).isApprox(expectedInput, 1e-5));
+    EXPECT_TRUE(decodedController.computeInput(t, vector_t::Random(STATE_DIM)).isApprox(expectedInput, 1e-5));
+  }
+}
+
+TEST_F(CompactPolicyTest, duplicatedEventNodes) {
+  // the event node is duplicated, and the bias and the gain jump between the pre- and the post-event node
+  constexpr size_t postEventIndex = 41;
+  primalSolution.timeTrajectory_[postEventIndex] = primalSolution.timeTrajectory_[postEventIndex - 1];
+  primalSolution.postEventIndices_ = {postEventIndex};
+  gainArray[postEventIndex] = 10.0 * matrix_t::Random(INPUT_DIM, STATE_DIM);
+  primalSolution.controllerPtr_.reset(new LinearController(primalSolution.timeTrajectory_, biasArray, gainArray));
+
+  for (const scalar_t gainTimeWindow : {-1.0, 0.1}) {
+    compact_policy::Settings settings;
+    settings.gainTimeWindow = gainTimeWindow;
+    CommandData decodedCommand;
+    PrimalSolution decodedPrimalSolution;
+    PerformanceIndex decodedPerformanceIndices;
+    roundTrip(settings, decodedCommand, decodedPrimalSolution, decodedPerformanceIndices);
+
+    checkPolicyData(decodedCommand, decodedPrimalSolution, decodedPerformanceIndices);
+    const auto& decodedController = dynamic_cast<const LinearController&>(*decodedPrimalSolution.controllerPtr_);
+    EXPECT_EQ(decodedController.timeStamp_, primalSolution.timeTrajectory_);
+    for (const size_t k : {postEventIndex - 1, postEventIndex}) {
+      const auto& x = primalSolution.stateTrajectory_[k];
+      if (gainTimeWindow < 0.0) {
+        EXPECT_TRUE(decodedController.biasArray_[k].isApprox(biasArray[k], 1e-6));
+        EXPECT_TRUE(decodedController.gainArray_[k].isApprox(gainArray[k], 1e-6));
+      } else {
+        // beyond the window, each node is feedforward along its own nominal state
+        const vector_t expectedBias = biasArray[k] + gainArray[k] * x;
+        EXPECT_TRUE(decodedController.biasArray_[k].isApprox(expectedBias, 1e-5));
+        EXPECT_TRUE(decodedController.gainArray_[k].isZero());
+      }
+    }
+  }
+}
+
+TEST_F(CompactPolicyTest, feedforwardController) {
+  primalSolution.controllerPtr_.reset(new FeedforwardController(primalSolution.timeTrajectory_, primalSolution.inputTrajectory_));
+  CommandData decodedCommand;
+  PrimalSolution decodedPrimalSolution;
+  PerformanceIndex decodedPerformanceIndices;
+  roundTrip(compact_policy::Settings(), decodedCommand, decodedPrimalSolution, decodedPerformanceIndices);
+
+  checkPolicyData(decodedCommand, decodedPrimalSolution, decodedPerformanceIndices);
+  ASSERT_EQ(decodedPrimalSolution.controllerPtr_->getType(), ControllerType::FEEDFORWARD);
+  for (size_t k = 0; k < N; k++) {
+    const scalar_t t = primalSolution.timeTrajectory_[k];
+    const vector_t x = vector_t::Random(STATE_DIM);
+    EXPECT_TRUE(decodedPrimalSolution.controllerPtr_->computeInput(t, x).isApprox(primalSolution.inputTrajectory_[k], 1e-6));
+  }
+}
+
+TEST_F(CompactPolicyTest, bufferSize) {
+  auto getSize = [&](const compact_policy::Settings& settings) {
+    std::vector<uint8_t> buffer;
+    compact_policy::encode(command, primalSolution, performanceIndices, settings, buffer);
+    return buffer.size();
+  };
+
+  compact_policy::Settings settings;
+  const size_t float32Size = getSize(settings);
+  settings.gainEncoding = compact_policy::GainEncoding::FLOAT16;
+  const size_t float16Size = getSize(settings);
+  settings.gainEncoding = compact_policy::GainEncoding::DELTA16;
+  const size_t delta16Size = getSize(settings);
+  settings.gainTimeWindow = 0.1;
+  const size_t truncatedSize = getSize(settings);
+
+  // the gains dominate the size: N * nu * nx * 4 bytes in single precision
+  const size_t gainSize = N * INPUT_DIM * STATE_DIM * sizeof(float);
+  EXPECT_GT(float32Size, gainSize);
+  EXPECT_LT(float16Size, float32Size - gainSize / 2 + gainSize / 10);
+  EXPECT_LT(delta16Size, float32Size - gainSize / 2 + gainSize / 10);
+  EXPECT_LT(truncatedSize, float32Size - gainSize * 8 / 10);
+}
+
+TEST_F(CompactPolicyTest, invalidBuffer) {
+  std::vector<uint8_t> buffer;
+  compact_policy::encode(command, primalSolution, performanceIndices, compact_policy::Settings(), buffer);
+
+  CommandData decodedCommand;
+  PrimalSolution decodedPrimalSolution;
+  PerformanceIndex decodedPerformanceIndices;
+
+  // unsupported version
+  auto wrongVersion = buffer;
+  wrongVersion[3] = compact_policy::VERSION + 1;
+  EXPECT_THROW(compact_policy::decode(wrongVersion, decodedCommand, decodedPrimalSolution, decodedPerformanceIndices),
+               std::runtime_error);
+
+  // truncated buffer
+  auto truncated = buffer;
+  truncated.resize(buffer.size() / 2);
+  EXPECT_THROW(compact_policy::decode(truncated, decodedCommand, decodedPrimalSolution, decodedPerformanceIndices), std::runtime_error);
+
+  // trailing data
+  auto extended = buffer;
+  extended.push_back(0);
+  EXPECT_THROW(compact_policy::decode(extended, decodedCommand, decodedPrimalSolution, decodedPerformanceIndices), std::runtime_error);
+
+  // post-event indices beyond the time trajectory or not sorted, as in a corrupted message
+  for (const size_array_t& postEventIndices : {size_array_t{primalSolution.timeTrajectory_.size() + 1}, size_array_t{40, 20}}) {
+    primalSolution.postEventIndices_ = postEventIndices;
+    std::vector<uint8_t> corrupted;
+    compact_policy::encode(command, primalSolution, performanceIndices, compact_policy::Settings(), corrupted);
+    EXPECT_THROW(compact_policy::decode(corrupted, decodedCommand, decodedPrimalSolution, decodedPerformanceIndices),
+                 std::runtime_error);
+  }
+}
@@ -0,0 +1,294 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <ocs2_core/control/LinearController.h>
+
+#include "ocs2_ros_interfaces/common/CompactPolicy.h"
+#include "ocs2_ros_interfaces/common/SharedMemoryRing.h"
+
+using namespace ocs2;
+
+namespace {
+
+std::string uniqueName(const std::string& suffix) {
+  return "/ocs2_test_" + std::to_string(::getpid()) + "_" + suffix;
+}
+
+/** Reads a message into a vector */
+bool readMessage(SharedMemoryRingReader& reader, std::vector<uint8_t>& message) {
+  return reader.readLatest([&](const uint8_t* data, size_t size) { message.assign(data, data + size); });
+}
+
+/** A policy whose values are all derived from the observation time */
+void createPolicy(const SystemObservation& observation, CommandData& command, PrimalSolution& primalSolution) {
+  constexpr size_t stateDim = 12;
+  constexpr size_t inputDim = 6;
+  constexpr size_t N = 50;
+  const scalar_t value = observation.time;
+
+  command.mpcInitObservation_ = observation;
+  command.mpcTargetTrajectories_ = TargetTrajectories({observation.time}, {vector_t::Constant(stateDim, value)});
+
+  primalSolution.clear();
+  vector_array_t biasArray(N, vector_t::Constant(inputDim, value));
+  matrix_array_t gainArray(N, matrix_t::Constant(inputDim, stateDim, value));
+  for (size_t k = 0; k < N; k++) {
+    primalSolution.timeTrajectory_.push_back(observation.time + 0.01 * k);
+    primalSolution.stateTrajectory_.push_back(vector_t::Constant(stateDim, value));
+    primalSolution.inputTrajectory_.push_back(vector_t::Constant(inputDim, value));
+  }
+  primalSolution.modeSchedule_ = ModeSchedule({}, {0});
+  primalSolution.controllerPtr_.reset(new LinearController(primalSolution.timeTrajectory_, std::move(biasArray), std::move(gainArray)));
+}
+
+}  // unnamed namespace
+
+TEST(SharedMemoryRingTest, writeRead) {
+  SharedMemoryRingWriter writer(uniqueName("writeRead"), 4, 64);
+  SharedMemoryRingReader reader(writer.getName());
+
+  std::vector<uint8_t> message;
+  EXPECT_FALSE(readMessage(reader, message));
+  EXPECT_TRUE(reader.isConnected());
+
+  const std::vector<uint8_t> sent{1, 2, 3, 4, 5};
+  writer.write(sent.data(), sent.size());
+  ASSERT_TRUE(readMessage(reader, message));
+  EXPECT_EQ(message, sent);
+
+  // no new message
+  EXPECT_FALSE(readMessage(reader, message));
+
+  // only the latest message is read
+  for (uint8_t i = 0; i < 10; i++) {
+    const std::vector<uint8_t> next(i + 1, i);
+    writer.write(next.data(), next.size());
+  }
+  ASSERT_TRUE(readMessage(reader, message));
+  EXPECT_EQ(message, std::vector<uint8_t>(10, 9));
+  EXPECT_FALSE(readMessage(reader, message));
+}
+
+TEST(SharedMemoryRingTest, exceedsCapacity) {
+  SharedMemoryRingWriter writer(uniqueName("exceedsCapacity"), 2, 8);
+  const std::vector<uint8_t> message(9, 0);
+  EXPECT_THROW(writer.write(message.data(), message.size()), std::runtime_error);
+  EXPECT_THROW(SharedMemoryRingWriter(uniqueName("invalid/name"), 2, 8), std::runtime_error);
+  EXPECT_THROW(SharedMemoryRingWriter(uniqueName("oneSlot"), 1, 8), std::runtime_error);
+}
+
+TEST(SharedMemoryRingTest, writerRestart) {
+  const auto name = uniqueName("writerRestart");
+  SharedMemoryRingReader reader(name);
+
+  std::vector<uint8_t> message;
+  EXPECT_FALSE(readMessage(reader, message));
+  EXPECT_FALSE(reader.isConnected());
+
+  for (uint8_t i = 0; i < 3; i++) {
+    SharedMemoryRingWriter writer(name, 2, 8);
+    writer.write(&i, 1);
+    ASSERT_TRUE(readMessage(reader, message));
+    EXPECT_EQ(message, std::vector<uint8_t>(1, i));
+  }
+
+  // the last writer is gone
+  EXPECT_FALSE(readMessage(reader, message));
+  EXPECT_FALSE(reader.isConnected());
+}
+
+TEST(SharedMemoryRingTest, crashedWriterRestart) {
+  const auto name = uniqueName("crashedWriterRestart");
+
+  // a writer process which terminates without closing and unlinking its segment
+  const pid_t pid = ::fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    auto* writerPtr = new SharedMemoryRingWriter(name, 2, 8);
+    const uint8_t value = 1;
+    writerPtr->write(&value, 1);
+    ::_exit(0);
+  }
+  int status = -1;
+  ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+
+  SharedMemoryRingReader reader(name);
+  std::vector<uint8_t> message;
+  ASSERT_TRUE(readMessage(reader, message));
+  EXPECT_EQ(message, std::vector<uint8_t>(1, 1));
+
+  // the restarted writer replaces the orphaned segment, which the reader detects periodically
+  SharedMemoryRingWriter writer(name, 2, 8);
+  const uint8_t value = 2;
+  writer.write(&value, 1);
+  bool isRead = false;
+  const auto startTime = std::chrono::steady_clock::now();
+  while (!isRead && std::chrono::steady_clock::now() - startTime < std::chrono::seconds(1)) {
+    isRead = readMessage(reader, message);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_TRUE(isRead);
+  EXPECT_EQ(message, std::vector<uint8_t>(1, 2));
+}
+
+TEST(SharedMemoryRingTest, concurrentWriter) {
+  constexpr size_t numMessages = 1000000;
+  constexpr size_t capacity = 256;
+  SharedMemoryRingWriter writer(uniqueName("concurrentWriter"), 2, capacity);
+  SharedMemoryRingReader reader(writer.getName());
+
+  std::atomic_bool isWriterDone{false};
+  std::thread writerThread([&]() {
+    std::vector<uint8_t> message;
+    for (size_t i = 1; i <= numMessages; i++) {
+      // every message is filled with its index and has a varying length
+      message.assign(1 + i % capacity, static_cast<uint8_t>(i));
+      writer.write(message.data(), message.size());
+    }
+    isWriterDone = true;
+  });
+
+  // a message which is read successfully is never torn
+  auto isConsistent = [](const std::vector<uint8_t>& message) {
+    return !message.empty() && std::all_of(message.cbegin(), message.cend(), [&](uint8_t v) { return v == message.front(); });
+  };
+
+  size_t numRead = 0;
+  std::vector<uint8_t> message;
+  while (!isWriterDone) {
+    if (readMessage(reader, message)) {
+      numRead++;
+      ASSERT_TRUE(isConsistent(message));
+    }
+  }
+  writerThread.join();
+  EXPECT_GT(numRead, 0);
+
+  // the last message
+  readMessage(reader, message);
+  EXPECT_EQ(message, std::vector<uint8_t>(1 + numMessages % capacity, static_cast<uint8_t>(numMessages)));
+}
+
+TEST(SharedMemoryRingTest, twoProcessPolicyExchange) {
+  constexpr size_t numObservations = 50;
+  const auto policyName = uniqueName("policy");
+  const auto observationName = uniqueName("observation");
+
+  const pid_t pid = ::fork();
+  ASSERT_GE(pid, 0);
+
+  if (pid == 0) {
+    // MPC process: answers every observation with a policy
+    int status = 0;
+    try {
+      SharedMemoryRingWriter policyWriter(policyName, 4, 1 << 20);
+      SharedMemoryRingReader observationReader(observationName);
+      SystemObservation observation;
+      CommandData command;
+      PrimalSolution primalSolution;
+      std::vector<uint8_t> buffer;
+      const auto startTime = std::chrono::steady_clock::now();
+      while (std::chrono::steady_clock::now() - startTime < std::chrono::seconds(10)) {
+        const bool isUpdated = observationReader.readLatest(
+            [&](const uint8_t* data, size_t size) { compact_policy::decodeObservation(data, size, observation); });
+        if (!isUpdated) {
+          std::this_thread::sleep_for(std::chrono::microseconds(10));
+        } else if (observation.time < 0.0) {
+          break;
+        } else {
+          createPolicy(observation, command, primalSolution);
+          compact_policy::encode(command, primalSolution, PerformanceIndex(), compact_policy::Settings(), buffer);
+          policyWriter.write(buffer.data(), buffer.size());
+        }
+      }
+      status = (observation.time < 0.0) ? 0 : 1;
+    } catch (...) {
+      status = 2;
+    }
+    ::_exit(status);
+  }
+
+  // MRT process
+  SharedMemoryRingWriter observationWriter(observationName, 4, 1024);
+  SharedMemoryRingReader policyReader(policyName);
+  SystemObservation observation;
+  observation.state = vector_t::Zero(12);
+  observation.input = vector_t::Zero(6);
+  std::vector<uint8_t> buffer;
+  CommandData command;
+  PrimalSolution primalSolution;
+  PerformanceIndex performanceIndices;
+
+  for (size_t i = 1; i <= numObservations; i++) {
+    observation.time = static_cast<scalar_t>(i);
+    observation.state.setConstant(observation.time);
+    compact_policy::encodeObservation(observation, buffer);
+
+    // the MPC process might not have opened the observation ring yet, hence the observation is repeated
+    bool isAnswered = false;
+    const auto startTime = std::chrono::steady_clock::now();
+    while (!isAnswered && std::chrono::steady_clock::now() - startTime < std::chrono::seconds(5)) {
+      observationWriter.write(buffer.data(), buffer.size());
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      policyReader.readLatest([&](const uint8_t* data, size_t size) {
+        compact_policy::decode(data, size, command, primalSolution, performanceIndices);
+      });
+      isAnswered = command.mpcInitObservation_.time == observation.time;
+    }
+    ASSERT_TRUE(isAnswered) << "No policy for observation " << i;
+
+    EXPECT_EQ(command.mpcInitObservation_.state, observation.state);
+    ASSERT_EQ(primalSolution.stateTrajectory_.size(), 50);
+    EXPECT_TRUE(primalSolution.stateTrajectory_.back().isConstant(observation.time));
+    const vector_t input = primalSolution.controllerPtr_->computeInput(observation.time, vector_t::Zero(12));
+    EXPECT_TRUE(input.isConstant(observation.time));
+  }
+
+  // stop the MPC process
+  observation.time = -1.0;
+  compact_policy::encodeObservation(observation, buffer);
+  observationWriter.write(buffer.data(), buffer.size());
+
+  int status = -1;
+  ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+}
@@ -51,6 +51,16 @@ class HpipmInterface {
   using OcpSize = hpipm_interface::OcpSize;
   using Settings = hpipm_interface::Settings;
 
+  /**
+   * Dual solution of the QP, used to warm start a subsequent solve. The multipliers and slacks of the constraints of a node are kept in
+   * the internal layout of HPIPM, i.e., they are only meaningful for a node with the same constraint sizes.
+   */
+  struct Multipliers {
+    vector_array_t dynamics;     // Multipliers of the dynamics from node k to k+1, for k = 0, ..., N-1
+    vector_array_t constraints;  // Multipliers of all bounds and constraints at node k, for k = 0, ..., N
+    vector_array_t slacks;       // Slacks of all bounds and constraints at node k, for k = 0, ..., N
+  };
+
   /**
    * Construct the Hpipm interface with given size and settings.
    * Can directly call solve() for a problem with consistent size.
@@ -60,8 +70,11 @@ class HpipmInterface {
   /** Destructor */
   ~HpipmInterface();
 
-  /** Resize the problem */
-  void resize(OcpSize ocpSize);
+  /**
+   * Resize the problem. The HPIPM memory and the staging workspace of the problem data are only rebuilt if the size differs from the
+   * current one, i.e., resizing to the current size does not allocate.
+   */
+  void resize(const OcpSize& ocpSize);
 
   /**
    * Solves a discrete linear quadratic optimal control problem. The interface needs to be resized to a consistent OcpSize before calling
@@ -73,8 +86,8 @@ class HpipmInterface {
    * @param dynamics : Linearized approximation of the discrete dynamics.
    * @param cost : Quadratic approximation of the cost.
    * @param constraints : Linearized approximation of constraints, all constraints are mapped to inequality constraints in HPIPM.
-   * @param [out] stateTrajectory : Solution state (deviation) trajectory.
-   * @param [out] inputTrajectory : Solution input (deviation) trajectory.
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory. Written in place, does not allocate if it is already sized.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory. Written in place, does not allocate if it is already sized.
    * @param verbose : Prints the HPIPM iteration statistics if true.
    * @return HPIPM returned with flag hpipm_status::
    *    SUCCESS = QP solved;
@@ -87,6 +100,46 @@ class HpipmInterface {
                      std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
                      vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose = false);
 
+  /**
+   * Solves a discrete linear quadratic optimal control problem with inequality constraints. The interface needs to be resized to a
+   * consistent OcpSize before calling this function, see hpipm_interface::extractSizesFromProblem().
+   *
+   * The inequality constraints are passed to HPIPM as one-sided general constraints, stacked below the equality constraints. If the
+   * OcpSize declares slack variables for a node, all inequality constraints of that node are softened with the slack penalty of the
+   * settings. Inequality constraints on the initial node that only depend on the state cannot be influenced and should be removed.
+   *
+   * @param x0 : Initial state (deviation).
+   * @param dynamics : Linearized approximation of the discrete dynamics.
+   * @param cost : Quadratic approximation of the cost.
+   * @param constraints : Linearized approximation of equality constraints, C*dx + D*du + e = 0. Pass nullptr if there are none.
+   * @param ineqConstraints : Linearized approximation of inequality constraints, C*dx + D*du + e >= 0.
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory.
+   * @param verbose : Prints the HPIPM iteration statistics if true.
+   * @return HPIPM returned with flag hpipm_status, see solve() above.
+   */
+  hpipm_status solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
+                     std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
+                     std::vector<VectorFunctionLinearApproximation>& ineqConstraints, vector_array_t& stateTrajectory,
+                     vector_array_t& inputTrajectory, bool verbose = false);
+
+  /**
+   * Gets the dual solution of the previously solved problem. Written in place, does not allocate if the trajectories are already sized.
+   *
+   * @param [out] multipliers : The multipliers of the last solve.
+   */
+  void getMultipliers(Multipliers& multipliers) const;
+
+  /**
+   * Seeds the next solve with the given multipliers. The primal initial guess is set to zero, i.e., to the linearization point of the QP.
+   * Nodes for which the given multipliers are empty or have an inconsistent size are cold started. The next solve uses the primal-dual
+   * initial guess (HPIPM warm_start = 2) regardless of settings.warm_start, later solves use settings.warm_start again. The interface
+   * needs to be resized to the size of the next problem before calling this function.
+   *
+   * @param [in] multipliers : The multipliers, e.g., from the previous problem shifted onto the nodes of the next problem.
+   */
+  void warmStart(const Multipliers& multipliers);
+
   /**
    * Return the Riccati cost-to-go for the previously solved problem.
    * Extra information about the initial stage is needed to complete calculation.
@@ -54,6 +54,10 @@ struct Settings {
   int warm_start = 0;
   int pred_corr = 1;
   int ric_alg = 0;  // square root ricatti recursion
+
+  // Penalty on the slack variables of softened inequality constraints: 0.5 * slackWeightQuadratic * s^2 + slackWeightLinear * s
+  scalar_t slackWeightQuadratic = 1e2;
+  scalar_t slackWeightLinear = 1e2;  // exact penalty if larger than the largest multiplier of the inequality constraints
 };
 
 std::ostream& operator<<(std::ostream& stream, const Settings& settings);
@@ -88,5 +88,35 @@ OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximat
                                 const std::vector<ScalarFunctionQuadraticApproximation>& cost,
                                 const std::vector<VectorFunctionLinearApproximation>* constraints);
 
+/**
+ * Extract sizes based on the problem data. Reuses the memory of the given OcpSize, i.e., does not allocate if the number of stages did
+ * not change.
+ *
+ * @param dynamics : Linearized approximation of the discrete dynamics.
+ * @param cost : Quadratic approximation of the cost.
+ * @param constraints : Linearized approximation of constraints, all constraints are mapped to inequality constraints in HPIPM.
+ * @param [out] ocpSize : Derived sizes
+ */
+void extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                             const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                             const std::vector<VectorFunctionLinearApproximation>* constraints, OcpSize& ocpSize);
+
+/**
+ * Extract sizes based on the problem data with additional inequality constraints. The inequality constraints are stacked below the
+ * equality constraints in the general constraints of HPIPM. Reuses the memory of the given OcpSize.
+ *
+ * @param dynamics : Linearized approximation of the discrete dynamics.
+ * @param cost : Quadratic approximation of the cost.
+ * @param constraints : Linearized approximation of equality constraints.
+ * @param ineqConstraints : Linearized approximation of inequality constraints, h(x, u) >= 0.
+ * @param softIneqConstraints : Adds one slack variable per inequality constraint.
+ * @param [out] ocpSize : Derived sizes
+ */
+void extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                             const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                             const std::vector<VectorFunctionLinearApproximation>* constraints,
+                             const std::vector<VectorFunctionLinearApproximation>* ineqConstraints, bool softIneqConstraints,
+                             OcpSize& ocpSize);
+
 }  // namespace hpipm_interface
 }  // namespace ocs2
\ No newline at end of file
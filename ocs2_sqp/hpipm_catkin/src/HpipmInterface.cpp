@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "hpipm_catkin/HpipmInterface.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include <ocs2_core/misc/LinearAlgebra.h>
 
 extern "C" {
@@ -87,19 +90,19 @@ namespace ocs2 {
 
 class HpipmInterface::Impl {
  public:
-  Impl(OcpSize ocpSize, Settings settings) : settings_(std::move(settings)) { initializeMemory(std::move(ocpSize), true); }
-
-  void initializeMemory(OcpSize ocpSize, bool forceInitialization = false) {
-    // We will remove the initial state from the decision variables before passing the data to HPIPM.
-    // This removes the need for adding constraints to enforce x[0] = x_init
-    ocpSize.numStates[0] = 0;
+  Impl(OcpSize ocpSize, Settings settings) : settings_(std::move(settings)) { initializeMemory(ocpSize, true); }
 
+  void initializeMemory(const OcpSize& ocpSize, bool forceInitialization = false) {
     // Skip memory initialization if problem size didn't change.
-    if (!forceInitialization && ocpSize_ == ocpSize) {
+    if (!forceInitialization && isSameSize(ocpSize)) {
       return;
     }
 
-    ocpSize_ = std::move(ocpSize);
+    ocpSize_ = ocpSize;
+
+    // We will remove the initial state from the decision variables before passing the data to HPIPM.
+    // This removes the need for adding constraints to enforce x[0] = x_init
+    ocpSize_.numStates[0] = 0;
 
     const int dim_size = d_ocp_qp_dim_memsize(ocpSize_.numStages);
     dimMem_.reserve(dim_size);
@@ -115,17 +118,106 @@ class HpipmInterface::Impl {
     const int qp_sol_size = d_ocp_qp_sol_memsize(&dim_);
     qpSolMem_.reserve(qp_sol_size);
     d_ocp_qp_sol_create(&dim_, &qpSol_, qpSolMem_.get());
+    coldStartSolution();  // the solution is used as initial guess with warm starting
 
     const int ipm_arg_size = d_ocp_qp_ipm_arg_memsize(&dim_);
     ipmArgMem_.reserve(ipm_arg_size);
     d_ocp_qp_ipm_arg_create(&dim_, &arg_, ipmArgMem_.get());
 
     applySettings(settings_);
+    isWarmStarted_ = false;
 
     // Setup workspace after applying the settings
     const int ipm_size = d_ocp_qp_ipm_ws_memsize(&dim_, &arg_);
     ipmMem_.reserve(ipm_size);
     d_ocp_qp_ipm_ws_create(&dim_, &arg_, &workspace_, ipmMem_.get());
+
+    // Staging of the problem data
+    initializeStaging();
+  }
+
+  /** Compares against the current size. The initial state is not a decision variable and thus ignored. */
+  bool isSameSize(const OcpSize& ocpSize) const {
+    // The sizes are compared first, skipping the initial state is only defined for a non-empty numStates.
+    if (ocpSize_.numStages != ocpSize.numStages || ocpSize_.numStates.size() != ocpSize.numStates.size()) {
+      return false;
+    }
+
+    // use && instead of &= to enable short-circuit evaluation
+    bool same = ocpSize.numStates.empty() ||
+                std::equal(std::next(ocpSize_.numStates.begin()), ocpSize_.numStates.end(), std::next(ocpSize.numStates.begin()));
+    same = same && (ocpSize_.numInputs == ocpSize.numInputs);
+    same = same && (ocpSize_.numInputBoxConstraints == ocpSize.numInputBoxConstraints);
+    same = same && (ocpSize_.numStateBoxConstraints == ocpSize.numStateBoxConstraints);
+    same = same && (ocpSize_.numIneqConstraints == ocpSize.numIneqConstraints);
+    same = same && (ocpSize_.numInputBoxSlack == ocpSize.numInputBoxSlack);
+    same = same && (ocpSize_.numStateBoxSlack == ocpSize.numStateBoxSlack);
+    same = same && (ocpSize_.numIneqSlack == ocpSize.numIneqSlack);
+    return same;
+  }
+
+  /** Sizes the staging workspace of the problem data according to ocpSize_ */
+  void initializeStaging() {
+    const int N = ocpSize_.numStages;
+
+    // Dynamics
+    AA_.assign(N, nullptr);
+    BB_.assign(N, nullptr);
+    bb_.assign(N, nullptr);
+    b0_.resize(N > 0 ? ocpSize_.numStates[1] : 0);
+
+    // Costs
+    QQ_.assign(N + 1, nullptr);
+    RR_.assign(N + 1, nullptr);
+    SS_.assign(N + 1, nullptr);
+    qq_.assign(N + 1, nullptr);
+    rr_.assign(N + 1, nullptr);
+    r0_.resize(ocpSize_.numInputs[0]);
+
+    // Constraints
+    CC_.assign(N + 1, nullptr);
+    DD_.assign(N + 1, nullptr);
+    llg_.assign(N + 1, nullptr);
+    uug_.assign(N + 1, nullptr);
+    boundData_.resize(N + 1);
+    upperBoundData_.resize(N + 1);
+    ugMask_.resize(N + 1);
+    CCData_.resize(N + 1);
+    DDData_.resize(N + 1);
+    for (int k = 0; k < N + 1; k++) {
+      const int numConstraints = ocpSize_.numIneqConstraints[k];
+      boundData_[k].resize(numConstraints);
+      upperBoundData_[k].resize(numConstraints);
+      ugMask_[k].setOnes(numConstraints);
+      CCData_[k].resize(numConstraints, ocpSize_.numStates[k]);
+      DDData_[k].resize(numConstraints, ocpSize_.numInputs[k]);
+    }
+
+    // Slack variables, the softened constraints are the last ones of the general constraints
+    idxs_.assign(N + 1, nullptr);
+    ZZ_.assign(N + 1, nullptr);
+    zz_.assign(N + 1, nullptr);
+    slackBound_.assign(N + 1, nullptr);
+    idxsData_.resize(N + 1);
+    slackWeightQuadraticData_.resize(N + 1);
+    slackWeightLinearData_.resize(N + 1);
+    slackBoundData_.resize(N + 1);
+    for (int k = 0; k < N + 1; k++) {
+      const int numSlack = ocpSize_.numIneqSlack[k];
+      const int firstSlackIndex =
+          ocpSize_.numInputBoxConstraints[k] + ocpSize_.numStateBoxConstraints[k] + ocpSize_.numIneqConstraints[k] - numSlack;
+      idxsData_[k].resize(numSlack);
+      std::iota(idxsData_[k].begin(), idxsData_[k].end(), firstSlackIndex);
+      slackWeightQuadraticData_[k].setConstant(numSlack, settings_.slackWeightQuadratic);
+      slackWeightLinearData_[k].setConstant(numSlack, settings_.slackWeightLinear);
+      slackBoundData_[k].setZero(numSlack);
+      if (numSlack > 0) {
+        idxs_[k] = idxsData_[k].data();
+        ZZ_[k] = slackWeightQuadraticData_[k].data();
+        zz_[k] = slackWeightLinearData_[k].data();
+        slackBound_[k] = slackBoundData_[k].data();
+      }
+    }
   }
 
   void applySettings(Settings& settings) {
@@ -144,8 +236,8 @@ class HpipmInterface::Impl {
   }
 
   void verifySizes(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
-                   std::vector<ScalarFunctionQuadraticApproximation>& cost,
-                   std::vector<VectorFunctionLinearApproximation>* constraints) const {
+                   std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
+                   std::vector<VectorFunctionLinearApproximation>* ineqConstraints) const {
     if (dynamics.size() != ocpSize_.numStages) {
       throw std::runtime_error("[HpipmInterface] Inconsistent size of dynamics: " + std::to_string(dynamics.size()) + " with " +
                                std::to_string(ocpSize_.numStages) + " number of stages.");
@@ -160,20 +252,29 @@ class HpipmInterface::Impl {
                                  std::to_string(ocpSize_.numStages + 1) + " nodes.");
       }
     }
+    if (ineqConstraints != nullptr) {
+      if (ineqConstraints->size() != ocpSize_.numStages + 1) {
+        throw std::runtime_error("[HpipmInterface] Inconsistent size of inequality constraints: " +
+                                 std::to_string(ineqConstraints->size()) + " with " + std::to_string(ocpSize_.numStages + 1) + " nodes.");
+      }
+      for (int k = 0; k < ocpSize_.numStages + 1; k++) {
+        const int numEq = (constraints != nullptr) ? (*constraints)[k].f.size() : 0;
+        if (numEq + (*ineqConstraints)[k].f.size() != ocpSize_.numIneqConstraints[k]) {
+          throw std::runtime_error("[HpipmInterface] Inconsistent number of constraints at node " + std::to_string(k) + ".");
+        }
+      }
+    }
     // TODO: expand with state-input size checks
   }
 
   hpipm_status solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
                      std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
-                     vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose) {
+                     std::vector<VectorFunctionLinearApproximation>* ineqConstraints, vector_array_t& stateTrajectory,
+                     vector_array_t& inputTrajectory, bool verbose) {
     const int N = ocpSize_.numStages;
-    verifySizes(x0, dynamics, cost, constraints);
+    verifySizes(x0, dynamics, cost, constraints, ineqConstraints);
 
     // === Dynamics ===
-    std::vector<scalar_t*> AA(N, nullptr);
-    std::vector<scalar_t*> BB(N, nullptr);
-    std::vector<scalar_t*> bb(N, nullptr);
-
     // k = 0. Absorb initial state into dynamics
     // The initial state is removed from the decision variables
     // The first dynamics becomes:
@@ -181,85 +282,54 @@ class HpipmInterface::Impl {
     //         = B[0]*u[0] + (b[0] + A[0]*x[0])
     //         = B[0]*u[0] + \tilde{b}[0]
     // numState[0] = 0 --> No need to specify A[0] here
-    vector_t b0 = dynamics[0].f;
-    b0.noalias() += dynamics[0].dfdx * x0;
-    BB[0] = dynamics[0].dfdu.data();
-    bb[0] = b0.data();
+    b0_ = dynamics[0].f;
+    b0_.noalias() += dynamics[0].dfdx * x0;
+    BB_[0] = dynamics[0].dfdu.data();
+    bb_[0] = b0_.data();
 
     // k = 1 -> N-1
     for (int k = 1; k < N; k++) {
-      AA[k] = dynamics[k].dfdx.data();
-      BB[k] = dynamics[k].dfdu.data();
-      bb[k] = dynamics[k].f.data();
+      AA_[k] = dynamics[k].dfdx.data();
+      BB_[k] = dynamics[k].dfdu.data();
+      bb_[k] = dynamics[k].f.data();
     }
 
     // === Costs ===
-    std::vector<scalar_t*> QQ(N + 1, nullptr);
-    std::vector<scalar_t*> RR(N + 1, nullptr);
-    std::vector<scalar_t*> SS(N + 1, nullptr);
-    std::vector<scalar_t*> qq(N + 1, nullptr);
-    std::vector<scalar_t*> rr(N + 1, nullptr);
-
     // k = 0. Elimination of initial state requires cost adaptation
     // numState[0] = 0 --> No need to specify Q[0], S[0], q[0] here
-    vector_t r0 = cost[0].dfdu;
-    r0 += cost[0].dfdux * x0;
-    RR[0] = cost[0].dfduu.data();
-    rr[0] = r0.data();
+    r0_ = cost[0].dfdu;
+    r0_.noalias() += cost[0].dfdux * x0;
+    RR_[0] = cost[0].dfduu.data();
+    rr_[0] = r0_.data();
 
     // k = 1 -> (N-1)
     for (int k = 1; k < N; k++) {
-      QQ[k] = cost[k].dfdxx.data();
-      RR[k] = cost[k].dfduu.data();
-      SS[k] = cost[k].dfdux.data();
-      qq[k] = cost[k].dfdx.data();
-      rr[k] = cost[k].dfdu.data();
+      QQ_[k] = cost[k].dfdxx.data();
+      RR_[k] = cost[k].dfduu.data();
+      SS_[k] = cost[k].dfdux.data();
+      qq_[k] = cost[k].dfdx.data();
+      rr_[k] = cost[k].dfdu.data();
     }
 
     // k = N, no inputs
-    QQ[N] = cost[N].dfdxx.data();
-    qq[N] = cost[N].dfdx.data();
+    QQ_[N] = cost[N].dfdxx.data();
+    qq_[N] = cost[N].dfdx.data();
 
     // === Constraints ===
-    // for ocs2 --> C*dx + D*du + e = 0
-    // for hpipm --> ug >= C*dx + D*du >= lg
-    std::vector<scalar_t*> CC(N + 1, nullptr);
-    std::vector<scalar_t*> DD(N + 1, nullptr);
-    std::vector<scalar_t*> llg(N + 1, nullptr);
-    std::vector<scalar_t*> uug(N + 1, nullptr);
-    std::vector<ocs2::vector_t> boundData;  // Declare at this scope to keep the data alive while HPIPM has the pointers
-
-    if (constraints != nullptr) {
-      auto& constr = *constraints;
-      boundData.resize(N + 1);
-
-      // k = 0, eliminate initial state
-      // numState[0] = 0 --> No need to specify C[0] here
-      if (constr[0].f.size() > 0) {
-        boundData[0] = -constr[0].f;
-        boundData[0].noalias() -= constr[0].dfdx * x0;
-        llg[0] = boundData[0].data();
-        uug[0] = boundData[0].data();
-        DD[0] = constr[0].dfdu.data();
-      }
-
-      // k = 1 -> (N-1)
-      for (int k = 1; k < N; k++) {
-        if (constr[k].f.size() > 0) {
-          CC[k] = constr[k].dfdx.data();
-          DD[k] = constr[k].dfdu.data();
-          boundData[k] = -constr[k].f;
-          llg[k] = boundData[k].data();
-          uug[k] = boundData[k].data();
-        }
-      }
-
-      // k = N, no inputs
-      if (constr[N].f.size() > 0) {
-        CC[N] = constr[N].dfdx.data();
-        boundData[N] = -constr[N].f;
-        llg[N] = boundData[N].data();
-        uug[N] = boundData[N].data();
+    // for ocs2 --> C*dx + D*du + e = 0 for equality constraints and C*dx + D*du + e >= 0 for inequality constraints
+    // for hpipm --> ug >= C*dx + D*du >= lg, the upper bound of the inequality constraints is disabled with the mask
+    std::fill(CC_.begin(), CC_.end(), nullptr);
+    std::fill(DD_.begin(), DD_.end(), nullptr);
+    std::fill(llg_.begin(), llg_.end(), nullptr);
+    std::fill(uug_.begin(), uug_.end(), nullptr);
+
+    for (int k = 0; k < N + 1; k++) {
+      const bool hasEqConstraints = constraints != nullptr && (*constraints)[k].f.size() > 0;
+      const bool hasIneqConstraints = ineqConstraints != nullptr && (*ineqConstraints)[k].f.size() > 0;
+      if (hasIneqConstraints) {
+        setStackedConstraints(k, x0, hasEqConstraints ? &(*constraints)[k] : nullptr, (*ineqConstraints)[k]);
+      } else if (hasEqConstraints) {
+        setEqualityConstraints(k, x0, (*constraints)[k]);
       }
     }
 
@@ -270,19 +340,24 @@ class HpipmInterface::Impl {
     int** hidxbu = nullptr;
     scalar_t** hlbu = nullptr;
     scalar_t** hubu = nullptr;
-    scalar_t** hZl = nullptr;
-    scalar_t** hZu = nullptr;
-    scalar_t** hzl = nullptr;
-    scalar_t** hzu = nullptr;
-    int** hidxs = nullptr;
-    scalar_t** hlls = nullptr;
-    scalar_t** hlus = nullptr;
 
     // === Set and solve ===
-    d_ocp_qp_set_all(AA.data(), BB.data(), bb.data(), QQ.data(), SS.data(), RR.data(), qq.data(), rr.data(), hidxbx, hlbx, hubx, hidxbu,
-                     hlbu, hubu, CC.data(), DD.data(), llg.data(), uug.data(), hZl, hZu, hzl, hzu, hidxs, hlls, hlus, &qp_);
+    d_ocp_qp_set_all(AA_.data(), BB_.data(), bb_.data(), QQ_.data(), SS_.data(), RR_.data(), qq_.data(), rr_.data(), hidxbx, hlbx, hubx,
+                     hidxbu, hlbu, hubu, CC_.data(), DD_.data(), llg_.data(), uug_.data(), ZZ_.data(), ZZ_.data(), zz_.data(), zz_.data(),
+                     idxs_.data(), slackBound_.data(), slackBound_.data(), &qp_);
+    for (int k = 0; k < N + 1; k++) {
+      if (ocpSize_.numIneqConstraints[k] > 0) {
+        d_ocp_qp_set_ug_mask(k, ugMask_[k].data(), &qp_);
+      }
+    }
     d_ocp_qp_ipm_solve(&qp_, &qpSol_, &arg_, &workspace_);
 
+    // A warm start applies to a single solve, subsequent solves use the configured mode again.
+    if (isWarmStarted_) {
+      d_ocp_qp_ipm_arg_set_warm_start(&settings_.warm_start, &arg_);
+      isWarmStarted_ = false;
+    }
+
     if (verbose) {
       printStatus();
     }
@@ -300,6 +375,134 @@ class HpipmInterface::Impl {
     return hpipm_status(hpipmStatus);
   }
 
+  /** Equality constraints at node k: -e <= C*dx + D*du <= -e */
+  void setEqualityConstraints(int k, const vector_t& x0, VectorFunctionLinearApproximation& constraints) {
+    auto& bound = boundData_[k];
+    bound = -constraints.f;
+    if (k == 0) {
+      // numState[0] = 0 --> No need to specify C[0] here, eliminate initial state
+      bound.noalias() -= constraints.dfdx * x0;
+    } else {
+      CC_[k] = constraints.dfdx.data();
+    }
+    if (k < ocpSize_.numStages) {
+      DD_[k] = constraints.dfdu.data();
+    }
+    llg_[k] = bound.data();
+    uug_[k] = bound.data();
+    ugMask_[k].setOnes();
+  }
+
+  /** Equality constraints stacked on top of the inequality constraints at node k: -e <= C*dx + D*du <= (-e or unbounded) */
+  void setStackedConstraints(int k, const vector_t& x0, const VectorFunctionLinearApproximation* eqConstraints,
+                             const VectorFunctionLinearApproximation& ineqConstraints) {
+    const int numEq = (eqConstraints != nullptr) ? eqConstraints->f.size() : 0;
+    const int numIneq = ineqConstraints.f.size();
+
+    auto& lowerBound = boundData_[k];
+    if (numEq > 0) {
+      lowerBound.head(numEq) = -eqConstraints->f;
+    }
+    lowerBound.tail(numIneq) = -ineqConstraints.f;
+
+    if (k == 0) {
+      // numState[0] = 0 --> No need to specify C[0] here, eliminate initial state
+      if (numEq > 0) {
+        lowerBound.head(numEq).noalias() -= eqConstraints->dfdx * x0;
+      }
+      lowerBound.tail(numIneq).noalias() -= ineqConstraints.dfdx * x0;
+    } else {
+      auto& C = CCData_[k];
+      if (numEq > 0) {
+        C.topRows(numEq) = eqConstraints->dfdx;
+      }
+      C.bottomRows(numIneq) = ineqConstraints.dfdx;
+      CC_[k] = C.data();
+    }
+
+    if (k < ocpSize_.numStages) {
+      auto& D = DDData_[k];
+      if (numEq > 0) {
+        D.topRows(numEq) = eqConstraints->dfdu;
+      }
+      D.bottomRows(numIneq) = ineqConstraints.dfdu;
+      DD_[k] = D.data();
+    }
+
+    auto& upperBound = upperBoundData_[k];
+    upperBound.head(numEq) = lowerBound.head(numEq);
+    upperBound.tail(numIneq).setZero();  // not used, masked
+    ugMask_[k].head(numEq).setOnes();
+    ugMask_[k].tail(numIneq).setZero();
+
+    llg_[k] = lowerBound.data();
+    uug_[k] = upperBound.data();
+  }
+
+  /** Sets the initial guess stored in the solution to the cold start of all nodes */
+  void coldStartSolution() {
+    for (int k = 0; k < ocpSize_.numStages + 1; k++) {
+      coldStartNode(k);
+    }
+  }
+
+  /**
+   * Sets the primal guess of node k to zero, and its multipliers unless they are kept. With warm_start = 2, HPIPM starts the interior
+   * point iterations from the given slacks and inequality multipliers, which therefore are strictly positive with t * lam = mu0, as in
+   * the cold start of HPIPM.
+   */
+  void coldStartNode(int k, bool keepMultipliers = false) {
+    toVector(qpSol_.ux[k]).setZero();
+    if (!keepMultipliers) {
+      if (k < ocpSize_.numStages) {
+        toVector(qpSol_.pi[k]).setZero();
+      }
+      toVector(qpSol_.lam[k]).setConstant(settings_.mu0);
+      toVector(qpSol_.t[k]).setOnes();
+    }
+  }
+
+  void getMultipliers(Multipliers& multipliers) const {
+    const int N = ocpSize_.numStages;
+    multipliers.dynamics.resize(N);
+    multipliers.constraints.resize(N + 1);
+    multipliers.slacks.resize(N + 1);
+    for (int k = 0; k < N + 1; k++) {
+      if (k < N) {
+        multipliers.dynamics[k] = toVector(qpSol_.pi[k]);
+      }
+      multipliers.constraints[k] = toVector(qpSol_.lam[k]);
+      multipliers.slacks[k] = toVector(qpSol_.t[k]);
+    }
+  }
+
+  void warmStart(const Multipliers& multipliers) {
+    const int N = ocpSize_.numStages;
+    for (int k = 0; k < N + 1; k++) {
+      const bool hasConsistentDynamics = k == N || (k < multipliers.dynamics.size() && multipliers.dynamics[k].size() == qpSol_.pi[k].m);
+      const bool hasConsistentConstraints = k < multipliers.constraints.size() && multipliers.constraints[k].size() == qpSol_.lam[k].m &&
+                                            k < multipliers.slacks.size() && multipliers.slacks[k].size() == qpSol_.t[k].m;
+      if (hasConsistentDynamics && hasConsistentConstraints) {
+        if (k < N) {
+          toVector(qpSol_.pi[k]) = multipliers.dynamics[k];
+        }
+        toVector(qpSol_.lam[k]) = multipliers.constraints[k];
+        toVector(qpSol_.t[k]) = multipliers.slacks[k];
+        coldStartNode(k, true);
+      } else {
+        coldStartNode(k);
+      }
+    }
+
+    // HPIPM only reads the multipliers of the initial guess with warm_start = 2
+    int warmStartMode = 2;
+    d_ocp_qp_ipm_arg_set_warm_start(&warmStartMode, &arg_);
+    isWarmStarted_ = true;
+  }
+
+  /** Map of the data of a HPIPM (blasfeo) vector */
+  static Eigen::Map<vector_t> toVector(const blasfeo_dvec& vec) { return Eigen::Map<vector_t>(vec.pa, vec.m); }
+
   bool getStateSolution(const vector_t& x0, vector_array_t& stateTrajectory) {
     stateTrajectory.resize(ocpSize_.numStages + 1);
     stateTrajectory.front() = x0;
@@ -505,6 +708,7 @@ class HpipmInterface::Impl {
  private:
   Settings settings_;
   OcpSize ocpSize_;
+  bool isWarmStarted_ = false;  // whether the next solve uses the multipliers set by warmStart()
 
   MemoryBlock dimMem_;
   d_ocp_qp_dim dim_;
@@ -520,6 +724,19 @@ class HpipmInterface::Impl {
 
   MemoryBlock ipmMem_;
   d_ocp_qp_ipm_ws workspace_;
+
+  // Staging workspace, keeps the pointers to the problem data and the data adapted for the initial state elimination alive while HPIPM
+  // uses them. Sized in initializeMemory.
+  std::vector<scalar_t*> AA_, BB_, bb_;
+  std::vector<scalar_t*> QQ_, RR_, SS_, qq_, rr_;
+  std::vector<scalar_t*> CC_, DD_, llg_, uug_;
+  vector_t b0_, r0_;
+  std::vector<vector_t> boundData_, upperBoundData_, ugMask_;
+  std::vector<matrix_t> CCData_, DDData_;  // Stacked equality and inequality constraints
+  std::vector<int*> idxs_;
+  std::vector<scalar_t*> ZZ_, zz_, slackBound_;
+  std::vector<std::vector<int>> idxsData_;
+  std::vector<vector_t> slackWeightQuadraticData_, slackWeightLinearData_, slackBoundData_;
 };
 
 HpipmInterface::HpipmInterface(OcpSize ocpSize, const Settings& settings)
@@ -527,15 +744,31 @@ HpipmInterface::HpipmInterface(OcpSize ocpSize, const Settings& settings)
 
 HpipmInterface::~HpipmInterface() = default;
 
-void HpipmInterface::resize(OcpSize ocpSize) {
-  pImpl_->initializeMemory(std::move(ocpSize));
+void HpipmInterface::resize(const OcpSize& ocpSize) {
+  pImpl_->initializeMemory(ocpSize);
 }
 
 hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
                                    std::vector<ScalarFunctionQuadraticApproximation>& cost,
                                    std::vector<VectorFunctionLinearApproximation>* constraints, vector_array_t& stateTrajectory,
                                    vector_array_t& inputTrajectory, bool verbose) {
-  return pImpl_->solve(x0, dynamics, cost, constraints, stateTrajectory, inputTrajectory, verbose);
+  return pImpl_->solve(x0, dynamics, cost, constraints, nullptr, stateTrajectory, inputTrajectory, verbose);
+}
+
+hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                   std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                                   std::vector<VectorFunctionLinearApproximation>* constraints,
+                                   std::vector<VectorFunctionLinearApproximation>& ineqConstraints, vector_array_t& stateTrajectory,
+                                   vector_array_t& inputTrajectory, bool verbose) {
+  return pImpl_->solve(x0, dynamics, cost, constraints, &ineqConstraints, stateTrajectory, inputTrajectory, verbose);
+}
+
+void HpipmInterface::getMultipliers(Multipliers& multipliers) const {
+  pImpl_->getMultipliers(multipliers);
+}
+
+void HpipmInterface::warmStart(const Multipliers& multipliers) {
+  pImpl_->warmStart(multipliers);
 }
 
 std::vector<ScalarFunctionQuadraticApproximation> HpipmInterface::getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0,
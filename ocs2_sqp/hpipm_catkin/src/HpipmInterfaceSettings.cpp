@@ -51,6 +51,10 @@ std::ostream& operator<<(std::ostream& stream, const Settings& settings) {
   loadData::printValue(stream, settings.warm_start, "warm_start", settings.warm_start != defaultSettings.warm_start);
   loadData::printValue(stream, settings.pred_corr, "pred_corr", settings.pred_corr != defaultSettings.pred_corr);
   loadData::printValue(stream, settings.ric_alg, "ric_alg", settings.ric_alg != defaultSettings.ric_alg);
+  loadData::printValue(stream, settings.slackWeightQuadratic, "slackWeightQuadratic",
+                       settings.slackWeightQuadratic != defaultSettings.slackWeightQuadratic);
+  loadData::printValue(stream, settings.slackWeightLinear, "slackWeightLinear",
+                       settings.slackWeightLinear != defaultSettings.slackWeightLinear);
   stream << " #### =============================================================================" << std::endl;
   return stream;
 }
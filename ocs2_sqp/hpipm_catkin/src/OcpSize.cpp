@@ -49,26 +49,60 @@ bool operator==(const OcpSize& lhs, const OcpSize& rhs) noexcept {
 OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
                                 const std::vector<ScalarFunctionQuadraticApproximation>& cost,
                                 const std::vector<VectorFunctionLinearApproximation>* constraints) {
+  OcpSize problemSize;
+  extractSizesFromProblem(dynamics, cost, constraints, problemSize);
+  return problemSize;
+}
+
+void extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                             const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                             const std::vector<VectorFunctionLinearApproximation>* constraints, OcpSize& ocpSize) {
+  extractSizesFromProblem(dynamics, cost, constraints, nullptr, false, ocpSize);
+}
+
+void extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                             const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                             const std::vector<VectorFunctionLinearApproximation>* constraints,
+                             const std::vector<VectorFunctionLinearApproximation>* ineqConstraints, bool softIneqConstraints,
+                             OcpSize& ocpSize) {
   const int numStages = dynamics.size();
 
-  OcpSize problemSize(dynamics.size());
+  // Reset to N stages without constraints. Keeps the memory if the number of stages did not change.
+  ocpSize.numStages = numStages;
+  ocpSize.numInputs.assign(numStages + 1, 0);
+  ocpSize.numStates.assign(numStages + 1, 0);
+  ocpSize.numInputBoxConstraints.assign(numStages + 1, 0);
+  ocpSize.numStateBoxConstraints.assign(numStages + 1, 0);
+  ocpSize.numIneqConstraints.assign(numStages + 1, 0);
+  ocpSize.numInputBoxSlack.assign(numStages + 1, 0);
+  ocpSize.numStateBoxSlack.assign(numStages + 1, 0);
+  ocpSize.numIneqSlack.assign(numStages + 1, 0);
 
   // State inputs
   for (int k = 0; k < numStages; k++) {
-    problemSize.numStates[k] = dynamics[k].dfdx.cols();
-    problemSize.numInputs[k] = dynamics[k].dfdu.cols();
+    ocpSize.numStates[k] = dynamics[k].dfdx.cols();
+    ocpSize.numInputs[k] = dynamics[k].dfdu.cols();
   }
-  problemSize.numStates[numStages] = dynamics[numStages - 1].dfdx.rows();
-  problemSize.numInputs[numStages] = 0;
+  ocpSize.numStates[numStages] = dynamics[numStages - 1].dfdx.rows();
+  ocpSize.numInputs[numStages] = 0;
 
   // Constraints
   if (constraints != nullptr) {
     for (int k = 0; k < numStages + 1; k++) {
-      problemSize.numIneqConstraints[k] = (*constraints)[k].f.size();
+      ocpSize.numIneqConstraints[k] = (*constraints)[k].f.size();
     }
   }
 
-  return problemSize;
+  // Inequality constraints, stacked below the equality constraints
+  if (ineqConstraints != nullptr) {
+    for (int k = 0; k < numStages + 1; k++) {
+      const int numIneq = (*ineqConstraints)[k].f.size();
+      ocpSize.numIneqConstraints[k] += numIneq;
+      if (softIneqConstraints) {
+        ocpSize.numIneqSlack[k] = numIneq;
+      }
+    }
+  }
 }
 
 }  // namespace hpipm_interface
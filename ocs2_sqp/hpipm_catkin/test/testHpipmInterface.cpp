@@ -109,6 +109,52 @@ TEST(test_hpiphm_interface, solve_after_resize) {
   }
 }
 
+TEST(test_hpiphm_interface, solve_repeatedly_with_reused_memory) {
+  int nx = 3;
+  int nu = 2;
+  int N = 5;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+
+  // In place size extraction
+  ocs2::HpipmInterface::OcpSize ocpSize;
+  ocs2::hpipm_interface::extractSizesFromProblem(system, cost, nullptr, ocpSize);
+  ASSERT_TRUE(ocpSize == ocs2::hpipm_interface::extractSizesFromProblem(system, cost, nullptr));
+
+  // Solve once
+  ocs2::HpipmInterface hpipmInterface;
+  hpipmInterface.resize(ocpSize);
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, nullptr, xSol, uSol, true), hpipm_status::SUCCESS);
+
+  // Solve again with the same sizes into the same output trajectories
+  const auto* xSolData = xSol[1].data();
+  const auto* uSolData = uSol[0].data();
+  x0 = ocs2::vector_t::Random(nx);
+  ocs2::hpipm_interface::extractSizesFromProblem(system, cost, nullptr, ocpSize);
+  hpipmInterface.resize(ocpSize);
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, nullptr, xSol, uSol, true), hpipm_status::SUCCESS);
+  ASSERT_EQ(xSol[1].data(), xSolData);
+  ASSERT_EQ(uSol[0].data(), uSolData);
+
+  // Initial condition
+  ASSERT_TRUE(xSol[0].isApprox(x0));
+
+  // Check dynamic feasibility
+  for (int k = 0; k < N; k++) {
+    ASSERT_TRUE(xSol[k + 1].isApprox(system[k].dfdx * xSol[k] + system[k].dfdu * uSol[k] + system[k].f));
+  }
+}
+
 TEST(test_hpiphm_interface, knownSolution) {
   int nx = 3;
   int nu = 2;
@@ -205,6 +251,194 @@ TEST(test_hpiphm_interface, with_constraints) {
   }
 }
 
+TEST(test_hpiphm_interface, with_inequality_constraints) {
+  // Initialize without size
+  ocs2::HpipmInterface hpipmInterface;
+
+  int nx = 3;
+  int nu = 2;
+  int nc = 1;
+  int N = 5;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    constraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nc));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  constraints.emplace_back(ocs2::VectorFunctionLinearApproximation());
+
+  // Unconstrained reference solution
+  std::vector<ocs2::vector_t> xSolRef;
+  std::vector<ocs2::vector_t> uSolRef;
+  hpipmInterface.resize(ocs2::hpipm_interface::extractSizesFromProblem(system, cost, &constraints));
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, xSolRef, uSolRef), hpipm_status::SUCCESS);
+
+  // Upper bound on the first input, active for the reference solution: uBound - u[0] >= 0
+  const ocs2::scalar_t margin = 0.1;
+  std::vector<ocs2::VectorFunctionLinearApproximation> ineqConstraints(N + 1);
+  for (int k = 0; k < N; k++) {
+    ineqConstraints[k].setZero(1, nx, nu);
+    ineqConstraints[k].dfdu(0, 0) = -1.0;
+    ineqConstraints[k].f(0) = uSolRef[k](0) - margin;
+  }
+  ineqConstraints[N].setZero(0, nx, 0);
+
+  ocs2::HpipmInterface::OcpSize ocpSize;
+  ocs2::hpipm_interface::extractSizesFromProblem(system, cost, &constraints, &ineqConstraints, false, ocpSize);
+  hpipmInterface.resize(ocpSize);
+
+  // Solve!
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  const auto status = hpipmInterface.solve(x0, system, cost, &constraints, ineqConstraints, xSol, uSol, true);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+
+  // Initial condition
+  ASSERT_TRUE(xSol[0].isApprox(x0));
+
+  // Check dynamic feasibility
+  for (int k = 0; k < N; k++) {
+    ASSERT_TRUE(xSol[k + 1].isApprox(system[k].dfdx * xSol[k] + system[k].dfdu * uSol[k] + system[k].f, 1e-9));
+  }
+
+  // Check constraints
+  for (int k = 0; k < N; k++) {
+    ASSERT_TRUE(constraints[k].f.isApprox(-constraints[k].dfdx * xSol[k] - constraints[k].dfdu * uSol[k], 1e-9));
+    const ocs2::vector_t h = ineqConstraints[k].f + ineqConstraints[k].dfdx * xSol[k] + ineqConstraints[k].dfdu * uSol[k];
+    ASSERT_GE(h.minCoeff(), -1e-6);
+  }
+
+  // The soft version of the problem may violate the constraints, but solves as well
+  ocs2::hpipm_interface::extractSizesFromProblem(system, cost, &constraints, &ineqConstraints, true, ocpSize);
+  hpipmInterface.resize(ocpSize);
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, ineqConstraints, xSol, uSol), hpipm_status::SUCCESS);
+  for (int k = 0; k < N; k++) {
+    ASSERT_TRUE(xSol[k + 1].isApprox(system[k].dfdx * xSol[k] + system[k].dfdu * uSol[k] + system[k].f, 1e-9));
+  }
+}
+
+TEST(test_hpiphm_interface, warmStartMultipliers) {
+  int nx = 3;
+  int nu = 2;
+  int N = 5;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  std::vector<ocs2::VectorFunctionLinearApproximation> ineqConstraints(N + 1);
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    ineqConstraints[k] = ocs2::getRandomConstraints(nx, nu, 1);
+    ineqConstraints[k].f.array() += 10.0;
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  ineqConstraints[N].setZero(0, nx, 0);
+
+  // Interface with warm start of primal and dual variables
+  ocs2::HpipmInterface::OcpSize ocpSize;
+  ocs2::hpipm_interface::extractSizesFromProblem(system, cost, nullptr, &ineqConstraints, false, ocpSize);
+  ocs2::HpipmInterface::Settings settings;
+  settings.warm_start = 2;
+  ocs2::HpipmInterface hpipmInterface(ocpSize, settings);
+
+  // Cold solve
+  std::vector<ocs2::vector_t> xSolCold;
+  std::vector<ocs2::vector_t> uSolCold;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, nullptr, ineqConstraints, xSolCold, uSolCold), hpipm_status::SUCCESS);
+
+  ocs2::HpipmInterface::Multipliers multipliers;
+  hpipmInterface.getMultipliers(multipliers);
+  ASSERT_EQ(multipliers.dynamics.size(), N);
+  ASSERT_EQ(multipliers.constraints.size(), N + 1);
+  ASSERT_EQ(multipliers.slacks.size(), N + 1);
+  for (int k = 0; k < N; k++) {
+    ASSERT_EQ(multipliers.dynamics[k].size(), nx);
+  }
+
+  // Warm started solve of the same problem converges to the same solution
+  hpipmInterface.warmStart(multipliers);
+  std::vector<ocs2::vector_t> xSolWarm;
+  std::vector<ocs2::vector_t> uSolWarm;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, nullptr, ineqConstraints, xSolWarm, uSolWarm), hpipm_status::SUCCESS);
+  for (int k = 0; k < N; k++) {
+    ASSERT_TRUE(xSolWarm[k + 1].isApprox(xSolCold[k + 1], 1e-6));
+    ASSERT_TRUE(uSolWarm[k].isApprox(uSolCold[k], 1e-6));
+  }
+
+  // Nodes with inconsistent multipliers are cold started
+  multipliers.dynamics.pop_back();
+  hpipmInterface.warmStart(multipliers);
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, nullptr, ineqConstraints, xSolWarm, uSolWarm), hpipm_status::SUCCESS);
+  for (int k = 0; k < N; k++) {
+    ASSERT_TRUE(uSolWarm[k].isApprox(uSolCold[k], 1e-6));
+  }
+}
+
+TEST(test_hpiphm_interface, warmStartMultipliersChangedConstraints) {
+  int nx = 3;
+  int nu = 2;
+  int N = 5;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  std::vector<ocs2::VectorFunctionLinearApproximation> ineqConstraints(N + 1);
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    ineqConstraints[k] = ocs2::getRandomConstraints(nx, nu, 1);
+    ineqConstraints[k].f.array() += 10.0;
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  ineqConstraints[N].setZero(0, nx, 0);
+
+  ocs2::HpipmInterface::OcpSize ocpSize;
+  ocs2::hpipm_interface::extractSizesFromProblem(system, cost, nullptr, &ineqConstraints, false, ocpSize);
+  ocs2::HpipmInterface::Settings settings;
+  settings.warm_start = 2;
+  ocs2::HpipmInterface hpipmInterface(ocpSize, settings);
+
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, nullptr, ineqConstraints, xSol, uSol), hpipm_status::SUCCESS);
+  ocs2::HpipmInterface::Multipliers multipliers;
+  hpipmInterface.getMultipliers(multipliers);
+
+  // The number of inequality constraints changes at some nodes, e.g., after a mode change
+  const int numChangedNodes = 2;
+  for (int k = 1; k < 1 + numChangedNodes; k++) {
+    ineqConstraints[k] = ocs2::getRandomConstraints(nx, nu, 3);
+    ineqConstraints[k].f.array() += 10.0;
+  }
+  ocs2::hpipm_interface::extractSizesFromProblem(system, cost, nullptr, &ineqConstraints, false, ocpSize);
+
+  // Reference solution from a cold start
+  ocs2::HpipmInterface hpipmInterfaceCold(ocpSize);
+  std::vector<ocs2::vector_t> xSolCold;
+  std::vector<ocs2::vector_t> uSolCold;
+  ASSERT_EQ(hpipmInterfaceCold.solve(x0, system, cost, nullptr, ineqConstraints, xSolCold, uSolCold), hpipm_status::SUCCESS);
+
+  // The nodes with changed dimensions are cold started, while the others are warm started
+  hpipmInterface.resize(ocpSize);
+  hpipmInterface.warmStart(multipliers);
+  std::vector<ocs2::vector_t> xSolWarm;
+  std::vector<ocs2::vector_t> uSolWarm;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, nullptr, ineqConstraints, xSolWarm, uSolWarm), hpipm_status::SUCCESS);
+  for (int k = 0; k < N; k++) {
+    ASSERT_TRUE(xSolWarm[k + 1].isApprox(xSolCold[k + 1], 1e-6));
+    ASSERT_TRUE(uSolWarm[k].isApprox(uSolCold[k], 1e-6));
+  }
+}
+
 TEST(test_hpiphm_interface, noInputs) {
   // Initialize without size
   ocs2::HpipmInterface hpipmInterface;
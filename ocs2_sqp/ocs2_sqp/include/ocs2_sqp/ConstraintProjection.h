@@ -46,6 +46,16 @@ namespace ocs2 {
  */
 std::pair<VectorFunctionLinearApproximation, matrix_t> qrConstraintProjection(const VectorFunctionLinearApproximation& constraint);
 
+/**
+ * Same as above, but writes the projection terms into existing memory. No reallocation happens if the sizes did not change.
+ *
+ * @param constraint : C = dfdx, D = dfdu, e = f;
+ * @param [out] projection : Projection terms Px = dfdx, Pu = dfdu, Pe = f
+ * @param [out] pseudoInverse : Left pseudo-inverse of D^T.
+ */
+void qrConstraintProjection(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projection,
+                            matrix_t& pseudoInverse);
+
 /**
  * Returns the linear projection
  *  u = Pu * \tilde{u} + Px * x + Pe
@@ -61,6 +71,16 @@ std::pair<VectorFunctionLinearApproximation, matrix_t> qrConstraintProjection(co
 std::pair<VectorFunctionLinearApproximation, matrix_t> luConstraintProjection(const VectorFunctionLinearApproximation& constraint,
                                                                               bool extractPseudoInverse = false);
 
+/**
+ * Same as above, but writes the projection terms into existing memory. No reallocation happens if the sizes did not change.
+ *
+ * @param constraint : C = dfdx, D = dfdu, e = f;
+ * @param [out] projection : Projection terms Px = dfdx, Pu = dfdu, Pe = f
+ * @param [out] pseudoInverse : If not nullptr, the left pseudo-inverse of D^T is written to it.
+ */
+void luConstraintProjection(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projection,
+                            matrix_t* pseudoInverse = nullptr);
+
 /**
  * Coefficients to compute the Newton step of the Lagrange multiplier associated with the state-input equality constraint such that
  * dfdx*dx + dfdu*du + dfdcostate*dcostate + f
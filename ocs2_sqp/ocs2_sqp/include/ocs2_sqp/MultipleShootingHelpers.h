@@ -87,8 +87,34 @@ scalar_t armijoDescentMetric(const std::vector<ScalarFunctionQuadraticApproximat
 void remapProjectedInput(const std::vector<VectorFunctionLinearApproximation>& constraintsProjection, const vector_array_t& deltaXSol,
                          vector_array_t& deltaUSol);
 
+/**
+ * Re-map the projected input back to the original space. Writes into the given output trajectory, i.e., does not allocate if deltaUSol
+ * is already sized.
+ *
+ * @param [in] constraintsProjection: The constraints projection.
+ * @param [in] deltaXSol: The state trajectory of the QP subproblem solution.
+ * @param [in] deltaUTildeSol: The projected input trajectory of the QP subproblem solution.
+ * @param [out] deltaUSol: The input trajectory in the original space.
+ */
+void remapProjectedInput(const std::vector<VectorFunctionLinearApproximation>& constraintsProjection, const vector_array_t& deltaXSol,
+                         const vector_array_t& deltaUTildeSol, vector_array_t& deltaUSol);
+
 void remapProjectedGain(const std::vector<VectorFunctionLinearApproximation>& constraintsProjection, matrix_array_t& KMatrices);
 
+/**
+ * Stacks the state and the state-input inequality constraints of a node into the inequality constraints of the QP subproblem:
+ * [stateIneqConstraints; stateInputIneqConstraints] >= 0. Reuses the memory of the output if its size did not change.
+ *
+ * @param [in] stateIneqConstraints: The linearized state inequality constraints. Might be empty.
+ * @param [in] stateInputIneqConstraints: The linearized state-input inequality constraints. Might be empty.
+ * @param [in] nx: The state dimension of the node.
+ * @param [in] nu: The input dimension of the node, after the projection if it is used.
+ * @param [out] ineqConstraints: The stacked inequality constraints.
+ */
+void stackInequalityConstraints(const VectorFunctionLinearApproximation& stateIneqConstraints,
+                                const VectorFunctionLinearApproximation& stateInputIneqConstraints, int nx, int nu,
+                                VectorFunctionLinearApproximation& ineqConstraints);
+
 /**
  * Constructs a primal solution (with a feedforward controller) based the LQ subproblem solution.
  *
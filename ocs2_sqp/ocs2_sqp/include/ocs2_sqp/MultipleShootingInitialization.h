@@ -34,6 +34,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 
+#include <hpipm_catkin/HpipmInterface.h>
+
 #include "ocs2_sqp/TimeDiscretization.h"
 
 namespace ocs2 {
@@ -94,5 +96,34 @@ void initializeStateInputTrajectories(const vector_t& initState, const std::vect
                                       const PrimalSolution& primalSolution, Initializer& initializer, vector_array_t& stateTrajectory,
                                       vector_array_t& inputTrajectory);
 
+/**
+ * Initializes for the state-input trajectories, taking into account changes of the mode schedule. The primalSolution is only interpolated
+ * on the intervals where its mode schedule agrees with the given one. The initializer is used for the remaining intervals.
+ *
+ * @param [in] initState :  Initial state
+ * @param [in] timeDiscretization : The annotated time trajectory
+ * @param [in] modeSchedule : The mode schedule of the new problem
+ * @param [in] primalSolution : previous solution
+ * @param [in] initializer : System initializer
+ * @param [out] stateTrajectory : The initialized state trajectory
+ * @param [out] inputTrajectory : The initialized input trajectory
+ */
+void initializeStateInputTrajectories(const vector_t& initState, const std::vector<AnnotatedTime>& timeDiscretization,
+                                      const ModeSchedule& modeSchedule, const PrimalSolution& primalSolution, Initializer& initializer,
+                                      vector_array_t& stateTrajectory, vector_array_t& inputTrajectory);
+
+/**
+ * Shifts the QP multipliers of the previous problem onto a new time discretization. A node takes the multipliers of the previous node
+ * whose interval contains its time, if both are of the same type (event or intermediate node). The terminal node takes the previous
+ * terminal multipliers. The multipliers of all other nodes are left empty, i.e., these nodes are cold started.
+ *
+ * @param [in] previousTimeDiscretization : The annotated time trajectory of the previous problem
+ * @param [in] previousMultipliers : The QP multipliers of the previous problem
+ * @param [in] timeDiscretization : The annotated time trajectory of the new problem
+ * @param [out] multipliers : The shifted multipliers. Reuses the memory if the sizes did not change.
+ */
+void shiftMultipliers(const std::vector<AnnotatedTime>& previousTimeDiscretization, const HpipmInterface::Multipliers& previousMultipliers,
+                      const std::vector<AnnotatedTime>& timeDiscretization, HpipmInterface::Multipliers& multipliers);
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
@@ -49,6 +49,9 @@ class MultipleShootingMpc final : public MPC_BASE {
                       const Initializer& initializer)
       : MPC_BASE(std::move(mpcSettings)) {
     solverPtr_.reset(new MultipleShootingSolver(std::move(settings), optimalControlProblem, initializer));
+    if (this->settings().timeBudget_ > 0.0) {
+      solverPtr_->setTimeBudget(this->settings().timeBudget_);
+    }
   };
 
   ~MultipleShootingMpc() override = default;
@@ -56,6 +59,13 @@ class MultipleShootingMpc final : public MPC_BASE {
   MultipleShootingSolver* getSolverPtr() override { return solverPtr_.get(); }
   const MultipleShootingSolver* getSolverPtr() const override { return solverPtr_.get(); }
 
+  void prepareNextRun(scalar_t nextTime) override {
+    // Only prepare if the next run will not reset the solver.
+    if (solverPtr_->settings().realtimeIteration && !settings().coldStart_ && !isFirstMpcRun()) {
+      solverPtr_->prepare(nextTime, nextTime + getTimeHorizon());
+    }
+  }
+
  protected:
   void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {
     if (settings().coldStart_) {
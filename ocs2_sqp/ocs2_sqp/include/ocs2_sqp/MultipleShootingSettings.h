@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <vector>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 
@@ -43,9 +45,13 @@ struct Settings {
   scalar_t deltaTol = 1e-6;  // Termination condition : RMS update of x(t) and u(t) are both below this value
   scalar_t costTol = 1e-4;   // Termination condition : (cost{i+1} - (cost{i}) < costTol AND constraints{i+1} < g_min
 
+  // Real-time iteration: A prepared run only takes a single full step, see MultipleShootingSolver::prepare()
+  bool realtimeIteration = false;
+
   // Linesearch - step size rules
-  scalar_t alpha_decay = 0.5;  // multiply the step size by this factor every time a linesearch step is rejected.
-  scalar_t alpha_min = 1e-4;   // terminate linesearch if the attempted step size is below this threshold
+  scalar_t alpha_decay = 0.5;       // multiply the step size by this factor every time a linesearch step is rejected.
+  scalar_t alpha_min = 1e-4;        // terminate linesearch if the attempted step size is below this threshold
+  bool parallelLinesearch = false;  // evaluate the step size candidates concurrently on the worker threads (requires nThreads > 1)
 
   // Linesearch - step acceptance criteria with c = costs, g = the norm of constraint violation, and w = [x; u]
   scalar_t g_max = 1e6;          // (1): IF g{i+1} > g_max REQUIRE g{i+1} < (1-gamma_c) * g{i}
@@ -59,6 +65,8 @@ struct Settings {
 
   // QP subproblem solver settings
   hpipm_interface::Settings hpipmSettings = hpipm_interface::Settings();
+  bool warmStartMultipliers = false;  // Shift the QP multipliers of the previous problem onto the next one. Needs hpipm warm_start = 2
+  int parallelRiccatiPartitions = 0;  // Solve QPs without inequalities by a Riccati recursion split in this many partitions. 0 uses HPIPM
 
   // Discretization method
   scalar_t dt = 0.01;  // user-defined time discretization
@@ -69,6 +77,10 @@ struct Settings {
   scalar_t inequalityConstraintDelta = 1e-6;
   bool projectStateInputEqualityConstraints = true;  // Use a projection method to resolve the state-input constraint Cx+Du+e
 
+  // Inequality constraints in the QP subproblem
+  bool inequalityConstraintsInQp = false;  // Pass the linearized state and state-input inequality constraints to the QP solver
+  bool softInequalityConstraints = false;  // Soften the inequality constraints of the QP with the slack penalty of hpipmSettings
+
   // Printing
   bool printSolverStatus = false;      // Print HPIPM status after solving the QP subproblem
   bool printSolverStatistics = false;  // Print benchmarking of the multiple shooting method
@@ -77,6 +89,7 @@ struct Settings {
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
+  std::vector<int> cpuAffinity;  // CPU core to pin each worker thread to (see ThreadPool), empty leaves the affinity unchanged
 };
 
 /**
@@ -42,6 +42,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/MultipleShootingSettings.h"
 #include "ocs2_sqp/MultipleShootingSolverStatus.h"
+#include "ocs2_sqp/MultipleShootingTranscription.h"
+#include "ocs2_sqp/PartitionedRiccatiSolver.h"
 #include "ocs2_sqp/TimeDiscretization.h"
 
 namespace ocs2 {
@@ -63,6 +65,22 @@ class MultipleShootingSolver : public SolverBase {
 
   void reset() override;
 
+  /** Gets the settings of the multiple shooting solver. */
+  const Settings& settings() const { return settings_; }
+
+  /**
+   * Preparation phase of the real-time iteration (requires settings.realtimeIteration). Linearizes the problem around the previous
+   * solution, shifted to the given time horizon, before the initial state is known. The next call to run() with unchanged target
+   * trajectories and mode schedule, over a time horizon that differs by at most settings.dt without passing an event or a node, only
+   * condenses the initial state into the prepared QP, solves it, and takes the full step (feedback phase). A deviating horizon moves the
+   * first and the last node of the prepared QP, and only the intervals they bound are linearized again. Otherwise, the preparation is
+   * discarded and run() solves the problem as usual, on the time discretization of the actual horizon.
+   *
+   * @param [in] initTime: The expected initial time of the next run() call.
+   * @param [in] finalTime: The expected final time of the next run() call.
+   */
+  void prepare(scalar_t initTime, scalar_t finalTime);
+
   scalar_t getFinalTime() const override { return primalSolution_.timeTrajectory_.back(); };
 
   void getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const override { *primalSolutionPtr = primalSolution_; }
@@ -77,6 +95,9 @@ class MultipleShootingSolver : public SolverBase {
 
   size_t getNumIterations() const override { return totalNumIterations_; }
 
+  /** Number of runs that only solved the prepared QP, i.e., the feedback phase of the real-time iteration. */
+  size_t getNumFeedbackPhases() const { return numFeedbackPhases_; }
+
   const OptimalControlProblem& getOptimalControlProblem() const override { return ocpDefinitions_.front(); }
 
   const PerformanceIndex& getPerformanceIndeces() const override { return getIterationsLog().back(); };
@@ -118,27 +139,70 @@ class MultipleShootingSolver : public SolverBase {
     runImpl(initTime, initState, finalTime);
   }
 
+  /** Whether the prepared QP can be used for a run over the given time horizon with the current references */
+  bool isPreparedFor(scalar_t initTime, scalar_t finalTime) const;
+
+  /** Moves the first and the last node of the prepared QP to the given horizon and linearizes the intervals they bound again */
+  void shiftPreparedHorizon(scalar_t initTime, scalar_t finalTime);
+
+  /**
+   * Feedback phase of the real-time iteration: solves the prepared QP for the given initial state and takes the full step. The prepared
+   * horizon is shifted first if the given one differs.
+   */
+  void runFeedbackPhase(scalar_t initTime, const vector_t& initState, scalar_t finalTime);
+
   /** Run a task in parallel with settings.nThreads */
   void runParallel(std::function<void(int)> taskFunction);
 
   /** Get profiling information as a string */
   std::string getBenchmarkingInformation() const;
 
-  /** Creates QP around t, x(t), u(t). Returns performance metrics at the current {t, x(t), u(t)} */
+  /**
+   * Creates QP around t, x(t), u(t). Returns performance metrics at the current {t, x(t), u(t)}
+   *
+   * @param [out] nodePerformancesPtr : If given, the performance metrics of each node are stored as well.
+   */
   PerformanceIndex setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                            const vector_array_t& u);
+                                            const vector_array_t& u, std::vector<PerformanceIndex>* nodePerformancesPtr = nullptr);
+
+  /** Creates the QP data of node i, the terminal node if i == N. Returns performance metrics of node i */
+  PerformanceIndex setupNodeQuadraticApproximation(int workerId, const std::vector<AnnotatedTime>& time, const vector_array_t& x,
+                                                   const vector_array_t& u, int i);
 
   /** Computes only the performance metrics at the current {t, x(t), u(t)} */
   PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                       const vector_array_t& u);
 
+  /**
+   * Computes the performance metrics at the current {t, x(t), u(t)} on the calling thread only.
+   *
+   * @param [in] ocpDefinition : The optimal control problem definition owned by the calling worker.
+   * @param [in] terminate : Polled between the nodes. The evaluation is abandoned as soon as it returns true.
+   * @param [out] performance : The performance metrics. Incomplete if the evaluation was abandoned.
+   * @return false if the evaluation was abandoned.
+   */
+  bool computePerformanceOnWorker(OptimalControlProblem& ocpDefinition, const std::vector<AnnotatedTime>& time, const vector_t& initState,
+                                  const vector_array_t& x, const vector_array_t& u, const std::function<bool()>& terminate,
+                                  PerformanceIndex& performance);
+
+  /** Computes the performance metrics of node i, the terminal node if i == N */
+  PerformanceIndex computeNodePerformance(OptimalControlProblem& ocpDefinition, const std::vector<AnnotatedTime>& time,
+                                          const vector_array_t& x, const vector_array_t& u, int i);
+
   /** Returns solution of the QP subproblem in delta coordinates: */
   struct OcpSubproblemSolution {
     vector_array_t deltaXSol;      // delta_x(t)
     vector_array_t deltaUSol;      // delta_u(t)
     scalar_t armijoDescentMetric;  // inner product of the cost gradient and decision variable step
   };
-  OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0);
+  /** Solves the QP subproblem. The solution is written into subproblemSolution_, whose memory is reused across iterations. */
+  const OcpSubproblemSolution& getOCPSolution(const vector_t& delta_x0);
+
+  /** Shifts the stored multipliers of the last QP onto the given time discretization. The next QP is warm started with them. */
+  void shiftQpMultipliers(const std::vector<AnnotatedTime>& time);
+
+  /** Stores the multipliers of the last solved QP together with its time discretization */
+  void storeQpMultipliers(const std::vector<AnnotatedTime>& time);
 
   /** Extract the value function based on the last solved QP */
   void extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x);
@@ -151,6 +215,20 @@ class MultipleShootingSolver : public SolverBase {
                                        const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
                                        vector_array_t& u);
 
+  /**
+   * Same as takeStep, but evaluates the candidate step sizes concurrently, one candidate per worker. The largest accepted step size is
+   * taken and the evaluation of all smaller candidates is abandoned. The selected step is identical to the one of takeStep.
+   */
+  multiple_shooting::StepInfo takeStepParallel(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
+                                               const vector_t& initState, const OcpSubproblemSolution& subproblemSolution,
+                                               vector_array_t& x, vector_array_t& u);
+
+  /** Keeps a copy of {x(t), u(t)} if it satisfies the constraint tolerance and has a lower merit than the best feasible iterate so far */
+  void updateBestFeasibleIterate(const vector_array_t& x, const vector_array_t& u, const PerformanceIndex& performance);
+
+  /** Replaces {x(t), u(t)} by the best feasible iterate if the given iterate is either infeasible or has a higher merit */
+  bool restoreBestFeasibleIterate(vector_array_t& x, vector_array_t& u, PerformanceIndex& performance);
+
   /** Determine convergence after a step */
   multiple_shooting::Convergence checkConvergence(int iteration, const PerformanceIndex& baseline,
                                                   const multiple_shooting::StepInfo& stepInfo) const;
@@ -174,6 +252,17 @@ class MultipleShootingSolver : public SolverBase {
 
   // Solver interface
   HpipmInterface hpipmInterface_;
+  hpipm_interface::OcpSize ocpSize_;
+  OcpSubproblemSolution subproblemSolution_;
+  vector_array_t projectedDeltaUSol_;  // QP solution in the projected input space, before re-mapping
+  PartitionedRiccatiSolver partitionedRiccatiSolver_;
+  bool qpSolvedByPartitionedRiccati_ = false;  // Which of the two QP solvers holds the feedback and cost-to-go of the last QP
+
+  // Warm start of the QP multipliers across problems
+  HpipmInterface::Multipliers qpMultipliers_;
+  std::vector<AnnotatedTime> qpMultipliersTimeDiscretization_;
+  HpipmInterface::Multipliers shiftedQpMultipliers_;
+  bool hasShiftedQpMultipliers_ = false;
 
   // LQ approximation
   std::vector<VectorFunctionLinearApproximation> dynamics_;
@@ -182,12 +271,49 @@ class MultipleShootingSolver : public SolverBase {
   std::vector<VectorFunctionLinearApproximation> stateInputEqConstraints_;
   std::vector<VectorFunctionLinearApproximation> stateIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> stateInputIneqConstraints_;
+  std::vector<VectorFunctionLinearApproximation> ineqConstraints_;  // Stacked inequality constraints of the QP subproblem
+
+  // Transcription of the node under construction, one per worker. Swapped with the LQ approximation above, such that the memory of the
+  // previous iteration is reused.
+  std::vector<multiple_shooting::Transcription> workerTranscriptions_;
+  std::vector<multiple_shooting::EventTranscription> workerEventTranscriptions_;
+  multiple_shooting::TerminalTranscription terminalTranscription_;
+  std::vector<PerformanceIndex> workerPerformances_;
+
+  // Trial trajectories of the parallel linesearch, one set per worker, and the accepted trial. Reused across iterations.
+  std::vector<vector_array_t> xTrial_;
+  std::vector<vector_array_t> uTrial_;
+  vector_array_t xAccepted_;
+  vector_array_t uAccepted_;
+
+  // The best feasible iterate of the current run, which is returned when the time budget is exhausted
+  vector_array_t xBestFeasible_;
+  vector_array_t uBestFeasible_;
+  PerformanceIndex bestFeasiblePerformance_;
+  bool hasBestFeasibleIterate_ = false;
+
+  // Real-time iteration: the QP prepared around the shifted previous solution, waiting for the initial state
+  struct PreparedSubproblem {
+    bool isValid = false;
+    scalar_t initTime = 0.0;
+    scalar_t finalTime = 0.0;
+    std::vector<AnnotatedTime> timeDiscretization;
+    vector_array_t x;
+    vector_array_t u;
+    PerformanceIndex performance;                   // at the prepared {t, x(t), u(t)}, without the initial state violation
+    std::vector<PerformanceIndex> nodePerformances;  // contributions of the nodes to the performance
+    // References of the LQ approximation
+    TargetTrajectories targetTrajectories;
+    ModeSchedule modeSchedule;
+  };
+  PreparedSubproblem preparedSubproblem_;
 
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
 
   // Benchmarking
   size_t numProblems_{0};
+  size_t numFeedbackPhases_{0};
   size_t totalNumIterations_{0};
   benchmark::RepeatedTimer initializationTimer_;
   benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
@@ -52,7 +52,7 @@ struct StepInfo {
 };
 
 /** Different types of convergence */
-enum class Convergence { FALSE, ITERATIONS, STEPSIZE, METRICS, PRIMAL };
+enum class Convergence { FALSE, ITERATIONS, STEPSIZE, METRICS, PRIMAL, TIME };
 
 std::string toString(const Convergence& convergence);
 
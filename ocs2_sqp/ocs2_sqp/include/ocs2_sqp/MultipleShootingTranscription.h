@@ -37,7 +37,9 @@ namespace ocs2 {
 namespace multiple_shooting {
 
 /**
- * Results of the transcription at an intermediate node
+ * Results of the transcription at an intermediate node.
+ * constraintsProjection and constraintPseudoInverse are only written by projectTranscription. They are empty if the node has no
+ * state-input equality constraints.
  */
 struct Transcription {
   VectorFunctionLinearApproximation dynamics;
@@ -65,8 +67,16 @@ Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlP
                                     DynamicsSensitivityDiscretizer& sensitivityDiscretizer, scalar_t t, scalar_t dt, const vector_t& x,
                                     const vector_t& x_next, const vector_t& u);
 
+/**
+ * Same as above, but writes into an existing transcription. The memory of the transcription is reused where possible.
+ */
+void setupIntermediateNode(const OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer,
+                           scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                           Transcription& transcription);
+
 /**
  * Apply the state-input equality constraint projection for a single intermediate node transcription.
+ * The projection is written into the existing memory of the transcription, no reallocation happens if the sizes did not change.
  *
  * @param transcription : Transcription for a single intermediate node
  * @param extractEqualityConstraintsPseudoInverse
@@ -92,6 +102,12 @@ struct TerminalTranscription {
  */
 TerminalTranscription setupTerminalNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x);
 
+/**
+ * Same as above, but writes into an existing transcription. The memory of the transcription is reused where possible.
+ */
+void setupTerminalNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
+                       TerminalTranscription& transcription);
+
 /**
  * Results of the transcription at an event
  */
@@ -114,5 +130,11 @@ struct EventTranscription {
 EventTranscription setupEventNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
                                   const vector_t& x_next);
 
+/**
+ * Same as above, but writes into an existing transcription. The memory of the transcription is reused where possible.
+ */
+void setupEventNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next,
+                    EventTranscription& transcription);
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
@@ -0,0 +1,125 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+namespace ocs2 {
+
+/**
+ * Parallel-in-time solver for the LQ subproblem of the multiple shooting method, without constraints other than the dynamics:
+ *
+ *   min_{dx, du} sum_k cost_k(dx_k, du_k) + cost_N(dx_N)
+ *   s.t. dx_{k+1} = A_k dx_k + B_k du_k + b_k, dx_0 given
+ *
+ * The horizon is split into partitions that are solved with an exact partitioned Riccati recursion:
+ * 1. Each partition runs a Riccati recursion with a zero terminal cost and a parametric terminal term lambda' * dx_end. This gives the
+ *    value function of the partition as a quadratic function of its initial state and lambda. (parallel)
+ * 2. The partitions are coupled by requiring lambda to be the gradient of the value function of the next partition. This reduced
+ *    system has the size of the state at each partition boundary. (serial)
+ * 3. Each partition runs a Riccati recursion with the exact value function at its end and rolls out the solution. (parallel)
+ *
+ * The solution, feedback matrices and cost-to-go's are identical to the ones of a single Riccati recursion.
+ */
+class PartitionedRiccatiSolver {
+ public:
+  /**
+   * Solves the LQ problem.
+   *
+   * @param x0 : Initial state deviation
+   * @param dynamics : Dynamics array of size N
+   * @param cost : Cost array of size N + 1
+   * @param numPartitions : Number of partitions, limited to N
+   * @param threadPool : Thread pool to solve the partitions on
+   * @param nThreads : Number of threads to use, including the calling thread
+   * @param [out] stateTrajectory : Solution state trajectory of size N + 1
+   * @param [out] inputTrajectory : Solution input trajectory of size N
+   *
+   * Throws a std::runtime_error if the input Hessian R + B' P B of a node is not positive definite, i.e. the LQ problem has no unique
+   * solution. The outputs are invalid in that case.
+   */
+  void solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+             const std::vector<ScalarFunctionQuadraticApproximation>& cost, int numPartitions, ThreadPool& threadPool, int nThreads,
+             vector_array_t& stateTrajectory, vector_array_t& inputTrajectory);
+
+  /** Feedback matrices K of the optimal solution du = K dx + k for the previously solved problem, of size N */
+  const matrix_array_t& getRiccatiFeedback() const { return feedback_; }
+
+  /** Feedforward inputs k of the optimal solution du = K dx + k for the previously solved problem, of size N */
+  const vector_array_t& getRiccatiFeedforward() const { return feedforward_; }
+
+  /** Quadratic cost-to-go's (dfdxx, dfdx) of the previously solved problem, of size N + 1. The constant term is not computed. */
+  const std::vector<ScalarFunctionQuadraticApproximation>& getRiccatiCostToGo() const { return costToGo_; }
+
+ private:
+  /** Value function of a partition as a function of its initial state x and terminal multiplier lambda, and the reduced system terms */
+  struct Partition {
+    int start;  // first node of the partition
+    int end;    // last node of the partition, the first node of the next partition
+
+    // V(x, lambda) = 0.5 x' S x + x' (M lambda + s) + 0.5 lambda' N lambda + n' lambda + const, where dx_end = M' x + N lambda + n
+    matrix_t S;
+    vector_t s;
+    matrix_t M;
+    matrix_t N;
+    vector_t n;
+
+    // Gradient of the exact value function at the start of the partition: W x + w
+    matrix_t W;
+    vector_t w;
+    // Optimal terminal multiplier of the partition: lambda = L x + l
+    matrix_t L;
+    vector_t l;
+    // Initial state of the partition
+    vector_t x0;
+  };
+
+  void parametricRiccatiRecursion(Partition& partition, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                  const std::vector<ScalarFunctionQuadraticApproximation>& cost);
+
+  void solveReducedSystem(const vector_t& x0);
+
+  void riccatiRecursion(int partitionIndex, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                        const std::vector<ScalarFunctionQuadraticApproximation>& cost);
+
+  void rollout(const Partition& partition, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+               vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) const;
+
+  /** Runs task(partitionIndex) for all partitions on the thread pool */
+  void runPartitions(const std::function<void(int)>& task, ThreadPool& threadPool, int nThreads);
+
+  std::vector<Partition> partitions_;
+  matrix_array_t feedback_;
+  vector_array_t feedforward_;
+  std::vector<ScalarFunctionQuadraticApproximation> costToGo_;
+};
+
+}  // namespace ocs2
@@ -32,6 +32,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 
 std::pair<VectorFunctionLinearApproximation, matrix_t> qrConstraintProjection(const VectorFunctionLinearApproximation& constraint) {
+  VectorFunctionLinearApproximation projectionTerms;
+  matrix_t pseudoInverse;
+  qrConstraintProjection(constraint, projectionTerms, pseudoInverse);
+  return std::make_pair(std::move(projectionTerms), std::move(pseudoInverse));
+}
+
+void qrConstraintProjection(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projection,
+                            matrix_t& pseudoInverse) {
   // Constraint Projectors are based on the QR decomposition
   const auto numConstraints = constraint.dfdu.rows();
   const auto numInputs = constraint.dfdu.cols();
@@ -40,33 +48,36 @@ std::pair<VectorFunctionLinearApproximation, matrix_t> qrConstraintProjection(co
   const matrix_t Q = QRof_DT.householderQ();
   const auto Q1 = Q.leftCols(numConstraints);
 
+  // left pseudo-inverse of D^T
   const auto R = QRof_DT.matrixQR().topRows(numConstraints).triangularView<Eigen::Upper>();
-  const matrix_t pseudoInverse = R.solve(Q1.transpose());  // left pseudo-inverse of D^T
+  pseudoInverse = Q1.transpose();
+  R.solveInPlace(pseudoInverse);
 
-  VectorFunctionLinearApproximation projectionTerms;
-  projectionTerms.dfdu = Q.rightCols(numInputs - numConstraints);
-  projectionTerms.dfdx.noalias() = -pseudoInverse.transpose() * constraint.dfdx;
-  projectionTerms.f.noalias() = -pseudoInverse.transpose() * constraint.f;
-
-  return std::make_pair(std::move(projectionTerms), std::move(pseudoInverse));
+  projection.dfdu = Q.rightCols(numInputs - numConstraints);
+  projection.dfdx.noalias() = -pseudoInverse.transpose() * constraint.dfdx;
+  projection.f.noalias() = -pseudoInverse.transpose() * constraint.f;
 }
 
 std::pair<VectorFunctionLinearApproximation, matrix_t> luConstraintProjection(const VectorFunctionLinearApproximation& constraint,
                                                                               bool extractPseudoInverse) {
+  VectorFunctionLinearApproximation projectionTerms;
+  matrix_t pseudoInverse;
+  luConstraintProjection(constraint, projectionTerms, extractPseudoInverse ? &pseudoInverse : nullptr);
+  return std::make_pair(std::move(projectionTerms), std::move(pseudoInverse));
+}
+
+void luConstraintProjection(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projection,
+                            matrix_t* pseudoInverse) {
   // Constraint Projectors are based on the LU decomposition
   const Eigen::FullPivLU<matrix_t> lu(constraint.dfdu);
 
-  VectorFunctionLinearApproximation projectionTerms;
-  projectionTerms.dfdu = lu.kernel();
-  projectionTerms.dfdx.noalias() = -lu.solve(constraint.dfdx);
-  projectionTerms.f.noalias() = -lu.solve(constraint.f);
+  projection.dfdu = lu.kernel();
+  projection.dfdx.noalias() = -lu.solve(constraint.dfdx);
+  projection.f.noalias() = -lu.solve(constraint.f);
 
-  matrix_t pseudoInverse;
-  if (extractPseudoInverse) {
-    pseudoInverse = lu.solve(matrix_t::Identity(constraint.f.size(), constraint.f.size())).transpose();  // left pseudo-inverse of D^T
+  if (pseudoInverse != nullptr) {
+    *pseudoInverse = lu.solve(matrix_t::Identity(constraint.f.size(), constraint.f.size())).transpose();  // left pseudo-inverse of D^T
   }
-
-  return std::make_pair(std::move(projectionTerms), std::move(pseudoInverse));
 }
 
 ProjectionMultiplierCoefficients extractProjectionMultiplierCoefficients(const VectorFunctionLinearApproximation& dynamics,
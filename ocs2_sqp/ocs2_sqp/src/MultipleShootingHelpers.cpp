@@ -62,6 +62,20 @@ void remapProjectedInput(const std::vector<VectorFunctionLinearApproximation>& c
   }
 }
 
+void remapProjectedInput(const std::vector<VectorFunctionLinearApproximation>& constraintsProjection, const vector_array_t& deltaXSol,
+                         const vector_array_t& deltaUTildeSol, vector_array_t& deltaUSol) {
+  deltaUSol.resize(deltaUTildeSol.size());
+  for (int i = 0; i < deltaUTildeSol.size(); ++i) {
+    if (constraintsProjection[i].f.size() > 0) {
+      deltaUSol[i] = constraintsProjection[i].f;
+      deltaUSol[i].noalias() += constraintsProjection[i].dfdu * deltaUTildeSol[i];
+      deltaUSol[i].noalias() += constraintsProjection[i].dfdx * deltaXSol[i];
+    } else {
+      deltaUSol[i] = deltaUTildeSol[i];
+    }
+  }
+}
+
 void remapProjectedGain(const std::vector<VectorFunctionLinearApproximation>& constraintsProjection, matrix_array_t& KMatrices) {
   matrix_t tmp;  // 1 temporary for re-use.
   for (int i = 0; i < KMatrices.size(); ++i) {
@@ -72,6 +86,26 @@ void remapProjectedGain(const std::vector<VectorFunctionLinearApproximation>& co
   }
 }
 
+void stackInequalityConstraints(const VectorFunctionLinearApproximation& stateIneqConstraints,
+                                const VectorFunctionLinearApproximation& stateInputIneqConstraints, int nx, int nu,
+                                VectorFunctionLinearApproximation& ineqConstraints) {
+  const int numStateIneq = stateIneqConstraints.f.size();
+  const int numStateInputIneq = stateInputIneqConstraints.f.size();
+  ineqConstraints.resize(numStateIneq + numStateInputIneq, nx, nu);
+
+  if (numStateIneq > 0) {
+    ineqConstraints.f.head(numStateIneq) = stateIneqConstraints.f;
+    ineqConstraints.dfdx.topRows(numStateIneq) = stateIneqConstraints.dfdx;
+    ineqConstraints.dfdu.topRows(numStateIneq).setZero();
+  }
+
+  if (numStateInputIneq > 0) {
+    ineqConstraints.f.tail(numStateInputIneq) = stateInputIneqConstraints.f;
+    ineqConstraints.dfdx.bottomRows(numStateInputIneq) = stateInputIneqConstraints.dfdx;
+    ineqConstraints.dfdu.bottomRows(numStateInputIneq) = stateInputIneqConstraints.dfdu;
+  }
+}
+
 PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, ModeSchedule&& modeSchedule, vector_array_t&& x,
                                 vector_array_t&& u) {
   // Correct for missing inputs at PreEvents and the terminal time
@@ -35,6 +35,13 @@ namespace multiple_shooting {
 void initializeStateInputTrajectories(const vector_t& initState, const std::vector<AnnotatedTime>& timeDiscretization,
                                       const PrimalSolution& primalSolution, Initializer& initializer, vector_array_t& stateTrajectory,
                                       vector_array_t& inputTrajectory) {
+  initializeStateInputTrajectories(initState, timeDiscretization, primalSolution.modeSchedule_, primalSolution, initializer,
+                                   stateTrajectory, inputTrajectory);
+}
+
+void initializeStateInputTrajectories(const vector_t& initState, const std::vector<AnnotatedTime>& timeDiscretization,
+                                      const ModeSchedule& modeSchedule, const PrimalSolution& primalSolution, Initializer& initializer,
+                                      vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
   const int N = static_cast<int>(timeDiscretization.size()) - 1;  // // size of the input trajectory
   stateTrajectory.clear();
   stateTrajectory.reserve(N + 1);
@@ -67,7 +74,8 @@ void initializeStateInputTrajectories(const vector_t& initState, const std::vect
       const scalar_t time = getIntervalStart(timeDiscretization[i]);
       const scalar_t nextTime = getIntervalEnd(timeDiscretization[i + 1]);
       vector_t input, nextState;
-      if (time > interpolateInputTill || nextTime > interpolateStateTill) {  // Using initializer
+      const bool isSameMode = modeSchedule.modeAtTime(time) == primalSolution.modeSchedule_.modeAtTime(time);
+      if (time > interpolateInputTill || nextTime > interpolateStateTill || !isSameMode) {  // Using initializer
         std::tie(input, nextState) = initializeIntermediateNode(initializer, time, nextTime, stateTrajectory.back());
       } else {  // interpolate previous solution
         std::tie(input, nextState) = initializeIntermediateNode(primalSolution, time, nextTime);
@@ -78,5 +86,45 @@ void initializeStateInputTrajectories(const vector_t& initState, const std::vect
   }
 }
 
+void shiftMultipliers(const std::vector<AnnotatedTime>& previousTimeDiscretization, const HpipmInterface::Multipliers& previousMultipliers,
+                      const std::vector<AnnotatedTime>& timeDiscretization, HpipmInterface::Multipliers& multipliers) {
+  const int N = static_cast<int>(timeDiscretization.size()) - 1;
+  const int previousN = static_cast<int>(previousTimeDiscretization.size()) - 1;
+  multipliers.dynamics.resize(N);
+  multipliers.constraints.resize(N + 1);
+  multipliers.slacks.resize(N + 1);
+
+  const bool hasPrevious = previousN > 0 && previousMultipliers.dynamics.size() == previousN &&
+                           previousMultipliers.constraints.size() == previousN + 1 && previousMultipliers.slacks.size() == previousN + 1;
+  const auto isEvent = [](const AnnotatedTime& annotatedTime) { return annotatedTime.event == AnnotatedTime::Event::PreEvent; };
+
+  int j = 0;  // previous node of which the interval contains the current node
+  for (int i = 0; i < N; i++) {
+    const scalar_t t = getInterpolationTime(timeDiscretization[i]);
+    while (j + 1 < previousN && getInterpolationTime(previousTimeDiscretization[j + 1]) <= t) {
+      ++j;
+    }
+    const bool isInsidePrevious = hasPrevious && getInterpolationTime(previousTimeDiscretization.front()) <= t;
+    if (isInsidePrevious && isEvent(timeDiscretization[i]) == isEvent(previousTimeDiscretization[j])) {
+      multipliers.dynamics[i] = previousMultipliers.dynamics[j];
+      multipliers.constraints[i] = previousMultipliers.constraints[j];
+      multipliers.slacks[i] = previousMultipliers.slacks[j];
+    } else {
+      multipliers.dynamics[i].resize(0);
+      multipliers.constraints[i].resize(0);
+      multipliers.slacks[i].resize(0);
+    }
+  }
+
+  // Terminal node
+  if (hasPrevious) {
+    multipliers.constraints[N] = previousMultipliers.constraints[previousN];
+    multipliers.slacks[N] = previousMultipliers.slacks[previousN];
+  } else {
+    multipliers.constraints[N].resize(0);
+    multipliers.slacks[N].resize(0);
+  }
+}
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
@@ -29,7 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/MultipleShootingSolver.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <mutex>
 #include <numeric>
 
 #include <ocs2_core/penalties/penalties/RelaxedBarrierPenalty.h>
@@ -46,7 +49,7 @@ MultipleShootingSolver::MultipleShootingSolver(Settings settings, const OptimalC
     : SolverBase(),
       settings_(std::move(settings)),
       hpipmInterface_(hpipm_interface::OcpSize(), settings.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority) {
+      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority, settings_.cpuAffinity) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
@@ -62,6 +65,11 @@ MultipleShootingSolver::MultipleShootingSolver(Settings settings, const OptimalC
   for (int w = 0; w < settings.nThreads; w++) {
     ocpDefinitions_.push_back(optimalControlProblem);
   }
+  workerTranscriptions_.resize(settings_.nThreads);
+  workerEventTranscriptions_.resize(settings_.nThreads);
+  workerPerformances_.resize(settings_.nThreads);
+  xTrial_.resize(settings_.nThreads);
+  uTrial_.resize(settings_.nThreads);
 
   // Operating points
   initializerPtr_.reset(initializer.clone());
@@ -71,6 +79,7 @@ MultipleShootingSolver::MultipleShootingSolver(Settings settings, const OptimalC
   filterLinesearch_.g_min = settings_.g_min;
   filterLinesearch_.gamma_c = settings_.gamma_c;
   filterLinesearch_.armijoFactor = settings_.armijoFactor;
+  filterLinesearch_.includeInequalityConstraints = settings_.inequalityConstraintsInQp && !settings_.softInequalityConstraints;
 }
 
 MultipleShootingSolver::~MultipleShootingSolver() {
@@ -82,11 +91,15 @@ MultipleShootingSolver::~MultipleShootingSolver() {
 void MultipleShootingSolver::reset() {
   // Clear solution
   primalSolution_ = PrimalSolution();
+  preparedSubproblem_ = PreparedSubproblem();
+  qpMultipliersTimeDiscretization_.clear();
+  hasShiftedQpMultipliers_ = false;
   valueFunction_.clear();
   performanceIndeces_.clear();
 
   // reset timers
   numProblems_ = 0;
+  numFeedbackPhases_ = 0;
   totalNumIterations_ = 0;
   linearQuadraticApproximationTimer_.reset();
   solveQpTimer_.reset();
@@ -149,7 +162,154 @@ ScalarFunctionQuadraticApproximation MultipleShootingSolver::getValueFunction(sc
   }
 }
 
+void MultipleShootingSolver::prepare(scalar_t initTime, scalar_t finalTime) {
+  if (!settings_.realtimeIteration) {
+    throw std::runtime_error("[MultipleShootingSolver::prepare] The real-time iteration is not enabled in the settings!");
+  }
+  if (primalSolution_.timeTrajectory_.empty()) {
+    throw std::runtime_error("[MultipleShootingSolver::prepare] A previous solution is required, call run() first!");
+  }
+
+  linearQuadraticApproximationTimer_.startTimer();
+  auto& prepared = preparedSubproblem_;
+  prepared.isValid = false;
+  prepared.initTime = initTime;
+  prepared.finalTime = finalTime;
+
+  // Determine time discretization, taking into account event times.
+  const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
+  prepared.timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+
+  // Initialize references
+  for (auto& ocpDefinition : ocpDefinitions_) {
+    const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
+    ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
+  }
+  prepared.targetTrajectories = this->getReferenceManager().getTargetTrajectories();
+  prepared.modeSchedule = this->getReferenceManager().getModeSchedule();
+
+  // Shift the previous solution. The initial state is predicted by the previous solution as well.
+  const vector_t predictedInitState =
+      LinearInterpolation::interpolate(initTime, primalSolution_.timeTrajectory_, primalSolution_.stateTrajectory_);
+  const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
+  multiple_shooting::initializeStateInputTrajectories(predictedInitState, prepared.timeDiscretization, modeSchedule, primalSolution_,
+                                                      *initializerPtr_, prepared.x, prepared.u);
+  shiftQpMultipliers(prepared.timeDiscretization);
+
+  // Make QP approximation, the deviation from the actual initial state is added in the feedback phase.
+  prepared.performance =
+      setupQuadraticSubproblem(prepared.timeDiscretization, prepared.x.front(), prepared.x, prepared.u, &prepared.nodePerformances);
+  prepared.isValid = true;
+  linearQuadraticApproximationTimer_.endTimer();
+}
+
+bool MultipleShootingSolver::isPreparedFor(scalar_t initTime, scalar_t finalTime) const {
+  const auto& prepared = preparedSubproblem_;
+  if (!prepared.isValid) {
+    return false;
+  }
+
+  // The references might have been updated since the preparation
+  const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
+  const bool isSameModeSchedule =
+      modeSchedule.eventTimes == prepared.modeSchedule.eventTimes && modeSchedule.modeSequence == prepared.modeSchedule.modeSequence;
+  if (!isSameModeSchedule || !(this->getReferenceManager().getTargetTrajectories() == prepared.targetTrajectories)) {
+    return false;
+  }
+
+  if (initTime == prepared.initTime && finalTime == prepared.finalTime) {
+    return true;
+  }
+
+  // A deviating horizon moves the first and the last node. They may move by at most one time step, without passing a neighboring node
+  // or an event, such that the prepared time discretization still matches the one of the actual horizon.
+  const auto& time = prepared.timeDiscretization;
+  const int N = static_cast<int>(time.size()) - 1;
+  const scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>();
+  if (N < 2 || std::abs(initTime - prepared.initTime) > settings_.dt || std::abs(finalTime - prepared.finalTime) > settings_.dt ||
+      initTime >= time[1].time - dt_min || finalTime <= time[N - 1].time + dt_min) {
+    return false;
+  }
+  auto hasEventBetween = [&](scalar_t t0, scalar_t t1) {
+    const scalar_t lower = std::min(t0, t1);
+    const scalar_t upper = std::max(t0, t1);
+    return std::any_of(modeSchedule.eventTimes.cbegin(), modeSchedule.eventTimes.cend(),
+                       [&](scalar_t eventTime) { return lower <= eventTime && eventTime <= upper; });
+  };
+  return !(initTime != prepared.initTime && hasEventBetween(initTime, prepared.initTime)) &&
+         !(finalTime != prepared.finalTime && hasEventBetween(finalTime, prepared.finalTime));
+}
+
+void MultipleShootingSolver::shiftPreparedHorizon(scalar_t initTime, scalar_t finalTime) {
+  auto& prepared = preparedSubproblem_;
+  auto& time = prepared.timeDiscretization;
+  const int N = static_cast<int>(time.size()) - 1;
+
+  // The initial state is predicted by the previous solution at the actual initial time
+  prepared.initTime = initTime;
+  prepared.finalTime = finalTime;
+  time.front().time = initTime;
+  time.back().time = finalTime;
+  prepared.x.front() = LinearInterpolation::interpolate(initTime, primalSolution_.timeTrajectory_, primalSolution_.stateTrajectory_);
+
+  // Only the first and the last interval, and the terminal node depend on the moved nodes
+  constexpr int workerId = 0;
+  for (const int i : {0, N - 1, N}) {
+    prepared.nodePerformances[i] = setupNodeQuadraticApproximation(workerId, time, prepared.x, prepared.u, i);
+  }
+  prepared.performance =
+      std::accumulate(std::next(prepared.nodePerformances.begin()), prepared.nodePerformances.end(), prepared.nodePerformances.front());
+  auto& performance = prepared.performance;
+  performance.merit = performance.cost + performance.equalityLagrangian + performance.inequalityLagrangian;
+}
+
+void MultipleShootingSolver::runFeedbackPhase(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  auto& prepared = preparedSubproblem_;
+
+  if (settings_.printSolverStatus || settings_.printLinesearch) {
+    std::cerr << "\n+++++++++++++ SQP real-time iteration, feedback phase ++++++++++++++\n";
+  }
+
+  if (initTime != prepared.initTime || finalTime != prepared.finalTime) {
+    linearQuadraticApproximationTimer_.startTimer();
+    shiftPreparedHorizon(initTime, finalTime);
+    linearQuadraticApproximationTimer_.endTimer();
+  }
+  prepared.isValid = false;  // the LQ approximation is consumed by this step
+
+  // Solve QP
+  solveQpTimer_.startTimer();
+  const vector_t delta_x0 = initState - prepared.x[0];
+  const auto& deltaSolution = getOCPSolution(delta_x0);
+  extractValueFunction(prepared.timeDiscretization, prepared.x);
+  storeQpMultipliers(prepared.timeDiscretization);
+  solveQpTimer_.endTimer();
+
+  // Take the full step
+  multiple_shooting::incrementTrajectory(prepared.x, deltaSolution.deltaXSol, 1.0, prepared.x);
+  multiple_shooting::incrementTrajectory(prepared.u, deltaSolution.deltaUSol, 1.0, prepared.u);
+
+  // Performance at the linearization point, which is all that is known without evaluating the new iterate.
+  performanceIndeces_.clear();
+  performanceIndeces_.push_back(prepared.performance);
+  performanceIndeces_.back().dynamicsViolationSSE += delta_x0.squaredNorm();
+
+  computeControllerTimer_.startTimer();
+  primalSolution_ = toPrimalSolution(prepared.timeDiscretization, std::move(prepared.x), std::move(prepared.u));
+  computeControllerTimer_.endTimer();
+
+  ++numProblems_;
+  ++numFeedbackPhases_;
+  ++totalNumIterations_;
+}
+
 void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  if (settings_.realtimeIteration && isPreparedFor(initTime, finalTime)) {
+    runFeedbackPhase(initTime, initState, finalTime);
+    return;
+  }
+  preparedSubproblem_.isValid = false;  // the LQ approximation is overwritten
+
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ SQP solver is initialized ++++++++++++++";
@@ -168,7 +328,11 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
 
   // Initialize the state and input
   vector_array_t x, u;
-  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
+  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, modeSchedule, primalSolution_, *initializerPtr_, x, u);
+
+  // Initialize the multipliers of the first QP
+  shiftQpMultipliers(timeDiscretization);
 
   // Bookkeeping
   performanceIndeces_.clear();
@@ -187,7 +351,7 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
     // Solve QP
     solveQpTimer_.startTimer();
     const vector_t delta_x0 = initState - x[0];
-    const auto deltaSolution = getOCPSolution(delta_x0);
+    const auto& deltaSolution = getOCPSolution(delta_x0);
     extractValueFunction(timeDiscretization, x);
     solveQpTimer_.endTimer();
 
@@ -196,6 +360,9 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
     const auto stepInfo = takeStep(baselinePerformance, timeDiscretization, initState, deltaSolution, x, u);
     performanceIndeces_.push_back(stepInfo.performanceAfterStep);
     linesearchTimer_.endTimer();
+    if (getTimeBudget() > 0.0) {
+      updateBestFeasibleIterate(x, u, stepInfo.performanceAfterStep);
+    }
 
     // Check convergence
     convergence = checkConvergence(iter, baselinePerformance, stepInfo);
@@ -205,6 +372,14 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
     ++totalNumIterations_;
   }
 
+  // An exhausted time budget might have stopped at an iterate which is infeasible or worse than an earlier one
+  if (convergence == multiple_shooting::Convergence::TIME) {
+    restoreBestFeasibleIterate(x, u, performanceIndeces_.back());
+  }
+  hasBestFeasibleIterate_ = false;
+
+  storeQpMultipliers(timeDiscretization);
+
   computeControllerTimer_.startTimer();
   primalSolution_ = toPrimalSolution(timeDiscretization, std::move(x), std::move(u));
   computeControllerTimer_.endTimer();
@@ -223,40 +398,84 @@ void MultipleShootingSolver::runParallel(std::function<void(int)> taskFunction)
   threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
 }
 
-MultipleShootingSolver::OcpSubproblemSolution MultipleShootingSolver::getOCPSolution(const vector_t& delta_x0) {
-  // Solve the QP
-  OcpSubproblemSolution solution;
-  auto& deltaXSol = solution.deltaXSol;
-  auto& deltaUSol = solution.deltaUSol;
-  hpipm_status status;
+const MultipleShootingSolver::OcpSubproblemSolution& MultipleShootingSolver::getOCPSolution(const vector_t& delta_x0) {
+  // Solve the QP. The sizes, the HPIPM workspace and the solution trajectories are reused if the problem structure did not change.
+  auto& deltaXSol = subproblemSolution_.deltaXSol;
+  auto& deltaUSol = settings_.projectStateInputEqualityConstraints ? projectedDeltaUSol_ : subproblemSolution_.deltaUSol;
   const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
-  if (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) {
-    hpipmInterface_.resize(hpipm_interface::extractSizesFromProblem(dynamics_, cost_, &stateInputEqConstraints_));
-    status =
-        hpipmInterface_.solve(delta_x0, dynamics_, cost_, &stateInputEqConstraints_, deltaXSol, deltaUSol, settings_.printSolverStatus);
-  } else {  // without constraints, or when using projection, we have an unconstrained QP.
-    hpipmInterface_.resize(hpipm_interface::extractSizesFromProblem(dynamics_, cost_, nullptr));
-    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
-  }
+  // without constraints, or when using projection, we have an unconstrained QP.
+  const bool constraintsInQp = hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints;
+  auto* constraintsPtr = constraintsInQp ? &stateInputEqConstraints_ : nullptr;
+  // inequality constraints are either handled by the QP solver or not at all.
+  auto* ineqConstraintsPtr = settings_.inequalityConstraintsInQp ? &ineqConstraints_ : nullptr;
+  // QPs with only the dynamics as constraints can be solved by the partitioned Riccati recursion on the worker threads.
+  qpSolvedByPartitionedRiccati_ = settings_.parallelRiccatiPartitions > 0 && constraintsPtr == nullptr && ineqConstraintsPtr == nullptr;
+  if (qpSolvedByPartitionedRiccati_) {
+    partitionedRiccatiSolver_.solve(delta_x0, dynamics_, cost_, settings_.parallelRiccatiPartitions, threadPool_, settings_.nThreads,
+                                    deltaXSol, deltaUSol);
+    hasShiftedQpMultipliers_ = false;
+  } else {
+    auto solveQp = [&](bool softInequalityConstraints) {
+      hpipm_interface::extractSizesFromProblem(dynamics_, cost_, constraintsPtr, ineqConstraintsPtr, softInequalityConstraints, ocpSize_);
+      hpipmInterface_.resize(ocpSize_);
+      if (hasShiftedQpMultipliers_) {
+        hpipmInterface_.warmStart(shiftedQpMultipliers_);
+        hasShiftedQpMultipliers_ = false;
+      }
+      return (ineqConstraintsPtr != nullptr)
+                 ? hpipmInterface_.solve(delta_x0, dynamics_, cost_, constraintsPtr, *ineqConstraintsPtr, deltaXSol, deltaUSol,
+                                         settings_.printSolverStatus)
+                 : hpipmInterface_.solve(delta_x0, dynamics_, cost_, constraintsPtr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+    };
+
+    auto status = solveQp(settings_.softInequalityConstraints);
+    if (status != hpipm_status::SUCCESS && ineqConstraintsPtr != nullptr && !settings_.softInequalityConstraints) {
+      // The linearized hard inequality constraints can render the QP infeasible, the QP is solved again with softened constraints.
+      if (settings_.printSolverStatus) {
+        std::cerr << "[MultipleShootingSolver] The QP with hard inequality constraints failed, retrying with softened constraints.\n";
+      }
+      status = solveQp(true);
+    }
 
-  if (status != hpipm_status::SUCCESS) {
-    throw std::runtime_error("[MultipleShootingSolver] Failed to solve QP");
+    if (status != hpipm_status::SUCCESS) {
+      throw std::runtime_error("[MultipleShootingSolver] Failed to solve QP");
+    }
   }
 
   // to determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
-  solution.armijoDescentMetric = multiple_shooting::armijoDescentMetric(cost_, deltaXSol, deltaUSol);
+  subproblemSolution_.armijoDescentMetric = multiple_shooting::armijoDescentMetric(cost_, deltaXSol, deltaUSol);
 
   // remap the tilde delta u to real delta u
   if (settings_.projectStateInputEqualityConstraints) {
-    multiple_shooting::remapProjectedInput(constraintsProjection_, deltaXSol, deltaUSol);
+    multiple_shooting::remapProjectedInput(constraintsProjection_, deltaXSol, projectedDeltaUSol_, subproblemSolution_.deltaUSol);
   }
 
-  return solution;
+  return subproblemSolution_;
+}
+
+void MultipleShootingSolver::shiftQpMultipliers(const std::vector<AnnotatedTime>& time) {
+  hasShiftedQpMultipliers_ = settings_.warmStartMultipliers && !qpMultipliersTimeDiscretization_.empty();
+  if (hasShiftedQpMultipliers_) {
+    multiple_shooting::shiftMultipliers(qpMultipliersTimeDiscretization_, qpMultipliers_, time, shiftedQpMultipliers_);
+  }
+}
+
+void MultipleShootingSolver::storeQpMultipliers(const std::vector<AnnotatedTime>& time) {
+  if (settings_.warmStartMultipliers) {
+    if (qpSolvedByPartitionedRiccati_) {
+      // The Riccati recursion has no inequality multipliers to shift
+      qpMultipliersTimeDiscretization_.clear();
+    } else {
+      hpipmInterface_.getMultipliers(qpMultipliers_);
+      qpMultipliersTimeDiscretization_ = time;
+    }
+  }
 }
 
 void MultipleShootingSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x) {
   if (settings_.createValueFunction) {
-    valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
+    valueFunction_ = qpSolvedByPartitionedRiccati_ ? partitionedRiccatiSolver_.getRiccatiCostToGo()
+                                                   : hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
     // Correct for linearization state
     for (int i = 0; i < time.size(); ++i) {
       valueFunction_[i].dfdx.noalias() -= valueFunction_[i].dfdxx * x[i];
@@ -267,7 +486,8 @@ void MultipleShootingSolver::extractValueFunction(const std::vector<AnnotatedTim
 PrimalSolution MultipleShootingSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
   if (settings_.useFeedbackPolicy) {
     ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
-    matrix_array_t KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
+    matrix_array_t KMatrices = qpSolvedByPartitionedRiccati_ ? partitionedRiccatiSolver_.getRiccatiFeedback()
+                                                             : hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
     if (settings_.projectStateInputEqualityConstraints) {
       multiple_shooting::remapProjectedGain(constraintsProjection_, KMatrices);
     }
@@ -280,79 +500,118 @@ PrimalSolution MultipleShootingSolver::toPrimalSolution(const std::vector<Annota
 }
 
 PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState,
-                                                                  const vector_array_t& x, const vector_array_t& u) {
+                                                                  const vector_array_t& x, const vector_array_t& u,
+                                                                  std::vector<PerformanceIndex>* nodePerformancesPtr) {
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
+  std::fill(workerPerformances_.begin(), workerPerformances_.end(), PerformanceIndex());
   dynamics_.resize(N);
   cost_.resize(N + 1);
   constraintsProjection_.resize(N);
   stateInputEqConstraints_.resize(N + 1);
   stateIneqConstraints_.resize(N + 1);
   stateInputIneqConstraints_.resize(N);
+  if (settings_.inequalityConstraintsInQp) {
+    ineqConstraints_.resize(N + 1);
+  }
+  if (nodePerformancesPtr != nullptr) {
+    nodePerformancesPtr->resize(N + 1);
+  }
 
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
-    // Get worker specific resources
-    OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
     PerformanceIndex workerPerformance;  // Accumulate performance in local variable
 
     int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        workerPerformance += sqp::computeEventPerformance(result);
-        dynamics_[i] = std::move(result.dynamics);
-        cost_[i] = std::move(result.cost);
-        constraintsProjection_[i] = VectorFunctionLinearApproximation::Zero(0, x[i].size(), 0);
-        stateInputEqConstraints_[i] = std::move(result.eqConstraints);
-        stateIneqConstraints_[i] = std::move(result.ineqConstraints);
-        stateInputIneqConstraints_[i] = VectorFunctionLinearApproximation::Zero(0, x[i].size(), 0);
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        workerPerformance += sqp::computeIntermediatePerformance(result, dt);
-        if (settings_.projectStateInputEqualityConstraints) {
-          multiple_shooting::projectTranscription(result);
-        }
-        dynamics_[i] = std::move(result.dynamics);
-        cost_[i] = std::move(result.cost);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
-        stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
-        stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
+    while (i <= N) {  // The terminal node is executed by only one worker
+      const auto nodePerformance = setupNodeQuadraticApproximation(workerId, time, x, u, i);
+      workerPerformance += nodePerformance;
+      if (nodePerformancesPtr != nullptr) {
+        (*nodePerformancesPtr)[i] = nodePerformance;
       }
-
       i = timeIndex++;
     }
 
-    if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
-      workerPerformance += sqp::computeTerminalPerformance(result);
-      cost_[i] = std::move(result.cost);
-      stateInputEqConstraints_[i] = std::move(result.eqConstraints);
-      stateIneqConstraints_[i] = std::move(result.ineqConstraints);
-    }
-
     // Accumulate! Same worker might run multiple tasks
-    performance[workerId] += workerPerformance;
+    workerPerformances_[workerId] += workerPerformance;
   };
   runParallel(std::move(parallelTask));
 
   // Account for init state in performance
-  performance.front().dynamicsViolationSSE += (initState - x.front()).squaredNorm();
+  workerPerformances_.front().dynamicsViolationSSE += (initState - x.front()).squaredNorm();
 
   // Sum performance of the threads
-  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
+  PerformanceIndex totalPerformance =
+      std::accumulate(std::next(workerPerformances_.begin()), workerPerformances_.end(), workerPerformances_.front());
   totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
   return totalPerformance;
 }
 
+PerformanceIndex MultipleShootingSolver::setupNodeQuadraticApproximation(int workerId, const std::vector<AnnotatedTime>& time,
+                                                                         const vector_array_t& x, const vector_array_t& u, int i) {
+  // Problem horizon
+  const int N = static_cast<int>(time.size()) - 1;
+
+  // Get worker specific resources
+  OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
+  const VectorFunctionLinearApproximation noConstraints;
+  PerformanceIndex performance;
+
+  if (i == N) {
+    // Terminal node
+    const scalar_t tN = getIntervalStart(time[N]);
+    auto& result = terminalTranscription_;
+    multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N], result);
+    performance = sqp::computeTerminalPerformance(result);
+    std::swap(cost_[i], result.cost);
+    std::swap(stateInputEqConstraints_[i], result.eqConstraints);
+    std::swap(stateIneqConstraints_[i], result.ineqConstraints);
+    if (settings_.inequalityConstraintsInQp) {
+      multiple_shooting::stackInequalityConstraints(stateIneqConstraints_[i], noConstraints, x[i].size(), 0, ineqConstraints_[i]);
+    }
+    return performance;
+  }
+
+  if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    // Event node
+    auto& result = workerEventTranscriptions_[workerId];
+    multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1], result);
+    performance = sqp::computeEventPerformance(result);
+    std::swap(dynamics_[i], result.dynamics);
+    std::swap(cost_[i], result.cost);
+    constraintsProjection_[i].setZero(0, x[i].size(), 0);
+    std::swap(stateInputEqConstraints_[i], result.eqConstraints);
+    std::swap(stateIneqConstraints_[i], result.ineqConstraints);
+    stateInputIneqConstraints_[i].setZero(0, x[i].size(), 0);
+  } else {
+    // Normal, intermediate node
+    const scalar_t ti = getIntervalStart(time[i]);
+    const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+    auto& result = workerTranscriptions_[workerId];
+    multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i], result);
+    performance = sqp::computeIntermediatePerformance(result, dt);
+    if (settings_.projectStateInputEqualityConstraints) {
+      multiple_shooting::projectTranscription(result);
+    }
+    std::swap(dynamics_[i], result.dynamics);
+    std::swap(cost_[i], result.cost);
+    std::swap(constraintsProjection_[i], result.constraintsProjection);
+    std::swap(stateInputEqConstraints_[i], result.stateInputEqConstraints);
+    std::swap(stateIneqConstraints_[i], result.stateIneqConstraints);
+    std::swap(stateInputIneqConstraints_[i], result.stateInputIneqConstraints);
+  }
+
+  if (settings_.inequalityConstraintsInQp) {
+    // The state-only constraints of the initial node cannot be influenced, x[0] is not a decision variable of the QP
+    const auto& stateIneqConstraints = (i > 0) ? stateIneqConstraints_[i] : noConstraints;
+    multiple_shooting::stackInequalityConstraints(stateIneqConstraints, stateInputIneqConstraints_[i], dynamics_[i].dfdx.cols(),
+                                                  dynamics_[i].dfdu.cols(), ineqConstraints_[i]);
+  }
+
+  return performance;
+}
+
 PerformanceIndex MultipleShootingSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState,
                                                             const vector_array_t& x, const vector_array_t& u) {
   // Problem horizon
@@ -366,25 +625,11 @@ PerformanceIndex MultipleShootingSolver::computePerformance(const std::vector<An
     PerformanceIndex workerPerformance;  // Accumulate performance in local variable
 
     int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        workerPerformance += sqp::computeEventPerformance(ocpDefinition, time[i].time, x[i], x[i + 1]);
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        workerPerformance += sqp::computeIntermediatePerformance(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
-      }
-
+    while (i <= N) {
+      workerPerformance += computeNodePerformance(ocpDefinition, time, x, u, i);
       i = timeIndex++;
     }
 
-    if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      workerPerformance += sqp::computeTerminalPerformance(ocpDefinition, tN, x[N]);
-    }
-
     // Accumulate! Same worker might run multiple tasks
     performance[workerId] += workerPerformance;
   };
@@ -399,12 +644,57 @@ PerformanceIndex MultipleShootingSolver::computePerformance(const std::vector<An
   return totalPerformance;
 }
 
+bool MultipleShootingSolver::computePerformanceOnWorker(OptimalControlProblem& ocpDefinition, const std::vector<AnnotatedTime>& time,
+                                                        const vector_t& initState, const vector_array_t& x, const vector_array_t& u,
+                                                        const std::function<bool()>& terminate, PerformanceIndex& performance) {
+  // Problem horizon
+  const int N = static_cast<int>(time.size()) - 1;
+
+  performance = PerformanceIndex();
+  for (int i = 0; i <= N; ++i) {
+    if (terminate()) {
+      return false;
+    }
+    performance += computeNodePerformance(ocpDefinition, time, x, u, i);
+  }
+
+  // Account for init state in performance
+  performance.dynamicsViolationSSE += (initState - x.front()).squaredNorm();
+
+  performance.merit = performance.cost + performance.equalityLagrangian + performance.inequalityLagrangian;
+  return true;
+}
+
+PerformanceIndex MultipleShootingSolver::computeNodePerformance(OptimalControlProblem& ocpDefinition, const std::vector<AnnotatedTime>& time,
+                                                                const vector_array_t& x, const vector_array_t& u, int i) {
+  // Problem horizon
+  const int N = static_cast<int>(time.size()) - 1;
+
+  if (i == N) {
+    // Terminal node
+    const scalar_t tN = getIntervalStart(time[N]);
+    return sqp::computeTerminalPerformance(ocpDefinition, tN, x[N]);
+  } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    // Event node
+    return sqp::computeEventPerformance(ocpDefinition, time[i].time, x[i], x[i + 1]);
+  } else {
+    // Normal, intermediate node
+    const scalar_t ti = getIntervalStart(time[i]);
+    const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+    return sqp::computeIntermediatePerformance(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+  }
+}
+
 multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIndex& baseline,
                                                              const std::vector<AnnotatedTime>& timeDiscretization,
                                                              const vector_t& initState, const OcpSubproblemSolution& subproblemSolution,
                                                              vector_array_t& x, vector_array_t& u) {
   using StepType = FilterLinesearch::StepType;
 
+  if (settings_.parallelLinesearch && settings_.nThreads > 1) {
+    return takeStepParallel(baseline, timeDiscretization, initState, subproblemSolution, x, u);
+  }
+
   /*
    * Filter linesearch based on:
    * "On the implementation of an interior-point filter line-search algorithm for large-scale nonlinear programming"
@@ -417,7 +707,7 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
   }
 
   // Baseline costs
-  const scalar_t baselineConstraintViolation = FilterLinesearch::totalConstraintViolation(baseline);
+  const scalar_t baselineConstraintViolation = filterLinesearch_.totalConstraintViolation(baseline);
 
   // Update norm
   const auto& dx = subproblemSolution.deltaXSol;
@@ -460,7 +750,7 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
       stepInfo.dx_norm = alpha * deltaXnorm;
       stepInfo.du_norm = alpha * deltaUnorm;
       stepInfo.performanceAfterStep = performanceNew;
-      stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew);
+      stepInfo.totalConstraintViolationAfterStep = filterLinesearch_.totalConstraintViolation(performanceNew);
       return stepInfo;
 
     } else {  // Try smaller step
@@ -484,7 +774,136 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
   stepInfo.dx_norm = 0.0;
   stepInfo.du_norm = 0.0;
   stepInfo.performanceAfterStep = baseline;
-  stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(baseline);
+  stepInfo.totalConstraintViolationAfterStep = filterLinesearch_.totalConstraintViolation(baseline);
+
+  if (settings_.printLinesearch) {
+    std::cerr << "[Linesearch terminated] Step size: " << stepInfo.stepSize << ", Step Type: " << toString(stepInfo.stepType) << "\n";
+  }
+
+  return stepInfo;
+}
+
+multiple_shooting::StepInfo MultipleShootingSolver::takeStepParallel(const PerformanceIndex& baseline,
+                                                                     const std::vector<AnnotatedTime>& timeDiscretization,
+                                                                     const vector_t& initState,
+                                                                     const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
+                                                                     vector_array_t& u) {
+  using StepType = FilterLinesearch::StepType;
+
+  if (settings_.printLinesearch) {
+    std::cerr << std::setprecision(9) << std::fixed;
+    std::cerr << "\n=== Linesearch (parallel) ===\n";
+    std::cerr << "Baseline:\n" << baseline << "\n";
+  }
+
+  // Update norm
+  const auto& dx = subproblemSolution.deltaXSol;
+  const auto& du = subproblemSolution.deltaUSol;
+  const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
+  const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
+
+  // Candidate step sizes in decreasing order. Follows the same back-tracking rules as the sequential linesearch.
+  std::vector<scalar_t> stepSizes{1.0};
+  for (scalar_t alpha = settings_.alpha_decay; alpha >= settings_.alpha_min; alpha *= settings_.alpha_decay) {
+    if (alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol) {
+      break;
+    }
+    stepSizes.push_back(alpha);
+  }
+  const int numStepSizes = static_cast<int>(stepSizes.size());
+
+  // Trial trajectories, one set for each worker. The memory of the previous linesearch is reused.
+  for (int w = 0; w < settings_.nThreads; w++) {
+    xTrial_[w].resize(x.size());
+    uTrial_[w].resize(u.size());
+  }
+
+  // The best step found so far. Protected by acceptedStepMutex.
+  std::mutex acceptedStepMutex;
+  std::atomic_int acceptedStepIndex{numStepSizes};  // index in stepSizes, numStepSizes if no step is accepted.
+  PerformanceIndex acceptedPerformance;
+  StepType acceptedStepType = StepType::UNKNOWN;
+
+  std::atomic_int nextStepIndex{0};
+  auto linesearchTask = [&](int workerId) {
+    auto& xNew = xTrial_[workerId];
+    auto& uNew = uTrial_[workerId];
+
+    // Once a step is accepted, all smaller step sizes are obsolete.
+    int stepIndex = nextStepIndex++;
+    while (stepIndex < acceptedStepIndex) {
+      const scalar_t alpha = stepSizes[stepIndex];
+
+      // Compute step
+      multiple_shooting::incrementTrajectory(u, du, alpha, uNew);
+      multiple_shooting::incrementTrajectory(x, dx, alpha, xNew);
+
+      // Compute cost and constraints, abandon early if a larger step size got accepted in the meantime.
+      PerformanceIndex performanceNew;
+      const bool completed = computePerformanceOnWorker(ocpDefinitions_[workerId], timeDiscretization, initState, xNew, uNew,
+                                                        [&]() { return acceptedStepIndex < stepIndex; }, performanceNew);
+
+      if (completed) {
+        // Step acceptance and record step type
+        bool stepAccepted;
+        StepType stepType;
+        std::tie(stepAccepted, stepType) =
+            filterLinesearch_.acceptStep(baseline, performanceNew, alpha * subproblemSolution.armijoDescentMetric);
+
+        std::lock_guard<std::mutex> lock(acceptedStepMutex);
+        if (settings_.printLinesearch) {
+          std::cerr << "[Worker " << workerId << "] Step size: " << alpha << ", Step Type: " << toString(stepType)
+                    << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
+          std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
+          std::cerr << performanceNew << "\n";
+        }
+
+        if (stepAccepted && stepIndex < acceptedStepIndex) {
+          acceptedStepIndex = stepIndex;
+          acceptedStepType = stepType;
+          acceptedPerformance = performanceNew;
+          xAccepted_.swap(xNew);
+          uAccepted_.swap(uNew);
+          xNew.resize(x.size());
+          uNew.resize(u.size());
+        }
+      }
+
+      stepIndex = nextStepIndex++;
+    }
+  };
+  runParallel(std::move(linesearchTask));
+
+  if (acceptedStepIndex < numStepSizes) {
+    const scalar_t alpha = stepSizes[acceptedStepIndex];
+    // The previous iterate is kept as the buffer of the next accepted step
+    x.swap(xAccepted_);
+    u.swap(uAccepted_);
+
+    // Prepare step info
+    multiple_shooting::StepInfo stepInfo;
+    stepInfo.stepSize = alpha;
+    stepInfo.stepType = acceptedStepType;
+    stepInfo.dx_norm = alpha * deltaXnorm;
+    stepInfo.du_norm = alpha * deltaUnorm;
+    stepInfo.performanceAfterStep = acceptedPerformance;
+    stepInfo.totalConstraintViolationAfterStep = filterLinesearch_.totalConstraintViolation(acceptedPerformance);
+
+    if (settings_.printLinesearch) {
+      std::cerr << "[Linesearch terminated] Step size: " << stepInfo.stepSize << ", Step Type: " << toString(stepInfo.stepType) << "\n";
+    }
+
+    return stepInfo;
+  }
+
+  // No candidate accepted -> Don't take a step
+  multiple_shooting::StepInfo stepInfo;
+  stepInfo.stepSize = 0.0;
+  stepInfo.stepType = StepType::ZERO;
+  stepInfo.dx_norm = 0.0;
+  stepInfo.du_norm = 0.0;
+  stepInfo.performanceAfterStep = baseline;
+  stepInfo.totalConstraintViolationAfterStep = filterLinesearch_.totalConstraintViolation(baseline);
 
   if (settings_.printLinesearch) {
     std::cerr << "[Linesearch terminated] Step size: " << stepInfo.stepSize << ", Step Type: " << toString(stepInfo.stepType) << "\n";
@@ -493,6 +912,34 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
   return stepInfo;
 }
 
+void MultipleShootingSolver::updateBestFeasibleIterate(const vector_array_t& x, const vector_array_t& u,
+                                                       const PerformanceIndex& performance) {
+  if (filterLinesearch_.totalConstraintViolation(performance) > settings_.g_min ||
+      (hasBestFeasibleIterate_ && performance.merit > bestFeasiblePerformance_.merit)) {
+    return;
+  }
+  // The assignment reuses the memory of the previous copy
+  xBestFeasible_ = x;
+  uBestFeasible_ = u;
+  bestFeasiblePerformance_ = performance;
+  hasBestFeasibleIterate_ = true;
+}
+
+bool MultipleShootingSolver::restoreBestFeasibleIterate(vector_array_t& x, vector_array_t& u, PerformanceIndex& performance) {
+  if (!hasBestFeasibleIterate_ ||
+      (filterLinesearch_.totalConstraintViolation(performance) <= settings_.g_min && performance.merit <= bestFeasiblePerformance_.merit)) {
+    return false;
+  }
+  // The feedback gains and the value function remain the ones of the last QP
+  x.swap(xBestFeasible_);
+  u.swap(uBestFeasible_);
+  performance = bestFeasiblePerformance_;
+  if (settings_.printSolverStatus || settings_.printLinesearch) {
+    std::cerr << "[Time budget] The best feasible iterate with merit " << performance.merit << " is returned.\n";
+  }
+  return true;
+}
+
 multiple_shooting::Convergence MultipleShootingSolver::checkConvergence(int iteration, const PerformanceIndex& baseline,
                                                                         const multiple_shooting::StepInfo& stepInfo) const {
   using Convergence = multiple_shooting::Convergence;
@@ -503,12 +950,16 @@ multiple_shooting::Convergence MultipleShootingSolver::checkConvergence(int iter
     // Converged because step size is below the specified minimum
     return Convergence::STEPSIZE;
   } else if (std::abs(stepInfo.performanceAfterStep.merit - baseline.merit) < settings_.costTol &&
-             FilterLinesearch::totalConstraintViolation(stepInfo.performanceAfterStep) < settings_.g_min) {
+             filterLinesearch_.totalConstraintViolation(stepInfo.performanceAfterStep) < settings_.g_min) {
     // Converged because the change in merit is below the specified tolerance while the constraint violation is below the minimum
     return Convergence::METRICS;
   } else if (stepInfo.dx_norm < settings_.deltaTol && stepInfo.du_norm < settings_.deltaTol) {
     // Converged because the change in primal variables is below the specified tolerance
     return Convergence::PRIMAL;
+  } else if (!fitsInTimeBudget(linearQuadraticApproximationTimer_.getExpectedIntervalInMilliseconds() +
+                               solveQpTimer_.getExpectedIntervalInMilliseconds() + linesearchTimer_.getExpectedIntervalInMilliseconds())) {
+    // Terminated because the next iteration, predicted from the previous ones, would exceed the time budget
+    return Convergence::TIME;
   } else {
     // None of the above convergence criteria were met -> not converged.
     return Convergence::FALSE;
@@ -42,6 +42,8 @@ std::string toString(const Convergence& convergence) {
       return "Cost decrease and constraint satisfaction below tolerance";
     case Convergence::PRIMAL:
       return "Primal update below tolerance";
+    case Convergence::TIME:
+      return "Next iteration exceeds the time budget";
     case Convergence::FALSE:
     default:
       return "Not Converged";
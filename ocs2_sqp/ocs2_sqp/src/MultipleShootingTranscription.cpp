@@ -40,8 +40,15 @@ namespace multiple_shooting {
 Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlProblem,
                                     DynamicsSensitivityDiscretizer& sensitivityDiscretizer, scalar_t t, scalar_t dt, const vector_t& x,
                                     const vector_t& x_next, const vector_t& u) {
-  // Results and short-hand notation
   Transcription transcription;
+  setupIntermediateNode(optimalControlProblem, sensitivityDiscretizer, t, dt, x, x_next, u, transcription);
+  return transcription;
+}
+
+void setupIntermediateNode(const OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer,
+                           scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                           Transcription& transcription) {
+  // Short-hand notation
   auto& dynamics = transcription.dynamics;
   auto& cost = transcription.cost;
   auto& stateInputEqConstraints = transcription.stateInputEqConstraints;
@@ -66,21 +73,27 @@ Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlP
     // C_{k} * dx_{k} + D_{k} * du_{k} + e_{k} = 0
     stateInputEqConstraints =
         optimalControlProblem.equalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
+  } else {
+    stateInputEqConstraints.resize(0, 0, 0);
   }
 
   // State inequality constraints.
   if (!optimalControlProblem.stateInequalityConstraintPtr->empty()) {
     stateIneqConstraints =
         optimalControlProblem.stateInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    stateIneqConstraints.resize(0, 0, 0);
   }
 
   // State-input inequality constraints.
   if (!optimalControlProblem.inequalityConstraintPtr->empty()) {
     stateInputIneqConstraints =
         optimalControlProblem.inequalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
+  } else {
+    stateInputIneqConstraints.resize(0, 0, 0);
   }
 
-  return transcription;
+  // constraintsProjection and constraintPseudoInverse are left untouched, projectTranscription overwrites them in place.
 }
 
 void projectTranscription(Transcription& transcription, bool extractEqualityConstraintsPseudoInverse) {
@@ -94,12 +107,12 @@ void projectTranscription(Transcription& transcription, bool extractEqualityCons
   if (stateInputEqConstraints.f.size() > 0) {
     // Projection stored instead of constraint, // TODO: benchmark between lu and qr method. LU seems slightly faster.
     if (extractEqualityConstraintsPseudoInverse) {
-      std::tie(projection, constraintPseudoInverse) = qrConstraintProjection(stateInputEqConstraints);
+      qrConstraintProjection(stateInputEqConstraints, projection, constraintPseudoInverse);
     } else {
-      projection = luConstraintProjection(stateInputEqConstraints).first;
-      constraintPseudoInverse = matrix_t();
+      luConstraintProjection(stateInputEqConstraints, projection);
+      constraintPseudoInverse.resize(0, 0);
     }
-    stateInputEqConstraints = VectorFunctionLinearApproximation();
+    stateInputEqConstraints.resize(0, 0, 0);
 
     // Adapt dynamics, cost, and state-input inequality constraints
     changeOfInputVariables(dynamics, projection.dfdu, projection.dfdx, projection.f);
@@ -107,12 +120,22 @@ void projectTranscription(Transcription& transcription, bool extractEqualityCons
     if (stateInputIneqConstraints.f.size() > 0) {
       changeOfInputVariables(stateInputIneqConstraints, projection.dfdu, projection.dfdx, projection.f);
     }
+  } else {
+    // Nothing to project. Only releases memory if the node had equality constraints before.
+    projection.resize(0, 0, 0);
+    constraintPseudoInverse.resize(0, 0);
   }
 }
 
 TerminalTranscription setupTerminalNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x) {
-  // Results and short-hand notation
   TerminalTranscription transcription;
+  setupTerminalNode(optimalControlProblem, t, x, transcription);
+  return transcription;
+}
+
+void setupTerminalNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
+                       TerminalTranscription& transcription) {
+  // Short-hand notation
   auto& cost = transcription.cost;
   auto& eqConstraints = transcription.eqConstraints;
   auto& ineqConstraints = transcription.ineqConstraints;
@@ -127,21 +150,29 @@ TerminalTranscription setupTerminalNode(const OptimalControlProblem& optimalCont
   if (!optimalControlProblem.finalEqualityConstraintPtr->empty()) {
     eqConstraints =
         optimalControlProblem.finalEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    eqConstraints.resize(0, 0, 0);
   }
 
   // State inequality constraints.
   if (!optimalControlProblem.finalInequalityConstraintPtr->empty()) {
     ineqConstraints =
         optimalControlProblem.finalInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    ineqConstraints.resize(0, 0, 0);
   }
-
-  return transcription;
 }
 
 EventTranscription setupEventNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
                                   const vector_t& x_next) {
-  // Results and short-hand notation
   EventTranscription transcription;
+  setupEventNode(optimalControlProblem, t, x, x_next, transcription);
+  return transcription;
+}
+
+void setupEventNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next,
+                    EventTranscription& transcription) {
+  // Short-hand notation
   auto& dynamics = transcription.dynamics;
   auto& cost = transcription.cost;
   auto& eqConstraints = transcription.eqConstraints;
@@ -163,15 +194,17 @@ EventTranscription setupEventNode(const OptimalControlProblem& optimalControlPro
   if (!optimalControlProblem.preJumpEqualityConstraintPtr->empty()) {
     eqConstraints =
         optimalControlProblem.preJumpEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    eqConstraints.resize(0, 0, 0);
   }
 
   // State inequality constraints.
   if (!optimalControlProblem.preJumpInequalityConstraintPtr->empty()) {
     ineqConstraints =
         optimalControlProblem.preJumpInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    ineqConstraints.resize(0, 0, 0);
   }
-
-  return transcription;
 }
 
 }  // namespace multiple_shooting
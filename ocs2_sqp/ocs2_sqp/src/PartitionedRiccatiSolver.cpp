@@ -0,0 +1,249 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_sqp/PartitionedRiccatiSolver.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+namespace ocs2 {
+
+namespace {
+
+/**
+ * One stage of the Riccati recursion. Given the cost-to-go (P, p) at the next node, computes the feedback K, the feedforward k and the
+ * cost-to-go (Pk, pk) at the current node. The Cholesky factorization of the input Hessian is returned as well.
+ * Throws if the input Hessian of the node is not positive definite.
+ */
+void riccatiStep(int node, const VectorFunctionLinearApproximation& dynamics, const ScalarFunctionQuadraticApproximation& cost,
+                 const matrix_t& P, const vector_t& p, Eigen::LLT<matrix_t>& Hllt, matrix_t& K, vector_t& k, matrix_t& Pk, vector_t& pk) {
+  // Shorthand notation
+  const matrix_t& A = dynamics.dfdx;
+  const matrix_t& B = dynamics.dfdu;
+  const vector_t& b = dynamics.f;
+
+  const matrix_t P_A = P * A;
+  vector_t p_plus_P_b = p;
+  p_plus_P_b.noalias() += P * b;
+
+  // H = R + B' P B, G = S + B' P A, g = r + B' (p + P b)
+  matrix_t H = cost.dfduu;
+  H.noalias() += B.transpose() * P * B;
+  matrix_t G = cost.dfdux;
+  G.noalias() += B.transpose() * P_A;
+  vector_t g = cost.dfdu;
+  g.noalias() += B.transpose() * p_plus_P_b;
+
+  Hllt.compute(H);
+  if (Hllt.info() != Eigen::Success) {
+    throw std::runtime_error("[PartitionedRiccatiSolver] The input Hessian of node " + std::to_string(node) +
+                             " is not positive definite.");
+  }
+  K = -Hllt.solve(G);
+  k = -Hllt.solve(g);
+
+  // Pk = Q + A' P A + G' K, pk = q + A' (p + P b) + G' k
+  Pk = cost.dfdxx;
+  Pk.noalias() += A.transpose() * P_A;
+  Pk.noalias() += G.transpose() * K;
+  Pk = 0.5 * (Pk + Pk.transpose()).eval();
+  pk = cost.dfdx;
+  pk.noalias() += A.transpose() * p_plus_P_b;
+  pk.noalias() += G.transpose() * k;
+}
+
+}  // namespace
+
+void PartitionedRiccatiSolver::solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                     const std::vector<ScalarFunctionQuadraticApproximation>& cost, int numPartitions,
+                                     ThreadPool& threadPool, int nThreads, vector_array_t& stateTrajectory,
+                                     vector_array_t& inputTrajectory) {
+  const int N = static_cast<int>(dynamics.size());
+  if (cost.size() != N + 1) {
+    throw std::runtime_error("[PartitionedRiccatiSolver] Inconsistent size of cost: " + std::to_string(cost.size()) + " with " +
+                             std::to_string(N + 1) + " expected.");
+  }
+
+  // Split the horizon into partitions of (almost) equal length
+  numPartitions = std::max(std::min(numPartitions, N), 1);
+  partitions_.resize(numPartitions);
+  for (int i = 0; i < numPartitions; i++) {
+    partitions_[i].start = (i * N) / numPartitions;
+    partitions_[i].end = ((i + 1) * N) / numPartitions;
+  }
+
+  feedback_.resize(N);
+  feedforward_.resize(N);
+  costToGo_.resize(N + 1);
+  stateTrajectory.resize(N + 1);
+  inputTrajectory.resize(N);
+
+  if (numPartitions > 1) {
+    runPartitions([&](int i) { parametricRiccatiRecursion(partitions_[i], dynamics, cost); }, threadPool, nThreads);
+    solveReducedSystem(x0);
+  } else {
+    partitions_.front().x0 = x0;
+  }
+
+  runPartitions(
+      [&](int i) {
+        riccatiRecursion(i, dynamics, cost);
+        rollout(partitions_[i], dynamics, stateTrajectory, inputTrajectory);
+      },
+      threadPool, nThreads);
+}
+
+void PartitionedRiccatiSolver::parametricRiccatiRecursion(Partition& partition,
+                                                          const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                                          const std::vector<ScalarFunctionQuadraticApproximation>& cost) {
+  const bool isLastPartition = partition.end == static_cast<int>(dynamics.size());
+  const int nx = dynamics[partition.end - 1].dfdx.rows();
+  const int numMultipliers = isLastPartition ? 0 : nx;
+
+  // Terminal value function: the terminal cost for the last partition, lambda' * dx_end for all others.
+  matrix_t P = isLastPartition ? cost.back().dfdxx : matrix_t::Zero(nx, nx);
+  vector_t p = isLastPartition ? cost.back().dfdx : vector_t::Zero(nx);
+  partition.M.setIdentity(nx, numMultipliers);
+  partition.N.setZero(numMultipliers, numMultipliers);
+  partition.n.setZero(numMultipliers);
+
+  Eigen::LLT<matrix_t> Hllt;
+  matrix_t K;
+  vector_t k;
+  matrix_t B_M;
+  for (int i = partition.end - 1; i >= partition.start; i--) {
+    riccatiStep(i, dynamics[i], cost[i], P, p, Hllt, K, k, partition.S, partition.s);
+
+    // Multiplier dependent terms, with du = K dx + k - inv(H) B' M lambda
+    B_M.noalias() = dynamics[i].dfdu.transpose() * partition.M;
+    partition.N.noalias() -= B_M.transpose() * Hllt.solve(B_M);
+    partition.n.noalias() += partition.M.transpose() * dynamics[i].f;
+    partition.n.noalias() += B_M.transpose() * k;
+    partition.M = (dynamics[i].dfdx.transpose() * partition.M + K.transpose() * B_M).eval();
+
+    P.swap(partition.S);
+    p.swap(partition.s);
+  }
+  partition.S.swap(P);
+  partition.s.swap(p);
+}
+
+void PartitionedRiccatiSolver::solveReducedSystem(const vector_t& x0) {
+  // Backward: gradient of the exact value function at the start of each partition
+  auto& lastPartition = partitions_.back();
+  lastPartition.W = lastPartition.S;
+  lastPartition.w = lastPartition.s;
+  for (int i = static_cast<int>(partitions_.size()) - 2; i >= 0; i--) {
+    auto& partition = partitions_[i];
+    const auto& next = partitions_[i + 1];
+
+    // lambda = W_next * dx_end + w_next, with dx_end = M' x + N lambda + n
+    matrix_t I_minus_WN = -next.W * partition.N;
+    I_minus_WN.diagonal().array() += 1.0;
+    const auto lu = I_minus_WN.partialPivLu();
+    partition.L = lu.solve(next.W * partition.M.transpose());
+    partition.l = lu.solve(next.W * partition.n + next.w);
+
+    partition.W = partition.S;
+    partition.W.noalias() += partition.M * partition.L;
+    partition.W = 0.5 * (partition.W + partition.W.transpose()).eval();
+    partition.w = partition.s;
+    partition.w.noalias() += partition.M * partition.l;
+  }
+
+  // Forward: initial states of the partitions
+  partitions_.front().x0 = x0;
+  for (int i = 0; i + 1 < static_cast<int>(partitions_.size()); i++) {
+    const auto& partition = partitions_[i];
+    const vector_t lambda = partition.L * partition.x0 + partition.l;
+    auto& nextX0 = partitions_[i + 1].x0;
+    nextX0 = partition.n;
+    nextX0.noalias() += partition.M.transpose() * partition.x0;
+    nextX0.noalias() += partition.N * lambda;
+  }
+}
+
+void PartitionedRiccatiSolver::riccatiRecursion(int partitionIndex, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                                const std::vector<ScalarFunctionQuadraticApproximation>& cost) {
+  const auto& partition = partitions_[partitionIndex];
+  const bool isLastPartition = partitionIndex + 1 == static_cast<int>(partitions_.size());
+
+  // Exact value function at the end of the partition
+  auto& terminalCostToGo = costToGo_[partition.end];
+  if (isLastPartition) {
+    terminalCostToGo.dfdxx = cost.back().dfdxx;
+    terminalCostToGo.dfdx = cost.back().dfdx;
+  }
+  const matrix_t& Pend = isLastPartition ? terminalCostToGo.dfdxx : partitions_[partitionIndex + 1].W;
+  const vector_t& pend = isLastPartition ? terminalCostToGo.dfdx : partitions_[partitionIndex + 1].w;
+
+  Eigen::LLT<matrix_t> Hllt;
+  for (int i = partition.end - 1; i >= partition.start; i--) {
+    const matrix_t& P = (i + 1 == partition.end) ? Pend : costToGo_[i + 1].dfdxx;
+    const vector_t& p = (i + 1 == partition.end) ? pend : costToGo_[i + 1].dfdx;
+    riccatiStep(i, dynamics[i], cost[i], P, p, Hllt, feedback_[i], feedforward_[i], costToGo_[i].dfdxx, costToGo_[i].dfdx);
+  }
+}
+
+void PartitionedRiccatiSolver::rollout(const Partition& partition, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                       vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) const {
+  // The state at the end of the partition is written by the next partition, except for the last one.
+  const bool isLastPartition = partition.end == static_cast<int>(dynamics.size());
+  stateTrajectory[partition.start] = partition.x0;
+  vector_t x = partition.x0;
+  vector_t x_next;
+  for (int i = partition.start; i < partition.end; i++) {
+    auto& u = inputTrajectory[i];
+    u = feedforward_[i];
+    u.noalias() += feedback_[i] * x;
+
+    x_next = dynamics[i].f;
+    x_next.noalias() += dynamics[i].dfdx * x;
+    x_next.noalias() += dynamics[i].dfdu * u;
+    x.swap(x_next);
+    if (i + 1 < partition.end || isLastPartition) {
+      stateTrajectory[i + 1] = x;
+    }
+  }
+}
+
+void PartitionedRiccatiSolver::runPartitions(const std::function<void(int)>& task, ThreadPool& threadPool, int nThreads) {
+  const int numPartitions = static_cast<int>(partitions_.size());
+  std::atomic_int partitionIndex{0};
+  auto parallelTask = [&](int) {
+    int i;
+    while ((i = partitionIndex++) < numPartitions) {
+      task(i);
+    }
+  };
+  threadPool.runParallel(std::move(parallelTask), std::min(nThreads, numPartitions));
+}
+
+}  // namespace ocs2
@@ -65,8 +65,8 @@ PerformanceIndex computeIntermediatePerformance(const multiple_shooting::Transcr
   performance.equalityConstraintsSSE = dt * getEqConstraintsSSE(transcription.stateInputEqConstraints.f);
 
   // Inequality constraints.
-  performance.inequalityConstraintsSSE =
-      dt * getIneqConstraintsSSE(transcription.stateIneqConstraints.f) + dt * getIneqConstraintsSSE(transcription.stateIneqConstraints.f);
+  performance.inequalityConstraintsSSE = dt * getIneqConstraintsSSE(transcription.stateIneqConstraints.f) +
+                                         dt * getIneqConstraintsSSE(transcription.stateInputIneqConstraints.f);
 
   return performance;
 }
@@ -27,13 +27,19 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+
 #include <gtest/gtest.h>
 
+#include "ocs2_sqp/MultipleShootingMpc.h"
 #include "ocs2_sqp/MultipleShootingSolver.h"
 
 #include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_mpc/MPC_MRT_Interface.h>
 
 #include <ocs2_oc/test/circular_kinematics.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
 
 TEST(test_circular_kinematics, solve_projected_EqConstraints) {
   // optimal control problem
@@ -141,3 +147,247 @@ TEST(test_circular_kinematics, solve_EqConstraints_inQPSubproblem) {
     ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
   }
 }
+
+TEST(test_circular_kinematics, solve_projected_EqConstraints_IneqConstraintsInQp) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // Input bounds: -inputLimit <= u <= inputLimit
+  const ocs2::scalar_t inputLimit = 0.5;
+  ocs2::VectorFunctionLinearApproximation inputBounds;
+  inputBounds.setZero(4, 2, 2);
+  inputBounds.f.setConstant(inputLimit);
+  inputBounds.dfdu.topRows(2) = -ocs2::matrix_t::Identity(2, 2);
+  inputBounds.dfdu.bottomRows(2) = ocs2::matrix_t::Identity(2, 2);
+  problem.inequalityConstraintPtr->add("inputBounds", ocs2::getOcs2Constraints(inputBounds));
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.inequalityConstraintsInQp = true;
+  settings.useFeedbackPolicy = true;
+  settings.printSolverStatistics = true;
+  settings.printLinesearch = true;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve
+  ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+  solver.run(startTime, initState, finalTime);
+
+  // Check initial condition
+  const auto primalSolution = solver.primalSolution(finalTime);
+  ASSERT_TRUE(primalSolution.stateTrajectory_.front().isApprox(initState));
+
+  // Check constraint satisfaction.
+  const auto performance = solver.getPerformanceIndeces();
+  ASSERT_LT(performance.dynamicsViolationSSE, 1e-6);
+  ASSERT_LT(performance.equalityConstraintsSSE, 1e-6);
+  ASSERT_LT(performance.inequalityConstraintsSSE, 1e-6);
+  for (const auto& u : primalSolution.inputTrajectory_) {
+    ASSERT_LE(u.cwiseAbs().maxCoeff(), inputLimit + 1e-6);
+  }
+}
+
+TEST(test_circular_kinematics, solve_parallelLinesearch) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.printSolverStatistics = true;
+  settings.printLinesearch = true;
+  settings.nThreads = 4;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve with sequential linesearch
+  settings.parallelLinesearch = false;
+  ocs2::MultipleShootingSolver sequentialSolver(settings, problem, zeroInitializer);
+  sequentialSolver.run(startTime, initState, finalTime);
+  const auto sequentialSolution = sequentialSolver.primalSolution(finalTime);
+
+  // Solve with parallel linesearch
+  settings.parallelLinesearch = true;
+  ocs2::MultipleShootingSolver parallelSolver(settings, problem, zeroInitializer);
+  parallelSolver.run(startTime, initState, finalTime);
+  const auto parallelSolution = parallelSolver.primalSolution(finalTime);
+
+  // The parallel linesearch selects the same steps as the sequential one
+  const auto& sequentialLog = sequentialSolver.getIterationsLog();
+  const auto& parallelLog = parallelSolver.getIterationsLog();
+  ASSERT_EQ(sequentialLog.size(), parallelLog.size());
+  for (int i = 0; i < sequentialLog.size(); i++) {
+    const auto relativeTol = 1e-9 * std::max(1.0, std::abs(sequentialLog[i].merit));
+    ASSERT_NEAR(sequentialLog[i].merit, parallelLog[i].merit, relativeTol);
+  }
+
+  ASSERT_EQ(sequentialSolution.timeTrajectory_.size(), parallelSolution.timeTrajectory_.size());
+  for (int i = 0; i < sequentialSolution.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(sequentialSolution.stateTrajectory_[i].isApprox(parallelSolution.stateTrajectory_[i], 1e-9));
+    ASSERT_TRUE(sequentialSolution.inputTrajectory_[i].isApprox(parallelSolution.inputTrajectory_[i], 1e-9));
+  }
+}
+
+TEST(test_circular_kinematics, solve_realtimeIteration) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.realtimeIteration = true;
+  settings.nThreads = 1;
+
+  // Additional problem definitions
+  const ocs2::scalar_t timeHorizon = 1.0;
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // First solve is not prepared and iterates until convergence
+  ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+  solver.run(startTime, initState, startTime + timeHorizon);
+  const auto numIterationsFirstRun = solver.getNumIterations();
+  const auto previousSolution = solver.primalSolution(startTime + timeHorizon);
+
+  // Preparation phase for the next run, the next state is not known yet.
+  const ocs2::scalar_t nextTime = startTime + 0.05;
+  solver.prepare(nextTime, nextTime + timeHorizon);
+
+  // Feedback phase with a slightly perturbed state
+  const ocs2::vector_t predictedState =
+      ocs2::LinearInterpolation::interpolate(nextTime, previousSolution.timeTrajectory_, previousSolution.stateTrajectory_);
+  const ocs2::vector_t nextState = predictedState + 1e-3 * ocs2::vector_t::Ones(2);
+  solver.run(nextTime, nextState, nextTime + timeHorizon);
+
+  // Only a single QP was solved
+  ASSERT_EQ(solver.getNumIterations(), numIterationsFirstRun + 1);
+  ASSERT_EQ(solver.getIterationsLog().size(), 1);
+
+  const auto primalSolution = solver.primalSolution(nextTime + timeHorizon);
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.front(), nextTime);
+  ASSERT_TRUE(primalSolution.stateTrajectory_.front().isApprox(nextState));
+  ASSERT_TRUE(primalSolution.inputTrajectory_.front().isApprox(primalSolution.controllerPtr_->computeInput(nextTime, nextState)));
+
+  // A run without matching preparation solves the problem as usual
+  solver.prepare(nextTime, nextTime + timeHorizon);
+  const ocs2::scalar_t unpreparedTime = nextTime + 10.0 * settings.dt;
+  solver.run(unpreparedTime, nextState, unpreparedTime + timeHorizon);
+  ASSERT_DOUBLE_EQ(solver.primalSolution(unpreparedTime + timeHorizon).timeTrajectory_.front(), unpreparedTime);
+}
+
+TEST(test_circular_kinematics, solve_realtimeIterationUnpredictedTime) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.realtimeIteration = true;
+  settings.nThreads = 1;
+
+  // Additional problem definitions
+  const ocs2::scalar_t timeHorizon = 1.0;
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+  solver.run(startTime, initState, startTime + timeHorizon);
+  const auto previousSolution = solver.primalSolution(startTime + timeHorizon);
+
+  // The actual initial time of the next run differs from the prediction by less than settings.dt
+  const ocs2::scalar_t predictedTime = startTime + 0.05;
+  const ocs2::scalar_t actualTime = predictedTime + 0.5 * settings.dt;
+  solver.prepare(predictedTime, predictedTime + timeHorizon);
+  const ocs2::vector_t actualState =
+      ocs2::LinearInterpolation::interpolate(actualTime, previousSolution.timeTrajectory_, previousSolution.stateTrajectory_);
+  solver.run(actualTime, actualState, actualTime + timeHorizon);
+
+  // The solution starts at the actual initial time and state
+  const auto primalSolution = solver.primalSolution(actualTime + timeHorizon);
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.front(), actualTime);
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.back(), actualTime + timeHorizon);
+  ASSERT_TRUE(primalSolution.stateTrajectory_.front().isApprox(actualState));
+  ASSERT_TRUE(primalSolution.inputTrajectory_.front().isApprox(primalSolution.controllerPtr_->computeInput(actualTime, actualState)));
+}
+
+TEST(test_circular_kinematics, solve_realtimeIterationMpcMrtInterface) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.realtimeIteration = true;
+  settings.nThreads = 1;
+
+  // MPC settings, the next run is prepared one MPC period ahead of the current observation
+  ocs2::mpc::Settings mpcSettings;
+  mpcSettings.timeHorizon_ = 1.0;
+  mpcSettings.mpcDesiredFrequency_ = 100.0;
+  const ocs2::scalar_t mpcPeriod = 1.0 / mpcSettings.mpcDesiredFrequency_;
+
+  ocs2::MultipleShootingMpc mpc(mpcSettings, settings, problem, zeroInitializer);
+  ocs2::MPC_MRT_Interface mpcMrtInterface(mpc);
+
+  ocs2::SystemObservation observation;
+  observation.time = 0.0;
+  observation.state = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+  observation.input = ocs2::vector_t::Zero(2);
+
+  constexpr size_t numRuns = 6;
+  for (size_t k = 0; k < numRuns; k++) {
+    mpcMrtInterface.setCurrentObservation(observation);
+    mpcMrtInterface.advanceMpc();
+    mpcMrtInterface.updatePolicy();
+
+    // Except for the first run, only the prepared QP is solved
+    ASSERT_EQ(mpc.getSolverPtr()->getNumFeedbackPhases(), k);
+    const auto& policy = mpcMrtInterface.getPolicy();
+    ASSERT_DOUBLE_EQ(policy.timeTrajectory_.front(), observation.time);
+    ASSERT_DOUBLE_EQ(policy.timeTrajectory_.back(), observation.time + mpcSettings.timeHorizon_);
+    ASSERT_TRUE(policy.stateTrajectory_.front().isApprox(observation.state));
+
+    // The next observation arrives a fraction of a time step before or after the predicted time
+    const ocs2::scalar_t timeDeviation = (k % 2 == 0) ? 0.3 * settings.dt : -0.3 * settings.dt;
+    const ocs2::scalar_t nextTime = observation.time + mpcPeriod + timeDeviation;
+    observation.state = ocs2::LinearInterpolation::interpolate(nextTime, policy.timeTrajectory_, policy.stateTrajectory_);
+    observation.time = nextTime;
+  }
+}
@@ -0,0 +1,147 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_sqp/PartitionedRiccatiSolver.h"
+
+#include <hpipm_catkin/HpipmInterface.h>
+
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+namespace ocs2 {
+namespace {
+
+struct LqProblem {
+  vector_t x0;
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> cost;
+};
+
+LqProblem getRandomLqProblem(int nx, int nu, int N) {
+  LqProblem problem;
+  problem.x0 = vector_t::Random(nx);
+  for (int k = 0; k < N; k++) {
+    problem.dynamics.emplace_back(getRandomDynamics(nx, nu));
+    problem.cost.emplace_back(getRandomCost(nx, nu));
+  }
+  problem.cost.emplace_back(getRandomCost(nx, 0));
+  return problem;
+}
+
+}  // namespace
+}  // namespace ocs2
+
+using namespace ocs2;
+
+TEST(testPartitionedRiccati, compareToHpipm) {
+  const int nx = 4;
+  const int nu = 3;
+  const int N = 20;
+  const int nThreads = 4;
+  const scalar_t tol = 1e-6;
+  auto problem = getRandomLqProblem(nx, nu, N);
+
+  // Reference solution
+  HpipmInterface hpipmInterface(HpipmInterface::OcpSize(N, nx, nu));
+  vector_array_t xRef;
+  vector_array_t uRef;
+  ASSERT_EQ(hpipmInterface.solve(problem.x0, problem.dynamics, problem.cost, nullptr, xRef, uRef, false), hpipm_status::SUCCESS);
+  const auto KRef = hpipmInterface.getRiccatiFeedback(problem.dynamics[0], problem.cost[0]);
+  const auto costToGoRef = hpipmInterface.getRiccatiCostToGo(problem.dynamics[0], problem.cost[0]);
+
+  ThreadPool threadPool(nThreads - 1);
+  PartitionedRiccatiSolver solver;
+  for (int numPartitions : {1, 2, 3, 7, N, 2 * N}) {
+    vector_array_t xSol;
+    vector_array_t uSol;
+    solver.solve(problem.x0, problem.dynamics, problem.cost, numPartitions, threadPool, nThreads, xSol, uSol);
+
+    ASSERT_EQ(xSol.size(), N + 1);
+    ASSERT_EQ(uSol.size(), N);
+    for (int k = 0; k < N; k++) {
+      EXPECT_TRUE(xSol[k].isApprox(xRef[k], tol)) << "numPartitions: " << numPartitions << ", k: " << k;
+      EXPECT_TRUE(uSol[k].isApprox(uRef[k], tol)) << "numPartitions: " << numPartitions << ", k: " << k;
+      EXPECT_TRUE(solver.getRiccatiFeedback()[k].isApprox(KRef[k], tol)) << "numPartitions: " << numPartitions << ", k: " << k;
+      EXPECT_TRUE(solver.getRiccatiCostToGo()[k].dfdxx.isApprox(costToGoRef[k].dfdxx, tol));
+      EXPECT_TRUE(solver.getRiccatiCostToGo()[k].dfdx.isApprox(costToGoRef[k].dfdx, tol));
+    }
+    EXPECT_TRUE(xSol[N].isApprox(xRef[N], tol)) << "numPartitions: " << numPartitions;
+  }
+}
+
+TEST(testPartitionedRiccati, eventNodes) {
+  const int nx = 3;
+  const int nu = 2;
+  const int N = 12;
+  const int nThreads = 3;
+  const scalar_t tol = 1e-8;
+  auto problem = getRandomLqProblem(nx, nu, N);
+
+  // Event nodes have no inputs
+  for (int k : {4, 8}) {
+    problem.dynamics[k] = getRandomDynamics(nx, 0);
+    problem.cost[k] = getRandomCost(nx, 0);
+  }
+
+  ThreadPool threadPool(nThreads - 1);
+  PartitionedRiccatiSolver solver;
+  vector_array_t xRef;
+  vector_array_t uRef;
+  solver.solve(problem.x0, problem.dynamics, problem.cost, 1, threadPool, nThreads, xRef, uRef);
+
+  vector_array_t xSol;
+  vector_array_t uSol;
+  solver.solve(problem.x0, problem.dynamics, problem.cost, 5, threadPool, nThreads, xSol, uSol);
+  for (int k = 0; k < N; k++) {
+    ASSERT_EQ(uSol[k].size(), uRef[k].size());
+    EXPECT_TRUE(xSol[k].isApprox(xRef[k], tol));
+    EXPECT_TRUE(uSol[k].isApprox(uRef[k], tol));
+  }
+  EXPECT_TRUE(xSol[N].isApprox(xRef[N], tol));
+}
+
+TEST(testPartitionedRiccati, indefiniteHessian) {
+  const int nx = 3;
+  const int nu = 2;
+  const int N = 12;
+  const int nThreads = 3;
+  auto problem = getRandomLqProblem(nx, nu, N);
+  problem.dynamics[6].dfdu.setZero();
+  problem.cost[6].dfduu = -matrix_t::Identity(nu, nu);
+
+  ThreadPool threadPool(nThreads - 1);
+  PartitionedRiccatiSolver solver;
+  vector_array_t xSol;
+  vector_array_t uSol;
+  for (int numPartitions : {1, 4}) {
+    EXPECT_THROW(solver.solve(problem.x0, problem.dynamics, problem.cost, numPartitions, threadPool, nThreads, xSol, uSol),
+                 std::runtime_error);
+  }
+}
@@ -90,6 +90,23 @@ TEST(test_projection, testProjectionLU) {
   ASSERT_TRUE((pseudoInverse.transpose() * constraint.f).isApprox(-projection.f));
 }
 
+TEST(test_projection, testProjectionLUInPlace) {
+  const auto constraint = ocs2::getRandomConstraints(30, 20, 10);
+  const auto result = ocs2::luConstraintProjection(constraint, true);
+
+  // Writing into a projection of the right size keeps its memory
+  ocs2::VectorFunctionLinearApproximation projection(20, 30, 10);
+  const auto* dfdxData = projection.dfdx.data();
+  ocs2::matrix_t pseudoInverse;
+  ocs2::luConstraintProjection(constraint, projection, &pseudoInverse);
+  ASSERT_EQ(projection.dfdx.data(), dfdxData);
+
+  ASSERT_TRUE(projection.f.isApprox(result.first.f));
+  ASSERT_TRUE(projection.dfdx.isApprox(result.first.dfdx));
+  ASSERT_TRUE(projection.dfdu.isApprox(result.first.dfdu));
+  ASSERT_TRUE(pseudoInverse.isApprox(result.second));
+}
+
 TEST(test_projection, testProjectionMultiplierCoefficients) {
   const size_t stateDim = 30;
   const size_t inputDim = 20;
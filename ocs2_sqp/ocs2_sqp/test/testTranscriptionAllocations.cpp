@@ -0,0 +1,141 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+
+#include "ocs2_sqp/MultipleShootingTranscription.h"
+
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+/*
+ * Counts the calls to malloc while counting is enabled. Eigen allocates its dynamic storage with malloc, operator new ends up there
+ * as well. Interposing malloc like this relies on glibc, therefore this test lives in its own executable.
+ */
+extern "C" void* __libc_malloc(size_t size);
+
+namespace {
+std::atomic_bool isCounting{false};
+std::atomic_size_t numAllocations{0};
+}  // namespace
+
+extern "C" void* malloc(size_t size) {
+  if (isCounting) {
+    ++numAllocations;
+  }
+  return __libc_malloc(size);
+}
+
+using namespace ocs2;
+using namespace ocs2::multiple_shooting;
+
+class TranscriptionAllocationsTest : public testing::Test {
+ protected:
+  static constexpr int nx = 4;
+  static constexpr int nu = 3;
+  static constexpr int nc = 2;
+
+  TranscriptionAllocationsTest()
+      : sensitivityDiscretizer(selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4)),
+        targetTrajectories({0.0}, {vector_t::Random(nx)}, {vector_t::Random(nu)}) {
+    problem.dynamicsPtr = getOcs2Dynamics(getRandomDynamics(nx, nu));
+    problem.costPtr->add("cost", getOcs2Cost(getRandomCost(nx, nu)));
+    problem.equalityConstraintPtr->add("equalityConstraint", getOcs2Constraints(getRandomConstraints(nx, nu, nc)));
+    problem.targetTrajectoriesPtr = &targetTrajectories;
+  }
+
+  /** Returns the number of allocations made by setting up and projecting the node into the given transcription */
+  size_t countAllocations(Transcription& transcription, bool extractPseudoInverse) {
+    numAllocations = 0;
+    isCounting = true;
+    setupIntermediateNode(problem, sensitivityDiscretizer, t, dt, x, x_next, u, transcription);
+    projectTranscription(transcription, extractPseudoInverse);
+    isCounting = false;
+    return numAllocations;
+  }
+
+  OptimalControlProblem problem;
+  DynamicsSensitivityDiscretizer sensitivityDiscretizer;
+  TargetTrajectories targetTrajectories;
+
+  const scalar_t t = 0.5;
+  const scalar_t dt = 0.1;
+  const vector_t x = vector_t::Random(nx);
+  const vector_t x_next = vector_t::Random(nx);
+  const vector_t u = vector_t::Random(nu);
+};
+
+constexpr int TranscriptionAllocationsTest::nx;
+constexpr int TranscriptionAllocationsTest::nu;
+constexpr int TranscriptionAllocationsTest::nc;
+
+TEST_F(TranscriptionAllocationsTest, luProjectionReusesMemory) {
+  Transcription reused;
+  countAllocations(reused, false);  // warm-up
+
+  Transcription fresh;
+  const auto numFreshAllocations = countAllocations(fresh, false);
+  const auto numReusedAllocations = countAllocations(reused, false);
+
+  // Pu, Px and Pe of the projection are written into the existing memory
+  ASSERT_GT(numFreshAllocations, 0u);
+  EXPECT_EQ(numFreshAllocations - numReusedAllocations, 3u);
+  EXPECT_TRUE(fresh.constraintsProjection.dfdu.isApprox(reused.constraintsProjection.dfdu));
+  EXPECT_TRUE(fresh.cost.dfduu.isApprox(reused.cost.dfduu));
+}
+
+TEST_F(TranscriptionAllocationsTest, qrProjectionReusesMemory) {
+  Transcription reused;
+  countAllocations(reused, true);  // warm-up
+
+  Transcription fresh;
+  const auto numFreshAllocations = countAllocations(fresh, true);
+  const auto numReusedAllocations = countAllocations(reused, true);
+
+  // Pu, Px, Pe and the pseudo-inverse are written into the existing memory
+  ASSERT_GT(numFreshAllocations, 0u);
+  EXPECT_EQ(numFreshAllocations - numReusedAllocations, 4u);
+  EXPECT_TRUE(fresh.constraintPseudoInverse.isApprox(reused.constraintPseudoInverse));
+  EXPECT_TRUE(fresh.cost.dfduu.isApprox(reused.cost.dfduu));
+}
+
+TEST_F(TranscriptionAllocationsTest, unconstrainedNodeHasNoProjection) {
+  Transcription transcription;
+  countAllocations(transcription, true);
+  ASSERT_EQ(transcription.constraintPseudoInverse.rows(), nc);
+
+  problem.equalityConstraintPtr->erase("equalityConstraint");
+  countAllocations(transcription, true);
+  EXPECT_EQ(transcription.constraintsProjection.f.size(), 0);
+  EXPECT_EQ(transcription.constraintPseudoInverse.size(), 0);
+  EXPECT_EQ(transcription.cost.dfduu.rows(), nu);
+}